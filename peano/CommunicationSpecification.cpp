@@ -40,6 +40,9 @@ std::string peano::CommunicationSpecification::toString() const {
     case ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeSendStateAfterLastTouchVertexLastTime:
       msg << "SendDataAfterProcessingOfLocalSubtreeSendStateAfterLastTouchVertexLastTime";
       break;
+    case ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground:
+      msg << "SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground";
+      break;
     case ExchangeWorkerMasterData::SendDataAndStateAfterProcessingOfLocalSubtree:
       msg << "SendDataAndStateAfterProcessingOfLocalSubtree";
       break;
@@ -61,6 +64,11 @@ bool peano::CommunicationSpecification::shallKernelControlHeap() const {
 }
 
 
+bool peano::CommunicationSpecification::shallReduceStateInBackground() const {
+  return exchangeWorkerMasterData==ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground;
+}
+
+
 peano::CommunicationSpecification operator&(const peano::CommunicationSpecification& lhs, const peano::CommunicationSpecification& rhs) {
   return peano::CommunicationSpecification::combine(lhs,rhs);
 }
@@ -98,6 +106,18 @@ peano::CommunicationSpecification peano::CommunicationSpecification::combine(con
     exchangeWorkerMasterData = peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeSendStateAfterLastTouchVertexLastTime;
   }
   else
+  if (
+    ((rhs.exchangeWorkerMasterData==peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground) & (lhs.exchangeWorkerMasterData==peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAndStateAfterProcessingOfLocalSubtree))
+    |
+    ((lhs.exchangeWorkerMasterData==peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground) & (rhs.exchangeWorkerMasterData==peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAndStateAfterProcessingOfLocalSubtree))
+  ) {
+    exchangeWorkerMasterData = peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeSendStateAfterLastTouchVertexLastTime;
+  }
+  else
+  if ((rhs.exchangeWorkerMasterData==peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground) | (lhs.exchangeWorkerMasterData==peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground)) {
+    exchangeWorkerMasterData = peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground;
+  }
+  else
   if ((rhs.exchangeWorkerMasterData==peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAndStateAfterProcessingOfLocalSubtree) | (lhs.exchangeWorkerMasterData==peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAndStateAfterProcessingOfLocalSubtree)) {
     exchangeWorkerMasterData = peano::CommunicationSpecification::ExchangeWorkerMasterData::SendDataAndStateAfterProcessingOfLocalSubtree;
   }
@@ -156,6 +176,9 @@ peano::CommunicationSpecification::Action peano::CommunicationSpecification::sen
     case ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeSendStateAfterLastTouchVertexLastTime:
       return peano::CommunicationSpecification::Action::Late;
       break;
+    case ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground:
+      return peano::CommunicationSpecification::Action::Late;
+      break;
     case ExchangeWorkerMasterData::SendDataAndStateAfterProcessingOfLocalSubtree:
       return peano::CommunicationSpecification::Action::Early;
       break;
@@ -176,6 +199,9 @@ peano::CommunicationSpecification::Action peano::CommunicationSpecification::sen
     case ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeSendStateAfterLastTouchVertexLastTime:
       return peano::CommunicationSpecification::Action::Early;
       break;
+    case ExchangeWorkerMasterData::SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground:
+      return peano::CommunicationSpecification::Action::Early;
+      break;
     case ExchangeWorkerMasterData::SendDataAndStateAfterProcessingOfLocalSubtree:
       return peano::CommunicationSpecification::Action::Early;
       break;
@@ -140,6 +140,25 @@ struct peano::CommunicationSpecification {
        * be exchanged later.
        */
       SendDataAfterProcessingOfLocalSubtreeSendStateAfterLastTouchVertexLastTime,
+      /**
+       * The worker behaves as for the previous flag, i.e. it sends its data
+       * as soon as possible and its state when all operations have
+       * terminated. The master however does not wait for the worker's state
+       * when it merges the worker's data. It receives the state in the
+       * background and merges it into its own state right before its
+       * endIteration(). The master thus can continue with its local work
+       * while the worker traverses its remaining halo cells. There is no
+       * synchronisation per worker anymore besides the data exchange.
+       *
+       * As a consequence, the worker state handed over to mergeWithMaster()
+       * does not hold the worker's data. Its isReceivedInBackground()
+       * returns true. Use this flag only if your mergeWithMaster() does not
+       * read the worker's state. The counters
+       * and flags of the Peano state are reduced correctly. If a rank is
+       * involved in a fork or join, the master falls back to a blocking
+       * receive of the worker's state.
+       */
+      SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground,
       /**
        * Send data and state up to the master as soon as the local spacetree is
        * processed. As a consequence, we call endIteration() and the
@@ -213,6 +232,12 @@ struct peano::CommunicationSpecification {
 
     bool shallKernelControlHeap() const;
 
+    /**
+     * Shall the master receive the workers' states in the background? See
+     * SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground.
+     */
+    bool shallReduceStateInBackground() const;
+
     /**
      * Realisation of the & operator.
      *
@@ -231,6 +256,17 @@ struct peano::CommunicationSpecification {
      * spec by default does not control the heap in the kernel, so if a
      * mapping selects true for the heap control flag both specs do not
      * agree. In this case, we do not write a warning.
+     *
+     * !!! Background state reduction
+     *
+     * The worker-master variants are ordered from the most restrictive one
+     * to the most aggressive one, and the combination picks the more
+     * restrictive variant. SendDataAndStateAfterProcessingOfLocalSubtree and
+     * SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground however
+     * relax different things: The former sends the state early but hands
+     * it over to mergeWithMaster(), the latter sends it late but does not
+     * hand it over. Their combination thus yields
+     * SendDataAfterProcessingOfLocalSubtreeSendStateAfterLastTouchVertexLastTime.
      */
     static peano::CommunicationSpecification combine(const peano::CommunicationSpecification& lhs, const peano::CommunicationSpecification& rhs);
   private:
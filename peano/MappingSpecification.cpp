@@ -6,10 +6,12 @@
 #include <sstream>
 
 
-peano::MappingSpecification::MappingSpecification(peano::MappingSpecification::Manipulates manipulates_, peano::MappingSpecification::Multithreading multithreading_, bool altersState_):
+peano::MappingSpecification::MappingSpecification(peano::MappingSpecification::Manipulates manipulates_, peano::MappingSpecification::Multithreading multithreading_, bool altersState_, bool supportsSubpatchFusion_, bool supportsBatchedEvents_):
   manipulates(manipulates_),
   multithreading(multithreading_),
-  altersState(altersState_) {
+  altersState(altersState_),
+  supportsSubpatchFusion(supportsSubpatchFusion_),
+  supportsBatchedEvents(supportsBatchedEvents_) {
 }
 
 
@@ -53,6 +55,8 @@ std::string peano::MappingSpecification::toString() const {
       break;
   }
   msg << ",alters-state=" << altersState;
+  msg << ",supports-subpatch-fusion=" << supportsSubpatchFusion;
+  msg << ",supports-batched-events=" << supportsBatchedEvents;
   msg << ")";
   return msg.str();
 }
@@ -121,12 +125,16 @@ peano::MappingSpecification operator&(const peano::MappingSpecification& lhs, co
 
   const bool altersState = (rhs.manipulates!=peano::MappingSpecification::Nop && rhs.altersState) | (lhs.manipulates!=peano::MappingSpecification::Nop && lhs.altersState);
 
-  const peano::MappingSpecification result(manipulates,multithreading,altersState);
+  const bool supportsSubpatchFusion = rhs.supportsSubpatchFusion && lhs.supportsSubpatchFusion;
+
+  const bool supportsBatchedEvents = rhs.supportsBatchedEvents && lhs.supportsBatchedEvents;
+
+  const peano::MappingSpecification result(manipulates,multithreading,altersState,supportsSubpatchFusion,supportsBatchedEvents);
   logTraceOutWith1Argument("operator&(...)",result.toString());
   return result;
 }
 
 
 peano::MappingSpecification peano::MappingSpecification::getMinimalSpecification() {
-  return MappingSpecification(Nop,peano::MappingSpecification::RunConcurrentlyOnFineGrid,false);
+  return MappingSpecification(Nop,peano::MappingSpecification::RunConcurrentlyOnFineGrid,false,true,true);
 }
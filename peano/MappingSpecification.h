@@ -67,6 +67,51 @@ Application hence doesn't need semaphores. </td>
  * copying and the reduction. We basically may assume that the event is
  * const.
  *
+ * <h2> Fused sweeps within one subtree visit </h2>
+ *
+ * On regular subtrees, Peano usually runs all the descending events (touch
+ * first time, descend, enter cell) on all levels before it invokes the first
+ * ascending event (leave cell, ascend, touch last time). If a regular subtree
+ * is held persistently, the kernel may instead fuse the two sweeps of one
+ * and the same visit of the subtree: it cuts the subtree into subpatches and
+ * runs the ascending events on one subpatch straight after its descending
+ * events, i.e. while the subpatch's data still resides in the caches. Leave
+ * cell events on one subpatch then might be invoked before enter cell events
+ * on a neighbouring subpatch, and touchVertexLastTime on an interior vertex
+ * of one subpatch might precede touchVertexFirstTime on a vertex of another
+ * one. The order per cell and per vertex is preserved. The kernel does so
+ * only if all six events on the levels below the subpatch level set
+ * supportsSubpatchFusion.
+ *
+ * The flag does not allow the kernel to fuse sweeps of different
+ * traversals: the ascend of one iteration always completes, and endIteration()
+ * is always called, before the descend of the next iteration starts.
+ *
+ * <h2> Batched events </h2>
+ *
+ * On regular subtrees, the kernel by default invokes enterCell and
+ * touchVertexFirstTime once per cell or vertex, respectively. If the
+ * specification sets supportsBatchedEvents, it instead invokes
+ *
+ * - enterCells(fineGridCells, fineGridVertices, fineGridVerticesEnumerator,
+ *   coarseGridVertices, coarseGridVerticesEnumerator, coarseGridCells,
+ *   firstCell, numberOfCells) and
+ * - touchVerticesFirstTime(fineGridVertices, fineGridVerticesEnumerator,
+ *   coarseGridVertices, coarseGridVerticesEnumerator, coarseGridCells,
+ *   firstVertex, numberOfVertices)
+ *
+ * once per contiguous range of cells or vertices along the x-axis. The
+ * arrays are the level arrays of the RegularGridContainer, and the range
+ * covers the linearised indices firstCell to firstCell+numberOfCells-1 (or
+ * the vertex counterparts). The enumerators are of type
+ * UnrolledLevelEnumerator and point to the first element of the range; the
+ * k-th element of the range sits at the enumerator's offset shifted by k
+ * along the x-axis. A range never contains outside cells, outside vertices
+ * or vertices that are read from a temporary stack. If the event handle
+ * does not provide the batched operations, the kernel falls back to the
+ * per-element events. Batched events are used level by level only, i.e.
+ * not if the kernel decomposes a subtree into subpatches.
+ *
  * @author Tobias Weinzierl
  */
 struct peano::MappingSpecification {
@@ -91,9 +136,34 @@ struct peano::MappingSpecification {
 
   Manipulates     manipulates;
   Multithreading  multithreading;
+
+  /**
+   * Does the event modify the state or any other attribute of the mapping?
+   *
+   * If not, the enter-cell and leave-cell loop bodies on regular subtrees
+   * do not copy the mapping. All tasks then invoke one and the same mapping
+   * object concurrently. The events thus have to be thread-safe, and they
+   * may only accumulate data through thread-safe means such as
+   * tarch::multicore::Accumulator. If the flag is set, each task works on a
+   * copy of its own that is merged back via mergeWithWorkerThread(). The
+   * touch-vertex loop bodies always work on copies.
+   */
   bool            altersState;
 
-  MappingSpecification(Manipulates manipulates_, Multithreading multithreading_, bool altersState_);
+  /**
+   * The event may be interleaved with the events of the opposite sweep
+   * direction on the subpatches of one persistent regular subtree within
+   * one traversal. See the class documentation.
+   */
+  bool            supportsSubpatchFusion;
+
+  /**
+   * The event handle may be invoked for whole ranges of cells or vertices
+   * on regular subtrees. See the class documentation.
+   */
+  bool            supportsBatchedEvents;
+
+  MappingSpecification(Manipulates manipulates_, Multithreading multithreading_, bool altersState_, bool supportsSubpatchFusion_=false, bool supportsBatchedEvents_=false);
 
   /**
    * Most general specification
@@ -1,11 +1,13 @@
 #include "peano/datatraversal/autotuning/GrainSize.h"
 #include "peano/datatraversal/autotuning/OracleForOnePhase.h"
+#include "peano/datatraversal/autotuning/Oracle.h"
 #include "tarch/Assertions.h"
 
 
 peano::datatraversal::autotuning::GrainSize::GrainSize(int grainSize, bool useTimer, int problemSize, MethodTrace askingMethod, OracleForOnePhase* hostOracle):
   _grainSize(grainSize),
   _useTimer(useTimer),
+  _recordTimingHistogram(Oracle::getInstance().recordsTimingHistograms()),
   _problemSize(problemSize),
   _askingMethod(askingMethod),
   _hostOracle(hostOracle),
@@ -15,9 +17,8 @@ peano::datatraversal::autotuning::GrainSize::GrainSize(int grainSize, bool useTi
 
   assertion5( !_useTimer || _hostOracle!=nullptr,grainSize, useTimer, problemSize, toString(askingMethod), (hostOracle==nullptr));
 
-  if (_useTimer) {
+  if (_useTimer || _recordTimingHistogram) {
     _watch = new tarch::timing::Watch("peano::datatraversal::autotuning::GrainSize", "GrainSize(...)", false);
-    assertion(_hostOracle!=nullptr);
   }
 }
 
@@ -25,19 +26,18 @@ peano::datatraversal::autotuning::GrainSize::GrainSize(int grainSize, bool useTi
 peano::datatraversal::autotuning::GrainSize::GrainSize(GrainSize&& movedObject):
   _grainSize(movedObject._grainSize),
   _useTimer(movedObject._useTimer),
+  _recordTimingHistogram(movedObject._recordTimingHistogram),
   _problemSize(movedObject._problemSize),
   _askingMethod(movedObject._askingMethod),
   _hostOracle(movedObject._hostOracle),
   _watch(movedObject._watch) {
-  if (_useTimer) {
-    assertion(_hostOracle!=nullptr);
-    movedObject._watch    = nullptr;
-  }
+  assertion( !_useTimer || _hostOracle!=nullptr );
+  movedObject._watch = nullptr;
 }
 
 
 peano::datatraversal::autotuning::GrainSize::~GrainSize() {
-  if (_useTimer && _watch!=nullptr) {
+  if (_watch!=nullptr) {
     parallelSectionHasTerminated();
   }
 }
@@ -54,15 +54,19 @@ bool peano::datatraversal::autotuning::GrainSize::runsParallel() const {
 
 
 void peano::datatraversal::autotuning::GrainSize::parallelSectionHasTerminated() {
-  if ( _useTimer ) {
-    assertion( _watch!=nullptr );
-    assertion( _hostOracle!=nullptr );
-    assertion( _problemSize>0 );
-
+  if ( _watch!=nullptr ) {
     _watch->stopTimer();
-    const double cost = _watch->getCalendarTime() / static_cast<double>(_problemSize);
+    const double time = _watch->getCalendarTime();
+
+    if (_useTimer) {
+      assertion( _hostOracle!=nullptr );
+      assertion( _problemSize>0 );
+      _hostOracle->parallelSectionHasTerminated(_problemSize,_grainSize,_askingMethod,time / static_cast<double>(_problemSize));
+    }
 
-    _hostOracle->parallelSectionHasTerminated(_problemSize,_grainSize,_askingMethod,cost);
+    if (_recordTimingHistogram) {
+      Oracle::getInstance().addTimingSample(_askingMethod,time,_grainSize>0);
+    }
 
     delete _watch;
     _watch = nullptr;
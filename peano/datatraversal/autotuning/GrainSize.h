@@ -26,12 +26,17 @@ namespace peano {
  * is provided once the object is destroyed (or explicitly closed). The class
  * design thus is very similar to TBB's lock.
  *
+ * If the Oracle records timing histograms, the object furthermore measures
+ * the section's time even if the host oracle is not interested in it, and
+ * hands it over to the Oracle once the section has terminated.
+ *
  * @author Tobias Weinzierl
  */
 class peano::datatraversal::autotuning::GrainSize {
   private:
     const int              _grainSize;
     const bool             _useTimer;
+    const bool             _recordTimingHistogram;
     const int              _problemSize;
     const MethodTrace      _askingMethod;
     OracleForOnePhase*     _hostOracle;
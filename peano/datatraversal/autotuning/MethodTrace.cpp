@@ -63,6 +63,9 @@ std::string peano::datatraversal::autotuning::toString( const MethodTrace& metho
     case MethodTrace::DecomposeDescendIntoMultilevelTasks:
       return "decompose-descend-into-multilevel-task";
 
+    case MethodTrace::TraverseLeafSiblingsConcurrently:
+      return "traverse-leaf-siblings-concurrently";
+
 
     case MethodTrace::UserDefined0:
       return "user-defined-0";
@@ -189,6 +192,9 @@ peano::datatraversal::autotuning::MethodTrace peano::datatraversal::autotuning::
     case static_cast<int>(MethodTrace::DecomposeDescendIntoMultilevelTasks):
       return MethodTrace::DecomposeDescendIntoMultilevelTasks;
 
+    case static_cast<int>(MethodTrace::TraverseLeafSiblingsConcurrently):
+      return MethodTrace::TraverseLeafSiblingsConcurrently;
+
     case static_cast<int>(MethodTrace::UserDefined0):
       return MethodTrace::UserDefined0;
     case static_cast<int>(MethodTrace::UserDefined1):
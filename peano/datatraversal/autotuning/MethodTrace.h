@@ -36,6 +36,14 @@ namespace peano {
         DecomposeAscendIntoMultilevelTasks               = 20,
         DecomposeDescendIntoMultilevelTasks              = 21,
 
+        /**
+         * Traverse the 3^d children of a refined cell concurrently if all of
+         * them are leaves. Refined children are never traversed concurrently.
+         * Has been added after the user-defined traces, i.e. it does not
+         * follow the numbering of the others.
+         */
+        TraverseLeafSiblingsConcurrently                 = 53,
+
         UserDefined3  = 22,
         UserDefined4  = 23,
         UserDefined5  = 24,
@@ -69,7 +77,7 @@ namespace peano {
         UserDefined1  = 51,
         UserDefined2  = 52,
 
-        NumberOfDifferentMethodsCalling                  = 53
+        NumberOfDifferentMethodsCalling                  = 54
       };
 
       std::string toString( const MethodTrace& methodTrace );
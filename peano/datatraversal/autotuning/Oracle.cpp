@@ -1,5 +1,6 @@
 #include "peano/datatraversal/autotuning/Oracle.h"
 #include "peano/datatraversal/autotuning/OracleForOnePhaseDummy.h"
+#include "peano/datatraversal/autotuning/TuningDatabase.h"
 #include "tarch/Assertions.h"
 #include "tarch/multicore/MulticoreDefinitions.h"
 #include "tarch/multicore/Lock.h"
@@ -28,7 +29,11 @@ peano::datatraversal::autotuning::Oracle::Oracle():
   _currentOracle(0),
   #endif
   _oraclePrototype(nullptr),
-  _numberOfOracles(0) {
+  _numberOfOracles(0),
+  _recordTimingHistograms(false),
+  _timingHistogramsDumpInterval(0.0),
+  _lastTimingHistogramsDump(std::chrono::steady_clock::now()),
+  _timingHistograms( static_cast<int>(MethodTrace::NumberOfDifferentMethodsCalling) ) {
 }
 
 
@@ -85,6 +90,26 @@ void peano::datatraversal::autotuning::Oracle::loadStatistics(const std::string&
 }
 
 
+void peano::datatraversal::autotuning::Oracle::loadTuningDatabase(const std::string& filename) {
+  TuningDatabase database;
+  database.load(filename);
+  for (int i=0; i<static_cast<int>(_oracles.size()); i++) {
+    assertion2(_oracles[i]!=nullptr,i,_numberOfOracles);
+    _oracles[i]->loadFromDatabase(database,i);
+  }
+}
+
+
+void peano::datatraversal::autotuning::Oracle::storeTuningDatabase(const std::string& filename) {
+  TuningDatabase database;
+  for (int i=0; i<static_cast<int>(_oracles.size()); i++) {
+    assertion2(_oracles[i]!=nullptr,i,_numberOfOracles);
+    _oracles[i]->storeInDatabase(database,i);
+  }
+  database.store(filename);
+}
+
+
 peano::datatraversal::autotuning::Oracle::~Oracle() {
   deleteOracles();
   if (_oraclePrototype!=0) {
@@ -100,6 +125,9 @@ void peano::datatraversal::autotuning::Oracle::setNumberOfOracles(int value) {
 
   deleteOracles();
   _numberOfOracles=value;
+  if (_oraclePrototype!=0) {
+    createOracles();
+  }
 
   logTraceOut( "setNumberOfOracles(int)");
 }
@@ -131,6 +159,7 @@ void peano::datatraversal::autotuning::Oracle::deleteOracles() {
   for (auto oracle: _oracles) {
     delete oracle;
   }
+  _oracles.clear();
 
   logTraceOut( "deleteOracles()");
 }
@@ -162,3 +191,81 @@ peano::datatraversal::autotuning::GrainSize peano::datatraversal::autotuning::Or
   return GrainSize( 0, false, problemSize, askingMethod, nullptr);
   #endif
 }
+
+
+void peano::datatraversal::autotuning::Oracle::recordTimingHistograms(bool value, double dumpInterval) {
+  logTraceInWith2Arguments( "recordTimingHistograms(bool,double)", value, dumpInterval );
+
+  tarch::multicore::Lock lock(_timingHistogramsSemaphore);
+  _recordTimingHistograms       = value;
+  _timingHistogramsDumpInterval = dumpInterval;
+  _lastTimingHistogramsDump     = std::chrono::steady_clock::now();
+
+  logTraceOut( "recordTimingHistograms(bool,double)" );
+}
+
+
+bool peano::datatraversal::autotuning::Oracle::recordsTimingHistograms() const {
+  return _recordTimingHistograms;
+}
+
+
+void peano::datatraversal::autotuning::Oracle::addTimingSample(MethodTrace askingMethod, double time, bool parallel) {
+  const int method = static_cast<int>(askingMethod);
+  assertion2( method>=0, method, time );
+  assertion2( method<static_cast<int>(_timingHistograms.size()), method, time );
+
+  bool plot = false;
+  {
+    tarch::multicore::Lock lock(_timingHistogramsSemaphore);
+    _timingHistograms[method].addSample(time,parallel);
+
+    if (_timingHistogramsDumpInterval>0.0) {
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      if ( std::chrono::duration<double>(now-_lastTimingHistogramsDump).count() >= _timingHistogramsDumpInterval ) {
+        _lastTimingHistogramsDump = now;
+        plot                      = true;
+      }
+    }
+  }
+
+  if (plot) {
+    plotTimingHistograms();
+  }
+}
+
+
+peano::datatraversal::autotuning::TimingHistogram peano::datatraversal::autotuning::Oracle::getTimingHistogram(MethodTrace askingMethod) {
+  tarch::multicore::Lock lock(_timingHistogramsSemaphore);
+  return _timingHistograms[ static_cast<int>(askingMethod) ];
+}
+
+
+void peano::datatraversal::autotuning::Oracle::plotTimingHistograms() {
+  std::ostringstream msg;
+  int numberOfPlottedHistograms = 0;
+  {
+    tarch::multicore::Lock lock(_timingHistogramsSemaphore);
+    for (int i=0; i<static_cast<int>(_timingHistograms.size()); i++) {
+      if (_timingHistograms[i].getNumberOfSamples()>0) {
+        msg << std::endl << toString( toMethodTrace(i) ) << ": " << _timingHistograms[i].toString();
+        numberOfPlottedHistograms++;
+      }
+    }
+  }
+
+  if (numberOfPlottedHistograms>0) {
+    logInfo( "plotTimingHistograms()", "timing histograms (times in seconds):" << msg.str() );
+  }
+  else {
+    logInfo( "plotTimingHistograms()", "no timing samples recorded" );
+  }
+}
+
+
+void peano::datatraversal::autotuning::Oracle::clearTimingHistograms() {
+  tarch::multicore::Lock lock(_timingHistogramsSemaphore);
+  for (auto& histogram: _timingHistograms) {
+    histogram.clear();
+  }
+}
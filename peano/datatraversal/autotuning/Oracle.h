@@ -4,6 +4,8 @@
 #define _PEANO_DATA_TRAVERSAL_AUTOTUNING_ORACLE_H_
 
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 
 
@@ -11,6 +13,7 @@
 #include "tarch/multicore/BooleanSemaphore.h"
 #include "peano/datatraversal/autotuning/GrainSize.h"
 #include "peano/datatraversal/autotuning/OracleForOnePhase.h"
+#include "peano/datatraversal/autotuning/TimingHistogram.h"
 
 
 namespace peano {
@@ -37,6 +40,22 @@ namespace peano {
  * - Keep track of the current phase, i.e. of the adapter used at the moment.
  * - Measure times needed for the parallelisation and give the concrete oracles
  *   feedback about the time needed.
+ * - Keep track of timing histograms per method trace if required.
+ *
+ * <h2> Timing histograms </h2>
+ *
+ * The concrete oracles decide on their own whether they want to get timing
+ * feedback (see GrainSize). Independent of this decision, you can ask the
+ * oracle to record per method trace how long the sections that have asked for
+ * a grain size ran, and whether they ran serially or in parallel. Switch this
+ * on through recordTimingHistograms(). The histograms then are available via
+ * getTimingHistogram() and plotTimingHistograms(), and, if you specify a dump
+ * interval, they are written to the info log device periodically while the
+ * code runs. As every section then needs a timer and a lock, the recording
+ * is switched off by default.
+ *
+ * The recording also works without shared memory parallelisation. All
+ * sections then are serial sections.
  *
  * @author Tobias Weinzierl
  */
@@ -73,6 +92,31 @@ class peano::datatraversal::autotuning::Oracle {
 
     int                                        _numberOfOracles;
 
+    /**
+     * Is read through recordsTimingHistograms() by each GrainSize without any
+     * lock, i.e. by many threads at the same time, while
+     * recordTimingHistograms() might reset it.
+     */
+    std::atomic<bool>                          _recordTimingHistograms;
+
+    /**
+     * Dump interval in seconds. Periodic dumps are switched off if the value
+     * is not positive.
+     */
+    double                                     _timingHistogramsDumpInterval;
+
+    std::chrono::steady_clock::time_point      _lastTimingHistogramsDump;
+
+    /**
+     * One histogram per method trace.
+     */
+    std::vector<TimingHistogram>               _timingHistograms;
+
+    /**
+     * Sections may terminate concurrently.
+     */
+    tarch::multicore::BooleanSemaphore         _timingHistogramsSemaphore;
+
     void createOracles();
     void deleteOracles();
 
@@ -100,6 +144,25 @@ class peano::datatraversal::autotuning::Oracle {
      */
     void loadStatistics(const std::string& filename);
 
+    /**
+     * Warm-start all oracles from a tuning database. Each oracle takes the
+     * entries of the configuration (machine, threads, dimensions) closest
+     * to the current one. As with loadStatistics(), you have to create your
+     * repositories before. It is not an error if the file does not exist yet.
+     *
+     * @see TuningDatabase
+     */
+    void loadTuningDatabase(const std::string& filename);
+
+    /**
+     * Merge what all oracles have learned into a tuning database. Entries of
+     * other configurations in the file are preserved. With MPI, several
+     * ranks may call this operation at the same time. They then serialise
+     * on a lock file, and a rank that does not get the lock within five
+     * seconds does not store anything (see TuningDatabase).
+     */
+    void storeTuningDatabase(const std::string& filename);
+
     /**
      * Tell the oracle how many different adapters you'll gonna use.
      */
@@ -146,6 +209,37 @@ class peano::datatraversal::autotuning::Oracle {
      *         zero this code piece shall not run in parallel
      */
     GrainSize  parallelise( int problemSize, MethodTrace askingMethod );
+
+    /**
+     * Switch the timing histograms on or off. Switching them on does not
+     * reset the histograms recorded so far. See class documentation.
+     *
+     * @param dumpInterval Time in seconds after which the oracle plots the
+     *          histograms again. The check is done whenever a section
+     *          terminates. Pass 0 if you do not want periodic dumps.
+     */
+    void recordTimingHistograms(bool value, double dumpInterval=0.0);
+
+    bool recordsTimingHistograms() const;
+
+    /**
+     * Is invoked by GrainSize if recordsTimingHistograms() holds.
+     *
+     * @param time Calendar time in seconds.
+     */
+    void addTimingSample(MethodTrace askingMethod, double time, bool parallel);
+
+    /**
+     * @return Copy of the histogram of one method trace.
+     */
+    TimingHistogram getTimingHistogram(MethodTrace askingMethod);
+
+    /**
+     * Plot all non-empty histograms to the info log device.
+     */
+    void plotTimingHistograms();
+
+    void clearTimingHistograms();
 };
 
 #endif
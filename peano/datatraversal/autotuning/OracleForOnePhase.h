@@ -15,6 +15,7 @@ namespace peano {
   namespace datatraversal {
     namespace autotuning {
       class OracleForOnePhase;
+      class TuningDatabase;
     }
   }
 }
@@ -69,6 +70,19 @@ class peano::datatraversal::autotuning::OracleForOnePhase {
      */
     virtual void loadStatistics(const std::string& filename, int oracleNumber) = 0;
 
+    /**
+     * Write what the oracle has learned into a tuning database. Not every
+     * oracle has to support this, so the default does nothing.
+     *
+     * @see TuningDatabase
+     */
+    virtual void storeInDatabase(TuningDatabase& database, int oracleNumber) const {}
+
+    /**
+     * Warm-start from a tuning database. The default does nothing.
+     */
+    virtual void loadFromDatabase(const TuningDatabase& database, int oracleNumber) {}
+
     /**
      * This operation is called by the oracle (management) on the active oracle
      * before it activates another one.
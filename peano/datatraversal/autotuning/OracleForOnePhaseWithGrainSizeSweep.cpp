@@ -0,0 +1,250 @@
+#include "peano/datatraversal/autotuning/OracleForOnePhaseWithGrainSizeSweep.h"
+#include "peano/datatraversal/autotuning/MethodTrace.h"
+#include "tarch/multicore/Lock.h"
+#include "tarch/Assertions.h"
+
+
+#include <algorithm>
+#include <sstream>
+
+
+tarch::logging::Log  peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::_log( "peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep" );
+
+
+peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::OracleForOnePhaseWithGrainSizeSweep():
+  _sweep( new Sweep() ) {
+  _sweep->sweptMethod = MethodTrace::NumberOfDifferentMethodsCalling;
+  _sweep->grainSize   = 0;
+}
+
+
+peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::OracleForOnePhaseWithGrainSizeSweep(std::shared_ptr<Sweep> sweep):
+  _sweep( sweep ) {
+}
+
+
+peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::~OracleForOnePhaseWithGrainSizeSweep() {
+}
+
+
+int peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::getBucket(int problemSize) {
+  assertion1( problemSize>0, problemSize );
+  int result = 0;
+  while (problemSize>1) {
+    problemSize /= 2;
+    result++;
+  }
+  return result;
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::switchToDiscovery() {
+  tarch::multicore::Lock lock(_sweep->semaphore);
+  _sweep->sweptMethod = MethodTrace::NumberOfDifferentMethodsCalling;
+  _sweep->grainSize   = 0;
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::switchToSweep(MethodTrace method, int grainSize) {
+  assertion1( grainSize>=0, grainSize );
+  assertion( method!=MethodTrace::NumberOfDifferentMethodsCalling );
+
+  tarch::multicore::Lock lock(_sweep->semaphore);
+  _sweep->sweptMethod = method;
+  _sweep->grainSize   = grainSize;
+}
+
+
+std::vector<peano::datatraversal::autotuning::MethodTrace> peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::getAskingMethods() const {
+  tarch::multicore::Lock lock(_sweep->semaphore);
+  std::vector<MethodTrace> result;
+  for (auto& p: _sweep->biggestProblemSize) {
+    result.push_back(p.first);
+  }
+  return result;
+}
+
+
+int peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::getBiggestProblemSize(MethodTrace method) const {
+  tarch::multicore::Lock lock(_sweep->semaphore);
+  return _sweep->biggestProblemSize.count(method)>0 ? _sweep->biggestProblemSize.at(method) : 0;
+}
+
+
+double peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::getCost(MethodTrace method, int bucket, int grainSize) const {
+  tarch::multicore::Lock lock(_sweep->semaphore);
+  const Key key(method,bucket);
+  if (
+    _sweep->measurements.count(key)>0
+    &&
+    _sweep->measurements.at(key).count(grainSize)>0
+  ) {
+    const Measurement& measurement = _sweep->measurements.at(key).at(grainSize);
+    return measurement.accumulatedCost / measurement.numberOfMeasurements;
+  }
+  else {
+    return -1.0;
+  }
+}
+
+
+int peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::getBestGrainSize(MethodTrace method, int bucket) const {
+  tarch::multicore::Lock lock(_sweep->semaphore);
+  const Key key(method,bucket);
+  int    result   = 0;
+  double bestCost = -1.0;
+  if ( _sweep->measurements.count(key)>0 ) {
+    for (auto& p: _sweep->measurements.at(key)) {
+      const double cost = p.second.accumulatedCost / p.second.numberOfMeasurements;
+      if (bestCost<0.0 || cost<bestCost) {
+        result   = p.first;
+        bestCost = cost;
+      }
+    }
+  }
+  return result;
+}
+
+
+peano::datatraversal::autotuning::GrainSize peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::parallelise(int problemSize, MethodTrace askingMethod) {
+  assertion2( problemSize>0, problemSize, peano::datatraversal::autotuning::toString(askingMethod) );
+
+  tarch::multicore::Lock lock(_sweep->semaphore);
+  if ( _sweep->biggestProblemSize.count(askingMethod)==0 ) {
+    _sweep->biggestProblemSize[askingMethod] = problemSize;
+  }
+  else {
+    _sweep->biggestProblemSize[askingMethod] = std::max( _sweep->biggestProblemSize[askingMethod], problemSize );
+  }
+
+  const bool useTimer  = askingMethod==_sweep->sweptMethod;
+  const int  grainSize = useTimer && _sweep->grainSize<problemSize ? _sweep->grainSize : 0;
+  lock.free();
+
+  return GrainSize(grainSize, useTimer, problemSize, askingMethod, this);
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::parallelSectionHasTerminated(int problemSize, int grainSize, MethodTrace askingMethod, double costPerProblemElement) {
+  tarch::multicore::Lock lock(_sweep->semaphore);
+  std::map<int,Measurement>& measurements = _sweep->measurements[ Key(askingMethod,getBucket(problemSize)) ];
+  if ( measurements.count(grainSize)==0 ) {
+    measurements[grainSize] = Measurement{0.0,0};
+  }
+  measurements[grainSize].accumulatedCost += costPerProblemElement;
+  measurements[grainSize].numberOfMeasurements++;
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::plotTable(std::ostream& out) const {
+  tarch::multicore::Lock lock(_sweep->semaphore);
+
+  out << "method-trace bucket grain-size cost-per-problem-element measurements speedup fastest" << std::endl;
+  for (auto& key: _sweep->measurements) {
+    double serialCost = -1.0;
+    double bestCost   = -1.0;
+    for (auto& p: key.second) {
+      const double cost = p.second.accumulatedCost / p.second.numberOfMeasurements;
+      if (p.first==0) serialCost = cost;
+      if (bestCost<0.0 || cost<bestCost) bestCost = cost;
+    }
+
+    for (auto& p: key.second) {
+      const double cost = p.second.accumulatedCost / p.second.numberOfMeasurements;
+      out << peano::datatraversal::autotuning::toString(key.first.first)
+          << " " << key.first.second
+          << " " << p.first
+          << " " << cost
+          << " " << p.second.numberOfMeasurements;
+      if (serialCost>0.0 && cost>0.0) {
+        out << " " << serialCost/cost;
+      }
+      else {
+        out << " -";
+      }
+      out << " " << (cost==bestCost ? "*" : "-")
+          << std::endl;
+    }
+  }
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::plotStatistics(std::ostream& out, int oracleNumber) const {
+  tarch::multicore::Lock lock(_sweep->semaphore);
+
+  out << "# " << std::endl;
+  out << "# -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------" << std::endl;
+  out << "# dump results from grain size sweep " << toString() << std::endl;
+  out << "# dump below presents data in format compatible with learning grain size oracle" << std::endl;
+  out << "# format: method=bucket,has-converged,best-grain-size,reference-cost,grain-size:cost:measurements,..." << std::endl;
+  out << "# -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------" << std::endl;
+
+  out << "begin OracleForOnePhaseWithLearningGrainSize" << std::endl;
+  out << "adapter-number=" << oracleNumber << std::endl;
+
+  for (auto& key: _sweep->measurements) {
+    const int bucket = key.first.second;
+
+    std::ostringstream candidates;
+    int                bestGrainSize = -1;
+    double             bestCost      = 0.0;
+    for (auto& p: key.second) {
+      // same candidates as OracleForOnePhaseWithLearningGrainSize::createRecord()
+      if ( p.first==0 || 2*p.first<=(1<<bucket) ) {
+        const double cost = p.second.accumulatedCost / p.second.numberOfMeasurements;
+        if (bestGrainSize<0 || cost<bestCost) {
+          bestGrainSize = p.first;
+          bestCost      = cost;
+        }
+        candidates << "," << p.first << ":" << cost << ":" << p.second.numberOfMeasurements;
+      }
+    }
+
+    if (bestGrainSize>=0) {
+      out << peano::datatraversal::autotuning::toString(key.first.first)
+          << "=" << bucket
+          << ",1"
+          << "," << bestGrainSize
+          << "," << bestCost
+          << candidates.str()
+          << std::endl;
+    }
+  }
+
+  out << "end OracleForOnePhaseWithLearningGrainSize" << std::endl;
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::loadStatistics(const std::string& filename, int oracleNumber) {
+  logWarning( "loadStatistics(string,int)", "grain size sweep does not load any statistics, i.e. ignore file " << filename );
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::deactivateOracle() {
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::activateOracle() {
+}
+
+
+peano::datatraversal::autotuning::OracleForOnePhase* peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::createNewOracle() const {
+  return new OracleForOnePhaseWithGrainSizeSweep(_sweep);
+}
+
+
+std::string peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep::toString() const {
+  std::ostringstream msg;
+  msg << "(swept-method=";
+  if (_sweep->sweptMethod==MethodTrace::NumberOfDifferentMethodsCalling) {
+    msg << "none";
+  }
+  else {
+    msg << peano::datatraversal::autotuning::toString(_sweep->sweptMethod);
+  }
+  msg << ",grain-size=" << _sweep->grainSize
+      << ",number-of-asking-methods=" << _sweep->biggestProblemSize.size()
+      << ",number-of-buckets=" << _sweep->measurements.size()
+      << ")";
+  return msg.str();
+}
@@ -0,0 +1,165 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_DATA_TRAVERSAL_AUTOTUNING_ORACLE_FOR_ONE_PHASE_WITH_GRAIN_SIZE_SWEEP_H_
+#define _PEANO_DATA_TRAVERSAL_AUTOTUNING_ORACLE_FOR_ONE_PHASE_WITH_GRAIN_SIZE_SWEEP_H_
+
+
+#include "tarch/logging/Log.h"
+#include "tarch/multicore/BooleanSemaphore.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhase.h"
+
+
+#include <map>
+#include <memory>
+#include <vector>
+
+
+namespace peano {
+  namespace datatraversal {
+    namespace autotuning {
+      class OracleForOnePhaseWithGrainSizeSweep;
+    }
+  }
+}
+
+
+/**
+ * Oracle for offline grain size sweeps
+ *
+ * This oracle is not meant for production runs. It is used by benchmark
+ * drivers (see peano::grid::benchmarks::GrainSizeSweep) that run one and the
+ * same grid over and over again and try out one grain size after the other.
+ * The oracle knows two modes:
+ *
+ * - Discovery: All methods run serially. The oracle bookkeeps which methods
+ *   ask for a grain size at all and which problem sizes they come along with.
+ * - Sweep: One method is handed out a fixed grain size (or 0 if the problem
+ *   is not bigger than the grain size). All the other methods run serially,
+ *   so they do not interfere with the measurement. The time per problem
+ *   element is recorded per problem size bucket and grain size.
+ *
+ * Pipelining is switched on and off through the grain sizes of
+ * PipelineAscendTask and PipelineDescendTask, i.e. it is swept as well.
+ *
+ * <h2> Output </h2>
+ *
+ * plotTable() writes all measurements as plain table. plotStatistics() writes
+ * the fastest grain size per method and bucket in the format of
+ * OracleForOnePhaseWithLearningGrainSize. If you use the learning oracle in
+ * your application, you can thus load the sweep's result through
+ * Oracle::loadStatistics() and start right in the exploitation phase.
+ *
+ * <h2> Clones </h2>
+ *
+ * All clones created through createNewOracle() share one set of sweep
+ * settings and measurements, i.e. it does not matter which adapter the
+ * benchmark runs and you can steer all oracles through the prototype. The
+ * oracle is thread-safe.
+ */
+class peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep: public peano::datatraversal::autotuning::OracleForOnePhase {
+  private:
+    static tarch::logging::Log                 _log;
+
+    struct Measurement {
+      double  accumulatedCost;
+      int     numberOfMeasurements;
+    };
+
+    /**
+     * Method trace and problem size bucket. The buckets are the ones of the
+     * learning oracle, i.e. bucket b holds problem sizes from [2^b,2^{b+1}).
+     */
+    typedef std::pair<MethodTrace,int>  Key;
+
+    struct Sweep {
+      tarch::multicore::BooleanSemaphore        semaphore;
+      MethodTrace                               sweptMethod;
+      int                                       grainSize;
+      std::map<MethodTrace,int>                 biggestProblemSize;
+      std::map< Key, std::map<int,Measurement> > measurements;
+    };
+
+    std::shared_ptr<Sweep>                     _sweep;
+
+    static int getBucket(int problemSize);
+
+    OracleForOnePhaseWithGrainSizeSweep(std::shared_ptr<Sweep> sweep);
+  public:
+    /**
+     * Creates an oracle in discovery mode.
+     */
+    OracleForOnePhaseWithGrainSizeSweep();
+
+    virtual ~OracleForOnePhaseWithGrainSizeSweep();
+
+    /**
+     * Run everything serially and bookkeep which methods ask for grain sizes.
+     */
+    void switchToDiscovery();
+
+    /**
+     * Hand out grainSize to method and measure its runtime. All other
+     * methods run serially.
+     */
+    void switchToSweep(MethodTrace method, int grainSize);
+
+    /**
+     * All methods that have asked for a grain size so far.
+     */
+    std::vector<MethodTrace> getAskingMethods() const;
+
+    /**
+     * Biggest problem size a method has asked for so far. 0 if the method
+     * never asked.
+     */
+    int getBiggestProblemSize(MethodTrace method) const;
+
+    /**
+     * Average cost per problem element. Negative if there is no measurement.
+     */
+    double getCost(MethodTrace method, int bucket, int grainSize) const;
+
+    /**
+     * Fastest grain size for a method and bucket. 0 (serial) if there is no
+     * measurement.
+     */
+    int getBestGrainSize(MethodTrace method, int bucket) const;
+
+    /**
+     * Write one line per method, bucket and grain size. The columns are
+     * method trace, bucket, grain size, cost per problem element, number of
+     * measurements, speedup relative to the serial run of the same bucket
+     * and a marker for the fastest grain size.
+     */
+    void plotTable(std::ostream& out) const;
+
+    GrainSize parallelise(int problemSize, MethodTrace askingMethod) override;
+    void parallelSectionHasTerminated(int problemSize, int grainSize, MethodTrace askingMethod, double costPerProblemElement) override;
+
+    /**
+     * Writes the fastest grain sizes in the format of
+     * OracleForOnePhaseWithLearningGrainSize. Per bucket, we write only those
+     * grain sizes that the learning oracle would consider as well.
+     */
+    void plotStatistics(std::ostream& out, int oracleNumber) const override;
+
+    /**
+     * Sweeps always start from scratch, so this operation only writes a
+     * warning.
+     */
+    void loadStatistics(const std::string& filename, int oracleNumber) override;
+
+    void deactivateOracle() override;
+    void activateOracle() override;
+
+    /**
+     * The clone shares the sweep settings and the measurements with this
+     * oracle.
+     */
+    OracleForOnePhase* createNewOracle() const override;
+
+    std::string toString() const;
+};
+
+
+#endif
@@ -0,0 +1,359 @@
+#include "peano/datatraversal/autotuning/OracleForOnePhaseWithLearningGrainSize.h"
+#include "peano/datatraversal/autotuning/MethodTrace.h"
+#include "peano/datatraversal/autotuning/TuningDatabase.h"
+#include "tarch/multicore/Lock.h"
+#include "tarch/Assertions.h"
+
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+
+tarch::logging::Log  peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::_log( "peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize" );
+
+
+const double peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::MovingAverageWeight = 0.1;
+
+
+peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::OracleForOnePhaseWithLearningGrainSize(
+  int     measurementsPerCandidate,
+  double  regressionTolerance,
+  int     probeInterval
+):
+  _measurementsPerCandidate(measurementsPerCandidate),
+  _regressionTolerance(regressionTolerance),
+  _probeInterval(probeInterval),
+  _records(),
+  _semaphore() {
+  assertion1( measurementsPerCandidate>=1, measurementsPerCandidate );
+  assertion1( regressionTolerance>0.0, regressionTolerance );
+  assertion1( probeInterval>=2, probeInterval );
+}
+
+
+peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::~OracleForOnePhaseWithLearningGrainSize() {
+}
+
+
+int peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::getBucket(int problemSize) {
+  assertion1( problemSize>0, problemSize );
+  int result = 0;
+  while (problemSize>1) {
+    problemSize /= 2;
+    result++;
+  }
+  return result;
+}
+
+
+peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::Record peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::createRecord(int bucket) {
+  Record result;
+  result.hasConverged          = false;
+  result.bestCandidate         = 0;
+  result.referenceCost         = 0.0;
+  result.numberOfExploitations = 0;
+
+  result.candidates.push_back( Candidate{0,0.0,0} );
+  for (int grainSize=1; 2*grainSize<=(1<<bucket); grainSize*=2) {
+    result.candidates.push_back( Candidate{grainSize,0.0,0} );
+  }
+  return result;
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::converge(Record& record) {
+  record.bestCandidate = 0;
+  for (int i=1; i<static_cast<int>(record.candidates.size()); i++) {
+    if ( record.candidates[i].averageCost < record.candidates[record.bestCandidate].averageCost ) {
+      record.bestCandidate = i;
+    }
+  }
+  record.hasConverged          = true;
+  record.referenceCost         = record.candidates[record.bestCandidate].averageCost;
+  record.numberOfExploitations = 0;
+}
+
+
+peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::Record& peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::getRecord(int problemSize, MethodTrace askingMethod) {
+  const int bucket = getBucket(problemSize);
+  const Key key(askingMethod,bucket);
+  if ( _records.count(key)==0 ) {
+    _records.insert( std::pair<Key,Record>(key, createRecord(bucket)) );
+  }
+  return _records[key];
+}
+
+
+peano::datatraversal::autotuning::GrainSize peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::parallelise(int problemSize, MethodTrace askingMethod) {
+  assertion2( problemSize>0, problemSize, peano::datatraversal::autotuning::toString(askingMethod) );
+
+  tarch::multicore::Lock lock(_semaphore);
+  Record& record = getRecord(problemSize,askingMethod);
+
+  const bool useTimer = record.candidates.size()>1;
+  int        grainSize = 0;
+  if (!useTimer) {
+    grainSize = 0;
+  }
+  else if (!record.hasConverged) {
+    // round-robin, i.e. take the candidate with the fewest measurements
+    int candidate = 0;
+    for (int i=1; i<static_cast<int>(record.candidates.size()); i++) {
+      if ( record.candidates[i].numberOfMeasurements < record.candidates[candidate].numberOfMeasurements ) {
+        candidate = i;
+      }
+    }
+    grainSize = record.candidates[candidate].grainSize;
+  }
+  else {
+    record.numberOfExploitations++;
+    int candidate = record.bestCandidate;
+    if (record.numberOfExploitations % _probeInterval == 0) {
+      candidate += (record.numberOfExploitations / _probeInterval) % 2 == 0 ? 1 : -1;
+      candidate  = std::max( 0, std::min( static_cast<int>(record.candidates.size())-1, candidate ) );
+    }
+    grainSize = record.candidates[candidate].grainSize;
+  }
+  lock.free();
+
+  return GrainSize(grainSize, useTimer, problemSize, askingMethod, this);
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::parallelSectionHasTerminated(int problemSize, int grainSize, MethodTrace askingMethod, double costPerProblemElement) {
+  tarch::multicore::Lock lock(_semaphore);
+  Record& record = getRecord(problemSize,askingMethod);
+
+  int candidate = 0;
+  while ( candidate<static_cast<int>(record.candidates.size()) && record.candidates[candidate].grainSize!=grainSize ) {
+    candidate++;
+  }
+  if ( candidate==static_cast<int>(record.candidates.size()) ) {
+    // grain size has not been handed out by this oracle, i.e. it stems from a
+    // record that has been reset or loaded meanwhile
+    return;
+  }
+
+  Candidate& measured = record.candidates[candidate];
+  if (!record.hasConverged) {
+    measured.averageCost = ( measured.averageCost * measured.numberOfMeasurements + costPerProblemElement ) / (measured.numberOfMeasurements+1);
+    measured.numberOfMeasurements++;
+
+    bool allCandidatesMeasured = true;
+    for (auto& p: record.candidates) {
+      allCandidatesMeasured &= p.numberOfMeasurements >= _measurementsPerCandidate;
+    }
+    if (allCandidatesMeasured) {
+      converge(record);
+      logDebug(
+        "parallelSectionHasTerminated(...)",
+        "converged for " << peano::datatraversal::autotuning::toString(askingMethod) << " and problem size " << problemSize << ": " << record.toString()
+      );
+    }
+  }
+  else {
+    measured.averageCost = (1.0-MovingAverageWeight) * measured.averageCost + MovingAverageWeight * costPerProblemElement;
+    measured.numberOfMeasurements++;
+
+    if ( candidate==record.bestCandidate && measured.averageCost > record.referenceCost * (1.0+_regressionTolerance) ) {
+      logInfo(
+        "parallelSectionHasTerminated(...)",
+        "cost of grain size " << grainSize << " for " << peano::datatraversal::autotuning::toString(askingMethod)
+        << " has increased from " << record.referenceCost << " to " << measured.averageCost << ", re-explore grain sizes"
+      );
+      for (auto& p: record.candidates) {
+        p.averageCost          = 0.0;
+        p.numberOfMeasurements = 0;
+      }
+      record.hasConverged = false;
+    }
+    else if ( candidate!=record.bestCandidate && measured.averageCost < record.candidates[record.bestCandidate].averageCost ) {
+      logDebug(
+        "parallelSectionHasTerminated(...)",
+        "switch from grain size " << record.candidates[record.bestCandidate].grainSize << " to " << grainSize
+        << " for " << peano::datatraversal::autotuning::toString(askingMethod) << " and problem size " << problemSize
+      );
+      record.bestCandidate = candidate;
+      record.referenceCost = measured.averageCost;
+    }
+  }
+}
+
+
+std::string peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::Record::toString() const {
+  std::ostringstream msg;
+  msg << hasConverged
+      << "," << candidates[bestCandidate].grainSize
+      << "," << referenceCost;
+  for (auto& p: candidates) {
+    msg << "," << p.grainSize << ":" << p.averageCost << ":" << p.numberOfMeasurements;
+  }
+  return msg.str();
+}
+
+
+bool peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::Record::fromString(const std::string& value, int bucket, Record& record) {
+  std::string values = value;
+  for (auto& c: values) {
+    if (c==',' || c==':') c = ' ';
+  }
+  std::istringstream in(values);
+
+  bool   converged     = false;
+  int    bestGrainSize = -1;
+  if ( !(in >> converged >> bestGrainSize >> record.referenceCost) ) {
+    return false;
+  }
+
+  record.candidates.clear();
+  Candidate candidate;
+  while ( in >> candidate.grainSize >> candidate.averageCost >> candidate.numberOfMeasurements ) {
+    record.candidates.push_back(candidate);
+  }
+
+  record.hasConverged          = converged;
+  record.bestCandidate         = -1;
+  record.numberOfExploitations = 0;
+  for (int i=0; i<static_cast<int>(record.candidates.size()); i++) {
+    if (record.candidates[i].grainSize==bestGrainSize) record.bestCandidate = i;
+  }
+
+  return bucket>=0
+      && !record.candidates.empty()
+      && record.bestCandidate>=0
+      && (bucket==0 || record.candidates.back().grainSize<(1<<bucket));
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::storeInDatabase(TuningDatabase& database, int oracleNumber) const {
+  tarch::multicore::Lock lock( const_cast<tarch::multicore::BooleanSemaphore&>(_semaphore) );
+  for (auto& p: _records) {
+    database.setEntry( oracleNumber, p.first.first, p.first.second, p.second.toString() );
+  }
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::loadFromDatabase(const TuningDatabase& database, int oracleNumber) {
+  tarch::multicore::Lock lock(_semaphore);
+  int numberOfRecords = 0;
+  for (auto& p: database.getEntries(oracleNumber)) {
+    Record record;
+    if ( Record::fromString(p.second, p.first.second, record) ) {
+      _records[ Key(p.first.first,p.first.second) ] = record;
+      numberOfRecords++;
+    }
+    else {
+      logWarning( "loadFromDatabase(...)", "skip malformed entry " << p.second << " for " << peano::datatraversal::autotuning::toString(p.first.first) );
+    }
+  }
+  logDebug( "loadFromDatabase(...)", "took over " << numberOfRecords << " record(s) for oracle " << oracleNumber );
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::plotStatistics(std::ostream& out, int oracleNumber) const {
+  tarch::multicore::Lock lock( const_cast<tarch::multicore::BooleanSemaphore&>(_semaphore) );
+
+  out << "# " << std::endl;
+  out << "# -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------" << std::endl;
+  out << "# dump results from learning oracle " << toString() << std::endl;
+  out << "# format: method=bucket,has-converged,best-grain-size,reference-cost,grain-size:cost:measurements,..." << std::endl;
+  out << "# -------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------" << std::endl;
+
+  out << "begin OracleForOnePhaseWithLearningGrainSize" << std::endl;
+  out << "adapter-number=" << oracleNumber << std::endl;
+
+  for (auto& p: _records) {
+    out << peano::datatraversal::autotuning::toString(p.first.first)
+        << "=" << p.first.second
+        << "," << p.second.toString()
+        << std::endl;
+  }
+
+  out << "end OracleForOnePhaseWithLearningGrainSize" << std::endl;
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::loadStatistics(const std::string& filename, int oracleNumber) {
+  std::ifstream file(filename.c_str());
+  if (!file.is_open()) {
+    logWarning( "loadStatistics(string,int)", "could not open file " << filename << ", start to learn from scratch" );
+    return;
+  }
+
+  tarch::multicore::Lock lock(_semaphore);
+
+  bool        withinBlock         = false;
+  bool        withinMatchingBlock = false;
+  int         numberOfRecords     = 0;
+  std::string line;
+  while ( std::getline(file,line) ) {
+    if (line=="begin OracleForOnePhaseWithLearningGrainSize") {
+      withinBlock = true;
+    }
+    else if (line=="end OracleForOnePhaseWithLearningGrainSize") {
+      withinBlock         = false;
+      withinMatchingBlock = false;
+    }
+    else if (withinBlock && line.find("adapter-number=")==0) {
+      try {
+        withinMatchingBlock = std::stoi( line.substr( std::string("adapter-number=").size() ) )==oracleNumber;
+      }
+      catch (std::exception& e) {
+        logError( "loadStatistics(string,int)", "malformed adapter number in line " << line << " of file " << filename << " (" << e.what() << "), skip block" );
+        withinMatchingBlock = false;
+      }
+    }
+    else if (withinMatchingBlock && line.find("=")!=std::string::npos) {
+      const std::string methodTrace = line.substr( 0, line.find("=") );
+      const std::string values      = line.substr( line.find("=")+1 );
+      const std::string bucket      = values.substr( 0, values.find(",") );
+
+      Record record;
+      if (
+        values.find(",")==std::string::npos
+        ||
+        toMethodTrace(methodTrace)==MethodTrace::NumberOfDifferentMethodsCalling
+        ||
+        !Record::fromString( values.substr( values.find(",")+1 ), std::atoi(bucket.c_str()), record )
+      ) {
+        logWarning( "loadStatistics(string,int)", "skip malformed line " << line << " in file " << filename );
+      }
+      else {
+        _records[ Key(toMethodTrace(methodTrace),std::atoi(bucket.c_str())) ] = record;
+        numberOfRecords++;
+      }
+    }
+  }
+
+  logInfo( "loadStatistics(string,int)", "read " << numberOfRecords << " record(s) for oracle " << oracleNumber << " from " << filename );
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::deactivateOracle() {
+}
+
+
+void peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::activateOracle() {
+}
+
+
+peano::datatraversal::autotuning::OracleForOnePhase* peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::createNewOracle() const {
+  return new OracleForOnePhaseWithLearningGrainSize(
+    _measurementsPerCandidate,
+    _regressionTolerance,
+    _probeInterval
+  );
+}
+
+
+std::string peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize::toString() const {
+  std::ostringstream msg;
+  msg << "(measurements-per-candidate=" << _measurementsPerCandidate
+      << ",regression-tolerance=" << _regressionTolerance
+      << ",probe-interval=" << _probeInterval
+      << ",number-of-records=" << _records.size()
+      << ")";
+  return msg.str();
+}
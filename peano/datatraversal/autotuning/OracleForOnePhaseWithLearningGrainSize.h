@@ -0,0 +1,179 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_DATA_TRAVERSAL_AUTOTUNING_ORACLE_FOR_ONE_PHASE_WITH_LEARNING_GRAIN_SIZE_H_
+#define _PEANO_DATA_TRAVERSAL_AUTOTUNING_ORACLE_FOR_ONE_PHASE_WITH_LEARNING_GRAIN_SIZE_H_
+
+
+#include "tarch/logging/Log.h"
+#include "tarch/multicore/BooleanSemaphore.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhase.h"
+
+
+#include <map>
+#include <vector>
+
+
+namespace peano {
+  namespace datatraversal {
+    namespace autotuning {
+      class OracleForOnePhaseWithLearningGrainSize;
+    }
+  }
+}
+
+
+/**
+ * Oracle that learns the grain sizes online
+ *
+ * The dummy oracle returns grain sizes derived from fixed thresholds which
+ * have to be retuned for every machine. This oracle instead measures. It
+ * keeps one record per method trace and problem size bucket. Bucket b holds
+ * all problem sizes from [2^b,2^{b+1}). Per bucket, the candidate grain sizes
+ * are 0 (serial) and 1,2,4,...,2^{b-1}.
+ *
+ * <h2> Learning </h2>
+ *
+ * - Exploration: We hand out the candidates round-robin until each candidate
+ *   has been measured a couple of times (measurementsPerCandidate). The
+ *   measurement is the time per problem element that the GrainSize object
+ *   reports through parallelSectionHasTerminated().
+ * - Exploitation: Once all candidates have been measured, we take the one with
+ *   the smallest average cost. Its cost at this point is our reference.
+ * - Probing: Every probeInterval-th call, we hand out a neighbour of the best
+ *   grain size (alternating the next smaller and the next bigger one). If the
+ *   neighbour turns out to be faster, it becomes the new best grain size. So
+ *   the oracle can follow slow drifts.
+ * - Regression: We track the cost of the best grain size as exponential
+ *   moving average. If it exceeds the reference by more than the
+ *   regressionTolerance, the machine's behaviour has changed (other load,
+ *   different data) and we start to explore all over again.
+ *
+ * <h2> Persistence </h2>
+ *
+ * plotStatistics() writes all records. loadStatistics() reads them back, and
+ * loaded records start in the exploitation phase. So you can reuse what a
+ * previous run has learned. Records that are not in the file are explored
+ * as usual. For production runs, use the tuning database instead (see
+ * Oracle::loadTuningDatabase()), as it keeps data from different machines
+ * and thread counts apart.
+ *
+ * The oracle is thread-safe, i.e. several threads may ask and report at the
+ * same time.
+ */
+class peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize: public peano::datatraversal::autotuning::OracleForOnePhase {
+  private:
+    static tarch::logging::Log                 _log;
+
+    /**
+     * Weight of a new measurement within the exponential moving average we
+     * use once a record has converged.
+     */
+    static const double                        MovingAverageWeight;
+
+    struct Candidate {
+      int     grainSize;
+      double  averageCost;
+      int     numberOfMeasurements;
+    };
+
+    struct Record {
+      std::vector<Candidate>  candidates;
+      bool                    hasConverged;
+      int                     bestCandidate;
+      double                  referenceCost;
+      int                     numberOfExploitations;
+
+      std::string toString() const;
+
+      /**
+       * Inverse of toString(). Returns false if the string is malformed or
+       * does not fit to the bucket.
+       */
+      static bool fromString(const std::string& value, int bucket, Record& record);
+    };
+
+    typedef std::pair<MethodTrace,int>  Key;
+
+    const int                                  _measurementsPerCandidate;
+    const double                               _regressionTolerance;
+    const int                                  _probeInterval;
+
+    std::map<Key,Record>                       _records;
+    tarch::multicore::BooleanSemaphore         _semaphore;
+
+    static int getBucket(int problemSize);
+
+    static Record createRecord(int bucket);
+
+    /**
+     * Switch record into exploitation phase, i.e. pick best candidate.
+     */
+    static void converge(Record& record);
+
+    Record& getRecord(int problemSize, MethodTrace askingMethod);
+  public:
+    /**
+     * @param measurementsPerCandidate Number of measurements per candidate
+     *                                 grain size before we decide.
+     * @param regressionTolerance      Relative increase of the best grain
+     *                                 size's cost that makes us re-explore.
+     * @param probeInterval            Every probeInterval-th decision on a
+     *                                 converged record tries a neighbouring
+     *                                 grain size.
+     */
+    OracleForOnePhaseWithLearningGrainSize(
+      int     measurementsPerCandidate = 4,
+      double  regressionTolerance      = 0.2,
+      int     probeInterval            = 64
+    );
+
+    virtual ~OracleForOnePhaseWithLearningGrainSize();
+
+    GrainSize parallelise(int problemSize, MethodTrace askingMethod) override;
+    void parallelSectionHasTerminated(int problemSize, int grainSize, MethodTrace askingMethod, double costPerProblemElement) override;
+
+    /**
+     * Dumps one line per record. The format is
+     *
+     * <pre>
+method=bucket,has-converged,best-grain-size,reference-cost,grain-size:cost:measurements,...
+       </pre>
+     *
+     * enclosed by a begin/end pair that identifies the oracle number.
+     */
+    void plotStatistics(std::ostream& out, int oracleNumber) const override;
+
+    /**
+     * Reads the block belonging to oracleNumber from a file written by
+     * plotStatistics(). Malformed lines are skipped with a warning.
+     */
+    void loadStatistics(const std::string& filename, int oracleNumber) override;
+
+    /**
+     * Each record becomes one database entry. The payload is the same string
+     * we use in plotStatistics().
+     */
+    void storeInDatabase(TuningDatabase& database, int oracleNumber) const override;
+
+    /**
+     * Loaded records overwrite the ones we have already learned. As with
+     * loadStatistics(), converged records are used straightaway, and the
+     * regression detection makes the oracle re-explore if the entries stem
+     * from a configuration that behaves differently.
+     */
+    void loadFromDatabase(const TuningDatabase& database, int oracleNumber) override;
+
+    void deactivateOracle() override;
+    void activateOracle() override;
+
+    /**
+     * The new oracle has the same parameters but has not learned anything
+     * yet.
+     */
+    OracleForOnePhase* createNewOracle() const override;
+
+    std::string toString() const;
+};
+
+
+#endif
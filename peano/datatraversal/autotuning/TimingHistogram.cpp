@@ -0,0 +1,126 @@
+#include "peano/datatraversal/autotuning/TimingHistogram.h"
+#include "tarch/Assertions.h"
+
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+
+peano::datatraversal::autotuning::TimingHistogram::TimingHistogram() {
+  clear();
+}
+
+
+void peano::datatraversal::autotuning::TimingHistogram::clear() {
+  _numberOfSerialSamples   = 0;
+  _numberOfParallelSamples = 0;
+  _serialTime              = 0.0;
+  _parallelTime            = 0.0;
+  _minTime                 = 0.0;
+  _maxTime                 = 0.0;
+  std::fill( _buckets, _buckets+NumberOfBuckets, 0 );
+}
+
+
+int peano::datatraversal::autotuning::TimingHistogram::getBucket(double time) {
+  const double nanoseconds = time * 1.0e9;
+  if (nanoseconds<2.0) {
+    return 0;
+  }
+  const int result = static_cast<int>( std::floor( std::log2(nanoseconds) ) );
+  return std::min( result, NumberOfBuckets-1 );
+}
+
+
+void peano::datatraversal::autotuning::TimingHistogram::addSample(double time, bool parallel) {
+  assertion1( time>=0.0, time );
+
+  if (getNumberOfSamples()==0) {
+    _minTime = time;
+    _maxTime = time;
+  }
+  else {
+    _minTime = std::min(_minTime,time);
+    _maxTime = std::max(_maxTime,time);
+  }
+
+  if (parallel) {
+    _numberOfParallelSamples++;
+    _parallelTime += time;
+  }
+  else {
+    _numberOfSerialSamples++;
+    _serialTime += time;
+  }
+
+  _buckets[ getBucket(time) ]++;
+}
+
+
+int peano::datatraversal::autotuning::TimingHistogram::getNumberOfSamples() const {
+  return _numberOfSerialSamples + _numberOfParallelSamples;
+}
+
+
+int peano::datatraversal::autotuning::TimingHistogram::getNumberOfSerialSamples() const {
+  return _numberOfSerialSamples;
+}
+
+
+int peano::datatraversal::autotuning::TimingHistogram::getNumberOfParallelSamples() const {
+  return _numberOfParallelSamples;
+}
+
+
+double peano::datatraversal::autotuning::TimingHistogram::getSerialTime() const {
+  return _serialTime;
+}
+
+
+double peano::datatraversal::autotuning::TimingHistogram::getParallelTime() const {
+  return _parallelTime;
+}
+
+
+double peano::datatraversal::autotuning::TimingHistogram::getMeanTime() const {
+  return getNumberOfSamples()==0 ? 0.0 : (_serialTime+_parallelTime) / getNumberOfSamples();
+}
+
+
+double peano::datatraversal::autotuning::TimingHistogram::getPercentile(double percentile) const {
+  assertion1( percentile>0.0 && percentile<=1.0, percentile );
+
+  if (getNumberOfSamples()==0) {
+    return 0.0;
+  }
+
+  const int rank   = std::max( 1, static_cast<int>( std::ceil(percentile * getNumberOfSamples()) ) );
+  int       bucket = 0;
+  int       samplesUpToBucket = _buckets[0];
+  while (samplesUpToBucket<rank) {
+    bucket++;
+    assertion3( bucket<NumberOfBuckets, bucket, rank, getNumberOfSamples() );
+    samplesUpToBucket += _buckets[bucket];
+  }
+
+  const double upperBucketBound = std::ldexp(1.0,bucket+1) * 1.0e-9;
+  return std::max( _minTime, std::min( _maxTime, upperBucketBound ) );
+}
+
+
+std::string peano::datatraversal::autotuning::TimingHistogram::toString() const {
+  std::ostringstream msg;
+  msg << "count=" << getNumberOfSamples();
+  if (getNumberOfSamples()>0) {
+    msg << ",mean=" << getMeanTime()
+        << ",p50=" << getPercentile(0.50)
+        << ",p95=" << getPercentile(0.95)
+        << ",p99=" << getPercentile(0.99);
+  }
+  msg << ",serial-sections=" << _numberOfSerialSamples
+      << ",serial-time=" << _serialTime
+      << ",parallel-sections=" << _numberOfParallelSamples
+      << ",parallel-time=" << _parallelTime;
+  return msg.str();
+}
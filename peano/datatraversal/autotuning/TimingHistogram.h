@@ -0,0 +1,100 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_DATA_TRAVERSAL_AUTOTUNING_TIMING_HISTOGRAM_H_
+#define _PEANO_DATA_TRAVERSAL_AUTOTUNING_TIMING_HISTOGRAM_H_
+
+
+#include <string>
+
+
+namespace peano {
+  namespace datatraversal {
+    namespace autotuning {
+      class TimingHistogram;
+    }
+  }
+}
+
+
+/**
+ * Latency histogram of one method trace
+ *
+ * The oracle records one sample per GrainSize object, i.e. per section that
+ * has asked the oracle whether to run in parallel. A sample is the calendar
+ * time between the parallelise() call and the end of the section. The
+ * histogram distinguishes sections that ran serially (grain size 0) from
+ * those that ran in parallel.
+ *
+ * <h2> Buckets </h2>
+ *
+ * The bucket b holds all samples from @f$ [2^b, 2^{b+1}) @f$ nanoseconds.
+ * Samples below one nanosecond go into the first, samples beyond the last
+ * bucket into the last bucket. Percentiles thus are accurate up to a factor
+ * of two. We return the upper bound of the bucket that holds the requested
+ * percentile, clamped to the minimal and maximal sample. If all samples are
+ * the same, all percentiles hence are exact.
+ *
+ * The histogram is not thread-safe. See Oracle.
+ */
+class peano::datatraversal::autotuning::TimingHistogram {
+  public:
+    /**
+     * The last bucket starts at @f$ 2^{47} @f$ nanoseconds, i.e. at roughly
+     * 39 hours.
+     */
+    static constexpr int NumberOfBuckets = 48;
+  private:
+    int     _numberOfSerialSamples;
+    int     _numberOfParallelSamples;
+    double  _serialTime;
+    double  _parallelTime;
+    double  _minTime;
+    double  _maxTime;
+    int     _buckets[NumberOfBuckets];
+
+    static int getBucket(double time);
+  public:
+    TimingHistogram();
+
+    /**
+     * @param time     Calendar time in seconds.
+     * @param parallel Has the section run in parallel?
+     */
+    void addSample(double time, bool parallel);
+
+    void clear();
+
+    int     getNumberOfSamples() const;
+    int     getNumberOfSerialSamples() const;
+    int     getNumberOfParallelSamples() const;
+
+    /**
+     * Accumulated time of all serial sections.
+     */
+    double  getSerialTime() const;
+
+    /**
+     * Accumulated time of all parallel sections.
+     */
+    double  getParallelTime() const;
+
+    /**
+     * Is 0 if there are no samples.
+     */
+    double  getMeanTime() const;
+
+    /**
+     * @param percentile Value from (0,1], i.e. 0.5 is the median.
+     * @return Approximation of the percentile or 0 if there are no samples.
+     */
+    double  getPercentile(double percentile) const;
+
+    /**
+     * One line with count, mean, p50, p95, p99 and the serial and parallel
+     * times.
+     */
+    std::string toString() const;
+};
+
+
+#endif
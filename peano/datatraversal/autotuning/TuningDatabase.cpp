@@ -0,0 +1,326 @@
+#include "peano/datatraversal/autotuning/TuningDatabase.h"
+#include "peano/utils/Globals.h"
+#include "tarch/compiler/CompilerSpecificSettings.h"
+#include "tarch/multicore/MulticoreDefinitions.h"
+#include "tarch/Assertions.h"
+
+
+#ifdef SharedMemoryParallelisation
+#include "tarch/multicore/Core.h"
+#endif
+
+
+#ifdef CompilerHasUTSName
+#include <sys/utsname.h>
+#endif
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+
+tarch::logging::Log  peano::datatraversal::autotuning::TuningDatabase::_log( "peano::datatraversal::autotuning::TuningDatabase" );
+
+
+peano::datatraversal::autotuning::TuningDatabase::Configuration peano::datatraversal::autotuning::TuningDatabase::Configuration::getCurrentConfiguration() {
+  Configuration result;
+  result.cpuModel   = "unknown";
+  result.hostName   = "unknown";
+  result.dimensions = DIMENSIONS;
+
+  #ifdef SharedMemoryParallelisation
+  result.numberOfThreads = tarch::multicore::Core::getInstance().getNumberOfThreads();
+  #else
+  result.numberOfThreads = 1;
+  #endif
+
+  #ifdef CompilerHasUTSName
+  utsname utsdata;
+  if ( uname(&utsdata)==0 ) {
+    result.hostName = utsdata.nodename;
+    result.cpuModel = utsdata.machine;
+  }
+  #endif
+
+  // On Linux, we can do better than the architecture name
+  std::ifstream cpuInfo( "/proc/cpuinfo" );
+  std::string   line;
+  while ( cpuInfo.is_open() && std::getline(cpuInfo,line) ) {
+    if ( line.find("model name")==0 && line.find(":")!=std::string::npos ) {
+      result.cpuModel = line.substr( line.find(":")+1 );
+      result.cpuModel.erase( 0, result.cpuModel.find_first_not_of(" \t") );
+      break;
+    }
+  }
+
+  result.cpuModel = sanitise(result.cpuModel);
+  result.hostName = sanitise(result.hostName);
+
+  return result;
+}
+
+
+double peano::datatraversal::autotuning::TuningDatabase::Configuration::getDistance(const Configuration& other) const {
+  if (dimensions!=other.dimensions) {
+    return -1.0;
+  }
+
+  double result = 0.0;
+  if (cpuModel!=other.cpuModel) {
+    result += 4.0;
+  }
+  else if (hostName!=other.hostName) {
+    result += 1.0;
+  }
+
+  result += std::abs( std::log2( static_cast<double>(std::max(numberOfThreads,1)) / static_cast<double>(std::max(other.numberOfThreads,1)) ) );
+
+  return result;
+}
+
+
+bool peano::datatraversal::autotuning::TuningDatabase::Configuration::operator<(const Configuration& other) const {
+  return std::tie(cpuModel,hostName,numberOfThreads,dimensions) < std::tie(other.cpuModel,other.hostName,other.numberOfThreads,other.dimensions);
+}
+
+
+bool peano::datatraversal::autotuning::TuningDatabase::Configuration::operator==(const Configuration& other) const {
+  return std::tie(cpuModel,hostName,numberOfThreads,dimensions) == std::tie(other.cpuModel,other.hostName,other.numberOfThreads,other.dimensions);
+}
+
+
+std::string peano::datatraversal::autotuning::TuningDatabase::Configuration::toString() const {
+  std::ostringstream msg;
+  msg << "(cpu-model=" << cpuModel
+      << ",host-name=" << hostName
+      << ",threads=" << numberOfThreads
+      << ",dimensions=" << dimensions
+      << ")";
+  return msg.str();
+}
+
+
+peano::datatraversal::autotuning::TuningDatabase::TuningDatabase():
+  _configuration( Configuration::getCurrentConfiguration() ),
+  _database() {
+}
+
+
+peano::datatraversal::autotuning::TuningDatabase::TuningDatabase(const Configuration& configuration):
+  _configuration( configuration ),
+  _database() {
+}
+
+
+const peano::datatraversal::autotuning::TuningDatabase::Configuration& peano::datatraversal::autotuning::TuningDatabase::getConfiguration() const {
+  return _configuration;
+}
+
+
+std::string peano::datatraversal::autotuning::TuningDatabase::sanitise(const std::string& value) {
+  std::string result = value;
+  for (auto& c: result) {
+    if (c==';' || c=='\n' || c=='\r') c = ' ';
+  }
+  return result;
+}
+
+
+bool peano::datatraversal::autotuning::TuningDatabase::read(const std::string& filename) {
+  std::ifstream file(filename.c_str());
+  if (!file.is_open()) {
+    return false;
+  }
+
+  std::string line;
+  bool        versionIsValid   = false;
+  int         numberOfEntries  = 0;
+  while ( std::getline(file,line) ) {
+    if ( line.empty() || line[0]=='#' ) {
+      continue;
+    }
+    else if ( line.find("version=")==0 ) {
+      const int version = std::atoi( line.substr( std::string("version=").size() ).c_str() );
+      versionIsValid = version==Version;
+      if (!versionIsValid) {
+        logWarning( "read(string)", "database " << filename << " has version " << version << " while this code expects version " << Version << ". Ignore file" );
+        return false;
+      }
+    }
+    else if ( versionIsValid && line.find("entry=")==0 ) {
+      std::vector<std::string> fields;
+      std::istringstream       in( line.substr( std::string("entry=").size() ) );
+      std::string              field;
+      // the payload is the last field, so we split only seven times
+      while ( static_cast<int>(fields.size())<7 && std::getline(in,field,';') ) {
+        fields.push_back(field);
+      }
+      std::string payload;
+      std::getline(in,payload);
+
+      Configuration configuration;
+      if ( fields.size()==7 && !payload.empty() ) {
+        configuration.cpuModel        = fields[0];
+        configuration.hostName        = fields[1];
+        configuration.numberOfThreads = std::atoi(fields[2].c_str());
+        configuration.dimensions      = std::atoi(fields[3].c_str());
+        const int         oracleNumber = std::atoi(fields[4].c_str());
+        const MethodTrace method       = toMethodTrace(fields[5]);
+        const int         bucket       = std::atoi(fields[6].c_str());
+
+        if (method!=MethodTrace::NumberOfDifferentMethodsCalling) {
+          _database[configuration][ EntryKey(oracleNumber,method,bucket) ] = payload;
+          numberOfEntries++;
+          continue;
+        }
+      }
+      logWarning( "read(string)", "skip malformed line " << line << " in file " << filename );
+    }
+    else {
+      logWarning( "read(string)", "skip malformed line " << line << " in file " << filename );
+    }
+  }
+
+  logDebug( "read(string)", "read " << numberOfEntries << " entries from " << filename );
+  return versionIsValid;
+}
+
+
+bool peano::datatraversal::autotuning::TuningDatabase::write(const std::string& filename) const {
+  std::ofstream file(filename.c_str());
+  if (!file.is_open()) {
+    logError( "write(string)", "could not write tuning database " << filename );
+    return false;
+  }
+
+  file << "# Peano autotuning database" << std::endl
+       << "# entry=cpu-model;host-name;threads;dimensions;oracle;method-trace;bucket;payload" << std::endl
+       << "version=" << Version << std::endl;
+
+  for (auto& configuration: _database)
+  for (auto& entry: configuration.second) {
+    file << "entry="
+         << configuration.first.cpuModel        << ";"
+         << configuration.first.hostName        << ";"
+         << configuration.first.numberOfThreads << ";"
+         << configuration.first.dimensions      << ";"
+         << std::get<0>(entry.first)            << ";"
+         << peano::datatraversal::autotuning::toString(std::get<1>(entry.first)) << ";"
+         << std::get<2>(entry.first)            << ";"
+         << entry.second
+         << std::endl;
+  }
+
+  file.close();
+  return !file.fail();
+}
+
+
+bool peano::datatraversal::autotuning::TuningDatabase::load(const std::string& filename) {
+  const bool result = read(filename);
+  logInfo( "load(string)", "loaded tuning database " << filename << ": " << toString() );
+  return result;
+}
+
+
+bool peano::datatraversal::autotuning::TuningDatabase::store(const std::string& filename) const {
+  const std::string lockFilename      = filename + ".lock";
+  const std::string temporaryFilename = filename + ".tmp";
+
+  // Exclusive creation ("x") fails if the lock file exists already
+  const int MaxNumberOfLockAttempts = 500;
+  std::FILE* lockFile               = nullptr;
+  for (int i=0; i<MaxNumberOfLockAttempts && lockFile==nullptr; i++) {
+    lockFile = std::fopen( lockFilename.c_str(), "wx" );
+    if (lockFile==nullptr) {
+      std::this_thread::sleep_for( std::chrono::milliseconds(10) );
+    }
+  }
+  if (lockFile==nullptr) {
+    logError( "store(string)", "could not acquire lock " << lockFilename << ". Remove the file manually if no other run is active" );
+    return false;
+  }
+
+  TuningDatabase merged(_configuration);
+  merged.read(filename);
+  if ( _database.count(_configuration)>0 ) {
+    for (auto& entry: _database.at(_configuration)) {
+      merged._database[_configuration][entry.first] = entry.second;
+    }
+  }
+
+  bool result = merged.write(temporaryFilename);
+  if (result) {
+    result = std::rename( temporaryFilename.c_str(), filename.c_str() )==0;
+    if (!result) {
+      logError( "store(string)", "could not replace " << filename << " by " << temporaryFilename );
+    }
+  }
+
+  std::fclose(lockFile);
+  std::remove( lockFilename.c_str() );
+
+  logInfo( "store(string)", "merged tuning data into " << filename << ": " << merged.toString() );
+  return result;
+}
+
+
+void peano::datatraversal::autotuning::TuningDatabase::setEntry(int oracleNumber, MethodTrace method, int bucket, const std::string& payload) {
+  assertion( !payload.empty() );
+  assertion1( payload.find('\n')==std::string::npos, payload );
+  _database[_configuration][ EntryKey(oracleNumber,method,bucket) ] = payload;
+}
+
+
+std::map< std::pair<peano::datatraversal::autotuning::MethodTrace,int>, std::string > peano::datatraversal::autotuning::TuningDatabase::getEntries(int oracleNumber) const {
+  const Entries* closestEntries  = nullptr;
+  double         closestDistance = 0.0;
+  for (auto& configuration: _database) {
+    const double distance = _configuration.getDistance(configuration.first);
+    bool holdsOracle = false;
+    for (auto& entry: configuration.second) {
+      holdsOracle |= std::get<0>(entry.first)==oracleNumber;
+    }
+    if ( distance>=0.0 && holdsOracle && (closestEntries==nullptr || distance<closestDistance) ) {
+      closestEntries  = &configuration.second;
+      closestDistance = distance;
+    }
+  }
+
+  std::map< std::pair<MethodTrace,int>, std::string > result;
+  if (closestEntries!=nullptr) {
+    for (auto& entry: *closestEntries) {
+      if ( std::get<0>(entry.first)==oracleNumber ) {
+        result[ std::pair<MethodTrace,int>(std::get<1>(entry.first),std::get<2>(entry.first)) ] = entry.second;
+      }
+    }
+    logDebug( "getEntries(int)", "use " << result.size() << " entries with distance " << closestDistance << " for oracle " << oracleNumber );
+  }
+  return result;
+}
+
+
+int peano::datatraversal::autotuning::TuningDatabase::getNumberOfEntries() const {
+  int result = 0;
+  for (auto& configuration: _database) {
+    result += configuration.second.size();
+  }
+  return result;
+}
+
+
+std::string peano::datatraversal::autotuning::TuningDatabase::toString() const {
+  std::ostringstream msg;
+  msg << "(configuration=" << _configuration.toString()
+      << ",number-of-configurations=" << _database.size()
+      << ",number-of-entries=" << getNumberOfEntries()
+      << ")";
+  return msg.str();
+}
@@ -0,0 +1,170 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_DATA_TRAVERSAL_AUTOTUNING_TUNING_DATABASE_H_
+#define _PEANO_DATA_TRAVERSAL_AUTOTUNING_TUNING_DATABASE_H_
+
+
+#include "tarch/logging/Log.h"
+#include "peano/datatraversal/autotuning/MethodTrace.h"
+
+
+#include <map>
+#include <string>
+#include <tuple>
+
+
+namespace peano {
+  namespace datatraversal {
+    namespace autotuning {
+      class TuningDatabase;
+    }
+  }
+}
+
+
+/**
+ * Persistent database of autotuning results
+ *
+ * Oracle::plotStatistics() and Oracle::loadStatistics() write and read plain
+ * per-run files. They do not know on which machine or with which setup the
+ * data has been recorded. The tuning database is a file that accumulates the
+ * knowledge of many runs. Each entry is identified by
+ *
+ * - the configuration, i.e. the CPU model, the host name, the number of
+ *   threads and DIMENSIONS,
+ * - the oracle (adapter) number,
+ * - the method trace, and
+ * - the problem size bucket.
+ *
+ * The entry's payload is a string that only the oracle understands.
+ *
+ * <h2> Warm start </h2>
+ *
+ * A run reads the database and asks for the entries of the configuration
+ * closest to its own one (see Configuration::getDistance()). If there are
+ * entries for exactly this machine and thread count, it gets those. Otherwise,
+ * it falls back to the same CPU model on another host, or finally to another
+ * thread count. Entries with a different dimension are never used.
+ *
+ * <h2> Merge </h2>
+ *
+ * store() locks the database file, rereads it, replaces all entries of the
+ * current configuration that this database holds, writes the result into a
+ * temporary file and renames this file. Concurrent runs thus never see a
+ * half-written database and do not lose each other's entries. The lock is a
+ * file next to the database. If a run crashes while it holds the lock, you
+ * have to remove the lock file manually.
+ *
+ * store() tries to acquire the lock 500 times and waits 10 ms after each
+ * failed attempt. If it does not get the lock within these five seconds, it
+ * logs an error, does not write anything and returns false. With many ranks
+ * storing into the same file at the same time, some of them thus might lose
+ * their entries, as each rank holds the lock while it rereads and rewrites
+ * the whole file. For large runs, let only one rank per configuration (e.g.
+ * one rank per node) store, or give each rank a file of its own.
+ *
+ * <h2> File format </h2>
+ *
+ * <pre>
+# comment
+version=1
+entry=cpu-model;host-name;threads;dimensions;oracle;method-trace;bucket;payload
+   </pre>
+ *
+ * Files with a different version are ignored.
+ */
+class peano::datatraversal::autotuning::TuningDatabase {
+  public:
+    static constexpr int Version = 1;
+
+    struct Configuration {
+      std::string  cpuModel;
+      std::string  hostName;
+      int          numberOfThreads;
+      int          dimensions;
+
+      /**
+       * Configuration of the current process.
+       */
+      static Configuration getCurrentConfiguration();
+
+      /**
+       * Is -1 if the other configuration must not be used at all, i.e. if the
+       * dimensions differ. Otherwise, 0 is a perfect match. A different host
+       * with the same CPU model costs less than a different CPU model. A
+       * different thread count costs the more the bigger the ratio of the
+       * thread counts.
+       */
+      double getDistance(const Configuration& other) const;
+
+      bool operator<(const Configuration& other) const;
+      bool operator==(const Configuration& other) const;
+
+      std::string toString() const;
+    };
+
+    /**
+     * Oracle number, method trace and problem size bucket.
+     */
+    typedef std::tuple<int,MethodTrace,int>  EntryKey;
+    typedef std::map<EntryKey,std::string>   Entries;
+  private:
+    static tarch::logging::Log  _log;
+
+    typedef std::map<Configuration,Entries>  Database;
+
+    const Configuration  _configuration;
+    Database             _database;
+
+    /**
+     * Parse a file and add all of its entries to the database. Entries that
+     * exist already are overwritten.
+     */
+    bool read(const std::string& filename);
+    bool write(const std::string& filename) const;
+
+    static std::string sanitise(const std::string& value);
+  public:
+    /**
+     * Database for the current configuration.
+     */
+    TuningDatabase();
+
+    /**
+     * Database for a particular configuration. Primarily there for tests.
+     */
+    TuningDatabase(const Configuration& configuration);
+
+    const Configuration& getConfiguration() const;
+
+    /**
+     * Load a database file. It is not an error if the file does not exist
+     * yet. You can load several files.
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * Merge the entries of the current configuration into the database file.
+     * See class documentation.
+     */
+    bool store(const std::string& filename) const;
+
+    /**
+     * Set an entry of the current configuration.
+     */
+    void setEntry(int oracleNumber, MethodTrace method, int bucket, const std::string& payload);
+
+    /**
+     * Entries for one oracle from the closest configuration that has any
+     * entries for this oracle. The result maps (method trace,bucket) pairs
+     * onto payloads.
+     */
+    std::map< std::pair<MethodTrace,int>, std::string > getEntries(int oracleNumber) const;
+
+    int getNumberOfEntries() const;
+
+    std::string toString() const;
+};
+
+
+#endif
@@ -0,0 +1,197 @@
+#include "peano/datatraversal/autotuning/tests/OracleForOnePhaseWithGrainSizeSweepTest.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhaseWithGrainSizeSweep.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhaseWithLearningGrainSize.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhaseDummy.h"
+#include "peano/datatraversal/autotuning/Oracle.h"
+#include "peano/grid/benchmarks/GrainSizeSweep.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+#include "tarch/parallel/Node.h"
+registerTest(peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest)
+
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+namespace {
+  /**
+   * Ignores the real time measurements of the GrainSize objects. The test
+   * feeds synthetic costs through learn() instead.
+   */
+  class SweepWithSyntheticCosts: public peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep {
+    public:
+      void parallelSectionHasTerminated(int problemSize, int grainSize, peano::datatraversal::autotuning::MethodTrace askingMethod, double costPerProblemElement) override {
+      }
+
+      void learn(int problemSize, int grainSize, peano::datatraversal::autotuning::MethodTrace askingMethod, double costPerProblemElement) {
+        OracleForOnePhaseWithGrainSizeSweep::parallelSectionHasTerminated(problemSize,grainSize,askingMethod,costPerProblemElement);
+      }
+  };
+
+  /**
+   * Cost model with a unique minimum at optimalGrainSize. Serial runs (grain
+   * size 0) are the most expensive ones.
+   */
+  double getSyntheticCost(int grainSize, int optimalGrainSize) {
+    if (grainSize==0) return 100.0;
+    return 1.0 + std::abs( std::log2(static_cast<double>(grainSize)) - std::log2(static_cast<double>(optimalGrainSize)) );
+  }
+
+  /**
+   * Number of records within the learning oracle's blocks of a statistics
+   * file.
+   */
+  int countRecords(std::istream& in) {
+    int         result      = 0;
+    bool        withinBlock = false;
+    std::string line;
+    while ( std::getline(in,line) ) {
+      if (line=="begin OracleForOnePhaseWithLearningGrainSize") {
+        withinBlock = true;
+      }
+      else if (line=="end OracleForOnePhaseWithLearningGrainSize") {
+        withinBlock = false;
+      }
+      else if (withinBlock && line.find("adapter-number=")!=0 && line.find("=")!=std::string::npos) {
+        result++;
+      }
+    }
+    return result;
+  }
+}
+
+
+peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest::OracleForOnePhaseWithGrainSizeSweepTest():
+  TestCase( "peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest" ) {
+}
+
+
+peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest::~OracleForOnePhaseWithGrainSizeSweepTest() {
+}
+
+
+void peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest::run() {
+  testMethod( testSweepAndReload );
+  testMethod( testGrainSizeSweepDriver );
+}
+
+
+void peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest::setUp() {
+}
+
+
+std::string peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest::getFilename(const std::string& suffix) {
+  std::ostringstream filename;
+  filename << "rank-" << tarch::parallel::Node::getInstance().getRank() << "-OracleForOnePhaseWithGrainSizeSweepTest." << suffix;
+  return filename.str();
+}
+
+
+void peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest::testSweepAndReload() {
+  const std::string filename         = getFilename("statistics");
+  const int         ProblemSize      = 100;
+  const int         Bucket           = 6;
+  const int         OptimalGrainSize = 8;
+
+  SweepWithSyntheticCosts sweep;
+
+  sweep.switchToDiscovery();
+  {
+    GrainSize grainSize = sweep.parallelise(ProblemSize, MethodTrace::UserDefined0);
+    validateEquals( grainSize.getGrainSize(), 0 );
+  }
+  validateEquals( static_cast<int>(sweep.getAskingMethods().size()), 1 );
+  validateEquals( sweep.getBiggestProblemSize(MethodTrace::UserDefined0), ProblemSize );
+
+  int grainSize = 0;
+  while (grainSize==0 || grainSize<ProblemSize) {
+    sweep.switchToSweep(MethodTrace::UserDefined0,grainSize);
+    GrainSize answer = sweep.parallelise(ProblemSize, MethodTrace::UserDefined0);
+    validateEqualsWithParams1( answer.getGrainSize(), grainSize, sweep.toString() );
+    sweep.learn(ProblemSize, answer.getGrainSize(), MethodTrace::UserDefined0, getSyntheticCost(answer.getGrainSize(),OptimalGrainSize));
+    grainSize = grainSize==0 ? 1 : 2*grainSize;
+  }
+  sweep.switchToDiscovery();
+
+  validateEqualsWithParams1( sweep.getBestGrainSize(MethodTrace::UserDefined0,Bucket), OptimalGrainSize, sweep.toString() );
+
+  std::ofstream out( filename.c_str() );
+  sweep.plotStatistics(out,0);
+  sweep.plotStatistics(out,1);
+  out.close();
+
+  // a huge probe interval makes the learning oracle's answers deterministic
+  OracleForOnePhaseWithLearningGrainSize reloadedOracle(4,0.2,1000);
+  reloadedOracle.loadStatistics(filename,1);
+  {
+    GrainSize answer = reloadedOracle.parallelise(ProblemSize, MethodTrace::UserDefined0);
+    validateEqualsWithParams1( answer.getGrainSize(), OptimalGrainSize, reloadedOracle.toString() );
+  }
+
+  // Without a shared memory parallelisation, the oracle singleton neither
+  // holds any oracles nor forwards any question
+  #if defined(SharedMemoryParallelisation)
+  Oracle::getInstance().setNumberOfOracles(2);
+  Oracle::getInstance().setOracle( new OracleForOnePhaseWithLearningGrainSize(4,0.2,1000) );
+  Oracle::getInstance().switchToOracle(1);
+  Oracle::getInstance().loadStatistics(filename);
+  {
+    GrainSize answer = Oracle::getInstance().parallelise(ProblemSize, MethodTrace::UserDefined0);
+    validateEquals( answer.getGrainSize(), OptimalGrainSize );
+  }
+  Oracle::getInstance().switchToOracle(0);
+  Oracle::getInstance().setNumberOfOracles(1);
+  Oracle::getInstance().setOracle( new OracleForOnePhaseDummy() );
+  #endif
+
+  std::remove( filename.c_str() );
+}
+
+
+void peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest::testGrainSizeSweepDriver() {
+  #if !defined(Parallel)
+  const std::string tableFilename  = getFilename("table");
+  const std::string oracleFilename = getFilename("statistics");
+
+  peano::grid::benchmarks::GrainSizeSweep driver(2,false,0,1);
+  validate( driver.run(tableFilename,oracleFilename,1) );
+
+  // The driver takes over the oracle singleton
+  Oracle::getInstance().setOracle( new OracleForOnePhaseDummy() );
+
+  std::ifstream table( tableFilename.c_str() );
+  validate( table.is_open() );
+  table.close();
+
+  std::ifstream tunedOracle( oracleFilename.c_str() );
+  validate( tunedOracle.is_open() );
+  const int numberOfSweptRecords = countRecords(tunedOracle);
+  tunedOracle.close();
+  #if defined(SharedMemoryParallelisation)
+  validate( numberOfSweptRecords>0 );
+  #endif
+
+  OracleForOnePhaseWithLearningGrainSize reloadedOracle;
+  reloadedOracle.loadStatistics(oracleFilename,0);
+  std::stringstream reloadedRecords;
+  reloadedOracle.plotStatistics(reloadedRecords,0);
+  validateEqualsWithParams1( countRecords(reloadedRecords), numberOfSweptRecords, reloadedRecords.str() );
+
+  std::remove( tableFilename.c_str() );
+  std::remove( oracleFilename.c_str() );
+  #endif
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
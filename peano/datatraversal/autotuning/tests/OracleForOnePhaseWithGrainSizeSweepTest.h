@@ -0,0 +1,61 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_DATA_TRAVERSAL_AUTOTUNING_TESTS_ORACLE_FOR_ONE_PHASE_WITH_GRAIN_SIZE_SWEEP_TEST_H_
+#define _PEANO_DATA_TRAVERSAL_AUTOTUNING_TESTS_ORACLE_FOR_ONE_PHASE_WITH_GRAIN_SIZE_SWEEP_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+
+#include <string>
+
+
+namespace peano {
+  namespace datatraversal {
+    namespace autotuning {
+      namespace tests {
+        class OracleForOnePhaseWithGrainSizeSweepTest;
+      }
+    }
+  }
+}
+
+
+/**
+ * Checks that the output of a grain size sweep can be fed into the learning
+ * oracle. All tests write their files into the working directory and remove
+ * them afterwards.
+ */
+class peano::datatraversal::autotuning::tests::OracleForOnePhaseWithGrainSizeSweepTest: public tarch::tests::TestCase {
+  private:
+    /**
+     * All ranks of a parallel test run execute the tests at the same time,
+     * so each rank writes files of its own.
+     */
+    static std::string getFilename(const std::string& suffix);
+
+    /**
+     * Sweep one method with a synthetic cost model, write the sweep's
+     * statistics and load them through Oracle::loadStatistics() into the
+     * learning oracle. The learning oracle then has to hand out the sweep's
+     * fastest grain size right away.
+     */
+    void testSweepAndReload();
+
+    /**
+     * Run a tiny GrainSizeSweep on a regular grid and reload the tuned file.
+     * The learning oracle has to accept every record the sweep has written.
+     * Without a shared memory parallelisation, no method asks for grain
+     * sizes, i.e. the file holds no records. The driver is not available
+     * with MPI, so the test is nop then.
+     */
+    void testGrainSizeSweepDriver();
+  public:
+    OracleForOnePhaseWithGrainSizeSweepTest();
+    virtual ~OracleForOnePhaseWithGrainSizeSweepTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
@@ -0,0 +1,166 @@
+#include "peano/datatraversal/autotuning/tests/OracleForOnePhaseWithLearningGrainSizeTest.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhaseWithLearningGrainSize.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+#include "tarch/parallel/Node.h"
+registerTest(peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest)
+
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+namespace {
+  /**
+   * Ignores the real time measurements of the GrainSize objects. The test
+   * feeds synthetic costs through learn() instead. We also make the probe
+   * interval very big such that the oracle's answers are deterministic.
+   */
+  class OracleWithSyntheticCosts: public peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize {
+    public:
+      OracleWithSyntheticCosts():
+        OracleForOnePhaseWithLearningGrainSize(2,0.2,1000) {
+      }
+
+      void parallelSectionHasTerminated(int problemSize, int grainSize, peano::datatraversal::autotuning::MethodTrace askingMethod, double costPerProblemElement) override {
+      }
+
+      void learn(int problemSize, int grainSize, peano::datatraversal::autotuning::MethodTrace askingMethod, double costPerProblemElement) {
+        OracleForOnePhaseWithLearningGrainSize::parallelSectionHasTerminated(problemSize,grainSize,askingMethod,costPerProblemElement);
+      }
+  };
+
+  /**
+   * Cost model with a unique minimum at optimalGrainSize. Serial runs (grain
+   * size 0) are the most expensive ones.
+   */
+  double getSyntheticCost(int grainSize, int optimalGrainSize) {
+    if (grainSize==0) return 100.0;
+    return 1.0 + std::abs( std::log2(static_cast<double>(grainSize)) - std::log2(static_cast<double>(optimalGrainSize)) );
+  }
+
+  /**
+   * Ask the oracle a couple of times and return the grain size it hands out
+   * most recently.
+   */
+  int train(OracleWithSyntheticCosts& oracle, int problemSize, int optimalGrainSize, int iterations) {
+    int result = -1;
+    for (int i=0; i<iterations; i++) {
+      peano::datatraversal::autotuning::GrainSize grainSize = oracle.parallelise(problemSize, peano::datatraversal::autotuning::MethodTrace::UserDefined0);
+      result = grainSize.getGrainSize();
+      oracle.learn(problemSize, result, peano::datatraversal::autotuning::MethodTrace::UserDefined0, getSyntheticCost(result,optimalGrainSize));
+    }
+    return result;
+  }
+}
+
+
+peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest::OracleForOnePhaseWithLearningGrainSizeTest():
+  TestCase( "peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest" ) {
+}
+
+
+peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest::~OracleForOnePhaseWithLearningGrainSizeTest() {
+}
+
+
+void peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest::run() {
+  testMethod( testConvergence );
+  testMethod( testRegression );
+  testMethod( testPlotAndLoadStatistics );
+}
+
+
+void peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest::setUp() {
+}
+
+
+void peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest::testConvergence() {
+  OracleWithSyntheticCosts oracle;
+
+  // problem size 1000 yields the candidates 0,1,2,...,256, i.e. ten
+  // candidates with two measurements each
+  train(oracle,1000,16,20);
+
+  for (int i=0; i<7; i++) {
+    GrainSize grainSize = oracle.parallelise(1000, MethodTrace::UserDefined0);
+    validateEqualsWithParams1( grainSize.getGrainSize(), 16, oracle.toString() );
+  }
+
+  // problem size one cannot be parallelised at all
+  GrainSize grainSize = oracle.parallelise(1, MethodTrace::UserDefined0);
+  validateEquals( grainSize.getGrainSize(), 0 );
+}
+
+
+void peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest::testRegression() {
+  OracleWithSyntheticCosts oracle;
+
+  train(oracle,1000,16,20);
+
+  // machine changes: grain size 16 becomes expensive, 64 is the best choice
+  // now. The oracle has to realise that and re-explore.
+  const int grainSize = train(oracle,1000,64,200);
+  validateEquals( grainSize, 64 );
+}
+
+
+void peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest::testPlotAndLoadStatistics() {
+  // all ranks of a parallel test run execute this test at the same time
+  std::ostringstream filenameStream;
+  filenameStream << "rank-" << tarch::parallel::Node::getInstance().getRank() << "-OracleForOnePhaseWithLearningGrainSizeTest.statistics";
+  const std::string filename = filenameStream.str();
+
+  OracleWithSyntheticCosts oracle;
+  train(oracle,1000,4,20);
+  train(oracle,100,2,20);
+
+  std::ofstream out( filename.c_str() );
+  oracle.plotStatistics(out,3);
+  out.close();
+
+  OracleWithSyntheticCosts reloadedOracle;
+  reloadedOracle.loadStatistics(filename,2);
+  {
+    GrainSize grainSize = reloadedOracle.parallelise(1000, MethodTrace::UserDefined0);
+    validateEquals( grainSize.getGrainSize(), 0 );
+  }
+
+  reloadedOracle.loadStatistics(filename,3);
+  {
+    GrainSize grainSize = reloadedOracle.parallelise(1000, MethodTrace::UserDefined0);
+    validateEquals( grainSize.getGrainSize(), 4 );
+  }
+  {
+    GrainSize grainSize = reloadedOracle.parallelise(100, MethodTrace::UserDefined0);
+    validateEquals( grainSize.getGrainSize(), 2 );
+  }
+
+  // malformed adapter numbers are skipped, i.e. the records loaded before
+  // remain
+  out.open( filename.c_str() );
+  out << "begin OracleForOnePhaseWithLearningGrainSize" << std::endl
+      << "adapter-number=three" << std::endl
+      << "end OracleForOnePhaseWithLearningGrainSize" << std::endl;
+  out.close();
+  reloadedOracle.loadStatistics(filename,3);
+  {
+    GrainSize grainSize = reloadedOracle.parallelise(1000, MethodTrace::UserDefined0);
+    validateEquals( grainSize.getGrainSize(), 4 );
+  }
+
+  std::remove( filename.c_str() );
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
@@ -0,0 +1,40 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_DATA_TRAVERSAL_AUTOTUNING_TESTS_ORACLE_FOR_ONE_PHASE_WITH_LEARNING_GRAIN_SIZE_TEST_H_
+#define _PEANO_DATA_TRAVERSAL_AUTOTUNING_TESTS_ORACLE_FOR_ONE_PHASE_WITH_LEARNING_GRAIN_SIZE_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+
+namespace peano {
+  namespace datatraversal {
+    namespace autotuning {
+      namespace tests {
+        class OracleForOnePhaseWithLearningGrainSizeTest;
+      }
+    }
+  }
+}
+
+
+/**
+ * We do not use real time measurements here, as those are not reproducible.
+ * Instead, the tests feed a synthetic cost model into the oracle and check
+ * that the oracle converges to the model's optimum, that it re-explores once
+ * the model changes, and that it can reload what it has learned.
+ */
+class peano::datatraversal::autotuning::tests::OracleForOnePhaseWithLearningGrainSizeTest: public tarch::tests::TestCase {
+  private:
+    void testConvergence();
+    void testRegression();
+    void testPlotAndLoadStatistics();
+  public:
+    OracleForOnePhaseWithLearningGrainSizeTest();
+    virtual ~OracleForOnePhaseWithLearningGrainSizeTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
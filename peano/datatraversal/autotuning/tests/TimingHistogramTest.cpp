@@ -0,0 +1,109 @@
+#include "peano/datatraversal/autotuning/tests/TimingHistogramTest.h"
+#include "peano/datatraversal/autotuning/TimingHistogram.h"
+#include "peano/datatraversal/autotuning/Oracle.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(peano::datatraversal::autotuning::tests::TimingHistogramTest)
+
+
+#include <utility>
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+peano::datatraversal::autotuning::tests::TimingHistogramTest::TimingHistogramTest():
+  TestCase( "peano::datatraversal::autotuning::tests::TimingHistogramTest" ) {
+}
+
+
+peano::datatraversal::autotuning::tests::TimingHistogramTest::~TimingHistogramTest() {
+}
+
+
+void peano::datatraversal::autotuning::tests::TimingHistogramTest::run() {
+  testMethod( testPercentiles );
+  testMethod( testSerialAndParallelTimes );
+  testMethod( testOracleRecordsGrainSizes );
+}
+
+
+void peano::datatraversal::autotuning::tests::TimingHistogramTest::setUp() {
+}
+
+
+void peano::datatraversal::autotuning::tests::TimingHistogramTest::testPercentiles() {
+  TimingHistogram histogram;
+  validateEquals( histogram.getNumberOfSamples(), 0 );
+  validateNumericalEquals( histogram.getMeanTime(), 0.0 );
+  validateNumericalEquals( histogram.getPercentile(0.5), 0.0 );
+
+  // identical samples yield exact percentiles
+  for (int i=0; i<10; i++) {
+    histogram.addSample( 1.0e-3, false );
+  }
+  validateEquals( histogram.getNumberOfSamples(), 10 );
+  validateNumericalEquals( histogram.getMeanTime(),      1.0e-3 );
+  validateNumericalEquals( histogram.getPercentile(0.5), 1.0e-3 );
+  validateNumericalEquals( histogram.getPercentile(1.0), 1.0e-3 );
+
+  // 90 fast and 10 slow sections: median is fast, p95 and p99 are slow
+  histogram.clear();
+  for (int i=0; i<90; i++) {
+    histogram.addSample( 1.0e-6, false );
+  }
+  for (int i=0; i<10; i++) {
+    histogram.addSample( 1.0, false );
+  }
+  validateEquals( histogram.getNumberOfSamples(), 100 );
+  validateWithParams1( histogram.getPercentile(0.50) <  2.0e-6, histogram.toString() );
+  validateWithParams1( histogram.getPercentile(0.50) >= 1.0e-6, histogram.toString() );
+  validateNumericalEqualsWithParams1( histogram.getPercentile(0.95), 1.0, histogram.toString() );
+  validateNumericalEqualsWithParams1( histogram.getPercentile(0.99), 1.0, histogram.toString() );
+  validateNumericalEqualsWithParams1( histogram.getMeanTime(), (90.0*1.0e-6+10.0)/100.0, histogram.toString() );
+}
+
+
+void peano::datatraversal::autotuning::tests::TimingHistogramTest::testSerialAndParallelTimes() {
+  TimingHistogram histogram;
+  histogram.addSample( 2.0, false );
+  histogram.addSample( 1.0, true );
+  histogram.addSample( 3.0, true );
+
+  validateEquals( histogram.getNumberOfSerialSamples(),   1 );
+  validateEquals( histogram.getNumberOfParallelSamples(), 2 );
+  validateNumericalEquals( histogram.getSerialTime(),     2.0 );
+  validateNumericalEquals( histogram.getParallelTime(),   4.0 );
+  validateNumericalEquals( histogram.getMeanTime(),       2.0 );
+  validateNumericalEquals( histogram.getPercentile(1.0),  3.0 );
+}
+
+
+void peano::datatraversal::autotuning::tests::TimingHistogramTest::testOracleRecordsGrainSizes() {
+  Oracle::getInstance().clearTimingHistograms();
+
+  {
+    GrainSize grainSize( 0, false, 10, MethodTrace::UserDefined0, nullptr );
+  }
+  validateEquals( Oracle::getInstance().getTimingHistogram(MethodTrace::UserDefined0).getNumberOfSamples(), 0 );
+
+  Oracle::getInstance().recordTimingHistograms(true);
+  {
+    GrainSize serialSection( 0, false, 10, MethodTrace::UserDefined0, nullptr );
+    GrainSize parallelSection( 2, false, 10, MethodTrace::UserDefined0, nullptr );
+    GrainSize movedSection( std::move(parallelSection) );
+    serialSection.parallelSectionHasTerminated();
+  }
+  Oracle::getInstance().recordTimingHistograms(false);
+
+  const TimingHistogram histogram = Oracle::getInstance().getTimingHistogram(MethodTrace::UserDefined0);
+  validateEqualsWithParams1( histogram.getNumberOfSerialSamples(),   1, histogram.toString() );
+  validateEqualsWithParams1( histogram.getNumberOfParallelSamples(), 1, histogram.toString() );
+  validateEquals( Oracle::getInstance().getTimingHistogram(MethodTrace::UserDefined1).getNumberOfSamples(), 0 );
+
+  Oracle::getInstance().clearTimingHistograms();
+  validateEquals( Oracle::getInstance().getTimingHistogram(MethodTrace::UserDefined0).getNumberOfSamples(), 0 );
+}
@@ -0,0 +1,39 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_DATA_TRAVERSAL_AUTOTUNING_TESTS_TIMING_HISTOGRAM_TEST_H_
+#define _PEANO_DATA_TRAVERSAL_AUTOTUNING_TESTS_TIMING_HISTOGRAM_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+
+namespace peano {
+  namespace datatraversal {
+    namespace autotuning {
+      namespace tests {
+        class TimingHistogramTest;
+      }
+    }
+  }
+}
+
+
+/**
+ * Tests the histogram with synthetic samples. Only the last test uses real
+ * GrainSize objects, i.e. real time measurements, and thus validates counts
+ * only.
+ */
+class peano::datatraversal::autotuning::tests::TimingHistogramTest: public tarch::tests::TestCase {
+  private:
+    void testPercentiles();
+    void testSerialAndParallelTimes();
+    void testOracleRecordsGrainSizes();
+  public:
+    TimingHistogramTest();
+    virtual ~TimingHistogramTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
@@ -0,0 +1,172 @@
+#include "peano/datatraversal/autotuning/tests/TuningDatabaseTest.h"
+#include "peano/datatraversal/autotuning/TuningDatabase.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhaseWithLearningGrainSize.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+#include "tarch/parallel/Node.h"
+registerTest(peano::datatraversal::autotuning::tests::TuningDatabaseTest)
+
+
+#include <cstdio>
+#include <sstream>
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+namespace {
+  /**
+   * All ranks of a parallel test run execute the tests at the same time.
+   */
+  std::string getFilename() {
+    std::ostringstream result;
+    result << "rank-" << tarch::parallel::Node::getInstance().getRank() << "-TuningDatabaseTest.database";
+    return result.str();
+  }
+
+  /**
+   * Oracle that ignores the real time measurements of its GrainSize objects.
+   */
+  class OracleWithSyntheticCosts: public peano::datatraversal::autotuning::OracleForOnePhaseWithLearningGrainSize {
+    public:
+      OracleWithSyntheticCosts():
+        OracleForOnePhaseWithLearningGrainSize(1,0.2,1000) {
+      }
+
+      void parallelSectionHasTerminated(int problemSize, int grainSize, peano::datatraversal::autotuning::MethodTrace askingMethod, double costPerProblemElement) override {
+      }
+
+      void learn(int problemSize, int grainSize, peano::datatraversal::autotuning::MethodTrace askingMethod, double costPerProblemElement) {
+        OracleForOnePhaseWithLearningGrainSize::parallelSectionHasTerminated(problemSize,grainSize,askingMethod,costPerProblemElement);
+      }
+  };
+}
+
+
+peano::datatraversal::autotuning::tests::TuningDatabaseTest::TuningDatabaseTest():
+  TestCase( "peano::datatraversal::autotuning::tests::TuningDatabaseTest" ) {
+}
+
+
+peano::datatraversal::autotuning::tests::TuningDatabaseTest::~TuningDatabaseTest() {
+}
+
+
+void peano::datatraversal::autotuning::tests::TuningDatabaseTest::run() {
+  testMethod( testClosestConfiguration );
+  testMethod( testMergeOnStore );
+  testMethod( testOracleWarmStart );
+}
+
+
+void peano::datatraversal::autotuning::tests::TuningDatabaseTest::setUp() {
+  std::remove( getFilename().c_str() );
+}
+
+
+void peano::datatraversal::autotuning::tests::TuningDatabaseTest::testClosestConfiguration() {
+  TuningDatabase::Configuration sameHost{"cpu A", "host 1", 8, 2};
+  TuningDatabase::Configuration sameCPU{"cpu A", "host 2", 8, 2};
+  TuningDatabase::Configuration otherCPU{"cpu B", "host 1", 8, 2};
+  TuningDatabase::Configuration otherThreads{"cpu A", "host 1", 2, 2};
+  TuningDatabase::Configuration otherDimension{"cpu A", "host 1", 8, 3};
+
+  validateNumericalEquals( sameHost.getDistance(sameHost), 0.0 );
+  validate( sameHost.getDistance(sameCPU) < sameHost.getDistance(otherCPU) );
+  validateNumericalEquals( sameHost.getDistance(otherThreads), 2.0 );
+  validate( sameHost.getDistance(otherDimension) < 0.0 );
+
+  TuningDatabase databaseOnSameCPU(sameCPU);
+  databaseOnSameCPU.setEntry( 1, MethodTrace::UserDefined0, 10, "same-cpu" );
+  databaseOnSameCPU.store(getFilename());
+
+  TuningDatabase databaseOnOtherCPU(otherCPU);
+  databaseOnOtherCPU.setEntry( 1, MethodTrace::UserDefined0, 10, "other-cpu" );
+  databaseOnOtherCPU.setEntry( 2, MethodTrace::UserDefined1, 10, "other-cpu" );
+  databaseOnOtherCPU.store(getFilename());
+
+  TuningDatabase database(sameHost);
+  validate( database.load(getFilename()) );
+  validateEquals( database.getNumberOfEntries(), 3 );
+
+  // oracle 1 is available for the same cpu model, so we prefer that one
+  auto entries = database.getEntries(1);
+  validateEquals( entries.size(), 1 );
+  validateEquals( entries.begin()->second, "same-cpu" );
+
+  // oracle 2 is available for another cpu only
+  entries = database.getEntries(2);
+  validateEquals( entries.size(), 1 );
+  validateEquals( entries.begin()->second, "other-cpu" );
+
+  // nothing is known in three dimensions
+  TuningDatabase databaseIn3d(otherDimension);
+  databaseIn3d.load(getFilename());
+  validateEquals( databaseIn3d.getEntries(1).size(), 0 );
+
+  std::remove( getFilename().c_str() );
+}
+
+
+void peano::datatraversal::autotuning::tests::TuningDatabaseTest::testMergeOnStore() {
+  TuningDatabase::Configuration configuration0{"cpu A", "host 1", 8, 2};
+  TuningDatabase::Configuration configuration1{"cpu A", "host 1", 16, 2};
+
+  TuningDatabase database0(configuration0);
+  database0.setEntry( 0, MethodTrace::UserDefined0, 4, "first" );
+  database0.store(getFilename());
+
+  TuningDatabase database1(configuration1);
+  database1.setEntry( 0, MethodTrace::UserDefined0, 4, "other-threads" );
+  database1.store(getFilename());
+
+  // update entry of first configuration, but do not lose the other one
+  database0.setEntry( 0, MethodTrace::UserDefined0, 4, "second" );
+  database0.store(getFilename());
+
+  TuningDatabase result0(configuration0);
+  result0.load(getFilename());
+  validateEquals( result0.getNumberOfEntries(), 2 );
+  validateEquals( result0.getEntries(0).begin()->second, "second" );
+
+  TuningDatabase result1(configuration1);
+  result1.load(getFilename());
+  validateEquals( result1.getEntries(0).begin()->second, "other-threads" );
+
+  std::remove( getFilename().c_str() );
+}
+
+
+void peano::datatraversal::autotuning::tests::TuningDatabaseTest::testOracleWarmStart() {
+  TuningDatabase::Configuration configuration{"cpu A", "host 1", 8, 2};
+
+  // train oracle such that grain size 8 is the best choice
+  OracleWithSyntheticCosts oracle;
+  for (int i=0; i<10; i++) {
+    GrainSize answer = oracle.parallelise(1000, MethodTrace::UserDefined0);
+    oracle.learn(1000, answer.getGrainSize(), MethodTrace::UserDefined0, answer.getGrainSize()==8 ? 1.0 : 1000.0);
+  }
+
+  TuningDatabase database(configuration);
+  oracle.storeInDatabase(database,4);
+  validateEquals( database.getNumberOfEntries(), 1 );
+  database.store(getFilename());
+
+  TuningDatabase reloadedDatabase(configuration);
+  reloadedDatabase.load(getFilename());
+  OracleWithSyntheticCosts warmStartedOracle;
+  warmStartedOracle.loadFromDatabase(reloadedDatabase,4);
+
+  GrainSize answer = warmStartedOracle.parallelise(1000, MethodTrace::UserDefined0);
+  validateEquals( answer.getGrainSize(), 8 );
+
+  std::remove( getFilename().c_str() );
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
@@ -0,0 +1,39 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_DATA_TRAVERSAL_AUTOTUNING_TESTS_TUNING_DATABASE_TEST_H_
+#define _PEANO_DATA_TRAVERSAL_AUTOTUNING_TESTS_TUNING_DATABASE_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+
+namespace peano {
+  namespace datatraversal {
+    namespace autotuning {
+      namespace tests {
+        class TuningDatabaseTest;
+      }
+    }
+  }
+}
+
+
+/**
+ * Works with artificial configurations, i.e. the tests do not depend on the
+ * machine they are running on. All tests write a database file into the
+ * working directory and remove it afterwards.
+ */
+class peano::datatraversal::autotuning::tests::TuningDatabaseTest: public tarch::tests::TestCase {
+  private:
+    void testClosestConfiguration();
+    void testMergeOnStore();
+    void testOracleWarmStart();
+  public:
+    TuningDatabaseTest();
+    virtual ~TuningDatabaseTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
@@ -109,6 +109,16 @@ namespace peano {
  * You can run the whole code without a reduction. For this, you may omit the
  * merge operations, but the important thing is that you make operator() const.
  *
+ * <h2> Reductions without copies </h2>
+ *
+ * If the loop body has to reduce only a few values, it is cheaper not to
+ * alter the state at all and to hold a tarch::multicore::Accumulator instead.
+ * Pass altersState=false. The loop then is not copied, all threads write
+ * into their own (padded) slot of the accumulator, and you read the result
+ * via reduce() once the loop has terminated. No merge is required. The grid's
+ * enterCell and leaveCell loop bodies follow this pattern if the mapping's
+ * specification says that the events do not alter the state.
+ *
  * @author Tobias Weinzierl
  */
 template <class LoopBody>
@@ -203,6 +203,13 @@ class peano::grid::RegularGridContainer {
         int      uninitalisedVertices;
         int      uninitalisedCells;
 
+        /**
+         * Number of cells along the patch boundary whose children's vertices
+         * are not loaded yet. Is used only if the vertices of a persistent
+         * subtree are reloaded, see haveReadAllChildrenVerticesOfOneBoundaryCell().
+         */
+        int      boundaryCellsWithUnreadChildren;
+
         /**
          * Is protected by the vertex semaphore
          */
@@ -334,6 +341,25 @@ class peano::grid::RegularGridContainer {
 
     void haveReadAllCells( int maxLevel );
 
+    /**
+     * Counterpart of haveReadVertices() for persistent regular subtrees
+     *
+     * If a regular subtree is held persistently, the load process reads only
+     * the vertices along the patch boundary from the input stack, and it
+     * recurses only into the cells at the patch boundary. All other vertices
+     * remain in the container in-between two traversals. Once all the
+     * boundary cells of one level have loaded their children's vertices, the
+     * next finer level thus is complete. The load process calls this
+     * operation for each boundary cell, and the container marks the next
+     * finer level as initialised as soon as the last boundary cell of a level
+     * has reported in. A descend running in parallel to the load thus can
+     * start with the coarse levels while the load is still busy with the
+     * fine ones.
+     *
+     * @param level Level of the boundary cell whose children have been loaded
+     */
+    void haveReadAllChildrenVerticesOfOneBoundaryCell( int level );
+
     void haveStoredAllVertices( int maxLevel );
     void haveStoredAllCells( int maxLevel );
 
@@ -416,6 +442,11 @@ class peano::grid::RegularGridContainer {
     static tarch::la::Vector<DIMENSIONS,int> getNumberOfCells( int level );
     static tarch::la::Vector<DIMENSIONS,int> getNumberOfVertices( int level );
 
+    /**
+     * Number of cells on a level that are adjacent to the patch boundary.
+     */
+    static int getNumberOfCellsAtPatchBoundary( int level );
+
     std::string toString() const;
 
     bool isCellAtPatchBoundaryWithinRegularSubtree(
@@ -5,11 +5,14 @@
 
 
 #include "tarch/logging/Log.h"
+#include "tarch/parallel/MPIConstants.h"
+#include "tarch/multicore/BooleanSemaphore.h"
 #include "peano/utils/PeanoOptimisations.h"
 
 
 #include <set>
 #include <map>
+#include <list>
 
 
 namespace peano {
@@ -151,6 +154,28 @@ class peano::grid::State {
      */
     std::map<int,bool>  _stateWillReduce;
 
+    /**
+     * Is set if this state is a mere placeholder for a worker state that is
+     * received in the background. See markAsReceivedInBackground().
+     */
+    bool                _isReceivedInBackground;
+
+    struct WorkerStateReceivedInBackground {
+      int                   rank;
+      MPIDatatypeContainer  data;
+      MPI_Request           request;
+    };
+
+    /**
+     * Worker states that are received in the background. We use a static
+     * list, as MPI holds pointers to the entries while states are copied
+     * throughout the traversal.
+     *
+     * @see receiveWorkerStateInBackground()
+     */
+    static std::list<WorkerStateReceivedInBackground>  _workerStatesReceivedInBackground;
+    static tarch::multicore::BooleanSemaphore           _workerStatesReceivedInBackgroundSemaphore;
+
     /**
      * We may fork/join only every third iteration.
      *
@@ -679,6 +704,56 @@ class peano::grid::State {
      */
     void mergeWithWorkerState(const peano::grid::State<StateData>& workerState);
 
+    /**
+     * Receive a worker's state in the background
+     *
+     * Counterpart of a blocking receive followed by mergeWithWorkerState().
+     * The operation posts a non-blocking receive for the worker's state and
+     * returns immediately. The master thus can continue with its local work.
+     * The state is merged not before
+     * mergeWithWorkerStatesReceivedInBackground() is called.
+     *
+     * Is used by the nodes if the communication specification says
+     * SendDataAfterProcessingOfLocalSubtreeReduceStateInBackground. The
+     * worker does not see any difference, as it sends its state exactly the
+     * same way as without the background reduction. As the worker sends its
+     * state after its cell and vertices, we may post the receive only after
+     * we have received those.
+     */
+    void receiveWorkerStateInBackground(int worker);
+
+    /**
+     * Wait for all worker states received in the background and merge them
+     *
+     * Is called by the root node right before endIteration(). The operation
+     * blocks if a worker has not sent its state yet, i.e. the master
+     * synchronises with its workers only when it needs the reduced data.
+     * Nop if there are no states received in the background.
+     */
+    void mergeWithWorkerStatesReceivedInBackground();
+
+    /**
+     * @return Number of worker states that are currently received in the
+     *         background.
+     */
+    static int getNumberOfWorkerStatesReceivedInBackground();
+
+    /**
+     * Mark a worker state as placeholder
+     *
+     * If the master receives a worker's state in the background, it still
+     * hands a worker state over to mergeWithMaster(). This state does not
+     * hold any of the worker's data. The node thus marks it, and
+     * mergeWithWorkerState() refuses to merge such a state.
+     */
+    void markAsReceivedInBackground();
+
+    /**
+     * @return The state is a placeholder for a worker state that is received
+     *         in the background, i.e. it does not hold any worker data.
+     */
+    bool isReceivedInBackground() const;
+
     /**
      * Receive state and cell from the master
      *
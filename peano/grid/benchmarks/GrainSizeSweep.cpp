@@ -0,0 +1,168 @@
+#include "peano/grid/benchmarks/GrainSizeSweep.h"
+#include "peano/grid/benchmarks/SyntheticEventHandle.h"
+
+#include "peano/grid/Grid.h"
+#include "peano/grid/Grid.cpph"
+#include "peano/grid/RegularGridContainer.h"
+#include "peano/grid/TraversalOrderOnTopLevel.h"
+#include "peano/geometry/Hexahedron.h"
+#include "peano/stacks/VertexSTDStack.h"
+#include "peano/stacks/CellSTDStack.h"
+
+#include "peano/datatraversal/autotuning/Oracle.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhaseWithGrainSizeSweep.h"
+#include "peano/datatraversal/autotuning/MethodTrace.h"
+
+#include "tarch/multicore/MulticoreDefinitions.h"
+#include "tarch/timing/Watch.h"
+#include "tarch/Assertions.h"
+
+
+#include <fstream>
+#include <sstream>
+
+
+tarch::logging::Log  peano::grid::benchmarks::GrainSizeSweep::_log( "peano::grid::benchmarks::GrainSizeSweep" );
+
+
+peano::grid::benchmarks::GrainSizeSweep::GrainSizeSweep(int depth, bool adaptive, int workload, int iterationsPerMeasurement):
+  _depth(depth),
+  _adaptive(adaptive),
+  _workload(workload),
+  _iterationsPerMeasurement(iterationsPerMeasurement) {
+  assertion1( depth>=1, depth );
+  assertion1( iterationsPerMeasurement>=1, iterationsPerMeasurement );
+}
+
+
+bool peano::grid::benchmarks::GrainSizeSweep::run(const std::string& tableFilename, const std::string& oracleFilename, int numberOfOracles) {
+  assertion1( numberOfOracles>=1, numberOfOracles );
+
+  #if defined(Parallel)
+  // The synthetic records do not hold the attributes required by the MPI
+  // parallelisation, so we cannot instantiate the grid.
+  logError( "run(...)", "grain size sweep is not available if the code is translated with MPI" );
+  return false;
+  #else
+  #if !defined(SharedMemoryParallelisation)
+  logWarning( "run(...)", "code is not translated with shared memory parallelisation, i.e. no method will ever ask the oracle and the sweep yields empty results" );
+  #endif
+
+  logInfo( "run(...)", "start grain size sweep " << toString() );
+
+  // The oracle singleton owns the prototype. All clones share the prototype's
+  // sweep settings, so we can steer them through this pointer.
+  peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep* oracle = new peano::datatraversal::autotuning::OracleForOnePhaseWithGrainSizeSweep();
+  peano::datatraversal::autotuning::Oracle::getInstance().setNumberOfOracles(1);
+  peano::datatraversal::autotuning::Oracle::getInstance().setOracle(oracle);
+  peano::datatraversal::autotuning::Oracle::getInstance().switchToOracle(0);
+
+  SyntheticEventHandle::configure( _depth, _adaptive, _workload );
+
+  peano::stacks::VertexSTDStack<SyntheticVertex>           vertexStack;
+  peano::stacks::CellSTDStack<SyntheticCell>               cellStack;
+  peano::geometry::Hexahedron                              geometry( 1.0, 0.0 );
+  SyntheticState                                           state;
+  peano::grid::RegularGridContainer<SyntheticVertex,SyntheticCell>  regularGridContainer;
+  peano::grid::TraversalOrderOnTopLevel                    traversalOrderOnTopLevel;
+
+  peano::grid::Grid<
+    SyntheticVertex,
+    SyntheticCell,
+    SyntheticState,
+    peano::stacks::VertexSTDStack<SyntheticVertex>,
+    peano::stacks::CellSTDStack<SyntheticCell>,
+    SyntheticEventHandle
+  > grid(
+    vertexStack,
+    cellStack,
+    geometry,
+    state,
+    1.0,
+    0.0,
+    regularGridContainer,
+    traversalOrderOnTopLevel
+  );
+
+  // Build up the grid. Afterwards, the kernel needs a couple of sweeps on the
+  // stationary grid before it identifies and holds regular subtrees.
+  oracle->switchToDiscovery();
+  const int MaxNumberOfIterationsToBuildGrid = 4*_depth + 8;
+  int       iteration                        = 0;
+  while ( iteration<MaxNumberOfIterationsToBuildGrid && (iteration<2 || !state.isGridStationary()) ) {
+    grid.iterate();
+    iteration++;
+  }
+  for (int i=0; i<_iterationsPerMeasurement+2; i++) {
+    grid.iterate();
+  }
+  logInfo( "run(...)", "built grid in " << iteration << " iteration(s). " << oracle->getAskingMethods().size() << " method(s) ask for grain sizes" );
+
+  for (auto method: oracle->getAskingMethods()) {
+    const int biggestProblemSize = oracle->getBiggestProblemSize(method);
+    int       grainSize          = 0;
+    while (grainSize==0 || grainSize<biggestProblemSize) {
+      tarch::timing::Watch watch( "peano::grid::benchmarks::GrainSizeSweep", "run(...)", false );
+      oracle->switchToSweep(method,grainSize);
+      for (int i=0; i<_iterationsPerMeasurement; i++) {
+        grid.iterate();
+      }
+      watch.stopTimer();
+      logInfo(
+        "run(...)",
+        "swept " << peano::datatraversal::autotuning::toString(method) << " with grain size " << grainSize
+        << ": " << watch.getCalendarTime()/_iterationsPerMeasurement << "s per grid sweep"
+      );
+      grainSize = grainSize==0 ? 1 : 2*grainSize;
+    }
+  }
+  oracle->switchToDiscovery();
+
+  grid.terminate();
+
+  bool result = true;
+
+  if (tableFilename.empty()) {
+    std::ostringstream table;
+    oracle->plotTable(table);
+    logInfo( "run(...)", table.str() );
+  }
+  else {
+    std::ofstream table( tableFilename.c_str() );
+    if (table.is_open()) {
+      oracle->plotTable(table);
+      logInfo( "run(...)", "wrote measurements to " << tableFilename );
+    }
+    else {
+      logError( "run(...)", "could not write " << tableFilename );
+      result = false;
+    }
+  }
+
+  std::ofstream tunedOracle( oracleFilename.c_str() );
+  if (tunedOracle.is_open()) {
+    for (int i=0; i<numberOfOracles; i++) {
+      oracle->plotStatistics(tunedOracle,i);
+    }
+    logInfo( "run(...)", "wrote tuned oracle to " << oracleFilename );
+  }
+  else {
+    logError( "run(...)", "could not write " << oracleFilename );
+    result = false;
+  }
+
+  return result;
+  #endif
+}
+
+
+std::string peano::grid::benchmarks::GrainSizeSweep::toString() const {
+  std::ostringstream msg;
+  msg << "(depth=" << _depth
+      << ",adaptive=" << _adaptive
+      << ",workload=" << _workload
+      << ",iterations-per-measurement=" << _iterationsPerMeasurement
+      << ",dimensions=" << DIMENSIONS
+      << ")";
+  return msg.str();
+}
@@ -0,0 +1,90 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_GRID_BENCHMARKS_GRAIN_SIZE_SWEEP_H_
+#define _PEANO_GRID_BENCHMARKS_GRAIN_SIZE_SWEEP_H_
+
+
+#include "tarch/logging/Log.h"
+
+
+#include <string>
+
+
+namespace peano {
+  namespace grid {
+    namespace benchmarks {
+      class GrainSizeSweep;
+    }
+  }
+}
+
+
+/**
+ * Offline grain size sweep
+ *
+ * The driver builds up a synthetic grid (see SyntheticEventHandle) over the
+ * grid's test records and traverses it over and over again. It first runs
+ * serially and records which method traces of the kernel ask the oracle for
+ * grain sizes at all. Then, it sweeps these methods one after another. For
+ * each method, it tries grain size 0 (serial) and all powers of two smaller
+ * than the biggest problem size the method has asked for. As the pipelining
+ * is controlled through the PipelineAscendTask and PipelineDescendTask grain
+ * sizes, the pipeline settings are swept, too.
+ *
+ * The output is a table with the measurements (see
+ * OracleForOnePhaseWithGrainSizeSweep::plotTable()) plus a tuned oracle file
+ * that OracleForOnePhaseWithLearningGrainSize reads through
+ * Oracle::loadStatistics().
+ *
+ * <h2> Usage </h2>
+ *
+ * There is no main in the Peano sources. Write a main that initialises the
+ * shared memory environment (peano::initSharedMemoryEnvironment()), creates
+ * a GrainSizeSweep and calls run(). The spatial dimension is the one you
+ * translate with (Dim2 or Dim3). Call the driver for a regular and an
+ * adaptive grid and for different depths if your application's grids vary.
+ * Without a shared memory parallelisation, the oracle is never asked, so the
+ * driver has nothing to measure.
+ *
+ * The driver takes over the oracle singleton, i.e. you have to reconfigure
+ * it afterwards if you want to do anything else in the same run.
+ */
+class peano::grid::benchmarks::GrainSizeSweep {
+  private:
+    static tarch::logging::Log  _log;
+
+    const int   _depth;
+    const bool  _adaptive;
+    const int   _workload;
+    const int   _iterationsPerMeasurement;
+  public:
+    /**
+     * @param depth                     Finest grid level.
+     * @param adaptive                  Use an adaptive instead of a regular
+     *                                  grid.
+     * @param workload                  Dummy operations per event. See
+     *                                  SyntheticEventHandle.
+     * @param iterationsPerMeasurement  Grid sweeps per method and grain size.
+     */
+    GrainSizeSweep(int depth, bool adaptive, int workload=0, int iterationsPerMeasurement=4);
+
+    /**
+     * Run the sweep.
+     *
+     * @param tableFilename   File for the measurement table. Empty string
+     *                        means we write the table to the info log.
+     * @param oracleFilename  File for the tuned oracle.
+     * @param numberOfOracles The tuned file holds one block per oracle, i.e.
+     *                        pass the number of oracles (adapters) of your
+     *                        application. All blocks are the same.
+     * @return Whether the files have been written. Always false if the code
+     *         is translated with MPI, as the synthetic grid is not available
+     *         then.
+     */
+    bool run(const std::string& tableFilename, const std::string& oracleFilename, int numberOfOracles);
+
+    std::string toString() const;
+};
+
+
+#endif
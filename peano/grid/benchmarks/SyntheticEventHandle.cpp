@@ -0,0 +1,385 @@
+#include "peano/grid/benchmarks/SyntheticEventHandle.h"
+#include "tarch/Assertions.h"
+
+
+#include <cmath>
+
+
+tarch::logging::Log  peano::grid::benchmarks::SyntheticEventHandle::_log( "peano::grid::benchmarks::SyntheticEventHandle" );
+
+
+peano::grid::benchmarks::SyntheticVertex::SyntheticVertex():
+  Base() {
+}
+
+
+peano::grid::benchmarks::SyntheticVertex::SyntheticVertex(const Base::DoNotCallStandardConstructor& value):
+  Base(value) {
+}
+
+
+peano::grid::benchmarks::SyntheticVertex::SyntheticVertex(const Base::PersistentVertex& argument):
+  Base(argument) {
+}
+
+
+peano::grid::benchmarks::SyntheticCell::SyntheticCell():
+  Base() {
+}
+
+
+peano::grid::benchmarks::SyntheticCell::SyntheticCell(const Base::DoNotCallStandardConstructor& value):
+  Base(value) {
+}
+
+
+peano::grid::benchmarks::SyntheticCell::SyntheticCell(const Base::PersistentCell& argument):
+  Base(argument) {
+}
+
+
+peano::grid::benchmarks::SyntheticStateRecord::SyntheticStateRecord():
+  peano::grid::tests::records::TestState(),
+  _hasModifiedGridInPreviousIteration(true),
+  _couldNotEraseDueToDecompositionFlag(false),
+  _subWorkerIsInvolvedInJoinOrFork(false) {
+}
+
+
+peano::grid::benchmarks::SyntheticStateRecord::SyntheticStateRecord(const PersistentRecords& persistentRecords):
+  peano::grid::tests::records::TestState(persistentRecords),
+  _hasModifiedGridInPreviousIteration(true),
+  _couldNotEraseDueToDecompositionFlag(false),
+  _subWorkerIsInvolvedInJoinOrFork(false) {
+}
+
+
+peano::grid::benchmarks::SyntheticStateRecord::SyntheticStateRecord(const peano::grid::tests::records::TestState& record):
+  peano::grid::tests::records::TestState(record),
+  _hasModifiedGridInPreviousIteration(true),
+  _couldNotEraseDueToDecompositionFlag(false),
+  _subWorkerIsInvolvedInJoinOrFork(false) {
+}
+
+
+bool peano::grid::benchmarks::SyntheticStateRecord::getHasModifiedGridInPreviousIteration() const {
+  return _hasModifiedGridInPreviousIteration;
+}
+
+
+void peano::grid::benchmarks::SyntheticStateRecord::setHasModifiedGridInPreviousIteration(const bool& hasModifiedGridInPreviousIteration) {
+  _hasModifiedGridInPreviousIteration = hasModifiedGridInPreviousIteration;
+}
+
+
+bool peano::grid::benchmarks::SyntheticStateRecord::getCouldNotEraseDueToDecompositionFlag() const {
+  return _couldNotEraseDueToDecompositionFlag;
+}
+
+
+void peano::grid::benchmarks::SyntheticStateRecord::setCouldNotEraseDueToDecompositionFlag(const bool& couldNotEraseDueToDecompositionFlag) {
+  _couldNotEraseDueToDecompositionFlag = couldNotEraseDueToDecompositionFlag;
+}
+
+
+bool peano::grid::benchmarks::SyntheticStateRecord::getSubWorkerIsInvolvedInJoinOrFork() const {
+  return _subWorkerIsInvolvedInJoinOrFork;
+}
+
+
+void peano::grid::benchmarks::SyntheticStateRecord::setSubWorkerIsInvolvedInJoinOrFork(const bool& subWorkerIsInvolvedInJoinOrFork) {
+  _subWorkerIsInvolvedInJoinOrFork = subWorkerIsInvolvedInJoinOrFork;
+}
+
+
+peano::grid::benchmarks::SyntheticState::SyntheticState():
+  Base() {
+}
+
+
+peano::grid::benchmarks::SyntheticState::SyntheticState(const Base::PersistentState& argument):
+  Base(argument) {
+}
+
+
+int   peano::grid::benchmarks::SyntheticEventHandle::_depth(1);
+bool  peano::grid::benchmarks::SyntheticEventHandle::_adaptive(false);
+int   peano::grid::benchmarks::SyntheticEventHandle::_workload(0);
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::configure(int depth, bool adaptive, int workload) {
+  assertion1( depth>=1, depth );
+  assertion1( workload>=0, workload );
+  _depth    = depth;
+  _adaptive = adaptive;
+  _workload = workload;
+}
+
+
+peano::grid::benchmarks::SyntheticEventHandle::SyntheticEventHandle():
+  _checksum(0.0) {
+}
+
+
+peano::grid::benchmarks::SyntheticEventHandle::SyntheticEventHandle(const SyntheticEventHandle& masterThread):
+  _checksum(0.0) {
+}
+
+
+double peano::grid::benchmarks::SyntheticEventHandle::getChecksum() const {
+  return _checksum;
+}
+
+
+bool peano::grid::benchmarks::SyntheticEventHandle::shallRefine( const tarch::la::Vector<DIMENSIONS,double>& x, int level ) const {
+  if (level>=_depth) {
+    return false;
+  }
+  else if (!_adaptive || level<2) {
+    return true;
+  }
+  else {
+    double distanceFromCentre = 0.0;
+    for (int d=0; d<DIMENSIONS; d++) {
+      distanceFromCentre += (x(d)-0.5) * (x(d)-0.5);
+    }
+    return std::abs( std::sqrt(distanceFromCentre) - 0.25 ) < 0.1;
+  }
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::refineIfRequired(
+  SyntheticVertex&                              fineGridVertex,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator
+) {
+  if (
+    fineGridVertex.getRefinementControl()==SyntheticVertex::Records::Unrefined
+    &&
+    shallRefine( fineGridX, coarseGridVerticesEnumerator.getLevel()+1 )
+  ) {
+    fineGridVertex.refine();
+  }
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::doWork( const tarch::la::Vector<DIMENSIONS,double>& x ) {
+  double value = x(0);
+  for (int i=0; i<_workload; i++) {
+    value = std::sin(value) + x(i%DIMENSIONS);
+  }
+  _checksum += value;
+}
+
+
+peano::CommunicationSpecification peano::grid::benchmarks::SyntheticEventHandle::communicationSpecification() const {
+  return peano::CommunicationSpecification::getMinimalSpecification();
+}
+
+
+peano::MappingSpecification peano::grid::benchmarks::SyntheticEventHandle::touchVertexLastTimeSpecification(int level) const {
+  return peano::MappingSpecification( peano::MappingSpecification::WholeTree, peano::MappingSpecification::RunConcurrentlyOnFineGrid, false );
+}
+
+
+peano::MappingSpecification peano::grid::benchmarks::SyntheticEventHandle::touchVertexFirstTimeSpecification(int level) const {
+  return peano::MappingSpecification( peano::MappingSpecification::WholeTree, peano::MappingSpecification::RunConcurrentlyOnFineGrid, false );
+}
+
+
+peano::MappingSpecification peano::grid::benchmarks::SyntheticEventHandle::enterCellSpecification(int level) const {
+  return peano::MappingSpecification( peano::MappingSpecification::WholeTree, peano::MappingSpecification::RunConcurrentlyOnFineGrid, false );
+}
+
+
+peano::MappingSpecification peano::grid::benchmarks::SyntheticEventHandle::leaveCellSpecification(int level) const {
+  return peano::MappingSpecification( peano::MappingSpecification::WholeTree, peano::MappingSpecification::RunConcurrentlyOnFineGrid, false );
+}
+
+
+peano::MappingSpecification peano::grid::benchmarks::SyntheticEventHandle::ascendSpecification(int level) const {
+  return peano::MappingSpecification( peano::MappingSpecification::WholeTree, peano::MappingSpecification::RunConcurrentlyOnFineGrid, false );
+}
+
+
+peano::MappingSpecification peano::grid::benchmarks::SyntheticEventHandle::descendSpecification(int level) const {
+  return peano::MappingSpecification( peano::MappingSpecification::WholeTree, peano::MappingSpecification::RunConcurrentlyOnFineGrid, false );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::createHangingVertex(
+  SyntheticVertex&                              fineGridVertex,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+) {
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::destroyHangingVertex(
+  const SyntheticVertex&                        fineGridVertex,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+) {
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::createInnerVertex(
+  SyntheticVertex&                              fineGridVertex,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+) {
+  refineIfRequired( fineGridVertex, fineGridX, coarseGridVerticesEnumerator );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::createBoundaryVertex(
+  SyntheticVertex&                              fineGridVertex,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+) {
+  refineIfRequired( fineGridVertex, fineGridX, coarseGridVerticesEnumerator );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::destroyVertex(
+  const SyntheticVertex&                        fineGridVertex,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+) {
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::createCell(
+  SyntheticCell&                                fineGridCell,
+  SyntheticVertex * const                       fineGridVertices,
+  const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfCell
+) {
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::destroyCell(
+  const SyntheticCell&                          fineGridCell,
+  SyntheticVertex * const                       fineGridVertices,
+  const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfCell
+) {
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::touchVertexFirstTime(
+  SyntheticVertex&                              fineGridVertex,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+) {
+  refineIfRequired( fineGridVertex, fineGridX, coarseGridVerticesEnumerator );
+  doWork( fineGridX );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::touchVertexLastTime(
+  SyntheticVertex&                              fineGridVertex,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+  const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+) {
+  doWork( fineGridX );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::enterCell(
+  SyntheticCell&                                fineGridCell,
+  SyntheticVertex * const                       fineGridVertices,
+  const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfCell
+) {
+  doWork( fineGridVerticesEnumerator.getCellCenter() );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::leaveCell(
+  SyntheticCell&                                fineGridCell,
+  SyntheticVertex * const                       fineGridVertices,
+  const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell,
+  const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfCell
+) {
+  doWork( fineGridVerticesEnumerator.getCellCenter() );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::beginIteration( SyntheticState& solverState ) {
+  _checksum = 0.0;
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::endIteration( SyntheticState& solverState ) {
+  logDebug( "endIteration(State)", "checksum=" << _checksum );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::descend(
+  SyntheticCell * const                         fineGridCells,
+  SyntheticVertex * const                       fineGridVertices,
+  const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell
+) {
+  doWork( coarseGridVerticesEnumerator.getCellCenter() );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::ascend(
+  SyntheticCell * const                         fineGridCells,
+  SyntheticVertex * const                       fineGridVertices,
+  const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+  SyntheticVertex * const                       coarseGridVertices,
+  const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+  SyntheticCell&                                coarseGridCell
+) {
+  doWork( coarseGridVerticesEnumerator.getCellCenter() );
+}
+
+
+void peano::grid::benchmarks::SyntheticEventHandle::mergeWithWorkerThread( const SyntheticEventHandle& workerThread ) {
+  _checksum += workerThread._checksum;
+}
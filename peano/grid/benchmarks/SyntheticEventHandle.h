@@ -0,0 +1,315 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_GRID_BENCHMARKS_SYNTHETIC_EVENT_HANDLE_H_
+#define _PEANO_GRID_BENCHMARKS_SYNTHETIC_EVENT_HANDLE_H_
+
+
+#include "tarch/logging/Log.h"
+#include "tarch/la/Vector.h"
+
+#include "peano/utils/Globals.h"
+#include "peano/MappingSpecification.h"
+#include "peano/CommunicationSpecification.h"
+
+#include "peano/grid/Vertex.h"
+#include "peano/grid/Cell.h"
+#include "peano/grid/State.h"
+#include "peano/grid/VertexEnumerator.h"
+#include "peano/grid/tests/records/TestVertex.h"
+#include "peano/grid/tests/records/TestCell.h"
+#include "peano/grid/tests/records/TestState.h"
+
+
+namespace peano {
+  namespace grid {
+    namespace benchmarks {
+      class SyntheticEventHandle;
+      class SyntheticVertex;
+      class SyntheticCell;
+      class SyntheticStateRecord;
+      class SyntheticState;
+    }
+  }
+}
+
+
+/**
+ * The grid's vertex, cell and state have protected constructors, as each
+ * application is supposed to derive its own classes from them. So do we.
+ */
+class peano::grid::benchmarks::SyntheticVertex: public peano::grid::Vertex<peano::grid::tests::records::TestVertex> {
+  private:
+    typedef peano::grid::Vertex<peano::grid::tests::records::TestVertex>  Base;
+  public:
+    SyntheticVertex();
+    SyntheticVertex(const Base::DoNotCallStandardConstructor&);
+    SyntheticVertex(const Base::PersistentVertex& argument);
+};
+
+
+class peano::grid::benchmarks::SyntheticCell: public peano::grid::Cell<peano::grid::tests::records::TestCell> {
+  private:
+    typedef peano::grid::Cell<peano::grid::tests::records::TestCell>  Base;
+  public:
+    SyntheticCell();
+    SyntheticCell(const Base::DoNotCallStandardConstructor&);
+    SyntheticCell(const Base::PersistentCell& argument);
+};
+
+
+/**
+ * The test state records have been generated before the kernel's state got
+ * the hasModifiedGridInPreviousIteration flag. We add the flag by hand, as we
+ * cannot regenerate the records without DaStGen. The flag is neither packed
+ * nor exchanged via MPI, which is fine for a shared memory benchmark.
+ *
+ * The same holds for the two flags the MPI parallelisation of the state
+ * requires. They allow the kernel's tests to instantiate the state with
+ * -DParallel, but they are not exchanged between ranks.
+ */
+class peano::grid::benchmarks::SyntheticStateRecord: public peano::grid::tests::records::TestState {
+  private:
+    bool  _hasModifiedGridInPreviousIteration;
+    bool  _couldNotEraseDueToDecompositionFlag;
+    bool  _subWorkerIsInvolvedInJoinOrFork;
+  public:
+    SyntheticStateRecord();
+    SyntheticStateRecord(const PersistentRecords& persistentRecords);
+    SyntheticStateRecord(const peano::grid::tests::records::TestState& record);
+
+    bool getHasModifiedGridInPreviousIteration() const;
+    void setHasModifiedGridInPreviousIteration(const bool& hasModifiedGridInPreviousIteration);
+
+    bool getCouldNotEraseDueToDecompositionFlag() const;
+    void setCouldNotEraseDueToDecompositionFlag(const bool& couldNotEraseDueToDecompositionFlag);
+
+    bool getSubWorkerIsInvolvedInJoinOrFork() const;
+    void setSubWorkerIsInvolvedInJoinOrFork(const bool& subWorkerIsInvolvedInJoinOrFork);
+};
+
+
+class peano::grid::benchmarks::SyntheticState: public peano::grid::State<peano::grid::benchmarks::SyntheticStateRecord> {
+  private:
+    typedef peano::grid::State<peano::grid::benchmarks::SyntheticStateRecord>  Base;
+  public:
+    SyntheticState();
+    SyntheticState(const Base::PersistentState& argument);
+};
+
+
+/**
+ * Event handle for synthetic benchmarks
+ *
+ * This event handle does not solve anything. It builds up a grid on the
+ * grid's test records and then keeps it. Each event does a little bit of
+ * arithmetics per vertex or cell (workload) such that the traversal is not
+ * purely memory-bound. With a workload of zero, the events are empty and you
+ * measure the kernel only.
+ *
+ * <h2> Grid </h2>
+ *
+ * - Regular: All vertices are refined until the fine grid level equals the
+ *   depth.
+ * - Adaptive: The first two levels are refined everywhere. Below, we refine
+ *   only around a sphere with radius 0.25 around the domain's centre. So the
+ *   grid has both regular subtrees and hanging vertices.
+ *
+ * All events may run concurrently, i.e. the benchmark imposes no
+ * restrictions on the kernel's parallelisation.
+ */
+class peano::grid::benchmarks::SyntheticEventHandle {
+  private:
+    static tarch::logging::Log  _log;
+
+    /**
+     * The grid default-constructs its event handle, so the grid parameters
+     * are static. See configure().
+     */
+    static int   _depth;
+    static bool  _adaptive;
+    static int   _workload;
+
+    /**
+     * Result of the dummy arithmetics. We only keep it so the compiler cannot
+     * optimise the workload away.
+     */
+    double  _checksum;
+
+    bool shallRefine( const tarch::la::Vector<DIMENSIONS,double>& x, int level ) const;
+
+    void refineIfRequired(
+      SyntheticVertex&                              fineGridVertex,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator
+    );
+
+    void doWork( const tarch::la::Vector<DIMENSIONS,double>& x );
+  public:
+    /**
+     * Set the grid parameters for all event handles. Call it before you
+     * create the grid.
+     *
+     * @param depth    Finest level of the grid. The root cell has level 0.
+     * @param adaptive Build an adaptive instead of a regular grid.
+     * @param workload Number of dummy operations per event.
+     */
+    static void configure(int depth, bool adaptive, int workload);
+
+    SyntheticEventHandle();
+
+    /**
+     * Copy constructor for the thread-local copies. The copy starts with a
+     * zero checksum, as mergeWithWorkerThread() adds the copy's checksum to
+     * the master's one.
+     */
+    SyntheticEventHandle(const SyntheticEventHandle& masterThread);
+
+    double getChecksum() const;
+
+    peano::CommunicationSpecification   communicationSpecification() const;
+    peano::MappingSpecification         touchVertexLastTimeSpecification(int level) const;
+    peano::MappingSpecification         touchVertexFirstTimeSpecification(int level) const;
+    peano::MappingSpecification         enterCellSpecification(int level) const;
+    peano::MappingSpecification         leaveCellSpecification(int level) const;
+    peano::MappingSpecification         ascendSpecification(int level) const;
+    peano::MappingSpecification         descendSpecification(int level) const;
+
+    void createHangingVertex(
+      SyntheticVertex&                              fineGridVertex,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+    );
+
+    void destroyHangingVertex(
+      const SyntheticVertex&                        fineGridVertex,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+    );
+
+    void createInnerVertex(
+      SyntheticVertex&                              fineGridVertex,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+    );
+
+    void createBoundaryVertex(
+      SyntheticVertex&                              fineGridVertex,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+    );
+
+    void destroyVertex(
+      const SyntheticVertex&                        fineGridVertex,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+    );
+
+    void createCell(
+      SyntheticCell&                                fineGridCell,
+      SyntheticVertex * const                       fineGridVertices,
+      const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfCell
+    );
+
+    void destroyCell(
+      const SyntheticCell&                          fineGridCell,
+      SyntheticVertex * const                       fineGridVertices,
+      const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfCell
+    );
+
+    void touchVertexFirstTime(
+      SyntheticVertex&                              fineGridVertex,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+    );
+
+    void touchVertexLastTime(
+      SyntheticVertex&                              fineGridVertex,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+      const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+    );
+
+    void enterCell(
+      SyntheticCell&                                fineGridCell,
+      SyntheticVertex * const                       fineGridVertices,
+      const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfCell
+    );
+
+    void leaveCell(
+      SyntheticCell&                                fineGridCell,
+      SyntheticVertex * const                       fineGridVertices,
+      const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell,
+      const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfCell
+    );
+
+    void beginIteration( SyntheticState& solverState );
+    void endIteration( SyntheticState& solverState );
+
+    void descend(
+      SyntheticCell * const                         fineGridCells,
+      SyntheticVertex * const                       fineGridVertices,
+      const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell
+    );
+
+    void ascend(
+      SyntheticCell * const                         fineGridCells,
+      SyntheticVertex * const                       fineGridVertices,
+      const peano::grid::VertexEnumerator&          fineGridVerticesEnumerator,
+      SyntheticVertex * const                       coarseGridVertices,
+      const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+      SyntheticCell&                                coarseGridCell
+    );
+
+    /**
+     * Event handles are copied per thread. We only accumulate the checksum.
+     */
+    void mergeWithWorkerThread( const SyntheticEventHandle& workerThread );
+};
+
+
+#endif
@@ -76,6 +76,18 @@ class peano::grid::nodes::Leaf: public peano::grid::nodes::Node<Vertex,Cell,Stat
       int                                       counter[FOUR_POWER_D]
     );
 
+    /**
+     * Does traverse() refine the leaf?
+     *
+     * If this operation returns false, traverse() solely invokes the enter
+     * and leave cell events and neither touches any stack nor the refined
+     * node.
+     */
+    static bool refinesInTraversal(
+      Vertex* const                 fineGridVertices,
+      const SingleLevelEnumerator&  fineGridVerticesEnumerator
+    );
+
     /**
      * Traverse the Leaf
      *
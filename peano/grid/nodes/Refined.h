@@ -7,8 +7,10 @@
 #include "peano/utils/Globals.h"
 #include "peano/grid/SingleLevelEnumerator.h"
 #include "peano/grid/nodes/Node.h"
+#include "peano/grid/nodes/loops/TraverseLeafSiblingsLoopBody.h"
 
 #include <bitset>
+#include <vector>
 
 
 
@@ -38,6 +40,7 @@ class peano::grid::nodes::Refined: public peano::grid::nodes::Node<Vertex,Cell,S
     typedef peano::grid::nodes::RegularRefined<Vertex,Cell,State,VertexStack,CellStack,EventHandle>     RegularRefinedNode;
 
     typedef peano::grid::RegularGridContainer<Vertex,Cell>                                    RegularGridContainer;
+    typedef peano::grid::nodes::loops::TraverseLeafSiblingsLoopBody<Vertex,Cell,State,EventHandle>   LeafSiblingsLoopBody;
 
     static tarch::logging::Log _log;
 
@@ -126,6 +129,38 @@ class peano::grid::nodes::Refined: public peano::grid::nodes::Node<Vertex,Cell,S
       Cell                   newFineGridCells[THREE_POWER_D],
       Vertex                 fineGridVertices[FOUR_POWER_D]
     ) const;
+    /**
+     * Traverse the leaf children of a refined cell concurrently
+     *
+     * This is a micro-optimisation for refined cells whose children all are
+     * leaves. Refined siblings, i.e. real subtrees, are always traversed one
+     * after another, as their concurrent traversal would require to split
+     * the shared stacks into segments per sibling.
+     *
+     * If all @f$ 3^d @f$ children are leaves that are not refined in this
+     * traversal, their traversal does not touch any stack, as descend() loads
+     * all their vertices before and stores them after the children's
+     * traversal. The children's enter and leave cell events then can run
+     * concurrently. See TraverseLeafSiblingsLoopBody for the colouring. We
+     * ask the oracle through
+     * MethodTrace::TraverseLeafSiblingsConcurrently whether to do
+     * so, i.e. the default oracle keeps the sequential traversal.
+     *
+     * The concurrent traversal is not available with TrackGridStatistics, as
+     * the leaves then update the state.
+     *
+     * @return Have the children been traversed? If not, the caller has to
+     *         traverse them one by one.
+     */
+    bool traverseLeafSiblingsConcurrently(
+      State&                                    state,
+      Cell&                                     fineGridCell,
+      Vertex                                    fineGridVertices[FOUR_POWER_D],
+      const SingleLevelEnumerator&              fineGridVerticesEnumerator,
+      Cell                                      descendingFineGridCells[THREE_POWER_D],
+      std::vector< SingleLevelEnumerator >&     descendingGridEnumerator,
+      Vertex*                                   descendingGridVertices
+    );
   public:
     Refined(
       VertexStack&                vertexStack,
@@ -203,6 +238,9 @@ class peano::grid::nodes::Refined: public peano::grid::nodes::Node<Vertex,Cell,S
      * - Load all the vertices of the @f$ 3^d @f$ subcells and see whether we
      *   can modify (restrict) the vertex enumerators' flags (for example find
      *   out whether a subcell is a regular refined grid).
+     * - Traverse the subcells. If all of them are leaves, this might happen
+     *   concurrently (see traverseLeafSiblingsConcurrently()). Otherwise, the
+     *   subcells are traversed one after another.
      *
      * !!! Visibility
      *
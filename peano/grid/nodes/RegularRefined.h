@@ -221,6 +221,29 @@ class peano::grid::nodes::RegularRefined: public peano::grid::nodes::Node<Vertex
      * return typically 0 if the grain size equals the maximum problem size.
      *
      *
+     * <h2>Fused sweeps</h2>
+     *
+     * If a subtree is held persistently and all events support subpatch
+     * fusion (see MappingSpecification), descend and ascend of this visit
+     * are realised by one FusedDescendAndAscend task. We never fuse the
+     * ascend of one traversal with the descend of the next one.
+     *
+     *
+     * <h2>Asynchronous stores</h2>
+     *
+     * If a subtree is not held persistently and the code is translated with
+     * AsynchronousStoresOnRegularSubtrees, the store tasks forked by
+     * StoreVerticesOnRegularRefinedPatch continue to run in the background
+     * once we return. They only read the regular grid container and write
+     * into blocks on the output stack that are reserved already. We
+     * therefore wait for them when we enter the next regular subtree. The
+     * vertex stack in turn waits before it reallocates or flips the output
+     * stack. It does not know the task system, so the constructor hands it
+     * an operation that processes store tasks while it waits. To make
+     * reallocations unlikely, we reserve space for the whole input stack on
+     * the output stack.
+     *
+     *
      * <h2>Drain regular subtrees</h2>
      *
      * If we drain a regular subtree in the parallel mode, we have to
@@ -0,0 +1,131 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_GRID_NODES_LOOPS_ASCEND_SUBPATCH_LOOP_BODY_H_
+#define _PEANO_GRID_NODES_LOOPS_ASCEND_SUBPATCH_LOOP_BODY_H_
+
+
+#include "tarch/logging/Log.h"
+#include "tarch/multicore/MulticoreDefinitions.h"
+
+#include "peano/utils/Globals.h"
+
+#include "peano/MappingSpecification.h"
+#include "peano/grid/RegularGridContainer.h"
+
+#include "peano/grid/nodes/loops/CallLeaveCellLoopBodyOnRegularRefinedPatch.h"
+#include "peano/grid/nodes/loops/CallTouchVertexLastTimeLoopBodyOnRegularRefinedPatch.h"
+#include "peano/grid/nodes/loops/CallAscendLoopBodyOnRegularRefinedPatch.h"
+
+
+#include <memory>
+#include <vector>
+
+
+namespace peano {
+  namespace grid {
+    namespace nodes {
+      namespace loops {
+        template <class Vertex, class Cell, class State, class EventHandle>
+        class AscendSubpatchLoopBody;
+      }
+    }
+  }
+}
+
+
+
+
+/**
+ * Ascend through all levels of one subpatch
+ *
+ * Counterpart of DescendSubpatchLoopBody: operator() runs leaveCell(),
+ * ascend() and touchVertexLastTime() on all levels of one subpatch from the
+ * finest level up to the level right below the subpatch level. The Ascend
+ * task runs the loop body with a 2^d colouring, too.
+ *
+ * A vertex on a subpatch interface may be touched the last time only once
+ * all adjacent subpatches have left their cells. We therefore count the
+ * visits and call the event (or the plain vertex transition if the event is
+ * switched off) for the last subpatch that visits the vertex. How many
+ * subpatches share a vertex follows from its position. The Ascend task
+ * releases the affected levels to the store process once all subpatches have
+ * terminated.
+ */
+template <class Vertex, class Cell, class State, class EventHandle>
+class peano::grid::nodes::loops::AscendSubpatchLoopBody {
+  private:
+    static tarch::logging::Log _log;
+
+    typedef peano::grid::nodes::loops::CallLeaveCellLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>             LeaveCellLoopBody;
+    typedef peano::grid::nodes::loops::CallTouchVertexLastTimeLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>   TouchVertexLastTimeLoopBody;
+    typedef peano::grid::nodes::loops::CallAscendLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>                AscendLoopBody;
+
+    const int                                        _treeDepth;
+    const int                                        _subpatchLevel;
+
+    peano::grid::RegularGridContainer<Vertex,Cell>&  _regularGridContainer;
+
+    /**
+     * Shared among all threads. See CallTouchVertexLastTimeLoopBodyOnRegularRefinedPatch.
+     */
+    bool&                                            _treeRemainsStatic;
+
+    /**
+     * Per level (index is level minus subpatch level minus one). An entry is
+     * nullptr if the respective event is not to be called on this level.
+     */
+    std::vector< std::unique_ptr<LeaveCellLoopBody> >             _leaveCellLoopBodies;
+    std::vector< std::unique_ptr<AscendLoopBody> >                _ascendLoopBodies;
+    std::vector< std::unique_ptr<TouchVertexLastTimeLoopBody> >   _touchVertexLastTimeLoopBodies;
+
+    /**
+     * Number of subpatches that have visited a vertex so far. One vector per
+     * level below the subpatch level. Shared among all copies.
+     */
+    std::shared_ptr< std::vector< std::vector<unsigned char> > >  _numberOfVisits;
+
+    static bool isEventCalled(const peano::MappingSpecification& specification, int level, int treeDepth);
+
+    /**
+     * Number of subpatches that hold a vertex on a given level.
+     */
+    int getNumberOfAdjacentSubpatches(const tarch::la::Vector<DIMENSIONS, int>& vertex, int level) const;
+  public:
+    /**
+     * All events on the levels below the subpatch level have to allow for a
+     * concurrent invocation. We do not distinguish the different types of
+     * concurrency, as the colouring of the subpatches ensures that no two
+     * subpatches running in parallel share any vertex or cell on the subpatch
+     * level or below. The coarser levels are not accessed at all.
+     */
+    static bool mayRunSubpatchesConcurrently(EventHandle& eventHandle, int treeDepth, int subpatchLevel);
+
+    AscendSubpatchLoopBody(
+      EventHandle&                                     eventHandle,
+      peano::grid::RegularGridContainer<Vertex,Cell>&  regularGridContainer,
+      bool&                                            treeRemainsStatic,
+      int                                              treeDepth,
+      int                                              subpatchLevel
+    );
+
+    AscendSubpatchLoopBody( const AscendSubpatchLoopBody& copy );
+
+    ~AscendSubpatchLoopBody() = default;
+
+    /**
+     * @see CallTouchVertexLastTimeLoopBodyOnRegularRefinedPatch::mergeIntoMasterThread()
+     */
+    void mergeIntoMasterThread() const;
+
+    /**
+     * @param subpatch Position of the subpatch's root cell on the subpatch
+     *                 level.
+     */
+    void operator() (const tarch::la::Vector<DIMENSIONS, int>& subpatch);
+};
+
+
+#include "peano/grid/nodes/loops/AscendSubpatchLoopBody.cpph"
+
+
+#endif
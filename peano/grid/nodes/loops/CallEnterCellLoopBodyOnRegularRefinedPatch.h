@@ -13,6 +13,9 @@
 #include "peano/datatraversal/Action.h"
 #include "peano/grid/RegularGridContainer.h"
 
+#include <memory>
+#include <utility>
+
 
 namespace peano {
   namespace grid {
@@ -52,25 +55,83 @@ class peano::grid::nodes::loops::CallEnterCellLoopBodyOnRegularRefinedPatch {
 
     const int                                        _level;
 
-    #if defined(SharedMemoryParallelisation)
     EventHandle&                                                _eventHandle;
-    EventHandle                                                 _threadLocalEventHandle;
-    #else
-    EventHandle&                                                _eventHandle;
-    EventHandle&                                                _threadLocalEventHandle;
+
+    /**
+     * If the event alters the state, every loop body copy works on a copy
+     * of the event handle of its own which is merged back in
+     * mergeIntoMasterThread(). Otherwise, all loop bodies work directly on
+     * _eventHandle and we do not copy the mapping at all. Mappings that
+     * want to reduce data without altering the state can use
+     * tarch::multicore::Accumulator.
+     */
+    const bool                                                  _altersState;
+
+    #if defined(SharedMemoryParallelisation)
+    std::unique_ptr<EventHandle>                                _threadLocalEventHandleCopy;
     #endif
+    EventHandle&                                                _threadLocalEventHandle;
 
     peano::grid::RegularGridContainer<Vertex,Cell>&  _regularGridContainer;
 
     UnrolledLevelEnumerator  _fineGridEnumerator;
     UnrolledLevelEnumerator  _coarseGridEnumerator;
+
+    /**
+     * @see MappingSpecification
+     */
+    const bool               _invokeBatchedEvents;
+
+    /**
+     * Invoke enterCell for one fine grid cell if the cell is inside.
+     */
+    void invokeEvent(const tarch::la::Vector<DIMENSIONS, int>& i);
+
+    /**
+     * Split the row of cells starting at firstCellOfRow into maximal ranges
+     * of inside cells and hand each range over to invokeBatchedEvent().
+     */
+    void invokeBatchedEvents(const tarch::la::Vector<DIMENSIONS, int>& firstCellOfRow);
+
+    /**
+     * Invoke the event handle's enterCells() for numberOfCells cells along
+     * the x-axis starting with firstCell. This overload is chosen if the
+     * event handle provides enterCells().
+     */
+    template <class Handle>
+    auto invokeBatchedEvent(Handle& eventHandle, const tarch::la::Vector<DIMENSIONS, int>& firstCell, int numberOfCells, int)
+      -> decltype( eventHandle.enterCells(
+        static_cast<Cell*>(nullptr), static_cast<Vertex*>(nullptr), std::declval<const UnrolledLevelEnumerator&>(),
+        static_cast<Vertex*>(nullptr), std::declval<const UnrolledLevelEnumerator&>(), static_cast<Cell*>(nullptr), 0, 0
+      ), void() );
+
+    /**
+     * Fallback if the event handle does not provide enterCells(): We invoke
+     * enterCell() cell by cell.
+     */
+    template <class Handle>
+    void invokeBatchedEvent(Handle& eventHandle, const tarch::la::Vector<DIMENSIONS, int>& firstCell, int numberOfCells, long);
   public:
+    /**
+     * @param invokeBatchedEvents If set, the loop body has to be used with
+     *          the range returned by getBatchedRange(), and each invocation
+     *          processes one row of cells along the x-axis.
+     */
     CallEnterCellLoopBodyOnRegularRefinedPatch(
       EventHandle&                                     eventHandle,
       peano::grid::RegularGridContainer<Vertex,Cell>&  regularGridContainer,
-      int                                              level
+      int                                              level,
+      bool                                             altersState,
+      bool                                             invokeBatchedEvents = false
     );
 
+    /**
+     * The cells of one level are stored x-fastest. With batched events, the
+     * loop body handles whole rows along the x-axis, so we collapse the
+     * range's first entry.
+     */
+    static tarch::la::Vector<DIMENSIONS, int> getBatchedRange(const tarch::la::Vector<DIMENSIONS, int>& numberOfCells);
+
     /**
      * Copy constructor.
      */
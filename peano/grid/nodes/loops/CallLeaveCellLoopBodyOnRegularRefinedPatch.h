@@ -13,6 +13,8 @@
 #include "peano/datatraversal/Action.h"
 #include "peano/grid/RegularGridContainer.h"
 
+#include <memory>
+
 
 namespace peano {
   namespace grid {
@@ -53,13 +55,22 @@ class peano::grid::nodes::loops::CallLeaveCellLoopBodyOnRegularRefinedPatch {
 
     const int                                        _level;
 
-    #if defined(SharedMemoryParallelisation)
     EventHandle&                                                _eventHandle;
-    EventHandle                                                 _threadLocalEventHandle;
-    #else
-    EventHandle&                                                _eventHandle;
-    EventHandle&                                                _threadLocalEventHandle;
+
+    /**
+     * If the event alters the state, every loop body copy works on a copy
+     * of the event handle of its own which is merged back in
+     * mergeIntoMasterThread(). Otherwise, all loop bodies work directly on
+     * _eventHandle and we do not copy the mapping at all. Mappings that
+     * want to reduce data without altering the state can use
+     * tarch::multicore::Accumulator.
+     */
+    const bool                                                  _altersState;
+
+    #if defined(SharedMemoryParallelisation)
+    std::unique_ptr<EventHandle>                                _threadLocalEventHandleCopy;
     #endif
+    EventHandle&                                                _threadLocalEventHandle;
 
     peano::grid::RegularGridContainer<Vertex,Cell>&  _regularGridContainer;
 
@@ -71,7 +82,12 @@ class peano::grid::nodes::loops::CallLeaveCellLoopBodyOnRegularRefinedPatch {
     CallLeaveCellLoopBodyOnRegularRefinedPatch(
       EventHandle&                                      eventHandle,
       peano::grid::RegularGridContainer<Vertex,Cell>&   regularGridContainer,
-      int                                               level
+      int                                               level,
+      bool                                              altersState
+    );
+
+    CallLeaveCellLoopBodyOnRegularRefinedPatch(
+      const CallLeaveCellLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>&  copy
     );
 
     ~CallLeaveCellLoopBodyOnRegularRefinedPatch() = default;
@@ -13,6 +13,8 @@
 #include "peano/datatraversal/Action.h"
 #include "peano/grid/RegularGridContainer.h"
 
+#include <utility>
+
 
 namespace peano {
   namespace grid {
@@ -65,13 +67,61 @@ class peano::grid::nodes::loops::CallTouchVertexFirstTimeLoopBodyOnRegularRefine
     UnrolledLevelEnumerator  _fineGridEnumerator;
     UnrolledLevelEnumerator  _coarseGridEnumerator;
 
+    /**
+     * @see MappingSpecification
+     */
+    const bool               _invokeBatchedEvents;
+
+    /**
+     * Invoke touchVertexFirstTime for one fine grid vertex if the vertex is
+     * not outside and not read from a temporary stack.
+     */
+    void invokeEvent(const tarch::la::Vector<DIMENSIONS, int>& i);
+
+    /**
+     * Split the row of vertices starting at firstVertexOfRow into maximal
+     * ranges of vertices that are neither outside nor read from a temporary
+     * stack, and hand each range over to invokeBatchedEvent().
+     */
+    void invokeBatchedEvents(const tarch::la::Vector<DIMENSIONS, int>& firstVertexOfRow);
+
+    /**
+     * Invoke the event handle's touchVerticesFirstTime() for numberOfVertices
+     * vertices along the x-axis starting with firstVertex. This overload is
+     * chosen if the event handle provides touchVerticesFirstTime().
+     */
+    template <class Handle>
+    auto invokeBatchedEvent(Handle& eventHandle, const tarch::la::Vector<DIMENSIONS, int>& firstVertex, int numberOfVertices, int)
+      -> decltype( eventHandle.touchVerticesFirstTime(
+        static_cast<Vertex*>(nullptr), std::declval<const UnrolledLevelEnumerator&>(),
+        static_cast<Vertex*>(nullptr), std::declval<const UnrolledLevelEnumerator&>(), static_cast<Cell*>(nullptr), 0, 0
+      ), void() );
+
+    /**
+     * Fallback if the event handle does not provide touchVerticesFirstTime():
+     * We invoke touchVertexFirstTime() vertex by vertex.
+     */
+    template <class Handle>
+    void invokeBatchedEvent(Handle& eventHandle, const tarch::la::Vector<DIMENSIONS, int>& firstVertex, int numberOfVertices, long);
+
   public:
+    /**
+     * @param invokeBatchedEvents If set, the loop body has to be used with
+     *          the range returned by getBatchedRange(), and each invocation
+     *          processes one row of vertices along the x-axis.
+     */
     CallTouchVertexFirstTimeLoopBodyOnRegularRefinedPatch(
       EventHandle&                                     eventHandle,
       peano::grid::RegularGridContainer<Vertex,Cell>&  regularGridContainer,
-      int                                              level
+      int                                              level,
+      bool                                             invokeBatchedEvents = false
     );
 
+    /**
+     * @see CallEnterCellLoopBodyOnRegularRefinedPatch::getBatchedRange()
+     */
+    static tarch::la::Vector<DIMENSIONS, int> getBatchedRange(const tarch::la::Vector<DIMENSIONS, int>& numberOfVertices);
+
     /**
      * Copy constructor
      *
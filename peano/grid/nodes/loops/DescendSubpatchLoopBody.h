@@ -0,0 +1,161 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_GRID_NODES_LOOPS_DESCEND_SUBPATCH_LOOP_BODY_H_
+#define _PEANO_GRID_NODES_LOOPS_DESCEND_SUBPATCH_LOOP_BODY_H_
+
+
+#include "tarch/logging/Log.h"
+#include "tarch/multicore/MulticoreDefinitions.h"
+
+#include "peano/utils/Globals.h"
+
+#include "peano/MappingSpecification.h"
+#include "peano/grid/RegularGridContainer.h"
+
+#include "peano/grid/nodes/loops/CallEnterCellLoopBodyOnRegularRefinedPatch.h"
+#include "peano/grid/nodes/loops/CallTouchVertexFirstTimeLoopBodyOnRegularRefinedPatch.h"
+#include "peano/grid/nodes/loops/CallDescendLoopBodyOnRegularRefinedPatch.h"
+
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+namespace peano {
+  namespace grid {
+    namespace nodes {
+      namespace loops {
+        template <class Vertex, class Cell, class State, class EventHandle>
+        class DescendSubpatchLoopBody;
+      }
+    }
+  }
+}
+
+
+
+
+/**
+ * Descend through all levels of one subpatch
+ *
+ * The Descend task usually runs through a regular subtree level by level and
+ * issues one parallel loop per level and event type. On deep trees, this
+ * yields many short parallel sections with a synchronisation in-between, and
+ * every level streams through the whole data of the level before we continue
+ * with the next finer one.
+ *
+ * This loop body realises an alternative multilevel decomposition: Each cell
+ * on a fixed subpatch level spans a subtree of its own. The loop body's
+ * operator() takes the position of such a cell and runs all descending
+ * events of the levels below this cell, i.e. touchVertexFirstTime(),
+ * descend() and enterCell(), in the same order as the level-wise traversal.
+ * The subpatch is handled as one task and its data remains in the caches
+ * while we descend.
+ *
+ * <h2> Dependencies at the subpatch interfaces </h2>
+ *
+ * Neighbouring subpatches share the vertices along their interface on all
+ * levels. The Descend task thus runs the loop body with a 2^d colouring:
+ * Subpatches of the same colour do not share any vertex and may run
+ * concurrently. Subpatches of different colours run one after another. A
+ * shared vertex is touched by the first subpatch that reaches it, i.e. we
+ * count how many subpatches have visited each vertex so far. The counters are
+ * shared by all copies of the loop body. As no two subpatches of one colour
+ * share a vertex, the counters need no lock.
+ *
+ * Due to the colouring, a touchVertexFirstTime() might be called before all
+ * coarse cells adjacent to the vertex have been entered. This is exactly what
+ * happens in a standard depth-first traversal, too. The events on the
+ * subpatch level and coarser, however, remain in the level-wise loops of the
+ * Descend task.
+ *
+ * <h2> Overlap with the load process </h2>
+ *
+ * If the load process runs in parallel, the finer levels of the subtree might
+ * not be available yet when the subpatch tasks are spawned. Each subpatch
+ * therefore waits for a level right before it runs the events of this level.
+ * The subpatches thus start on the coarse levels while the load process still
+ * fills the finer ones. The wait is passed in by the Descend task, as the
+ * loop body itself does not know whether the load runs in parallel.
+ *
+ * <h2> Thread-local data </h2>
+ *
+ * The loop body holds one instance of the standard loop bodies per level.
+ * Each of them holds a thread-local copy of the event handle. Each copy of
+ * the present loop body thus copies the event handle once per level and
+ * event type. mergeIntoMasterThread() hands on to all these loop bodies.
+ */
+template <class Vertex, class Cell, class State, class EventHandle>
+class peano::grid::nodes::loops::DescendSubpatchLoopBody {
+  private:
+    static tarch::logging::Log _log;
+
+    typedef peano::grid::nodes::loops::CallEnterCellLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>              EnterCellLoopBody;
+    typedef peano::grid::nodes::loops::CallTouchVertexFirstTimeLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>   TouchVertexFirstTimeLoopBody;
+    typedef peano::grid::nodes::loops::CallDescendLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>                DescendLoopBody;
+
+    const int                                        _treeDepth;
+    const int                                        _subpatchLevel;
+
+    peano::grid::RegularGridContainer<Vertex,Cell>&  _regularGridContainer;
+
+    /**
+     * Blocks until a level is loaded. Is invoked with the level as argument.
+     */
+    const std::function<void(int)>                   _waitUntilLevelIsInitialised;
+
+    /**
+     * Per level (index is level minus subpatch level minus one). An entry is
+     * nullptr if the respective event is not to be called on this level.
+     */
+    std::vector< std::unique_ptr<TouchVertexFirstTimeLoopBody> >  _touchVertexFirstTimeLoopBodies;
+    std::vector< std::unique_ptr<DescendLoopBody> >               _descendLoopBodies;
+    std::vector< std::unique_ptr<EnterCellLoopBody> >             _enterCellLoopBodies;
+
+    /**
+     * Number of subpatches that have visited a vertex so far. One vector per
+     * level below the subpatch level. Shared among all copies.
+     */
+    std::shared_ptr< std::vector< std::vector<unsigned char> > >  _numberOfVisits;
+
+    static bool isEventCalled(const peano::MappingSpecification& specification, int level, int treeDepth);
+  public:
+    /**
+     * All events on the levels below the subpatch level have to allow for a
+     * concurrent invocation. We do not distinguish the different types of
+     * concurrency, as the colouring of the subpatches ensures that no two
+     * subpatches running in parallel share any vertex or cell on the subpatch
+     * level or below. The coarser levels are not accessed at all.
+     */
+    static bool mayRunSubpatchesConcurrently(EventHandle& eventHandle, int treeDepth, int subpatchLevel);
+
+    DescendSubpatchLoopBody(
+      EventHandle&                                     eventHandle,
+      peano::grid::RegularGridContainer<Vertex,Cell>&  regularGridContainer,
+      int                                              treeDepth,
+      int                                              subpatchLevel,
+      const std::function<void(int)>&                  waitUntilLevelIsInitialised
+    );
+
+    DescendSubpatchLoopBody( const DescendSubpatchLoopBody& copy );
+
+    ~DescendSubpatchLoopBody() = default;
+
+    /**
+     * @see CallTouchVertexFirstTimeLoopBodyOnRegularRefinedPatch::mergeIntoMasterThread()
+     */
+    void mergeIntoMasterThread() const;
+
+    /**
+     * @param subpatch Position of the subpatch's root cell on the subpatch
+     *                 level.
+     */
+    void operator() (const tarch::la::Vector<DIMENSIONS, int>& subpatch);
+};
+
+
+#include "peano/grid/nodes/loops/DescendSubpatchLoopBody.cpph"
+
+
+#endif
@@ -0,0 +1,102 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_GRID_NODES_LOOPS_FUSED_SUBPATCH_LOOP_BODY_H_
+#define _PEANO_GRID_NODES_LOOPS_FUSED_SUBPATCH_LOOP_BODY_H_
+
+
+#include "tarch/logging/Log.h"
+#include "tarch/multicore/MulticoreDefinitions.h"
+
+#include "peano/utils/Globals.h"
+
+#include "peano/MappingSpecification.h"
+#include "peano/grid/RegularGridContainer.h"
+
+#include "peano/grid/nodes/loops/DescendSubpatchLoopBody.h"
+#include "peano/grid/nodes/loops/AscendSubpatchLoopBody.h"
+
+
+namespace peano {
+  namespace grid {
+    namespace nodes {
+      namespace loops {
+        template <class Vertex, class Cell, class State, class EventHandle>
+        class FusedSubpatchLoopBody;
+      }
+    }
+  }
+}
+
+
+
+
+/**
+ * Descend and ascend through all levels of one subpatch
+ *
+ * Combination of DescendSubpatchLoopBody and AscendSubpatchLoopBody: The
+ * operator() first runs all descending events of a subpatch and then
+ * immediately all its ascending events. Per subpatch, we thus run through the
+ * data once rather than twice, as the subpatch's data remains in the caches
+ * in-between the two sweeps.
+ *
+ * The two sweeps are not separated anymore. A subpatch leaves its cells and
+ * touches its interior vertices the last time before its neighbours have
+ * entered their cells. Vertices shared by several subpatches are touched the
+ * first time by the first subpatch and the last time by the last subpatch
+ * that visits them, so the order per vertex and per cell is preserved. We
+ * fuse only if the mappings declare that all events below the subpatch level
+ * support subpatch fusion (see MappingSpecification). The fusion is confined
+ * to one visit of the subtree, i.e. it never crosses traversals.
+ */
+template <class Vertex, class Cell, class State, class EventHandle>
+class peano::grid::nodes::loops::FusedSubpatchLoopBody {
+  private:
+    static tarch::logging::Log _log;
+
+    typedef peano::grid::nodes::loops::DescendSubpatchLoopBody<Vertex,Cell,State,EventHandle>  DescendLoopBody;
+    typedef peano::grid::nodes::loops::AscendSubpatchLoopBody<Vertex,Cell,State,EventHandle>   AscendLoopBody;
+
+    DescendLoopBody  _descendLoopBody;
+    AscendLoopBody   _ascendLoopBody;
+
+    static bool isEventCalled(const peano::MappingSpecification& specification, int level, int treeDepth);
+  public:
+    /**
+     * All events on the levels below the subpatch level that are actually
+     * called have to support subpatch fusion.
+     */
+    static bool maySweepsBeFused(EventHandle& eventHandle, int treeDepth, int subpatchLevel);
+
+    /**
+     * @see DescendSubpatchLoopBody::mayRunSubpatchesConcurrently()
+     * @see AscendSubpatchLoopBody::mayRunSubpatchesConcurrently()
+     */
+    static bool mayRunSubpatchesConcurrently(EventHandle& eventHandle, int treeDepth, int subpatchLevel);
+
+    FusedSubpatchLoopBody(
+      EventHandle&                                     eventHandle,
+      peano::grid::RegularGridContainer<Vertex,Cell>&  regularGridContainer,
+      bool&                                            treeRemainsStatic,
+      int                                              treeDepth,
+      int                                              subpatchLevel,
+      const std::function<void(int)>&                  waitUntilLevelIsInitialised
+    );
+
+    FusedSubpatchLoopBody( const FusedSubpatchLoopBody& copy ) = default;
+
+    ~FusedSubpatchLoopBody() = default;
+
+    void mergeIntoMasterThread() const;
+
+    /**
+     * @param subpatch Position of the subpatch's root cell on the subpatch
+     *                 level.
+     */
+    void operator() (const tarch::la::Vector<DIMENSIONS, int>& subpatch);
+};
+
+
+#include "peano/grid/nodes/loops/FusedSubpatchLoopBody.cpph"
+
+
+#endif
@@ -0,0 +1,135 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_GRID_NODES_LOOPS_TRAVERSE_LEAF_SIBLINGS_LOOP_BODY_H_
+#define _PEANO_GRID_NODES_LOOPS_TRAVERSE_LEAF_SIBLINGS_LOOP_BODY_H_
+
+
+#include "tarch/logging/Log.h"
+#include "tarch/multicore/BooleanSemaphore.h"
+#include "tarch/multicore/MulticoreDefinitions.h"
+
+#include "peano/utils/Globals.h"
+#include "peano/MappingSpecification.h"
+#include "peano/grid/SingleLevelEnumerator.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace peano {
+  namespace grid {
+    namespace nodes {
+      namespace loops {
+        template <class Vertex, class Cell, class State, class EventHandle>
+        class TraverseLeafSiblingsLoopBody;
+      }
+    }
+  }
+}
+
+
+
+
+/**
+ * Traverse Leaf Siblings Loop Body
+ *
+ * A refined cell whose @f$ 3^d @f$ children are all leaves that are not
+ * refined in this traversal does not need any stack throughout the traversal
+ * of its children: Refined::descend() has loaded all the children's vertices
+ * before it traverses the children, and it stores them only after the last
+ * child has been traversed. In-between, the traversal of a leaf boils down
+ * to an enter cell and a leave cell event. This loop body invokes these two
+ * events for one child, i.e. the children may be traversed concurrently.
+ *
+ * The loop body is a micro-optimisation for refined cells whose children all
+ * are leaves. Refined children remain sequential: They read from and write
+ * to the shared input, output and temporary stacks, and neighbouring
+ * siblings hand over their shared vertices through the temporary stacks. A
+ * concurrent traversal of refined siblings would need stack segments of
+ * their own per sibling, and we do not split the stacks that way.
+ *
+ * <h2> Thread safety </h2>
+ *
+ * The loop body is used only if both the enter and the leave cell
+ * specification allow the kernel to run the events concurrently on the fine
+ * grid. See getColouring(). If one of the events alters the state, every
+ * loop body copy works on an event handle copy of its own that is merged
+ * back in mergeIntoMasterThread(). The loop body never writes to the state,
+ * i.e. it may not be used if the grid statistics are tracked (see
+ * InvokeEnterCell).
+ */
+template <class Vertex, class Cell, class State, class EventHandle>
+class peano::grid::nodes::loops::TraverseLeafSiblingsLoopBody {
+  private:
+    static tarch::logging::Log                 _log;
+
+    /**
+     * Protects the merge of the thread-local event handles.
+     */
+    static tarch::multicore::BooleanSemaphore  _semaphore;
+
+    State&                                                      _state;
+    Cell* const                                                 _fineGridCells;
+    Vertex* const                                               _fineGridVertices;
+    const std::vector< peano::grid::SingleLevelEnumerator >&    _fineGridVerticesEnumerators;
+    Cell&                                                       _coarseGridCell;
+    Vertex* const                                               _coarseGridVertices;
+    const peano::grid::SingleLevelEnumerator&                   _coarseGridVerticesEnumerator;
+
+    EventHandle&                                                _eventHandle;
+    const bool                                                  _altersState;
+
+    #if defined(SharedMemoryParallelisation)
+    std::unique_ptr<EventHandle>                                _threadLocalEventHandleCopy;
+    #endif
+    EventHandle&                                                _threadLocalEventHandle;
+  public:
+    /**
+     * @param fineGridCells               The @f$ 3^d @f$ children.
+     * @param fineGridVertices            The @f$ 4^d @f$ vertices of the children.
+     * @param fineGridVerticesEnumerators One enumerator per child with the
+     *          child's offset already set.
+     */
+    TraverseLeafSiblingsLoopBody(
+      State&                                                    state,
+      Cell* const                                               fineGridCells,
+      Vertex* const                                             fineGridVertices,
+      const std::vector< peano::grid::SingleLevelEnumerator >&  fineGridVerticesEnumerators,
+      Cell&                                                     coarseGridCell,
+      Vertex* const                                             coarseGridVertices,
+      const peano::grid::SingleLevelEnumerator&                 coarseGridVerticesEnumerator,
+      EventHandle&                                              eventHandle,
+      bool                                                      altersState
+    );
+
+    TraverseLeafSiblingsLoopBody( const TraverseLeafSiblingsLoopBody& copy );
+
+    ~TraverseLeafSiblingsLoopBody() = default;
+
+    /**
+     * Map the combined enter and leave cell specification onto a colouring
+     * of the dForLoop over the @f$ 3^d @f$ children.
+     *
+     * All children share the coarse grid cell and its vertices. Neighbouring
+     * children share fine grid vertices. If the events thus have to avoid
+     * coarse grid races or are serial, we return
+     * dForLoop::Serial. AvoidFineGridRaces yields a @f$ 2^d @f$ colouring.
+     */
+    static int getColouring(const peano::MappingSpecification& specification);
+
+    /**
+     * @see CallEnterCellLoopBodyOnRegularRefinedPatch::mergeIntoMasterThread()
+     */
+    void mergeIntoMasterThread() const;
+
+    /**
+     * Invoke enterCell and leaveCell for the child at position k.
+     */
+    void operator() (const tarch::la::Vector<DIMENSIONS, int>& k);
+};
+
+
+#include "peano/grid/nodes/loops/TraverseLeafSiblingsLoopBody.cpph"
+
+
+#endif
@@ -14,6 +14,7 @@
 #include "peano/grid/nodes/loops/CallLeaveCellLoopBodyOnRegularRefinedPatch.h"
 #include "peano/grid/nodes/loops/CallTouchVertexLastTimeLoopBodyOnRegularRefinedPatch.h"
 #include "peano/grid/nodes/loops/CallAscendLoopBodyOnRegularRefinedPatch.h"
+#include "peano/grid/nodes/loops/AscendSubpatchLoopBody.h"
 
 
 namespace peano {
@@ -22,6 +23,9 @@ namespace peano {
       namespace tasks {
         template <class Vertex, class Cell, class State, class EventHandle>
         class Ascend;
+
+        template <class Vertex, class Cell, class State, class EventHandle>
+        class FusedDescendAndAscend;
       }
     }
   }
@@ -32,10 +36,20 @@ namespace peano {
 
 /**
  * Ascend on regular refined subtree
+ *
+ * !!! Multilevel decomposition
+ *
+ * Counterpart of the multilevel decomposition in Descend: If the oracle
+ * returns a non-zero grain size for
+ * MethodTrace::DecomposeAscendIntoMultilevelTasks, all levels below the
+ * subpatch level are handled by one task per subpatch (see
+ * AscendSubpatchLoopBody). Afterwards, we continue level by level.
  */
 template <class Vertex, class Cell, class State, class EventHandle>
 class peano::grid::nodes::tasks::Ascend {
   public:
+    friend class peano::grid::nodes::tasks::FusedDescendAndAscend<Vertex,Cell,State,EventHandle>;
+
     /**
      * @see Destructor of any of the loop bodies.
      */
@@ -46,6 +60,7 @@ class peano::grid::nodes::tasks::Ascend {
     typedef peano::grid::nodes::loops::CallLeaveCellLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>             LeaveCellLoopBody;
     typedef peano::grid::nodes::loops::CallTouchVertexLastTimeLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>   TouchVertexLastTimeLoopBody;
     typedef peano::grid::nodes::loops::CallAscendLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>                AscendLoopBody;
+    typedef peano::grid::nodes::loops::AscendSubpatchLoopBody<Vertex,Cell,State,EventHandle>                                 SubpatchLoopBody;
 
     static tarch::logging::Log  _log;
 
@@ -68,6 +83,29 @@ class peano::grid::nodes::tasks::Ascend {
     void ascend(int fineGridLevel);
     void leaveCells(int level);
 
+    /**
+     * Release the level to the store process and update the statistics.
+     * Invoked once all events on the level have terminated.
+     */
+    void haveCalledAllEventsOnLevel(int level);
+
+    /**
+     * Update the flags of the vertices on the coarsest level and the
+     * statistics. Invoked once all levels have been processed.
+     */
+    void haveCalledAllEventsOnAllLevels();
+
+    /**
+     * Run through the levels finestLevel to 0. On finestLevel, we only leave
+     * the cells.
+     */
+    void ascendLevelByLevel(int finestLevel);
+
+    /**
+     * Run through all levels below subpatchLevel with one task per subpatch.
+     */
+    void ascendSubpatches(int subpatchLevel, int grainSize);
+
     bool mayRunEventsOnMultipleLevelsInParallel(int levelOfTouchLastTime) const;
   public:
     Ascend(
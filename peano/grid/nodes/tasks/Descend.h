@@ -14,6 +14,7 @@
 #include "peano/grid/nodes/loops/CallEnterCellLoopBodyOnRegularRefinedPatch.h"
 #include "peano/grid/nodes/loops/CallTouchVertexFirstTimeLoopBodyOnRegularRefinedPatch.h"
 #include "peano/grid/nodes/loops/CallDescendLoopBodyOnRegularRefinedPatch.h"
+#include "peano/grid/nodes/loops/DescendSubpatchLoopBody.h"
 
 
 namespace peano {
@@ -22,6 +23,9 @@ namespace peano {
       namespace tasks {
         template <class Vertex, class Cell, class State, class EventHandle>
         class Descend;
+
+        template <class Vertex, class Cell, class State, class EventHandle>
+        class FusedDescendAndAscend;
       }
     }
   }
@@ -38,10 +42,24 @@ namespace peano {
  * and cell events are strictly sequential in-between the levels, i.e. these
  * are not tasks that can run in parallel. Only the load and store process can
  * be deployed to an additional thread.
+ *
+ * !!! Multilevel decomposition
+ *
+ * On deep regular subtrees, the task may alternatively cut the tree into
+ * subpatches: Each cell on the subpatch level (half the tree depth) spans a
+ * subtree that is processed through all finer levels as one task. See
+ * DescendSubpatchLoopBody for the dependencies along the subpatch interfaces.
+ * The levels up to the subpatch level are still processed level by level. We
+ * ask the oracle for MethodTrace::DecomposeDescendIntoMultilevelTasks whether
+ * to use the decomposition. A grain size of zero falls back to the level-wise
+ * traversal. The decomposition requires that none of the descending events
+ * below the subpatch level is serial.
  */
 template <class Vertex, class Cell, class State, class EventHandle>
 class peano::grid::nodes::tasks::Descend {
   public:
+    friend class peano::grid::nodes::tasks::FusedDescendAndAscend<Vertex,Cell,State,EventHandle>;
+
     /**
      * @see Destructor of any of the loop bodies.
      */
@@ -52,6 +70,7 @@ class peano::grid::nodes::tasks::Descend {
     typedef peano::grid::nodes::loops::CallEnterCellLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>              EnterCellLoopBody;
     typedef peano::grid::nodes::loops::CallTouchVertexFirstTimeLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>   TouchVertexFirstTimeLoopBody;
     typedef peano::grid::nodes::loops::CallDescendLoopBodyOnRegularRefinedPatch<Vertex,Cell,State,EventHandle>                DescendLoopBody;
+    typedef peano::grid::nodes::loops::DescendSubpatchLoopBody<Vertex,Cell,State,EventHandle>                                 SubpatchLoopBody;
 
     const int              _treeDepth;
     State&                 _state;
@@ -60,10 +79,26 @@ class peano::grid::nodes::tasks::Descend {
 
     const bool                   _descendProcessRunsInParallelToOtherTasks;
 
+    void waitUntilLevelIsInitialised(int level);
     void touchVerticesFirstTime(int level);
     void descend(int fineGridLevel);
     void enterCells(int level);
 
+    /**
+     * Run through the levels 0 to finestLevel. On finestLevel, we only enter
+     * the cells.
+     */
+    void descendLevelByLevel(int finestLevel);
+
+    /**
+     * Run through all levels below subpatchLevel with one task per subpatch.
+     * We do not wait for the finer levels to be loaded before we spawn the
+     * subpatch tasks. Each subpatch waits for a level itself, so subpatches
+     * may descend into the upper levels while the lower ones are still
+     * loaded.
+     */
+    void descendSubpatches(int subpatchLevel, int grainSize);
+
     bool mayRunEventsOnMultipleLevelsInParallel(int levelOfTouchFirstTime) const;
   public:
     Descend(
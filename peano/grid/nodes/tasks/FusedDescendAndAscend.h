@@ -0,0 +1,93 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_GRID_NODES_TASKS_FUSED_DESCEND_AND_ASCEND_H_
+#define _PEANO_GRID_NODES_TASKS_FUSED_DESCEND_AND_ASCEND_H_
+
+
+#include "peano/utils/Globals.h"
+
+#include "peano/grid/RegularGridContainer.h"
+
+#include "peano/grid/nodes/tasks/Ascend.h"
+#include "peano/grid/nodes/tasks/Descend.h"
+#include "peano/grid/nodes/loops/FusedSubpatchLoopBody.h"
+
+
+namespace peano {
+  namespace grid {
+    namespace nodes {
+      namespace tasks {
+        template <class Vertex, class Cell, class State, class EventHandle>
+        class FusedDescendAndAscend;
+      }
+    }
+  }
+}
+
+
+/**
+ * Descend and ascend on a persistent regular subtree in one sweep
+ *
+ * Replaces a Descend task followed by an Ascend task. The levels up to the
+ * subpatch level (half the tree depth) are handled level by level as in the
+ * two original tasks. Below, each subpatch runs through all its levels
+ * downwards and then immediately upwards again (see FusedSubpatchLoopBody).
+ * On stationary grids, this halves the number of passes through the fine
+ * grid data.
+ *
+ * We use the task only for persistent regular subtrees: There, neither the
+ * cells nor the interior vertices are streamed in or out, so there is no
+ * store process that could run in parallel to the ascend anyway. Use
+ * mayFuseSweeps() to find out whether the mappings allow for a fusion.
+ *
+ * Whether the subpatches run concurrently is decided by the oracle for
+ * MethodTrace::DecomposeDescendIntoMultilevelTasks. A grain size of zero runs
+ * the fused sweep serially.
+ */
+template <class Vertex, class Cell, class State, class EventHandle>
+class peano::grid::nodes::tasks::FusedDescendAndAscend {
+  private:
+    typedef peano::grid::RegularGridContainer<Vertex,Cell>                                   RegularGridContainer;
+    typedef peano::grid::nodes::tasks::Descend<Vertex,Cell,State,EventHandle>                DescendTask;
+    typedef peano::grid::nodes::tasks::Ascend<Vertex,Cell,State,EventHandle>                 AscendTask;
+    typedef peano::grid::nodes::loops::FusedSubpatchLoopBody<Vertex,Cell,State,EventHandle>  SubpatchLoopBody;
+
+    static tarch::logging::Log  _log;
+
+    const int              _treeDepth;
+    EventHandle&           _eventHandle;
+    RegularGridContainer&  _gridContainer;
+
+    DescendTask            _descendTask;
+    AscendTask             _ascendTask;
+  public:
+    /**
+     * @return Whether the tree is deep enough for a subpatch decomposition and
+     *         all events below the subpatch level commute with the opposite
+     *         sweep.
+     */
+    static bool mayFuseSweeps(EventHandle& eventHandle, int treeDepth);
+
+    FusedDescendAndAscend(
+      const int              treeDepth,
+      State&                 state,
+      EventHandle&           eventHandle,
+      RegularGridContainer&  gridContainer,
+      bool                   descendProcessRunsInParallelToOtherTasks
+    );
+
+    ~FusedDescendAndAscend() = default;
+
+    bool operator() ();
+
+    /**
+     * @see Ascend::treeRemainsStatic()
+     */
+    bool treeRemainsStatic() const;
+};
+
+
+#include "peano/grid/nodes/tasks/FusedDescendAndAscend.cpph"
+
+
+#endif
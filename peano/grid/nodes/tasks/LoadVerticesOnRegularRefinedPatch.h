@@ -339,6 +339,14 @@ class peano::grid::nodes::tasks::LoadVerticesOnRegularRefinedPatch {
     );
   public:
     /**
+     * Load only the patch boundary of a persistent regular subtree. The
+     * interior vertices remain in the grid container. As the task recurses
+     * only into boundary cells, it tells the container whenever a boundary
+     * cell's children are loaded, and the container then releases level by
+     * level (see RegularGridContainer::haveReadAllChildrenVerticesOfOneBoundaryCell()).
+     * A descend pipelined with this load thus may start on the coarse levels
+     * while the load is still busy with the finer ones.
+     *
      * @see StoreVerticesOnRegularRefinedPatch
      */
     static const int DoNotSplitAndHandleOnlyPatchBoundary = -2;
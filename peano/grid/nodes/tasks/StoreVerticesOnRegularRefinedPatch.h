@@ -186,6 +186,14 @@ class peano::grid::nodes::tasks::StoreVerticesOnRegularRefinedPatch {
   public:
     static bool haveAllStoreVerticesTasksTerminated();
 
+    /**
+     * Process store vertices tasks until all of them have terminated. This
+     * includes tasks that have been forked by store processes of previous
+     * regular subtrees which still run in the background. Degenerates to nop
+     * without shared memory parallelisation.
+     */
+    static void waitUntilAllStoreVerticesTasksHaveTerminated();
+
     /**
      * Can be handed in as max fork level. As the value -1 is already used by
      * peano::grid::nodes::transformOracleResult() to ensure that absolutely
@@ -1,5 +1,23 @@
 #include "peano/grid/tests/RegularRefinedTest.h"
+#include "peano/grid/benchmarks/SyntheticEventHandle.h"
 #include "peano/grid/nodes/RegularRefined.h"
+#include "peano/grid/Grid.h"
+#include "peano/grid/Grid.cpph"
+#include "peano/grid/RegularGridContainer.h"
+#include "peano/grid/TraversalOrderOnTopLevel.h"
+#include "peano/geometry/Hexahedron.h"
+#include "peano/stacks/VertexSTDStack.h"
+#include "peano/stacks/CellSTDStack.h"
+
+#include "peano/datatraversal/autotuning/Oracle.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhase.h"
+#include "peano/datatraversal/autotuning/OracleForOnePhaseDummy.h"
+
+#include "tarch/multicore/MulticoreDefinitions.h"
+
+
+#include <atomic>
+#include <vector>
 
 
 #include "tarch/tests/TestCaseFactory.h"
@@ -15,6 +33,411 @@ registerTest(peano::grid::tests::RegularRefinedTest)
 tarch::logging::Log peano::grid::tests::RegularRefinedTest::_log( "peano::grid::tests::RegularRefinedTest" );
 
 
+// The synthetic benchmark's records do not hold the attributes required by
+// the MPI parallelisation, so the grid cannot be instantiated with them.
+#if !defined(Parallel)
+namespace {
+  /**
+   * The grid owns its event handle, so we bookmark the checksum of each
+   * traversal in endIteration(). Besides the checksum, we count how often
+   * the vertices are touched for the first and the last time. The counters
+   * are shared by all copies of the event handle.
+   */
+  class ChecksumEventHandle: public peano::grid::benchmarks::SyntheticEventHandle {
+    private:
+      static std::atomic<int> touchVertexFirstTimeCalls;
+      static std::atomic<int> touchVertexLastTimeCalls;
+    public:
+      static double           checksumOfLastTraversal;
+      static std::vector<int> touchVertexFirstTimeCallsPerTraversal;
+      static std::vector<int> touchVertexLastTimeCallsPerTraversal;
+
+      static void clearVisitCounters() {
+        touchVertexFirstTimeCalls = 0;
+        touchVertexLastTimeCalls  = 0;
+        touchVertexFirstTimeCallsPerTraversal.clear();
+        touchVertexLastTimeCallsPerTraversal.clear();
+      }
+
+      void touchVertexFirstTime(
+        peano::grid::benchmarks::SyntheticVertex&     fineGridVertex,
+        const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+        const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+        peano::grid::benchmarks::SyntheticVertex * const coarseGridVertices,
+        const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+        peano::grid::benchmarks::SyntheticCell&       coarseGridCell,
+        const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+      ) {
+        touchVertexFirstTimeCalls++;
+        SyntheticEventHandle::touchVertexFirstTime(fineGridVertex,fineGridX,fineGridH,coarseGridVertices,coarseGridVerticesEnumerator,coarseGridCell,fineGridPositionOfVertex);
+      }
+
+      void touchVertexLastTime(
+        peano::grid::benchmarks::SyntheticVertex&     fineGridVertex,
+        const tarch::la::Vector<DIMENSIONS,double>&   fineGridX,
+        const tarch::la::Vector<DIMENSIONS,double>&   fineGridH,
+        peano::grid::benchmarks::SyntheticVertex * const coarseGridVertices,
+        const peano::grid::VertexEnumerator&          coarseGridVerticesEnumerator,
+        peano::grid::benchmarks::SyntheticCell&       coarseGridCell,
+        const tarch::la::Vector<DIMENSIONS,int>&      fineGridPositionOfVertex
+      ) {
+        touchVertexLastTimeCalls++;
+        SyntheticEventHandle::touchVertexLastTime(fineGridVertex,fineGridX,fineGridH,coarseGridVertices,coarseGridVerticesEnumerator,coarseGridCell,fineGridPositionOfVertex);
+      }
+
+      void endIteration( peano::grid::benchmarks::SyntheticState& solverState ) {
+        SyntheticEventHandle::endIteration(solverState);
+        checksumOfLastTraversal = getChecksum();
+        touchVertexFirstTimeCallsPerTraversal.push_back( touchVertexFirstTimeCalls.exchange(0) );
+        touchVertexLastTimeCallsPerTraversal.push_back( touchVertexLastTimeCalls.exchange(0) );
+      }
+  };
+
+  double            ChecksumEventHandle::checksumOfLastTraversal = 0.0;
+  std::atomic<int>  ChecksumEventHandle::touchVertexFirstTimeCalls(0);
+  std::atomic<int>  ChecksumEventHandle::touchVertexLastTimeCalls(0);
+  std::vector<int>  ChecksumEventHandle::touchVertexFirstTimeCallsPerTraversal;
+  std::vector<int>  ChecksumEventHandle::touchVertexLastTimeCallsPerTraversal;
+
+  /**
+   * Same events as ChecksumEventHandle, but all of them support subpatch
+   * fusion, i.e. the kernel may fuse descend and ascend on persistent
+   * regular subtrees.
+   */
+  class FusingChecksumEventHandle: public ChecksumEventHandle {
+    private:
+      static peano::MappingSpecification getSpecification() {
+        return peano::MappingSpecification( peano::MappingSpecification::WholeTree, peano::MappingSpecification::RunConcurrentlyOnFineGrid, false, true );
+      }
+    public:
+      peano::MappingSpecification touchVertexLastTimeSpecification(int level) const  { return getSpecification(); }
+      peano::MappingSpecification touchVertexFirstTimeSpecification(int level) const { return getSpecification(); }
+      peano::MappingSpecification enterCellSpecification(int level) const            { return getSpecification(); }
+      peano::MappingSpecification leaveCellSpecification(int level) const            { return getSpecification(); }
+      peano::MappingSpecification ascendSpecification(int level) const               { return getSpecification(); }
+      peano::MappingSpecification descendSpecification(int level) const              { return getSpecification(); }
+  };
+
+  /**
+   * Same events as ChecksumEventHandle, but the kernel invokes enterCell and
+   * touchVertexFirstTime in batches on regular subtrees. The batched events
+   * forward to the per-element events.
+   */
+  class BatchedChecksumEventHandle: public ChecksumEventHandle {
+    private:
+      static peano::MappingSpecification getBatchedSpecification() {
+        return peano::MappingSpecification( peano::MappingSpecification::WholeTree, peano::MappingSpecification::RunConcurrentlyOnFineGrid, false, false, true );
+      }
+    public:
+      /**
+       * Is set as soon as one batched event is invoked.
+       */
+      static bool batchedEventsHaveBeenInvoked;
+
+      peano::MappingSpecification touchVertexFirstTimeSpecification(int level) const { return getBatchedSpecification(); }
+      peano::MappingSpecification enterCellSpecification(int level) const            { return getBatchedSpecification(); }
+
+      void touchVerticesFirstTime(
+        peano::grid::benchmarks::SyntheticVertex * const  fineGridVertices,
+        const peano::grid::UnrolledLevelEnumerator&       fineGridVerticesEnumerator,
+        peano::grid::benchmarks::SyntheticVertex * const  coarseGridVertices,
+        const peano::grid::UnrolledLevelEnumerator&       coarseGridVerticesEnumerator,
+        peano::grid::benchmarks::SyntheticCell * const    coarseGridCells,
+        int                                               firstVertex,
+        int                                               numberOfVertices
+      ) {
+        batchedEventsHaveBeenInvoked = true;
+
+        peano::grid::UnrolledLevelEnumerator fineGridEnumerator(fineGridVerticesEnumerator);
+        peano::grid::UnrolledLevelEnumerator coarseGridEnumerator(coarseGridVerticesEnumerator);
+        tarch::la::Vector<DIMENSIONS,int>    vertex = fineGridVerticesEnumerator.getOffset();
+        for (int i=0; i<numberOfVertices; i++) {
+          tarch::la::Vector<DIMENSIONS,int> offsetOfCoarseGridEnumerator;
+          tarch::la::Vector<DIMENSIONS,int> positionWithinNextCoarserCell;
+          peano::grid::nodes::computePositionRelativeToNextCoarserLevelFromFineGridVertexPosition(vertex,offsetOfCoarseGridEnumerator,positionWithinNextCoarserCell);
+
+          fineGridEnumerator.setOffset(vertex);
+          coarseGridEnumerator.setOffset(offsetOfCoarseGridEnumerator);
+
+          touchVertexFirstTime(
+            fineGridVertices[firstVertex+i],
+            fineGridEnumerator.getVertexPosition(),
+            fineGridEnumerator.getCellSize(),
+            coarseGridVertices,
+            coarseGridEnumerator,
+            coarseGridCells[ coarseGridEnumerator.lineariseCellIndex(offsetOfCoarseGridEnumerator) ],
+            positionWithinNextCoarserCell
+          );
+          vertex(0)++;
+        }
+      }
+
+      void enterCells(
+        peano::grid::benchmarks::SyntheticCell * const    fineGridCells,
+        peano::grid::benchmarks::SyntheticVertex * const  fineGridVertices,
+        const peano::grid::UnrolledLevelEnumerator&       fineGridVerticesEnumerator,
+        peano::grid::benchmarks::SyntheticVertex * const  coarseGridVertices,
+        const peano::grid::UnrolledLevelEnumerator&       coarseGridVerticesEnumerator,
+        peano::grid::benchmarks::SyntheticCell * const    coarseGridCells,
+        int                                               firstCell,
+        int                                               numberOfCells
+      ) {
+        batchedEventsHaveBeenInvoked = true;
+
+        peano::grid::UnrolledLevelEnumerator fineGridEnumerator(fineGridVerticesEnumerator);
+        peano::grid::UnrolledLevelEnumerator coarseGridEnumerator(coarseGridVerticesEnumerator);
+        tarch::la::Vector<DIMENSIONS,int>    cell = fineGridVerticesEnumerator.getOffset();
+        for (int i=0; i<numberOfCells; i++) {
+          tarch::la::Vector<DIMENSIONS,int> offsetOfCoarseGridEnumerator;
+          tarch::la::Vector<DIMENSIONS,int> positionWithinNextCoarserCell;
+          peano::grid::nodes::computePositionRelativeToNextCoarserLevelFromFineGridCellPosition(cell,offsetOfCoarseGridEnumerator,positionWithinNextCoarserCell);
+
+          fineGridEnumerator.setOffset(cell);
+          coarseGridEnumerator.setOffset(offsetOfCoarseGridEnumerator);
+
+          enterCell(
+            fineGridCells[firstCell+i],
+            fineGridVertices,
+            fineGridEnumerator,
+            coarseGridVertices,
+            coarseGridEnumerator,
+            coarseGridCells[ coarseGridEnumerator.lineariseCellIndex(offsetOfCoarseGridEnumerator) ],
+            positionWithinNextCoarserCell
+          );
+          cell(0)++;
+        }
+      }
+  };
+
+  bool BatchedChecksumEventHandle::batchedEventsHaveBeenInvoked = false;
+
+  /**
+   * Same events as ChecksumEventHandle, but enter and leave cell alter the
+   * state, i.e. concurrently running events work on event handle copies of
+   * their own.
+   */
+  class ReducingChecksumEventHandle: public ChecksumEventHandle {
+    private:
+      static peano::MappingSpecification getReducingSpecification() {
+        return peano::MappingSpecification( peano::MappingSpecification::WholeTree, peano::MappingSpecification::RunConcurrentlyOnFineGrid, true );
+      }
+    public:
+      peano::MappingSpecification enterCellSpecification(int level) const            { return getReducingSpecification(); }
+      peano::MappingSpecification leaveCellSpecification(int level) const            { return getReducingSpecification(); }
+  };
+
+  /**
+   * Number of traversals of the most recent iterateSyntheticGrid() call after
+   * which the vertex stack still had outstanding block pushes.
+   */
+  int traversalsWithOutstandingBlockPushes = 0;
+
+  /**
+   * Build up a regular grid and traverse it a couple of times. The grid has
+   * to be built and then has to remain stationary for a couple of traversals
+   * before the kernel holds the regular subtrees persistently.
+   *
+   * @return Checksum per traversal
+   */
+  template <class EventHandle>
+  std::vector<double> iterateSyntheticGrid(int depth) {
+    peano::stacks::VertexSTDStack<peano::grid::benchmarks::SyntheticVertex>  vertexStack;
+    peano::stacks::CellSTDStack<peano::grid::benchmarks::SyntheticCell>      cellStack;
+    peano::geometry::Hexahedron                                              geometry( 1.0, 0.0 );
+    peano::grid::benchmarks::SyntheticState                                  state;
+    peano::grid::RegularGridContainer<peano::grid::benchmarks::SyntheticVertex,peano::grid::benchmarks::SyntheticCell>  regularGridContainer;
+    peano::grid::TraversalOrderOnTopLevel                                    traversalOrderOnTopLevel;
+
+    peano::grid::Grid<
+      peano::grid::benchmarks::SyntheticVertex,
+      peano::grid::benchmarks::SyntheticCell,
+      peano::grid::benchmarks::SyntheticState,
+      peano::stacks::VertexSTDStack<peano::grid::benchmarks::SyntheticVertex>,
+      peano::stacks::CellSTDStack<peano::grid::benchmarks::SyntheticCell>,
+      EventHandle
+    > grid(
+      vertexStack,
+      cellStack,
+      geometry,
+      state,
+      1.0,
+      0.0,
+      regularGridContainer,
+      traversalOrderOnTopLevel
+    );
+
+    ChecksumEventHandle::clearVisitCounters();
+    traversalsWithOutstandingBlockPushes = 0;
+
+    std::vector<double> result;
+    for (int i=0; i<4*depth+8; i++) {
+      grid.iterate();
+      result.push_back( ChecksumEventHandle::checksumOfLastTraversal );
+      if (vertexStack.hasOutstandingBlockPushes()) {
+        traversalsWithOutstandingBlockPushes++;
+      }
+    }
+
+    grid.terminate();
+
+    return result;
+  }
+
+  /**
+   * Variant of the synthetic grid run. The default is a regular grid whose
+   * subtrees are held persistently, while nothing is pipelined, fused,
+   * batched or decomposed. Each test switches on the features it covers.
+   */
+  struct SyntheticGridOptions {
+    /**
+     * The oracle switches on the pipelined tasks of the regular subtrees.
+     */
+    bool pipelineTasks;
+    /**
+     * The events support subpatch fusion, i.e. the kernel may fuse descend
+     * and ascend on persistent regular subtrees.
+     */
+    bool fuseSweeps;
+    /**
+     * The oracle lets the kernel hold the regular subtrees persistently.
+     * Otherwise, it splits up their store process into tasks.
+     */
+    bool holdSubtreesPersistently;
+    /**
+     * The event handle asks for batched enterCell and touchVertexFirstTime
+     * events.
+     */
+    bool batchEvents;
+    /**
+     * Traverse an adaptive instead of a regular grid.
+     */
+    bool adaptive;
+    /**
+     * Refined cells with leaf children only traverse these concurrently.
+     */
+    bool traverseLeafSiblingsConcurrently;
+    /**
+     * The oracle cuts the descend and the ascend on the regular subtrees
+     * into subpatches.
+     */
+    bool decomposeIntoMultilevelTasks;
+
+    SyntheticGridOptions():
+      pipelineTasks(false),
+      fuseSweeps(false),
+      holdSubtreesPersistently(true),
+      batchEvents(false),
+      adaptive(false),
+      traverseLeafSiblingsConcurrently(false),
+      decomposeIntoMultilevelTasks(false) {
+    }
+  };
+
+  /**
+   * Answers the kernel's questions according to the SyntheticGridOptions.
+   * We count how often the oracle has handed out a multilevel
+   * decomposition.
+   */
+  class PipeliningOracle: public peano::datatraversal::autotuning::OracleForOnePhase {
+    private:
+      const SyntheticGridOptions _options;
+    public:
+      static int numberOfDescendDecompositions;
+      static int numberOfAscendDecompositions;
+
+      PipeliningOracle(const SyntheticGridOptions& options):
+        _options(options) {
+      }
+
+      peano::datatraversal::autotuning::GrainSize parallelise(int problemSize, peano::datatraversal::autotuning::MethodTrace askingMethod) override {
+        if (_options.decomposeIntoMultilevelTasks && askingMethod==peano::datatraversal::autotuning::MethodTrace::DecomposeDescendIntoMultilevelTasks) {
+          numberOfDescendDecompositions++;
+          return peano::datatraversal::autotuning::GrainSize(1, false, problemSize, askingMethod, this);
+        }
+        if (_options.decomposeIntoMultilevelTasks && askingMethod==peano::datatraversal::autotuning::MethodTrace::DecomposeAscendIntoMultilevelTasks) {
+          numberOfAscendDecompositions++;
+          return peano::datatraversal::autotuning::GrainSize(1, false, problemSize, askingMethod, this);
+        }
+
+        const bool parallelise =
+          (
+            _options.holdSubtreesPersistently
+            &&
+            askingMethod==peano::datatraversal::autotuning::MethodTrace::HoldPersistentRegularSubgrid
+          )
+          ||
+          (
+            _options.pipelineTasks
+            &&
+            (
+              askingMethod==peano::datatraversal::autotuning::MethodTrace::PipelineDescendTask
+              ||
+              askingMethod==peano::datatraversal::autotuning::MethodTrace::PipelineAscendTask
+              ||
+              askingMethod==peano::datatraversal::autotuning::MethodTrace::CallEnterCellAndInitialiseEnumeratorsOnRegularStationaryGrid
+              ||
+              askingMethod==peano::datatraversal::autotuning::MethodTrace::DecomposeDescendIntoMultilevelTasks
+            )
+          )
+          ||
+          (
+            !_options.holdSubtreesPersistently
+            &&
+            askingMethod==peano::datatraversal::autotuning::MethodTrace::SplitStoreVerticesTaskOnRegularStationaryGrid
+          )
+          ||
+          (
+            _options.traverseLeafSiblingsConcurrently
+            &&
+            askingMethod==peano::datatraversal::autotuning::MethodTrace::TraverseLeafSiblingsConcurrently
+          );
+        return peano::datatraversal::autotuning::GrainSize(parallelise ? 1 : 0, false, problemSize, askingMethod, this);
+      }
+
+      void parallelSectionHasTerminated(int problemSize, int grainSize, peano::datatraversal::autotuning::MethodTrace askingMethod, double costPerProblemElement) override {}
+      void plotStatistics(std::ostream& out, int oracleNumber) const override {}
+      void loadStatistics(const std::string& filename, int oracleNumber) override {}
+      void deactivateOracle() override {}
+      void activateOracle() override {}
+
+      peano::datatraversal::autotuning::OracleForOnePhase* createNewOracle() const override {
+        return new PipeliningOracle(_options);
+      }
+  };
+
+  int PipeliningOracle::numberOfDescendDecompositions = 0;
+  int PipeliningOracle::numberOfAscendDecompositions  = 0;
+
+  /**
+   * Runs the synthetic grid with the given options.
+   *
+   * @return Checksum per traversal
+   */
+  std::vector<double> runSyntheticGrid( const SyntheticGridOptions& options ) {
+    assertion( !options.fuseSweeps || !options.batchEvents );
+    assertion( !options.traverseLeafSiblingsConcurrently || (!options.fuseSweeps && !options.batchEvents) );
+
+    peano::datatraversal::autotuning::Oracle::getInstance().setNumberOfOracles(1);
+    peano::datatraversal::autotuning::Oracle::getInstance().setOracle( new PipeliningOracle(options) );
+    peano::datatraversal::autotuning::Oracle::getInstance().switchToOracle(0);
+
+    const int Depth = options.adaptive ? 4 : 3;
+    peano::grid::benchmarks::SyntheticEventHandle::configure( Depth, options.adaptive, 1 );
+
+    const std::vector<double> result =
+      options.fuseSweeps                       ? iterateSyntheticGrid<FusingChecksumEventHandle>(Depth) :
+      options.batchEvents                      ? iterateSyntheticGrid<BatchedChecksumEventHandle>(Depth) :
+      options.traverseLeafSiblingsConcurrently ? iterateSyntheticGrid<ReducingChecksumEventHandle>(Depth) :
+                                                 iterateSyntheticGrid<ChecksumEventHandle>(Depth);
+
+    peano::datatraversal::autotuning::Oracle::getInstance().setOracle( new peano::datatraversal::autotuning::OracleForOnePhaseDummy() );
+
+    return result;
+  }
+}
+#endif
+
+
 peano::grid::tests::RegularRefinedTest::RegularRefinedTest():
   TestCase( "peano::grid::tests::RegularRefinedTest" ) {
 }
@@ -28,6 +451,18 @@ void peano::grid::tests::RegularRefinedTest::run() {
   logTraceIn( "run() ");
   testMethod( test2DComputePositionRelativeToNextCoarserLevelFromFineGridVertexPosition );
   testMethod( test2DComputePositionRelativeToNextCoarserLevelFromFineGridCellPosition );
+  #if !defined(Parallel)
+  testMethod( testPersistentSubtreesWithPipelinedLoad );
+  testMethod( testLevelwiseReleaseOfPersistentSubtreeBoundary );
+  testMethod( testPersistentSubtreesWithFusedSweeps );
+  testMethod( testAsynchronousStoresOnRegularSubtrees );
+  #if defined(SharedMemoryParallelisation) && defined(AsynchronousStoresOnRegularSubtrees)
+  testMethod( testAsynchronousStoresCompleteBeforeStackFlip );
+  #endif
+  testMethod( testBatchedEventsOnRegularSubtrees );
+  testMethod( testConcurrentLeafSiblingsOnAdaptiveGrid );
+  testMethod( testMultilevelDecompositionOfRegularSubtrees );
+  #endif
   logTraceOut( "run() ");
 }
 
@@ -169,6 +604,236 @@ void peano::grid::tests::RegularRefinedTest::test2DComputePositionRelativeToNext
 }
 
 
+#if !defined(Parallel)
+void peano::grid::tests::RegularRefinedTest::testPersistentSubtreesWithPipelinedLoad() {
+  logTraceIn( "testPersistentSubtreesWithPipelinedLoad()" );
+
+  SyntheticGridOptions pipelined;
+  pipelined.pipelineTasks = true;
+
+  const std::vector<double> serialChecksums                    = runSyntheticGrid( SyntheticGridOptions() );
+  const std::vector<int>    serialTouchVertexFirstTimeCalls    = ChecksumEventHandle::touchVertexFirstTimeCallsPerTraversal;
+  const std::vector<double> pipelinedChecksums                 = runSyntheticGrid( pipelined );
+  const std::vector<int>    pipelinedTouchVertexFirstTimeCalls = ChecksumEventHandle::touchVertexFirstTimeCallsPerTraversal;
+
+  validateEquals( serialChecksums.size(), pipelinedChecksums.size() );
+  validateEquals( serialTouchVertexFirstTimeCalls.size(), pipelinedTouchVertexFirstTimeCalls.size() );
+  for (int i=0; i<static_cast<int>(serialChecksums.size()); i++) {
+    validateWithParams1( serialChecksums[i]>0.0, i );
+    validateNumericalEqualsWithParams3( serialChecksums[i], pipelinedChecksums[i], i, serialChecksums[i], pipelinedChecksums[i] );
+    validateEqualsWithParams1( serialTouchVertexFirstTimeCalls[i], pipelinedTouchVertexFirstTimeCalls[i], i );
+  }
+
+  logTraceOut( "testPersistentSubtreesWithPipelinedLoad()" );
+}
+
+
+void peano::grid::tests::RegularRefinedTest::testLevelwiseReleaseOfPersistentSubtreeBoundary() {
+  logTraceIn( "testLevelwiseReleaseOfPersistentSubtreeBoundary()" );
+
+  typedef peano::grid::RegularGridContainer<peano::grid::benchmarks::SyntheticVertex,peano::grid::benchmarks::SyntheticCell>  GridContainer;
+
+  validateEquals( GridContainer::getNumberOfCellsAtPatchBoundary(0), 1 );
+  validateEquals( GridContainer::getNumberOfCellsAtPatchBoundary(1), THREE_POWER_D-1 );
+  #ifdef Dim2
+  validateEquals( GridContainer::getNumberOfCellsAtPatchBoundary(2), 9*9-7*7 );
+  #endif
+
+  GridContainer gridContainer;
+  validate( gridContainer.isRegularSubtreeAvailable(2) );
+
+  // Cells of persistent subtrees are not reloaded
+  gridContainer.haveReadAllCells(2);
+  validate( !gridContainer.isLevelInitialised(1) );
+  validate( !gridContainer.isLevelInitialised(2) );
+
+  gridContainer.haveReadAllChildrenVerticesOfOneBoundaryCell(0);
+  validate(  gridContainer.isLevelInitialised(1) );
+  validate( !gridContainer.isLevelInitialised(2) );
+
+  for (int i=0; i<GridContainer::getNumberOfCellsAtPatchBoundary(1)-1; i++) {
+    gridContainer.haveReadAllChildrenVerticesOfOneBoundaryCell(1);
+    validateWithParams1( !gridContainer.isLevelInitialised(2), i );
+  }
+  gridContainer.haveReadAllChildrenVerticesOfOneBoundaryCell(1);
+  validate( gridContainer.isLevelInitialised(2) );
+
+  gridContainer.haveStoredAllVertices(2);
+  validate( !gridContainer.isLevelInitialised(1) );
+  validate( !gridContainer.isLevelInitialised(2) );
+
+  gridContainer.haveReadAllChildrenVerticesOfOneBoundaryCell(0);
+  validate(  gridContainer.isLevelInitialised(1) );
+  validate( !gridContainer.isLevelInitialised(2) );
+
+  logTraceOut( "testLevelwiseReleaseOfPersistentSubtreeBoundary()" );
+}
+
+
+void peano::grid::tests::RegularRefinedTest::testPersistentSubtreesWithFusedSweeps() {
+  logTraceIn( "testPersistentSubtreesWithFusedSweeps()" );
+
+  SyntheticGridOptions fused;
+  fused.fuseSweeps = true;
+
+  SyntheticGridOptions fusedPipelined;
+  fusedPipelined.fuseSweeps    = true;
+  fusedPipelined.pipelineTasks = true;
+
+  const std::vector<double> referenceChecksums      = runSyntheticGrid( SyntheticGridOptions() );
+  const std::vector<double> fusedChecksums          = runSyntheticGrid( fused );
+  const std::vector<double> fusedPipelinedChecksums = runSyntheticGrid( fusedPipelined );
+
+  validateEquals( referenceChecksums.size(), fusedChecksums.size() );
+  validateEquals( referenceChecksums.size(), fusedPipelinedChecksums.size() );
+  for (int i=0; i<static_cast<int>(referenceChecksums.size()); i++) {
+    validateNumericalEqualsWithParams3( referenceChecksums[i], fusedChecksums[i], i, referenceChecksums[i], fusedChecksums[i] );
+    validateNumericalEqualsWithParams3( referenceChecksums[i], fusedPipelinedChecksums[i], i, referenceChecksums[i], fusedPipelinedChecksums[i] );
+  }
+
+  logTraceOut( "testPersistentSubtreesWithFusedSweeps()" );
+}
+
+
+void peano::grid::tests::RegularRefinedTest::testAsynchronousStoresOnRegularSubtrees() {
+  logTraceIn( "testAsynchronousStoresOnRegularSubtrees()" );
+
+  SyntheticGridOptions split;
+  split.holdSubtreesPersistently = false;
+
+  const std::vector<double> serialChecksums = runSyntheticGrid( SyntheticGridOptions() );
+  const std::vector<double> splitChecksums  = runSyntheticGrid( split );
+
+  validateEquals( serialChecksums.size(), splitChecksums.size() );
+  for (int i=0; i<static_cast<int>(serialChecksums.size()); i++) {
+    validateWithParams1( serialChecksums[i]>0.0, i );
+    validateNumericalEqualsWithParams3( serialChecksums[i], splitChecksums[i], i, serialChecksums[i], splitChecksums[i] );
+  }
+
+  logTraceOut( "testAsynchronousStoresOnRegularSubtrees()" );
+}
+
+
+#if defined(SharedMemoryParallelisation) && defined(AsynchronousStoresOnRegularSubtrees)
+void peano::grid::tests::RegularRefinedTest::testAsynchronousStoresCompleteBeforeStackFlip() {
+  logTraceIn( "testAsynchronousStoresCompleteBeforeStackFlip()" );
+
+  SyntheticGridOptions split;
+  split.holdSubtreesPersistently = false;
+
+  const std::vector<double> serialChecksums = runSyntheticGrid( SyntheticGridOptions() );
+  const std::vector<double> splitChecksums  = runSyntheticGrid( split );
+
+  validateEquals( traversalsWithOutstandingBlockPushes, 0 );
+  validateEquals( serialChecksums.size(), splitChecksums.size() );
+  for (int i=0; i<static_cast<int>(serialChecksums.size()); i++) {
+    validateNumericalEqualsWithParams3( serialChecksums[i], splitChecksums[i], i, serialChecksums[i], splitChecksums[i] );
+  }
+
+  logTraceOut( "testAsynchronousStoresCompleteBeforeStackFlip()" );
+}
+#endif
+
+
+void peano::grid::tests::RegularRefinedTest::testBatchedEventsOnRegularSubtrees() {
+  logTraceIn( "testBatchedEventsOnRegularSubtrees()" );
+
+  BatchedChecksumEventHandle::batchedEventsHaveBeenInvoked = false;
+
+  SyntheticGridOptions batched;
+  batched.batchEvents = true;
+
+  const std::vector<double> referenceChecksums = runSyntheticGrid( SyntheticGridOptions() );
+  const std::vector<double> batchedChecksums   = runSyntheticGrid( batched );
+
+  validate( BatchedChecksumEventHandle::batchedEventsHaveBeenInvoked );
+  validateEquals( referenceChecksums.size(), batchedChecksums.size() );
+  for (int i=0; i<static_cast<int>(referenceChecksums.size()); i++) {
+    validateWithParams1( referenceChecksums[i]>0.0, i );
+    validateNumericalEqualsWithParams3( referenceChecksums[i], batchedChecksums[i], i, referenceChecksums[i], batchedChecksums[i] );
+  }
+
+  logTraceOut( "testBatchedEventsOnRegularSubtrees()" );
+}
+
+
+void peano::grid::tests::RegularRefinedTest::testConcurrentLeafSiblingsOnAdaptiveGrid() {
+  logTraceIn( "testConcurrentLeafSiblingsOnAdaptiveGrid()" );
+
+  SyntheticGridOptions sequential;
+  sequential.adaptive = true;
+
+  SyntheticGridOptions concurrent;
+  concurrent.adaptive                         = true;
+  concurrent.traverseLeafSiblingsConcurrently = true;
+
+  const std::vector<double> referenceChecksums  = runSyntheticGrid( sequential );
+  const std::vector<double> concurrentChecksums = runSyntheticGrid( concurrent );
+
+  validateEquals( referenceChecksums.size(), concurrentChecksums.size() );
+  for (int i=0; i<static_cast<int>(referenceChecksums.size()); i++) {
+    validateWithParams1( referenceChecksums[i]>0.0, i );
+    validateNumericalEqualsWithParams3( referenceChecksums[i], concurrentChecksums[i], i, referenceChecksums[i], concurrentChecksums[i] );
+  }
+
+  logTraceOut( "testConcurrentLeafSiblingsOnAdaptiveGrid()" );
+}
+
+
+void peano::grid::tests::RegularRefinedTest::testMultilevelDecompositionOfRegularSubtrees() {
+  logTraceIn( "testMultilevelDecompositionOfRegularSubtrees()" );
+
+  SyntheticGridOptions decomposed;
+  decomposed.decomposeIntoMultilevelTasks = true;
+
+  SyntheticGridOptions pipelined;
+  pipelined.decomposeIntoMultilevelTasks = true;
+  pipelined.pipelineTasks                = true;
+  pipelined.holdSubtreesPersistently     = false;
+
+  const std::vector<double> referenceChecksums              = runSyntheticGrid( SyntheticGridOptions() );
+  const std::vector<int>    referenceTouchFirstTimeCalls    = ChecksumEventHandle::touchVertexFirstTimeCallsPerTraversal;
+  const std::vector<int>    referenceTouchLastTimeCalls     = ChecksumEventHandle::touchVertexLastTimeCallsPerTraversal;
+
+  PipeliningOracle::numberOfDescendDecompositions = 0;
+  PipeliningOracle::numberOfAscendDecompositions  = 0;
+
+  const std::vector<double> decomposedChecksums             = runSyntheticGrid( decomposed );
+  const std::vector<int>    decomposedTouchFirstTimeCalls   = ChecksumEventHandle::touchVertexFirstTimeCallsPerTraversal;
+  const std::vector<int>    decomposedTouchLastTimeCalls    = ChecksumEventHandle::touchVertexLastTimeCallsPerTraversal;
+
+  const std::vector<double> pipelinedChecksums              = runSyntheticGrid( pipelined );
+  const std::vector<int>    pipelinedTouchFirstTimeCalls    = ChecksumEventHandle::touchVertexFirstTimeCallsPerTraversal;
+  const std::vector<int>    pipelinedTouchLastTimeCalls     = ChecksumEventHandle::touchVertexLastTimeCallsPerTraversal;
+
+  // Without shared memory parallelisation, Oracle::parallelise() does not
+  // ask the oracles at all
+  #if defined(SharedMemoryParallelisation)
+  validate( PipeliningOracle::numberOfDescendDecompositions>0 );
+  validate( PipeliningOracle::numberOfAscendDecompositions>0 );
+  #endif
+
+  validateEquals( referenceTouchFirstTimeCalls.size(), referenceChecksums.size() );
+  validateEquals( decomposedTouchFirstTimeCalls.size(), referenceChecksums.size() );
+  validateEquals( pipelinedTouchFirstTimeCalls.size(), referenceChecksums.size() );
+
+  for (int i=0; i<static_cast<int>(referenceChecksums.size()); i++) {
+    validateWithParams1( referenceChecksums[i]>0.0, i );
+    validateNumericalEqualsWithParams3( referenceChecksums[i], decomposedChecksums[i], i, referenceChecksums[i], decomposedChecksums[i] );
+    validateNumericalEqualsWithParams3( referenceChecksums[i], pipelinedChecksums[i], i, referenceChecksums[i], pipelinedChecksums[i] );
+
+    validateWithParams1( referenceTouchFirstTimeCalls[i]>0, i );
+    validateEqualsWithParams1( referenceTouchFirstTimeCalls[i], decomposedTouchFirstTimeCalls[i], i );
+    validateEqualsWithParams1( referenceTouchLastTimeCalls[i],  decomposedTouchLastTimeCalls[i],  i );
+    validateEqualsWithParams1( referenceTouchFirstTimeCalls[i], pipelinedTouchFirstTimeCalls[i],  i );
+    validateEqualsWithParams1( referenceTouchLastTimeCalls[i],  pipelinedTouchLastTimeCalls[i],   i );
+  }
+
+  logTraceOut( "testMultilevelDecompositionOfRegularSubtrees()" );
+}
+#endif
+
+
 #ifdef UseTestSpecificCompilerSettings
 #pragma optimize("",on)
 #endif
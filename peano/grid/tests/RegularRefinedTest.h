@@ -6,6 +6,7 @@
 
 #include "tarch/tests/TestCase.h"
 #include "tarch/logging/Log.h"
+#include "tarch/multicore/MulticoreDefinitions.h"
 
 
 namespace peano {
@@ -24,6 +25,82 @@ class peano::grid::tests::RegularRefinedTest: public tarch::tests::TestCase {
 
     void test2DComputePositionRelativeToNextCoarserLevelFromFineGridVertexPosition();
     void test2DComputePositionRelativeToNextCoarserLevelFromFineGridCellPosition();
+
+    #if !defined(Parallel)
+    /**
+     * Run a couple of traversals over a regular synthetic grid with and
+     * without pipelined load/descend tasks, and validate that both variants
+     * yield the same checksum per traversal. If the code is translated with
+     * PersistentRegularSubtrees, the grid is held persistently after a few
+     * iterations, i.e. the test then covers the persistent subtree path of
+     * RegularRefined::traverse(). There, the descend runs in parallel to the
+     * load of the subtree's boundary and waits level by level until the load
+     * has released a level. If a level were never released, the pipelined
+     * traversal would not terminate. Each vertex furthermore has to be
+     * touched as often as in the serial traversal.
+     */
+    void testPersistentSubtreesWithPipelinedLoad();
+
+    /**
+     * Mimic the boundary load of a persistent subtree of height two on the
+     * grid container. The root's children complete the first level. The
+     * second level is released only once all the boundary cells of the first
+     * level have loaded their children. A store resets the levels again.
+     */
+    void testLevelwiseReleaseOfPersistentSubtreeBoundary();
+
+    /**
+     * Same setup as testPersistentSubtreesWithPipelinedLoad(), but the events
+     * support subpatch fusion. The kernel thus fuses descend and ascend on
+     * the persistent subtrees. The checksums have to match the
+     * ones of the unfused traversal.
+     */
+    void testPersistentSubtreesWithFusedSweeps();
+
+    /**
+     * The regular subtrees are never held persistently and the store process
+     * is split into tasks. With AsynchronousStoresOnRegularSubtrees, these
+     * tasks continue to run while the traversal proceeds with the remaining
+     * grid. The checksums have to match the ones of the serial traversal
+     * that holds the subtrees persistently.
+     */
+    void testAsynchronousStoresOnRegularSubtrees();
+
+    #if defined(SharedMemoryParallelisation) && defined(AsynchronousStoresOnRegularSubtrees)
+    /**
+     * Variant of testAsynchronousStoresOnRegularSubtrees() that is built only
+     * if the stores do not wait for their tasks. Each traversal ends with a
+     * stack flip, i.e. no block push on the vertex stack may be outstanding
+     * once a traversal has terminated.
+     */
+    void testAsynchronousStoresCompleteBeforeStackFlip();
+    #endif
+
+    /**
+     * The event handle asks for batched enterCell and touchVertexFirstTime
+     * events, and its batched events forward to the per-element events. The
+     * checksums have to match the ones of the per-element traversal.
+     */
+    void testBatchedEventsOnRegularSubtrees();
+
+    /**
+     * Traverse an adaptive synthetic grid. Refined cells with leaf children
+     * only traverse these children concurrently. The checksums have to match
+     * the ones of the sequential traversal.
+     */
+    void testConcurrentLeafSiblingsOnAdaptiveGrid();
+
+    /**
+     * The oracle cuts both the descend and the ascend on the regular
+     * subtrees into subpatches. Neighbouring subpatches share vertices, so we
+     * validate that each vertex is still touched exactly once per traversal,
+     * i.e. that the number of touchVertexFirstTime() and
+     * touchVertexLastTime() calls matches the level-wise traversal. The
+     * second run pipelines the load and the descend, i.e. the subpatches
+     * start while the finer levels are still loaded.
+     */
+    void testMultilevelDecompositionOfRegularSubtrees();
+    #endif
   public:
     RegularRefinedTest();
 
@@ -0,0 +1,100 @@
+#include "peano/grid/tests/StateTest.h"
+#include "peano/grid/benchmarks/SyntheticEventHandle.h"
+
+#ifdef Parallel
+#include "tarch/parallel/Node.h"
+#include "peano/parallel/SendReceiveBufferPool.h"
+#endif
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(peano::grid::tests::StateTest)
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+tarch::logging::Log peano::grid::tests::StateTest::_log( "peano::grid::tests::StateTest" );
+
+
+peano::grid::tests::StateTest::StateTest():
+  TestCase( "peano::grid::tests::StateTest" ) {
+}
+
+
+peano::grid::tests::StateTest::~StateTest() {
+}
+
+
+void peano::grid::tests::StateTest::run() {
+  logTraceIn( "run() ");
+  #ifdef Parallel
+  testMethod( testMergeWithWorkerStatesReceivedInBackground );
+  testMethod( testMarkAsReceivedInBackground );
+  #endif
+  logTraceOut( "run() ");
+}
+
+
+void peano::grid::tests::StateTest::setUp() {
+}
+
+
+#ifdef Parallel
+void peano::grid::tests::StateTest::testMergeWithWorkerStatesReceivedInBackground() {
+  logTraceIn( "testMergeWithWorkerStatesReceivedInBackground()" );
+
+  peano::grid::benchmarks::SyntheticState::initDatatype();
+
+  const int rank = tarch::parallel::Node::getInstance().getRank();
+  const int tag  = peano::parallel::SendReceiveBufferPool::getInstance().getIterationManagementTag();
+
+  peano::grid::benchmarks::SyntheticState masterState;
+  validate( masterState.isGridStationary() );
+
+  masterState.receiveWorkerStateInBackground(rank);
+  masterState.receiveWorkerStateInBackground(rank);
+  validateEquals( peano::grid::benchmarks::SyntheticState::getNumberOfWorkerStatesReceivedInBackground(), 2 );
+
+  peano::grid::benchmarks::SyntheticState stationaryWorkerState;
+  peano::grid::benchmarks::SyntheticState refinedWorkerState;
+  refinedWorkerState.updateRefinementHistoryAfterLoad(true,false,false,false);
+
+  stationaryWorkerState.send(rank,tag,false);
+  refinedWorkerState.send(rank,tag,false);
+
+  masterState.mergeWithWorkerStatesReceivedInBackground();
+
+  validateEquals( peano::grid::benchmarks::SyntheticState::getNumberOfWorkerStatesReceivedInBackground(), 0 );
+  validateWithParams1( !masterState.isGridStationary(), masterState.toString() );
+
+  // Nop if no worker state is pending
+  masterState.mergeWithWorkerStatesReceivedInBackground();
+  validateEquals( peano::grid::benchmarks::SyntheticState::getNumberOfWorkerStatesReceivedInBackground(), 0 );
+
+  logTraceOut( "testMergeWithWorkerStatesReceivedInBackground()" );
+}
+
+
+void peano::grid::tests::StateTest::testMarkAsReceivedInBackground() {
+  logTraceIn( "testMarkAsReceivedInBackground()" );
+
+  peano::grid::benchmarks::SyntheticState workerState;
+  validate( !workerState.isReceivedInBackground() );
+
+  workerState.markAsReceivedInBackground();
+  validate( workerState.isReceivedInBackground() );
+
+  const peano::grid::benchmarks::SyntheticState copy(workerState);
+  validate( copy.isReceivedInBackground() );
+
+  logTraceOut( "testMarkAsReceivedInBackground()" );
+}
+#endif
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
@@ -0,0 +1,55 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_GRID_TESTS_STATE_TEST_H_
+#define _PEANO_GRID_TESTS_STATE_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+#include "tarch/logging/Log.h"
+
+
+namespace peano {
+  namespace grid {
+    namespace tests {
+      class StateTest;
+    }
+  }
+}
+
+
+/**
+ * Tests for the reduction of the states along the master-worker tree
+ */
+class peano::grid::tests::StateTest: public tarch::tests::TestCase {
+  private:
+    static tarch::logging::Log  _log;
+
+    #ifdef Parallel
+    /**
+     * Each rank acts as its own worker: It posts two background receives for
+     * worker states from itself, sends two worker states to itself, and then
+     * merges them. The second worker state has refined, so the merged state
+     * must not be stationary anymore. Afterwards, no worker state may be
+     * pending. The test runs on any number of ranks, as each rank talks only
+     * to itself.
+     */
+    void testMergeWithWorkerStatesReceivedInBackground();
+
+    /**
+     * A placeholder for a worker state that is received in the background
+     * has to be recognisable as such.
+     */
+    void testMarkAsReceivedInBackground();
+    #endif
+  public:
+    StateTest();
+
+    virtual ~StateTest();
+
+    virtual void run();
+
+    void virtual setUp();
+};
+
+
+#endif
@@ -7,15 +7,7 @@
 
 #include "tarch/multicore/BooleanSemaphore.h"
 #include "tarch/compiler/CompilerSpecificSettings.h"
-
-
-/**
- * With this ifdef, we can define whether the pool shall use a dedicated
- * thread to receive data in the background.
- */
-#if defined(SharedMemoryParallelisation) && defined(MultipleThreadsMayTriggerMPICalls) && defined(Parallel) && !defined(noMPIUsesItsOwnThread) && !defined(MPIUsesItsOwnThread)
-#define MPIUsesItsOwnThread
-#endif
+#include "tarch/parallel/ProgressEngine.h"
 
 
 #if defined(MPIUsesItsOwnThread)
@@ -54,32 +46,14 @@ class peano::heap::BoundaryDataExchanger {
      */
     static tarch::logging::Log _log;
 
-    struct BackgroundThread {
-      public:
-        enum class State {
-          ReceiveDataInBackground,
-          Suspend,
-		  Terminate
-        };
-
-        static std::string toString(State state);
-      private:
-        BoundaryDataExchanger*              _boundaryDataExchanger;
-        tarch::multicore::BooleanSemaphore  _semaphore;
-        State                               _state;
-
-        BackgroundThread(const BackgroundThread&) = delete;
-      public:
-        BackgroundThread(BoundaryDataExchanger*  boundaryDataExchanger);
-        virtual ~BackgroundThread();
-        bool operator()();
-        std::string toString() const;
-        void switchState( State newState );
-        State getState() const;
-    };
-
     #ifdef MPIHeapUsesItsOwnThread
-    BackgroundThread*  _backgroundThread;
+    /**
+     * Handle of the exchanger's polling routine within the progress engine.
+     * The routine is registered lazily in startToSendData().
+     *
+     * @see tarch::parallel::ProgressEngine
+     */
+    int  _progressEngineHandle;
     #endif
 
   protected:
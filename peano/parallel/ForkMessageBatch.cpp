@@ -0,0 +1,91 @@
+#include "peano/parallel/ForkMessageBatch.h"
+
+#include "tarch/parallel/Node.h"
+#include "tarch/Assertions.h"
+
+
+tarch::logging::Log peano::parallel::ForkMessageBatch::_log( "peano::parallel::ForkMessageBatch" );
+
+
+peano::parallel::ForkMessageBatch::ForkMessageBatch(int tag):
+  _messages(),
+  _requests(),
+  _destinations(),
+  _tag(tag) {
+}
+
+
+peano::parallel::ForkMessageBatch::~ForkMessageBatch() {
+  #ifdef Parallel
+  if (!_requests.empty()) {
+    logError( "~ForkMessageBatch()", "batch still holds " << _requests.size() << " pending fork message(s). Call waitForForkMessages() before the batch is destroyed" );
+    MPI_Waitall( static_cast<int>(_requests.size()), _requests.data(), MPI_STATUSES_IGNORE );
+  }
+  #endif
+}
+
+
+void peano::parallel::ForkMessageBatch::send(const peano::parallel::messages::ForkMessage& message, int destination) {
+  logTraceInWith2Arguments( "send(ForkMessage,int)", message.toString(), destination );
+
+  #ifdef Parallel
+  assertion( peano::parallel::messages::ForkMessage::Datatype!=0 );
+
+  _messages.push_back( message );
+  _destinations.push_back( destination );
+  _requests.push_back( MPI_Request() );
+
+  const int result = MPI_Isend(
+    &_messages.back(), 1, peano::parallel::messages::ForkMessage::Datatype, destination,
+    _tag, tarch::parallel::Node::getInstance().getCommunicator(),
+    &_requests.back()
+  );
+  if (result!=MPI_SUCCESS) {
+    logError(
+      "send(ForkMessage,int)",
+      "was not able to send fork message " << message.toString() << " to node " << destination <<
+      ": " << tarch::parallel::MPIReturnValueToString(result)
+    );
+  }
+  #endif
+
+  logTraceOut( "send(ForkMessage,int)" );
+}
+
+
+void peano::parallel::ForkMessageBatch::waitForForkMessages() {
+  #ifdef Parallel
+  if (!_requests.empty()) {
+    logTraceInWith1Argument( "waitForForkMessages()", _requests.size() );
+
+    clock_t      timeOutWarning   = tarch::parallel::Node::getInstance().getDeadlockWarningTimeStamp();
+    clock_t      timeOutShutdown  = tarch::parallel::Node::getInstance().getDeadlockTimeOutTimeStamp();
+    bool         triggeredTimeoutWarning = false;
+
+    int flag = 0;
+    MPI_Testall( static_cast<int>(_requests.size()), _requests.data(), &flag, MPI_STATUSES_IGNORE );
+    while (!flag) {
+      if ( tarch::parallel::Node::getInstance().isTimeOutWarningEnabled() && (clock()>timeOutWarning) && (!triggeredTimeoutWarning)) {
+        tarch::parallel::Node::getInstance().writeTimeOutWarning( "peano::parallel::ForkMessageBatch", "waitForForkMessages()", _destinations[0], _tag, static_cast<int>(_requests.size()) );
+        triggeredTimeoutWarning = true;
+      }
+      if ( tarch::parallel::Node::getInstance().isTimeOutDeadlockEnabled() && (clock()>timeOutShutdown)) {
+        tarch::parallel::Node::getInstance().triggerDeadlockTimeOut( "peano::parallel::ForkMessageBatch", "waitForForkMessages()", _destinations[0], _tag, static_cast<int>(_requests.size()) );
+      }
+      tarch::parallel::Node::getInstance().receiveDanglingMessages();
+      MPI_Testall( static_cast<int>(_requests.size()), _requests.data(), &flag, MPI_STATUSES_IGNORE );
+    }
+
+    _messages.clear();
+    _requests.clear();
+    _destinations.clear();
+
+    logTraceOut( "waitForForkMessages()" );
+  }
+  #endif
+}
+
+
+int peano::parallel::ForkMessageBatch::getNumberOfPendingMessages() const {
+  return static_cast<int>(_requests.size());
+}
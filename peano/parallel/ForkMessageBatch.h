@@ -0,0 +1,83 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PARALLEL_FORK_MESSAGE_BATCH_H_
+#define _PEANO_PARALLEL_FORK_MESSAGE_BATCH_H_
+
+
+#include "peano/parallel/messages/ForkMessage.h"
+#include "tarch/parallel/MPIConstants.h"
+#include "tarch/logging/Log.h"
+
+#include <list>
+#include <vector>
+
+
+namespace peano {
+  namespace parallel {
+    class ForkMessageBatch;
+  }
+}
+
+
+/**
+ * Batch of Fork Messages
+ *
+ * If a rank forks a patch into several workers, it sends one fork message
+ * per worker. The DaStGen send either is blocking or waits for the
+ * non-blocking send to complete, i.e. the fork messages go out one after
+ * another. This class instead posts all the sends non-blocking and completes
+ * them together in waitForForkMessages(). The messages are copied into the
+ * batch, as MPI reads from the buffers until the sends have completed.
+ *
+ * The owner has to call waitForForkMessages() before it destroys the batch.
+ * The wait receives dangling messages, i.e. it may run arbitrary services,
+ * which we do not want to happen implicitly within a destructor. As the new
+ * workers are activated by the node pool before the fork messages are sent,
+ * the wait always terminates.
+ */
+class peano::parallel::ForkMessageBatch {
+  private:
+    static tarch::logging::Log  _log;
+
+    /**
+     * A list, as the sends hold pointers to the messages.
+     */
+    std::list<peano::parallel::messages::ForkMessage>  _messages;
+
+    std::vector<MPI_Request>                           _requests;
+    std::vector<int>                                   _destinations;
+
+    const int                                          _tag;
+  public:
+    /**
+     * @param tag Tag of the fork messages. Usually
+     *          NodePool::getTagForForkMessages().
+     */
+    ForkMessageBatch(int tag);
+
+    /**
+     * The batch should be empty, i.e. waitForForkMessages() should have been
+     * called. Otherwise, we write an error and block until the pending sends
+     * have completed without receiving any dangling messages.
+     */
+    ~ForkMessageBatch();
+
+    /**
+     * Post a non-blocking send of a copy of message to destination.
+     */
+    void send(const peano::parallel::messages::ForkMessage& message, int destination);
+
+    /**
+     * Wait until all sends posted so far have completed. Receives dangling
+     * messages meanwhile. Afterwards, the batch is empty and can be reused.
+     */
+    void waitForForkMessages();
+
+    /**
+     * @return Number of sends that have been posted but not been waited for.
+     */
+    int getNumberOfPendingMessages() const;
+};
+
+
+#endif
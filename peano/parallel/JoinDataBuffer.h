@@ -4,6 +4,9 @@
 #define _PEANO_PARALLEL_JOIN_DATA_BUFFER_H_
 
 
+#include <string>
+
+
 namespace peano {
   namespace parallel {
     class JoinDataBuffer;
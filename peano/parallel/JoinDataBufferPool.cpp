@@ -1,5 +1,6 @@
 #include "peano/parallel/JoinDataBufferPool.h"
 #include "peano/parallel/JoinDataBufferImplementation.h"
+#include "peano/parallel/RunLengthEncodedJoinDataBuffer.h"
 
 #include "tarch/Assertions.h"
 #include "tarch/parallel/Node.h"
@@ -19,7 +20,8 @@ tarch::logging::Log peano::parallel::JoinDataBufferPool::_log( "peano::parallel:
 
 peano::parallel::JoinDataBufferPool::JoinDataBufferPool():
   _map(),
-  _bufferSize(1) {
+  _bufferSize(1),
+  _compressStreams(false) {
   _vertexTag            = tarch::parallel::Node::getInstance().reserveFreeTag("JoinDataBufferPool[vertex]");
   _cellTag              = tarch::parallel::Node::getInstance().reserveFreeTag("JoinDataBufferPool[cell]");
   _cellMarkerTag        = tarch::parallel::Node::getInstance().reserveFreeTag("JoinDataBufferPool[cell-marker]");
@@ -102,14 +104,21 @@ void peano::parallel::JoinDataBufferPool::releaseMessages() {
         tarch::parallel::Node::getInstance().getRank()
       );
 
-      delete p->second._vertexBuffer;
-      delete p->second._cellBuffer;
-      delete p->second._cellMarkerBuffer;
+      // The run-length encoded buffers wait for their sends in the destructor
+      // and thus might call receiveDanglingMessages(). We hence remove the
+      // buffers from the map before we destroy them.
+      JoinDataBuffer* vertexBuffer     = p->second._vertexBuffer;
+      JoinDataBuffer* cellBuffer       = p->second._cellBuffer;
+      JoinDataBuffer* cellMarkerBuffer = p->second._cellMarkerBuffer;
 
       p->second._vertexBuffer = 0;
       p->second._cellBuffer = 0;
       p->second._cellMarkerBuffer = 0;
 
+      delete vertexBuffer;
+      delete cellBuffer;
+      delete cellMarkerBuffer;
+
       logDebug( "releaseMessages()", "destroyed vertex, cell, and marker buffer for rank " << p->first << " on rank " << tarch::parallel::Node::getInstance().getRank() );
     }
   }
@@ -128,8 +137,13 @@ int peano::parallel::JoinDataBufferPool::getCellLevelFromStream(int fromRank) {
 void peano::parallel::JoinDataBufferPool::createCellMarkerBufferManually(bool isReceiveBuffer, int fromOrToRank) {
   #ifdef Parallel
   if (_map[fromOrToRank]._cellMarkerBuffer==0) {
-    typedef JoinDataBufferImplementation<int> BufferType;
-    _map[fromOrToRank]._cellMarkerBuffer = new BufferType(isReceiveBuffer, _bufferSize, MPI_INT, fromOrToRank, _cellMarkerTag);
+    if (_compressStreams) {
+      _map[fromOrToRank]._cellMarkerBuffer = new RunLengthEncodedJoinDataBuffer(isReceiveBuffer, _bufferSize, fromOrToRank, _cellMarkerTag);
+    }
+    else {
+      typedef JoinDataBufferImplementation<int> BufferType;
+      _map[fromOrToRank]._cellMarkerBuffer = new BufferType(isReceiveBuffer, _bufferSize, MPI_INT, fromOrToRank, _cellMarkerTag);
+    }
     logDebug( "sendVertex(...)", "created cell tag join buffer on rank " << tarch::parallel::Node::getInstance().getRank() << " for rank " << fromOrToRank << ", is receive buffer=" << isReceiveBuffer);
   }
   #endif
@@ -143,12 +157,25 @@ int peano::parallel::JoinDataBufferPool::getRawCellMarkerFromStream(int fromRank
   createCellMarkerBufferManually(true,fromRank);
 
   typedef JoinDataBufferImplementation<int> BufferType;
-  const int result = static_cast<BufferType*>(_map[fromRank]._cellMarkerBuffer)->getTopElement();
+  const int result = _compressStreams ?
+    static_cast<RunLengthEncodedJoinDataBuffer*>(_map[fromRank]._cellMarkerBuffer)->getTopElement() :
+    static_cast<BufferType*>(_map[fromRank]._cellMarkerBuffer)->getTopElement();
   logTraceOutWith1Argument( "getRawCellMarkerFromStream(int)", result );
   return result;
 }
 
 
+void peano::parallel::JoinDataBufferPool::sendCellMarker(int cellMarker, int toRank) {
+  typedef JoinDataBufferImplementation<int> BufferType;
+  if (_compressStreams) {
+    static_cast<RunLengthEncodedJoinDataBuffer*>(_map[toRank]._cellMarkerBuffer)->send(cellMarker);
+  }
+  else {
+    static_cast<BufferType*>(_map[toRank]._cellMarkerBuffer)->send(cellMarker);
+  }
+}
+
+
 std::bitset<NUMBER_OF_VERTICES_PER_ELEMENT> peano::parallel::JoinDataBufferPool::getCellMarkerFromStream(int fromRank) {
   int result = getRawCellMarkerFromStream(fromRank);
 
@@ -199,3 +226,22 @@ void peano::parallel::JoinDataBufferPool::setBufferSize( int bufferSize ) {
   _bufferSize = bufferSize;
   #endif
 }
+
+
+void peano::parallel::JoinDataBufferPool::setStreamCompression( bool value ) {
+  #ifdef Parallel
+  assertion1( _map.empty(), tarch::parallel::Node::getInstance().getRank() );
+
+  _compressStreams = value;
+  logInfo( "setStreamCompression(bool)", "stream compression for joins and forks=" << _compressStreams << ", buffer size=" << _bufferSize );
+  #endif
+}
+
+
+bool peano::parallel::JoinDataBufferPool::usePackedRecords() const {
+  #ifdef ParallelExchangePackedRecordsThroughoutJoinsAndForks
+  return true;
+  #else
+  return _compressStreams;
+  #endif
+}
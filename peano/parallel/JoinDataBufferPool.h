@@ -18,6 +18,10 @@
 namespace peano {
   namespace parallel {
     class JoinDataBufferPool;
+
+    namespace tests {
+      class RunLengthEncodedJoinDataBufferTest;
+    }
   }
 }
 
@@ -38,6 +42,28 @@ namespace peano {
  *
  * @image html peano/parallel/JoinDataBuffer.png
  *
+ * !!! Stream compression
+ *
+ * Joins and forks stream whole subtrees through the pool. By default, the
+ * pool sends the plain vertex and cell records plus one integer marker per
+ * cell. If you switch on the stream compression via
+ * setStreamCompression(), the pool
+ *
+ * - sends the packed records for vertices and cells, i.e. all flags and
+ *   enums are squeezed into a few bytes (this is what the compile flag
+ *   ParallelExchangePackedRecordsThroughoutJoinsAndForks does, too, which
+ *   is set by default if you use PackedRecords), and
+ * - run-length encodes the cell markers (see
+ *   RunLengthEncodedJoinDataBuffer). Along the space-filling curve, most
+ *   markers of a subtree are the same.
+ *
+ * The encoding is done per page, i.e. you have to increase the buffer size
+ * via setBufferSize() to benefit from the run-length encoding. Encoded pages
+ * are sent in the background and decoded by receiveDanglingMessages(), i.e.
+ * both the encoding and the decoding overlap with the grid traversal. Master
+ * and worker have to use the same setting. Change it only before the grid is
+ * set up or while there are no buffers.
+ *
  * @author Tobias Weinzierl
  */
 class peano::parallel::JoinDataBufferPool: public tarch::services::Service {
@@ -70,6 +96,13 @@ class peano::parallel::JoinDataBufferPool: public tarch::services::Service {
     int _cellTag;
     int _cellMarkerTag;
 
+    /**
+     * By default false.
+     */
+    bool _compressStreams;
+
+    friend class peano::parallel::tests::RunLengthEncodedJoinDataBufferTest;
+
     /**
      * It is yet another singleton.
      */
@@ -81,6 +114,15 @@ class peano::parallel::JoinDataBufferPool: public tarch::services::Service {
      * Invoked by getRawCellMarkerFromStream()
      */
     void createCellMarkerBufferManually(bool isReceiveBuffer, int fromOrToRank);
+
+    void sendCellMarker(int cellMarker, int toRank);
+
+    /**
+     * Packed records are used either if the compile flag
+     * ParallelExchangePackedRecordsThroughoutJoinsAndForks is set or if the
+     * stream compression is switched on.
+     */
+    bool usePackedRecords() const;
   public:
     static JoinDataBufferPool& getInstance();
 
@@ -158,6 +200,12 @@ class peano::parallel::JoinDataBufferPool: public tarch::services::Service {
      * Set a new buffer size.
      */
     void setBufferSize( int bufferSize );
+
+    /**
+     * Switch the stream compression on or off. See the class documentation.
+     * May only be called if there are no buffers.
+     */
+    void setStreamCompression( bool value );
 };
 
 
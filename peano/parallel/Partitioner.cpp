@@ -45,7 +45,8 @@ tarch::logging::Log peano::parallel::Partitioner::_log( "peano::parallel::Partit
 peano::parallel::Partitioner::Partitioner( const std::bitset<THREE_POWER_D>& localCellsOfPatch ):
   _ranks(),
   _localCellsOfPatch( localCellsOfPatch ),
-  _assignedNodes(THREE_POWER_D) {
+  _assignedNodes(THREE_POWER_D),
+  _forkMessages( tarch::parallel::NodePool::getInstance().getTagForForkMessages() ) {
   assertion2(_localCellsOfPatch.count()>0,_localCellsOfPatch,tarch::parallel::Node::getInstance().getRank());
 }
 
@@ -135,13 +136,7 @@ void peano::parallel::Partitioner::sendForkMessages(
         h,
         levelOfPatch+1
       );
-      #ifdef Parallel
-      message.send(
-        _ranks[assignedRemoteRanks],
-        tarch::parallel::NodePool::getInstance().getTagForForkMessages(),
-        true, SendAndReceiveLoadBalancingMessagesBlocking
-      );
-      #endif
+      _forkMessages.send( message, _ranks[assignedRemoteRanks] );
       _assignedNodes[CellIndex] = _ranks[assignedRemoteRanks];
       assignedRemoteRanks++;
     }
@@ -154,6 +149,11 @@ void peano::parallel::Partitioner::sendForkMessages(
 }
 
 
+void peano::parallel::Partitioner::waitForForkMessages() {
+  _forkMessages.waitForForkMessages();
+}
+
+
 int peano::parallel::Partitioner::getRankOfWorkerReponsibleForCell( tarch::la::Vector<DIMENSIONS,int> cellIndex ) const {
   int cellNumber = peano::utils::dLinearised(cellIndex,3);
   assertion( cellNumber>=0 );
@@ -4,6 +4,7 @@
 #define _PEANO_PARALLEL_PARTITIONER_H_
 
 
+#include "peano/parallel/ForkMessageBatch.h"
 #include "tarch/la/Vector.h"
 #include "peano/utils/Globals.h"
 #include "peano/utils/Loop.h"
@@ -42,6 +43,14 @@ namespace peano {
  * which is befilled with geometric information about the involved cells.
  * getRankOfWorkerReponsibleForCell() then identifies per child cell which rank
  * has to become responsible for this cell.
+ *
+ * The fork messages are sent non-blocking (see sendForkMessages()), and the
+ * caller completes them through waitForForkMessages() once it has marked the
+ * forked cells as remote. This is the only part of the fork that overlaps
+ * with other work. The workers still are reserved with one answer message
+ * per rank (see reserveNodes()), and the forked subtrees are streamed out in
+ * the traversal after the fork as before, i.e. the stream-out does not
+ * overlap with the fork.
  */
 class peano::parallel::Partitioner {
   protected:
@@ -58,6 +67,8 @@ class peano::parallel::Partitioner {
 
     std::vector<int>                  _assignedNodes;
 
+    ForkMessageBatch                  _forkMessages;
+
   public:
     /**
      * Init MPI Datatypes
@@ -104,7 +115,9 @@ class peano::parallel::Partitioner {
      *
      * This operation asks for new workers at the node pool, and it also adds
      * these new workers to the loadbalancing's oracle. It does not communicate
-     * with the new workers directly.
+     * with the new workers directly. All workers are requested with one
+     * request message, but the node pool answers with one blocking message
+     * per requested rank (see tarch::parallel::NodePool::reserveFreeNodes()).
      *
      * If the local command does not equal ForkAllChildrenAndBecomeAdministrativeRank
      * but wants to fork, we do not fork all potential candidates but leave one
@@ -121,10 +134,12 @@ class peano::parallel::Partitioner {
      *
      * !!! Send protocol
      *
-     * The partitioner could send its partitioning message either blocking or
-     * non-blocking. As the message is a direct follow-up to a job message
-     * resulting from re-balancing, I make the flag
-     * SendAndReceiveLoadBalancingMessagesBlocking determine the send protocol.
+     * The partitioner posts all fork messages as non-blocking sends at once
+     * and returns. The messages thus travel to all new workers concurrently
+     * while the caller marks the forked cells as remote. The caller then has
+     * to complete the sends through waitForForkMessages() before it destroys
+     * the partitioner. Before, the partitioner sent one message after another
+     * and waited for each send to complete.
      *
      * @param domainOffset Offset of original computational domain, i.e. the
      *                     @f$ 3^d @f$ patch, that is now split.
@@ -141,6 +156,13 @@ class peano::parallel::Partitioner {
       const std::bitset<DIMENSIONS>&               bitfieldOfCoarseLevelLevel
     );
 
+    /**
+     * Wait until all fork messages have been sent. Receives dangling
+     * messages meanwhile. Has to be called after sendForkMessages() before
+     * the partitioner is destroyed.
+     */
+    void waitForForkMessages();
+
     int getRankOfWorkerReponsibleForCell( tarch::la::Vector<DIMENSIONS,int> cellIndex ) const;
 
     std::string getPartitiongDescription() const;
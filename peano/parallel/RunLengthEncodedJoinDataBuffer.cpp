@@ -0,0 +1,292 @@
+#include "peano/parallel/RunLengthEncodedJoinDataBuffer.h"
+
+#include "peano/performanceanalysis/CommunicationMatrix.h"
+
+#include "tarch/parallel/Node.h"
+#include "tarch/parallel/ProgressEngine.h"
+#include "tarch/multicore/Jobs.h"
+#include "tarch/Assertions.h"
+
+#include <sstream>
+
+
+tarch::logging::Log peano::parallel::RunLengthEncodedJoinDataBuffer::_log( "peano::parallel::RunLengthEncodedJoinDataBuffer" );
+
+
+peano::parallel::RunLengthEncodedJoinDataBuffer::RunLengthEncodedJoinDataBuffer(bool isReceiveBuffer, int bufferSize, int rank, int tag ):
+  _isReceiveBuffer( isReceiveBuffer ),
+  _bufferSize(bufferSize),
+  _buffer(),
+  _numberOfPagesInFlight(0),
+  _currentElement(0),
+  _rank(rank),
+  _tag(tag),
+  _numberOfEntries(0),
+  _numberOfEncodedEntries(0) {
+  assertion( bufferSize>0 );
+  #ifdef Parallel
+  assertion( tag!=MPI_ANY_TAG );
+  #endif
+
+  if (!_isReceiveBuffer) {
+    _buffer.reserve(bufferSize);
+  }
+}
+
+
+peano::parallel::RunLengthEncodedJoinDataBuffer::~RunLengthEncodedJoinDataBuffer() {
+  logTraceInWith4Arguments( "~RunLengthEncodedJoinDataBuffer()", _numberOfEntries, _numberOfEncodedEntries, _rank, _tag );
+
+  assertion( isEmpty() );
+
+  waitForSentPages();
+
+  logTraceOut( "~RunLengthEncodedJoinDataBuffer()" );
+}
+
+
+void peano::parallel::RunLengthEncodedJoinDataBuffer::encode( const std::vector<int>& values, std::vector<int>& encodedValues ) {
+  std::vector<int>::const_iterator p = values.begin();
+  while (p!=values.end()) {
+    const int value     = *p;
+    int       runLength = 0;
+    while (p!=values.end() && *p==value) {
+      runLength++;
+      p++;
+    }
+    encodedValues.push_back(value);
+    encodedValues.push_back(runLength);
+  }
+}
+
+
+void peano::parallel::RunLengthEncodedJoinDataBuffer::decode( const int* encodedValues, int numberOfEncodedValues, std::vector<int>& values ) {
+  assertion1( numberOfEncodedValues%2==0, numberOfEncodedValues );
+
+  for (int i=0; i<numberOfEncodedValues; i+=2) {
+    assertion2( encodedValues[i+1]>0, i, encodedValues[i+1] );
+    values.insert( values.end(), encodedValues[i+1], encodedValues[i] );
+  }
+}
+
+
+bool peano::parallel::RunLengthEncodedJoinDataBuffer::isReceiveBuffer() const {
+  return _isReceiveBuffer;
+}
+
+
+bool peano::parallel::RunLengthEncodedJoinDataBuffer::isEmpty() const {
+  return _isReceiveBuffer ? _currentElement==static_cast<int>(_buffer.size()) : _buffer.empty();
+}
+
+
+void peano::parallel::RunLengthEncodedJoinDataBuffer::receivePageIfAvailable() {
+  assertion(_isReceiveBuffer);
+
+  #ifdef Parallel
+  int        flag   = 0;
+  MPI_Status status;
+  const int  result = MPI_Iprobe(
+    _rank, _tag,
+    tarch::parallel::Node::getInstance().getCommunicator(),
+    &flag, &status
+  );
+  if (result!=MPI_SUCCESS) {
+    logError(
+      "receivePageIfAvailable()",
+      "probing for messages from node " << _rank
+        << " failed: " << tarch::parallel::MPIReturnValueToString(result)
+    );
+  }
+  if (flag) {
+    logTraceIn( "receivePageIfAvailable()" );
+
+    int messages = 0;
+    MPI_Get_count(&status, MPI_INT, &messages);
+    assertion3( messages>0 && messages%2==0, messages, _bufferSize, tarch::parallel::Node::getInstance().getRank() );
+
+    std::vector<int> encodedPage(messages);
+    const int result = MPI_Recv(
+      encodedPage.data(), messages, MPI_INT, _rank, _tag,
+      tarch::parallel::Node::getInstance().getCommunicator(),
+      &status
+    );
+    if (result!=MPI_SUCCESS) {
+      logError(
+        "receivePageIfAvailable()",
+        "receive of " << messages << " encoded message(s) from node " << _rank
+          << " failed: " << tarch::parallel::MPIReturnValueToString(result)
+      );
+    }
+
+    peano::performanceanalysis::CommunicationMatrix::getInstance().receivedMessages(
+      _rank, peano::performanceanalysis::CommunicationMatrix::Kind::JoinAndForkData, _tag,
+      1, static_cast<long int>(sizeof(int)) * messages
+    );
+
+    const int oldSize = static_cast<int>(_buffer.size());
+    decode( encodedPage.data(), messages, _buffer );
+
+    _numberOfEncodedEntries += messages;
+    _numberOfEntries        += static_cast<int>(_buffer.size()) - oldSize;
+
+    logDebug( "receivePageIfAvailable()", "decoded " << messages << " entries from node " << _rank << " into " << (static_cast<int>(_buffer.size()) - oldSize) << " entries" );
+    logTraceOut( "receivePageIfAvailable()" );
+  }
+  #endif
+}
+
+
+void peano::parallel::RunLengthEncodedJoinDataBuffer::releaseMessages() {
+  assertion(!_isReceiveBuffer);
+
+  logTraceInWith3Arguments( "releaseMessages()", _buffer.size(), _rank, _tag );
+
+  #ifdef Parallel
+  if (!_buffer.empty()) {
+    std::vector<int>* encodedPage = new std::vector<int>();
+    encode( _buffer, *encodedPage );
+
+    const int   encodedEntries = static_cast<int>(encodedPage->size());
+    MPI_Request request;
+    const int   result = MPI_Isend(
+      encodedPage->data(), encodedEntries, MPI_INT, _rank, _tag,
+      tarch::parallel::Node::getInstance().getCommunicator(),
+      &request
+    );
+    if (result!=MPI_SUCCESS) {
+      logError( "releaseMessages()", "send of " << encodedEntries << " encoded message(s) failed: " << tarch::parallel::MPIReturnValueToString(result) );
+    }
+
+    _numberOfPagesInFlight.fetch_add(1);
+    tarch::parallel::ProgressEngine::getInstance().addRequest(
+      request,
+      new tarch::multicore::jobs::GenericJobWithCopyOfFunctor(
+        [this,encodedPage]() -> bool {
+          delete encodedPage;
+          _numberOfPagesInFlight.fetch_sub(1);
+          return false;
+        },
+        tarch::multicore::jobs::JobType::ProcessImmediately,
+        0
+      )
+    );
+
+    peano::performanceanalysis::CommunicationMatrix::getInstance().sentMessages(
+      _rank, peano::performanceanalysis::CommunicationMatrix::Kind::JoinAndForkData, _tag,
+      1, static_cast<long int>(sizeof(int)) * encodedEntries
+    );
+    logDebug( "releaseMessages()", "encoded " << _buffer.size() << " message(s) into " << encodedEntries << " entries for rank " << _rank );
+
+    _numberOfEntries        += static_cast<int>(_buffer.size());
+    _numberOfEncodedEntries += encodedEntries;
+    _buffer.clear();
+  }
+  #endif
+
+  logTraceOut( "releaseMessages()");
+}
+
+
+void peano::parallel::RunLengthEncodedJoinDataBuffer::waitForSentPages() {
+  #ifdef Parallel
+  clock_t      timeOutWarning   = tarch::parallel::Node::getInstance().getDeadlockWarningTimeStamp();
+  clock_t      timeOutShutdown  = tarch::parallel::Node::getInstance().getDeadlockTimeOutTimeStamp();
+  bool         triggeredTimeoutWarning = false;
+
+  while (_numberOfPagesInFlight.load()>0) {
+    if ( tarch::parallel::Node::getInstance().isTimeOutWarningEnabled() && (clock()>timeOutWarning) && (!triggeredTimeoutWarning)) {
+      tarch::parallel::Node::getInstance().writeTimeOutWarning( "peano::parallel::RunLengthEncodedJoinDataBuffer", "waitForSentPages()", _rank, _tag, _numberOfPagesInFlight.load() );
+      triggeredTimeoutWarning = true;
+    }
+    if ( tarch::parallel::Node::getInstance().isTimeOutDeadlockEnabled() && (clock()>timeOutShutdown)) {
+      tarch::parallel::Node::getInstance().triggerDeadlockTimeOut( "peano::parallel::RunLengthEncodedJoinDataBuffer", "waitForSentPages()", _rank, _tag, _numberOfPagesInFlight.load() );
+    }
+    // Node's receiveDanglingMessages() polls the services only if there is
+    // an incoming message, so we drive the engine explicitly.
+    tarch::parallel::ProgressEngine::getInstance().receiveDanglingMessages();
+    tarch::parallel::Node::getInstance().receiveDanglingMessages();
+  }
+  #endif
+}
+
+
+void peano::parallel::RunLengthEncodedJoinDataBuffer::removeTopElementFromStream() {
+  assertion( !isEmpty () );
+  assertion( isReceiveBuffer() );
+  _currentElement++;
+}
+
+
+void peano::parallel::RunLengthEncodedJoinDataBuffer::send( int value ) {
+  assertion(!_isReceiveBuffer);
+
+  _buffer.push_back(value);
+
+  if ( static_cast<int>(_buffer.size())==_bufferSize ) {
+    releaseMessages();
+  }
+}
+
+
+int peano::parallel::RunLengthEncodedJoinDataBuffer::getTopElement() {
+  assertion1( isReceiveBuffer(), tarch::parallel::Node::getInstance().getRank() );
+
+  if (isEmpty()) {
+    logTraceInWith4Arguments( "getTopElement()", "is-empty", _tag, _rank, _buffer.size() );
+
+    const std::clock_t  timeOutWarning          = tarch::parallel::Node::getInstance().getDeadlockWarningTimeStamp();
+    const std::clock_t  timeOutShutdown         = tarch::parallel::Node::getInstance().getDeadlockTimeOutTimeStamp();
+    bool                triggeredTimeoutWarning = false;
+
+    while (isEmpty()) {
+      // deadlock aspect
+      if (
+         tarch::parallel::Node::getInstance().isTimeOutWarningEnabled() &&
+         (clock()>timeOutWarning) &&
+         (!triggeredTimeoutWarning)
+      ) {
+         tarch::parallel::Node::getInstance().writeTimeOutWarning(
+         "peano::parallel::RunLengthEncodedJoinDataBuffer",
+         "getTopElement()", _rank, _tag, 1
+         );
+         triggeredTimeoutWarning = true;
+      }
+      if (
+         tarch::parallel::Node::getInstance().isTimeOutDeadlockEnabled() &&
+         (clock()>timeOutShutdown)
+      ) {
+         tarch::parallel::Node::getInstance().triggerDeadlockTimeOut(
+         "peano::parallel::RunLengthEncodedJoinDataBuffer",
+         "getTopElement()", _rank, _tag, 1
+         );
+      }
+      // call receive indirectly
+      tarch::parallel::Node::getInstance().receiveDanglingMessages();
+    }
+
+    logTraceOutWith1Argument( "getTopElement()", _currentElement );
+  }
+
+  assertion2( !isEmpty(), _buffer.size(), tarch::parallel::Node::getInstance().getRank() );
+  return _buffer[_currentElement];
+}
+
+
+std::string peano::parallel::RunLengthEncodedJoinDataBuffer::toString() const {
+  std::ostringstream msg;
+
+  msg << "("
+      "is-receive-buffer=" << _isReceiveBuffer
+      << ",buffer-size=" << _bufferSize
+      << ",buffered-entries=" << _buffer.size()
+      << ",current-element=" << _currentElement
+      << ",pages-in-flight=" << _numberOfPagesInFlight.load()
+      << ",entries=" << _numberOfEntries
+      << ",encoded-entries=" << _numberOfEncodedEntries
+      << ",rank=" << _rank
+      << ",tag=" << _tag
+      << ")";
+
+  return msg.str();
+}
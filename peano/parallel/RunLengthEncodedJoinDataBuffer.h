@@ -0,0 +1,129 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PARALLEL_RUN_LENGTH_ENCODED_JOIN_DATA_BUFFER_H_
+#define _PEANO_PARALLEL_RUN_LENGTH_ENCODED_JOIN_DATA_BUFFER_H_
+
+
+#include "peano/parallel/JoinDataBuffer.h"
+
+#include "tarch/logging/Log.h"
+#include "tarch/parallel/MPIConstants.h"
+
+#include <vector>
+#include <atomic>
+
+
+namespace peano {
+  namespace parallel {
+    class RunLengthEncodedJoinDataBuffer;
+  }
+}
+
+
+/**
+ * Run-length encoded join data buffer for integers
+ *
+ * Is used by the JoinDataBufferPool for the cell markers if stream
+ * compression is switched on. Cells along the space-filling curve mostly
+ * share their marker: Inside a joined or forked subtree, no adjacent vertex
+ * is adjacent to the master, i.e. the marker is zero for long sequences of
+ * cells. We thus do not send the markers but pairs of marker and number of
+ * repetitions.
+ *
+ * <h2> Overlap with the traversal </h2>
+ *
+ * The sender collects the plain markers. Once bufferSize markers are
+ * collected, it encodes them and hands the encoded page over to a
+ * non-blocking send. The sender then continues with the traversal. The send
+ * request goes to the tarch::parallel::ProgressEngine together with a
+ * continuation that frees the page, i.e. the pages are freed in the
+ * background. Only the destructor waits for the pages still in flight.
+ *
+ * The receiver decodes a page as soon as it is received in
+ * receivePageIfAvailable(). As this operation is called by
+ * receiveDanglingMessages() throughout the traversal, the decoding happens in
+ * the background, too. getTopElement() then returns plain markers.
+ *
+ * @see JoinDataBufferImplementation
+ */
+class peano::parallel::RunLengthEncodedJoinDataBuffer: public peano::parallel::JoinDataBuffer {
+  private:
+    static tarch::logging::Log  _log;
+
+    const bool          _isReceiveBuffer;
+    const int           _bufferSize;
+
+    /**
+     * On the receiver, this is the sequence of all decoded entries. On the
+     * sender, it holds the entries that have not been encoded yet.
+     */
+    std::vector<int>    _buffer;
+
+    /**
+     * Number of encoded pages that are currently sent. The pages themselves
+     * are owned by the continuations handed over to the progress engine.
+     */
+    std::atomic<int>    _numberOfPagesInFlight;
+
+    /**
+     * Only used by the receive buffer.
+     */
+    int                 _currentElement;
+
+    int                 _rank;
+
+    int                 _tag;
+
+    int                 _numberOfEntries;
+    int                 _numberOfEncodedEntries;
+
+    /**
+     * Wait until the progress engine has completed the sends of all pages.
+     */
+    void waitForSentPages();
+  public:
+    RunLengthEncodedJoinDataBuffer(bool isReceiveBuffer, int bufferSize, int rank, int tag );
+
+    /**
+     * Waits until all encoded pages have left the buffer.
+     */
+    virtual ~RunLengthEncodedJoinDataBuffer();
+
+    virtual bool isReceiveBuffer() const;
+
+    virtual bool isEmpty() const;
+
+    /**
+     * Receives an encoded page if there is one and appends its decoded
+     * entries to the buffer.
+     */
+    virtual void receivePageIfAvailable();
+
+    /**
+     * Encodes the entries not sent yet and sends them away in the
+     * background.
+     */
+    virtual void releaseMessages();
+
+    virtual void removeTopElementFromStream();
+
+    void send( int value );
+
+    int getTopElement();
+
+    virtual std::string toString() const;
+
+    /**
+     * Append the run-length encoded values to encodedValues. Each run is
+     * represented by the value followed by its length.
+     */
+    static void encode( const std::vector<int>& values, std::vector<int>& encodedValues );
+
+    /**
+     * Counterpart of encode(). Appends the decoded values to values.
+     */
+    static void decode( const int* encodedValues, int numberOfEncodedValues, std::vector<int>& values );
+};
+
+
+#endif
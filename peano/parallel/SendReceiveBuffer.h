@@ -84,6 +84,21 @@ class peano::parallel::SendReceiveBuffer {
      */
     virtual void releaseSentMessages() = 0;
 
+    /**
+     * Post Sent Messages
+     *
+     * Sends away all messages still stored in the outgoing buffers but does
+     * not wait for the send to complete. The pool calls this operation for
+     * all buffers before it calls releaseSentMessages() for any of them.
+     *
+     * Each buffer has only one send request though. Before a buffer posts
+     * its final page, it thus waits until its previous page has gone out.
+     * The final sends to all partners are in flight at the same time only
+     * if these previous sends have completed, e.g. if a buffer sends one
+     * page per sweep.
+     */
+    virtual void postSentMessages() = 0;
+
     /**
      * Release Sent Messages
      *
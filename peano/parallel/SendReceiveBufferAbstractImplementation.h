@@ -8,6 +8,7 @@
 #include "peano/utils/PeanoOptimisations.h"
 
 #include <vector>
+#include <chrono>
 
 #include "tarch/parallel/MPIConstants.h"
 
@@ -15,6 +16,10 @@ namespace peano {
   namespace parallel {
     template <class Vertex>
     class SendReceiveBufferAbstractImplementation;
+
+    namespace tests {
+      class SendReceiveBufferTest;
+    }
   }
 }
 
@@ -72,6 +77,33 @@ namespace peano {
  *
  * The send/receive buffers use the communication tag 1.
  *
+ * <h2> Adaptive page size </h2>
+ *
+ * The receiver does not rely on the sender's page size. Each receive page
+ * records how many messages it holds and grows if an incoming MPI message is
+ * bigger than its capacity. The sender thus may change _bufferPageSize
+ * from iteration to iteration. If an adaptive page size is enabled (see
+ * setAdaptivePageSize()), releaseSentMessages() measures how many MPI
+ * messages per second the buffer has sent to its partner within the last
+ * iteration. If this rate exceeds a given maximum, the page size is doubled.
+ * If all the data of an iteration fit into a quarter of one page, there is no
+ * overlap of computation and communication anymore and the page size is
+ * halved. Both changes respect a lower and an upper bound.
+ *
+ * Received messages that already belong to the next iteration are not copied
+ * from the receive into the deploy buffer anymore. The pages are swapped
+ * instead.
+ *
+ * <h2> Send requests </h2>
+ *
+ * There are two send buffers but only one send request per buffer. Before
+ * a page is sent, sendBuffer() waits until the previous page has gone out.
+ * So does postSentMessages(), i.e. posting the final pages of all buffers
+ * of a pool might block on each buffer's previous page. Only if a buffer
+ * sends its whole sweep at once (see setSendWholeSweepAtOnce()), there is
+ * no previous page, and the final sends of all buffers are in flight at
+ * the same time.
+ *
  * @image html peano/parallel/parallel_SendReceiveBuffer.gif
  *
  * @image html peano/parallel/parallel_SendReceiveBuffer_Functionality.png
@@ -87,11 +119,52 @@ class peano::parallel::SendReceiveBufferAbstractImplementation: public peano::pa
      */
     static tarch::logging::Log _log;
 
+    friend class peano::parallel::tests::SendReceiveBufferTest;
+
     /**
-     * Maximal size of the send and the receive buffer.
+     * Number of messages per send page, i.e. per MPI message. Is fixed unless
+     * an adaptive page size is enabled.
      */
     int _bufferPageSize;
 
+    /**
+     * If set, the send buffer grows instead of being sent when it is full.
+     * All the vertices of one sweep then go out in one MPI message.
+     */
+    bool _sendWholeSweepAtOnce;
+
+    /**
+     * Bounds for the adaptive page size. The page size is fixed if both are
+     * equal.
+     */
+    int _minimalBufferPageSize;
+    int _maximalBufferPageSize;
+
+    /**
+     * MPI messages per second to one partner beyond which the page size is
+     * increased.
+     */
+    double _maximalMessageRate;
+
+    /**
+     * Number of messages the two send buffers can hold. Is greater or equal to
+     * _bufferPageSize.
+     */
+    int _sendBufferCapacity;
+
+    /**
+     * Number of MPI messages sent since the last releaseSentMessages().
+     */
+    int _numberOfSentPages;
+
+    /**
+     * Time stamp of the first sendVertex() after the last
+     * releaseSentMessages(). We use wall clock time, as clock() measures the
+     * CPU time of the whole process and thus is wrong as soon as several
+     * threads are busy or the rank waits.
+     */
+    std::chrono::steady_clock::time_point _timeStampOfFirstSend;
+
     /**
      * Number of elements sent already.
      */
@@ -155,6 +228,16 @@ class peano::parallel::SendReceiveBufferAbstractImplementation: public peano::pa
      */
     std::vector<MPIDatatypeContainer*> _receiveBuffer[2];
 
+    /**
+     * Number of messages held by each page of the two receive buffers.
+     */
+    std::vector<int>                   _receiveBufferPageSize[2];
+
+    /**
+     * Number of messages each page of the two receive buffers can hold.
+     */
+    std::vector<int>                   _receiveBufferPageCapacity[2];
+
     /**
      * Number of the node this send / receive buffer is communicating with.
      */
@@ -183,7 +266,7 @@ class peano::parallel::SendReceiveBufferAbstractImplementation: public peano::pa
     /**
      * Current receive page. Note that the receive buffer is filled from left
      * to right, i.e. this counter is an increasing one. Since the messages are
-     * send en block (see _bufferPageSize) there's no need for an attribute
+     * send en block (one MPI message per page) there's no need for an attribute
      * _currrentReceiveBufferElement. The counter points to the first free page
      * available, i.e. if it points to 0 no pages have been received.
      */
@@ -225,6 +308,40 @@ class peano::parallel::SendReceiveBufferAbstractImplementation: public peano::pa
      */
     void finishOngoingSendTask();
 
+    /**
+     * Double the capacity and the page size of the send buffers. The
+     * current send buffer's content is preserved. Must not be called if
+     * there's an ongoing send task.
+     */
+    void growSendBuffer();
+
+    /**
+     * Reallocate both send buffers with a new capacity. The first
+     * _sendBufferCurrentPageElement entries of the current send buffer are
+     * preserved, the other send buffer's content is lost. Must not be called
+     * if there's an ongoing send task.
+     */
+    void resizeSendBuffers(int newCapacity);
+
+    /**
+     * Adapt the page size to the message rate of the iteration that has
+     * just been sent completely. Resets the message rate measurement. Has to
+     * be called when there is no ongoing send task, as the send buffers might
+     * be reallocated.
+     */
+    void adaptPageSize();
+
+    /**
+     * Number of pages of the current receive buffer that hold the messages
+     * of the current iteration, i.e. the first _numberOfElementsSent messages.
+     */
+    int getNumberOfReceiveBufferPagesOfCurrentIteration() const;
+
+    /**
+     * @return Number of messages held by a page of the deploy buffer.
+     */
+    int getDeployBufferPageSize(int page) const;
+
     /**
      * Switch Receive And Deploy Buffer
      *
@@ -243,23 +360,21 @@ class peano::parallel::SendReceiveBufferAbstractImplementation: public peano::pa
      *
      * As the operation tries to avoid copying, it interchanges deploy and
      * receive buffers. If the number of received messages exceeds the number of
-     * sent messages, the additional messages thus have to be copied from the
-     * receive buffer into the deploy buffer before the two buffers are
-     * interchanged.
+     * sent messages, the pages holding the additional messages are swapped
+     * with the first pages of the deploy buffer before the two buffers are
+     * interchanged. Received messages are thus never copied.
      *
      * @image html peano/parallel/parallel_SendReceiveBuffer_receivePageIfAvailable.png
      *
      * !!! Algorithm
      *
      * - If neither vertices are sent nor vertices received, return.
-     * - Determine number of pages to transfer: It is the number of sent
-     *   messages divided by buffer size. As it is integer arithmetics, use the
-     *   upper Gaussian bracket.
+     * - Determine number of pages to transfer: The pages' message counts are
+     *   summed up until they equal the number of sent messages.
      * - Determine deploy buffer properties.
-     * - Copy additional blocks from receive buffer to deploy buffer. Start at
-     *   index 0 at deploy buffer.
-     * - _currentReceiveBufferPage is set to number of blocks copied to deploy
-     *   buffer.
+     * - Swap additional pages from receive buffer with deploy buffer pages.
+     *   Start at index 0 at deploy buffer.
+     * - _currentReceiveBufferPage is set to number of pages swapped.
      * - Decrement _sizeOfReceiveBuffer by the number of sent messages.
      * - _numberOfElementsSent becomes zero.
      * - Interchange deploy and receive buffer.
@@ -348,9 +463,34 @@ class peano::parallel::SendReceiveBufferAbstractImplementation: public peano::pa
      */
     int getSizeOfReceiveBuffer() const;
 
+    /**
+     * Enable the adaptive page size.
+     *
+     * The page size passed to the constructor is clamped to the bounds and
+     * serves as initial page size. Pass the same value twice to switch the
+     * adaptivity off again.
+     *
+     * @param maximalMessageRate MPI messages per second to this partner
+     *          beyond which the page size is doubled.
+     */
+    void setAdaptivePageSize(int minimalBufferPageSize, int maximalBufferPageSize, double maximalMessageRate);
+
+    /**
+     * @return Current page size, i.e. number of vertices per MPI message.
+     */
+    int getBufferPageSize() const;
+
+    /**
+     * Collect all the vertices of a sweep and send them as one MPI message
+     * in postSentMessages(). The receiver does not have to know about this
+     * setting. Has to be called before the first vertex is sent.
+     */
+    void setSendWholeSweepAtOnce(bool value);
+
     virtual void receivePageIfAvailable();
     virtual int getNumberOfReceivedMessages() const;
     virtual void releaseSentMessages();
+    virtual void postSentMessages();
     virtual void releaseReceivedMessages(bool);
 };
 
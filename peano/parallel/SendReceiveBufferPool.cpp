@@ -5,17 +5,8 @@
 #include "tarch/parallel/NodePool.h"
 #include "tarch/Assertions.h"
 #include "tarch/timing/Watch.h"
-#include "tarch/multicore/Lock.h"
 
 
-#include "tarch/multicore/Jobs.h"
-
-#include "peano/datatraversal/TaskSet.h"
-
-
-#include <atomic>
-#include <chrono>
-#include <thread>
 
 #include "tarch/services/ServiceFactory.h"
 registerService(peano::parallel::SendReceiveBufferPool)
@@ -28,41 +19,43 @@ tarch::logging::Log
 #ifdef Parallel
 peano::parallel::SendReceiveBufferPool::SendReceiveBufferPool():
   #ifdef MPIUsesItsOwnThread
-  _backgroundThread(nullptr),
+  _progressEngineHandle(tarch::parallel::ProgressEngine::InvalidHandle),
   #endif
   _iterationManagementTag(MPI_ANY_TAG),
   _iterationDataTag(MPI_ANY_TAG),
   _bufferSize(0),
-  _mode(SendAndDeploy) {
+  _minimalBufferSize(0),
+  _maximalBufferSize(0),
+  _maximalMessageRate(0.0),
+  _mode(SendAndDeploy),
+  _exchangeMode(ExchangePagesInBackground) {
   _iterationManagementTag = tarch::parallel::Node::getInstance().reserveFreeTag("SendReceiveBufferPool[it-mgmt]");
   _iterationDataTag       = tarch::parallel::Node::getInstance().reserveFreeTag("SendReceiveBufferPool[it-data]");
 
-  // I originally wanted to spawn a thread immediately here. However, that
-  // seems not to work as the job environment might not have been up (it
-  // seems some stuff here's initialised statically). Therefore, I lazy
-  // kick off the thread in releaseMessages().
-/*
-  #ifdef MPIUsesItsOwnThread
-  _backgroundThread = new BackgroundThread();
-  peano::datatraversal::TaskSet spawnTask(_backgroundThread,peano::datatraversal::TaskSet::TaskType::LongRunningBackground);
-  #endif
-*/
+  // I originally wanted to register at the progress engine immediately here.
+  // However, that seems not to work as the job environment might not have
+  // been up (it seems some stuff here's initialised statically). Therefore, I
+  // lazily register in releaseMessages().
 }
 #else
 peano::parallel::SendReceiveBufferPool::SendReceiveBufferPool():
   _iterationManagementTag(-1),
   _iterationDataTag(-1),
   _bufferSize(0),
-  _mode(SendAndDeploy) {
+  _minimalBufferSize(0),
+  _maximalBufferSize(0),
+  _maximalMessageRate(0.0),
+  _mode(SendAndDeploy),
+  _exchangeMode(ExchangePagesInBackground) {
 }
 #endif
 
 
 peano::parallel::SendReceiveBufferPool::~SendReceiveBufferPool() {
   #if defined(MPIUsesItsOwnThread)
-  if (_backgroundThread != nullptr) {
-    _backgroundThread->switchState(BackgroundThread::State::Terminate);
-    _backgroundThread = nullptr;
+  if (_progressEngineHandle != tarch::parallel::ProgressEngine::InvalidHandle) {
+    tarch::parallel::ProgressEngine::getInstance().deregisterPollingRoutine(_progressEngineHandle);
+    _progressEngineHandle = tarch::parallel::ProgressEngine::InvalidHandle;
   }
   #endif
 
@@ -96,6 +89,18 @@ std::string peano::parallel::SendReceiveBufferPool::toString( SendReceiveMode  m
 }
 
 
+std::string peano::parallel::SendReceiveBufferPool::toString( ExchangeMode  mode) {
+  switch (mode) {
+    case ExchangePagesInBackground:
+      return "exchange-pages-in-background";
+    case ExchangeOncePerSweep:
+      return "exchange-once-per-sweep";
+  }
+
+  return "undef";
+}
+
+
 int peano::parallel::SendReceiveBufferPool::getIterationManagementTag() const {
   #ifdef Parallel
   assertion( _iterationManagementTag!=MPI_ANY_TAG );
@@ -118,23 +123,29 @@ void peano::parallel::SendReceiveBufferPool::receiveDanglingMessages() {
   #if !defined(MPIUsesItsOwnThread)
   receiveDanglingMessagesFromAllBuffersInPool();
   #else
-  if (_backgroundThread==nullptr) {
-    _backgroundThread = new BackgroundThread();
-    peano::datatraversal::TaskSet spawnTask(_backgroundThread,peano::datatraversal::TaskSet::TaskType::BackgroundMPIReceiveTask);
-  }
+  const int pauseToken = tarch::parallel::ProgressEngine::getInstance().pausePollingRoutine(_progressEngineHandle);
+  receiveDanglingMessagesFromAllBuffersInPool();
+  tarch::parallel::ProgressEngine::getInstance().resumePollingRoutine(pauseToken);
+  #endif
+}
+
 
-  if (_backgroundThread->getState()==BackgroundThread::State::Suspend) {
-    receiveDanglingMessagesFromAllBuffersInPool();
+#ifdef MPIUsesItsOwnThread
+void peano::parallel::SendReceiveBufferPool::suspendBackgroundReceives() {
+  if (_progressEngineHandle==tarch::parallel::ProgressEngine::InvalidHandle) {
+    _progressEngineHandle = tarch::parallel::ProgressEngine::getInstance().registerPollingRoutine(
+      "peano::parallel::SendReceiveBufferPool",
+      [this]() -> void {
+        receiveDanglingMessagesFromAllBuffersInPool();
+      },
+      false
+    );
   }
   else {
-    _backgroundThread->switchState(BackgroundThread::State::Suspend);
-
-    receiveDanglingMessagesFromAllBuffersInPool();
-
-    _backgroundThread->switchState(BackgroundThread::State::ReceiveDataInBackground);
+    tarch::parallel::ProgressEngine::getInstance().suspendPollingRoutine(_progressEngineHandle);
   }
-  #endif
 }
+#endif
 
 
 void peano::parallel::SendReceiveBufferPool::receiveDanglingMessagesFromAllBuffersInPool() {
@@ -147,9 +158,9 @@ void peano::parallel::SendReceiveBufferPool::receiveDanglingMessagesFromAllBuffe
 
 void peano::parallel::SendReceiveBufferPool::terminate() {
   #if defined(MPIUsesItsOwnThread)
-  if (_backgroundThread != nullptr) {
-    _backgroundThread->switchState(BackgroundThread::State::Terminate);
-    _backgroundThread = nullptr;
+  if (_progressEngineHandle != tarch::parallel::ProgressEngine::InvalidHandle) {
+    tarch::parallel::ProgressEngine::getInstance().deregisterPollingRoutine(_progressEngineHandle);
+    _progressEngineHandle = tarch::parallel::ProgressEngine::InvalidHandle;
   }
   #endif
 
@@ -168,10 +179,7 @@ void peano::parallel::SendReceiveBufferPool::restart() {
   assertion1( _map.empty(), tarch::parallel::Node::getInstance().getRank() );
 
   #ifdef MPIUsesItsOwnThread
-  if (_backgroundThread==nullptr) {
-    _backgroundThread = new BackgroundThread();
-    peano::datatraversal::TaskSet spawnTask(_backgroundThread,peano::datatraversal::TaskSet::TaskType::BackgroundMPIReceiveTask);
-  }
+  suspendBackgroundReceives();
   #endif
 }
 
@@ -182,12 +190,14 @@ void peano::parallel::SendReceiveBufferPool::releaseMessages() {
   logTraceInWith1Argument( "releaseMessages()", toString(_mode) );
 
   #if defined(MPIUsesItsOwnThread)
-  if (_backgroundThread!=nullptr) {
-    _backgroundThread->switchState(BackgroundThread::State::Suspend);
-  }
+  suspendBackgroundReceives();
   #endif
 
 
+  for (auto& p: _map) {
+    p.second->postSentMessages();
+  }
+
   std::map<int,SendReceiveBuffer*>::iterator p = _map.begin();
   while (  p != _map.end() ) {
     p->second->releaseSentMessages();
@@ -205,12 +215,8 @@ void peano::parallel::SendReceiveBufferPool::releaseMessages() {
   }
 
   #if defined(MPIUsesItsOwnThread)
-  if (_backgroundThread==nullptr) {
-    _backgroundThread = new BackgroundThread();
-    peano::datatraversal::TaskSet spawnTask(_backgroundThread,peano::datatraversal::TaskSet::TaskType::BackgroundMPIReceiveTask);
-  }
-  assertion(_backgroundThread!=nullptr);
-  _backgroundThread->switchState(BackgroundThread::State::ReceiveDataInBackground);
+  assertion(_progressEngineHandle!=tarch::parallel::ProgressEngine::InvalidHandle);
+  tarch::parallel::ProgressEngine::getInstance().activatePollingRoutine(_progressEngineHandle);
   #endif
 
   switch (_mode) {
@@ -240,71 +246,27 @@ void peano::parallel::SendReceiveBufferPool::setBufferSize( int bufferSize ) {
 }
 
 
-peano::parallel::SendReceiveBufferPool::BackgroundThread::BackgroundThread():
-  _semaphore(),
-  _state(peano::parallel::SendReceiveBufferPool::BackgroundThread::State::Suspend) {
-}
-
+void peano::parallel::SendReceiveBufferPool::setAdaptiveBufferSize( int minimalBufferSize, int maximalBufferSize, double maximalMessageRate ) {
+  #ifdef Parallel
+  assertion1( _map.empty(), tarch::parallel::Node::getInstance().getRank() );
+  assertion3( minimalBufferSize>0, minimalBufferSize, maximalBufferSize, tarch::parallel::Node::getInstance().getRank() );
+  assertion3( minimalBufferSize<=maximalBufferSize, minimalBufferSize, maximalBufferSize, tarch::parallel::Node::getInstance().getRank() );
+  assertion2( maximalMessageRate>0.0, maximalMessageRate, tarch::parallel::Node::getInstance().getRank() );
 
-bool peano::parallel::SendReceiveBufferPool::BackgroundThread::operator()() {
-  #if !defined(MPIUsesItsOwnThread)
-  assertionMsg( false, "not never enter this operator" );
+  _minimalBufferSize  = minimalBufferSize;
+  _maximalBufferSize  = maximalBufferSize;
+  _maximalMessageRate = maximalMessageRate;
   #endif
-
-  tarch::multicore::Lock lock(_semaphore);
-  bool result = true;
-
-  switch (_state) {
-    case State::ReceiveDataInBackground:
-      {
-        SendReceiveBufferPool::getInstance().receiveDanglingMessagesFromAllBuffersInPool();
-        // A release fence prevents the memory reordering of any read or write which precedes it in program order with any write which follows it in program order.
-        //std::atomic_thread_fence(std::memory_order_release);
-      }
-      break;
-    case State::Suspend:
-      break;
-    case State::Terminate:
-      result = false;
-      break;
-  }
-
-  lock.free();
-
-  return result;
-}
-
-
-std::string peano::parallel::SendReceiveBufferPool::BackgroundThread::toString() const {
-  return toString(_state);
-}
-
-
-std::string peano::parallel::SendReceiveBufferPool::BackgroundThread::toString(State state) {
-  switch (state) {
-    case State::ReceiveDataInBackground:
-      return "receive-data-in-background";
-    case State::Suspend:
-      return "suspend";
-    case State::Terminate:
-	  return "terminate";
-  }
-
-  return "<undef>";
 }
 
 
-void peano::parallel::SendReceiveBufferPool::BackgroundThread::switchState(State newState ) {
-  logTraceInWith1Argument( "switchState(State)", toString() );
-
-  tarch::multicore::Lock lock(_semaphore);
-  _state = newState;
-
-  logTraceOutWith1Argument( "switchState(State)", toString() );
-}
-
+void peano::parallel::SendReceiveBufferPool::setExchangeMode( ExchangeMode mode ) {
+  #ifdef Parallel
+  assertion1( _map.empty(), tarch::parallel::Node::getInstance().getRank() );
 
-peano::parallel::SendReceiveBufferPool::BackgroundThread::~BackgroundThread() {
+  logInfo( "setExchangeMode(ExchangeMode)", "switch boundary exchange to " << toString(mode) );
+  _exchangeMode = mode;
+  #endif
 }
 
 
@@ -341,10 +303,3 @@ void peano::parallel::SendReceiveBufferPool::exchangeBoundaryVertices(bool value
 bool peano::parallel::SendReceiveBufferPool::deploysValidData() const {
   return _mode==SendAndDeploy || _mode==DeployButDoNotSend;
 }
-
-
-peano::parallel::SendReceiveBufferPool::BackgroundThread::State peano::parallel::SendReceiveBufferPool::BackgroundThread::getState() const {
-  return _state;
-}
-
-
@@ -9,23 +9,20 @@
 #include "tarch/compiler/CompilerSpecificSettings.h"
 #include "tarch/multicore/BooleanSemaphore.h"
 #include "tarch/multicore/MulticoreDefinitions.h"
+#include "tarch/parallel/ProgressEngine.h"
 
 #include "peano/parallel/SendReceiveBuffer.h"
 
-/**
- * With this ifdef, we can define whether the pool shall use a dedicated
- * thread to receive data in the background.
- */
-#if defined(SharedMemoryParallelisation) && defined(MultipleThreadsMayTriggerMPICalls) && defined(Parallel) && !defined(noMPIUsesItsOwnThread) && !defined(MPIUsesItsOwnThread)
-#define MPIUsesItsOwnThread
-#endif
-
 
 #include <map>
 
 namespace peano {
   namespace parallel {
     class SendReceiveBufferPool;
+
+    namespace tests {
+      class SendReceiveBufferTest;
+    }
   }
 }
 
@@ -44,6 +41,31 @@ namespace peano {
  * The buffer management is a lazy management, i.e. buffers required are
  * created on demand.
  *
+ * <h2> Exchange modes </h2>
+ *
+ * By default, each buffer sends a page of vertices as soon as the page is
+ * full. The data thus flows while the traversal continues (see
+ * ExchangePagesInBackground). Alternatively, the pool can exchange the
+ * boundary once per sweep (ExchangeOncePerSweep): each buffer then collects
+ * all vertices of a sweep and sends them as one message in releaseMessages().
+ * This is the communication pattern of a neighbourhood all-to-all over the
+ * ranks the pool holds buffers for. It induces only one message per
+ * neighbour and sweep, but it gives up the overlap of the exchange with the
+ * traversal.
+ *
+ * We do not use MPI's neighbourhood collectives here. Creating a
+ * distributed graph communicator is collective over all ranks of the
+ * original communicator, while idle ranks wait in the node pool and forks
+ * and joins involve only a master and its worker. The pool's buffer map
+ * instead is the neighbour list. It changes automatically whenever a fork
+ * or join changes the neighbours.
+ *
+ * In both modes, releaseMessages() first posts the final sends to all
+ * neighbours and only then waits for them to complete. If the pages are
+ * exchanged in the background, posting the final page of one neighbour
+ * still waits for the page sent to this neighbour before (see
+ * SendReceiveBuffer::postSentMessages()).
+ *
  * @author Tobias Weinzierl
  */
 class peano::parallel::SendReceiveBufferPool: public tarch::services::Service {
@@ -51,6 +73,11 @@ class peano::parallel::SendReceiveBufferPool: public tarch::services::Service {
     enum BufferAccessType {
       LIFO,FIFO
     };
+
+    enum ExchangeMode {
+      ExchangePagesInBackground,
+      ExchangeOncePerSweep
+    };
   private:
     enum SendReceiveMode {
       SendAndDeploy,
@@ -59,43 +86,20 @@ class peano::parallel::SendReceiveBufferPool: public tarch::services::Service {
       NeitherDeployNorSend
     };
 
-    struct BackgroundThread {
-      public:
-        enum class State {
-          ReceiveDataInBackground,
-          Suspend,
-		  Terminate
-        };
-
-        static std::string toString(State state);
-      private:
-        /**
-         * There is only one background thread object from the pool's point of
-         * view. However, we deploy the thread as a task of its own. Then, it
-         * is copied. However, as all copies of the thread shall share one state
-         * and one semaphore, I have to make all attributes static. As a
-         * consequence, any instance seems to be an object but indeed it is only
-         * a lightweight object wrapper around global data.
-         */
-        tarch::multicore::BooleanSemaphore  _semaphore;
-        State                               _state;
-        BackgroundThread(const BackgroundThread&) = delete;
-      public:
-        BackgroundThread();
-        virtual ~BackgroundThread();
-        bool operator()();
-        std::string toString() const;
-        void switchState( State newState );
-        State getState() const;
-    };
-
     #ifdef MPIUsesItsOwnThread
     /**
-     * We hold a pointer to the background thread object, but we do not delete
-     * it as it is passed into Peano's job interface. This job interface has
-     * the responsibility to delete all job objects.
+     * Handle of the pool's polling routine within the progress engine. The
+     * routine is registered lazily, as the engine's thread should not be
+     * launched before the multicore environment is up.
+     *
+     * @see tarch::parallel::ProgressEngine
+     */
+    int _progressEngineHandle;
+
+    /**
+     * Register at progress engine if not done yet and suspend the polling.
      */
-    BackgroundThread* _backgroundThread;
+    void suspendBackgroundReceives();
     #endif
 
     static tarch::logging::Log _log;
@@ -120,8 +124,21 @@ class peano::parallel::SendReceiveBufferPool: public tarch::services::Service {
      */
     int _bufferSize;
 
+    /**
+     * Bounds of the adaptive page size. Both are 0 if the page size is fixed.
+     *
+     * @see setAdaptiveBufferSize()
+     */
+    int _minimalBufferSize;
+    int _maximalBufferSize;
+    double _maximalMessageRate;
+
     SendReceiveMode _mode;
 
+    ExchangeMode    _exchangeMode;
+
+    friend class peano::parallel::tests::SendReceiveBufferTest;
+
     SendReceiveBufferPool();
 
     /**
@@ -130,6 +147,7 @@ class peano::parallel::SendReceiveBufferPool: public tarch::services::Service {
     SendReceiveBufferPool(const SendReceiveBufferPool& copy) {}
 
     static std::string toString( SendReceiveMode  mode);
+    static std::string toString( ExchangeMode  mode);
 
   public:
     /**
@@ -320,6 +338,35 @@ class peano::parallel::SendReceiveBufferPool: public tarch::services::Service {
      */
     void setBufferSize( int bufferSize );
 
+    /**
+     * Let the buffers adapt their page size
+     *
+     * By default, each buffer sends one MPI message per bufferSize vertices.
+     * Small pages allow the receiver to receive in the background early but
+     * induce many messages. With this operation, each buffer adapts its page
+     * size within the given bounds per iteration: If it sends more than
+     * maximalMessageRate MPI messages per second to its partner, it doubles
+     * the page size. If all the vertices of an iteration fit into a quarter
+     * of a page, it halves the page size. The buffer size set via
+     * setBufferSize() is the initial page size. See
+     * SendReceiveBufferAbstractImplementation for details.
+     *
+     * As the receivers cope with any page size, the ranks do not have to agree
+     * on the bounds. Like setBufferSize(), this operation has to be called
+     * before any buffer is created.
+     */
+    void setAdaptiveBufferSize( int minimalBufferSize, int maximalBufferSize, double maximalMessageRate = 1.0e4 );
+
+    /**
+     * Choose how the boundary data is exchanged. See the class
+     * documentation. In ExchangeOncePerSweep, the buffer size set via
+     * setBufferSize() is the initial capacity of the send buffers, and an
+     * adaptive buffer size is ignored. The receivers cope with both modes, so
+     * the ranks do not have to agree on the mode. Has to be called before any
+     * buffer is created.
+     */
+    void setExchangeMode( ExchangeMode mode );
+
     /**
      * Switch data send and received on/off.
      *
@@ -0,0 +1,181 @@
+#include "peano/parallel/benchmarks/TimeToFork.h"
+#include "peano/parallel/ForkMessageBatch.h"
+#include "peano/parallel/Partitioner.h"
+#include "peano/parallel/messages/ForkMessage.h"
+
+#include "tarch/parallel/Node.h"
+#include "tarch/parallel/NodePool.h"
+#include "tarch/timing/Watch.h"
+#include "tarch/Assertions.h"
+
+
+#include <fstream>
+#include <sstream>
+
+
+tarch::logging::Log  peano::parallel::benchmarks::TimeToFork::_log( "peano::parallel::benchmarks::TimeToFork" );
+
+
+peano::parallel::benchmarks::TimeToFork::TimeToFork(int numberOfSamples):
+  _numberOfSamples(numberOfSamples),
+  _tag(-1) {
+  assertion1( numberOfSamples>=1, numberOfSamples );
+  #ifdef Parallel
+  _tag = tarch::parallel::Node::reserveFreeTag( "peano::parallel::benchmarks::TimeToFork[acknowledgement]" );
+  #endif
+}
+
+
+peano::parallel::benchmarks::TimeToFork::~TimeToFork() {
+  #ifdef Parallel
+  tarch::parallel::Node::releaseTag( _tag );
+  #endif
+}
+
+
+double peano::parallel::benchmarks::TimeToFork::fork(int numberOfWorkers, bool batched) {
+  double result = -1.0;
+
+  #ifdef Parallel
+  tarch::timing::Watch watch( "peano::parallel::benchmarks::TimeToFork", "fork(int,bool)", false );
+
+  const std::vector<int> workers = tarch::parallel::NodePool::getInstance().reserveFreeNodes(numberOfWorkers);
+
+  peano::parallel::messages::ForkMessage message;
+  message.setDomainOffset( 0.0 );
+  message.setH( 1.0 );
+  message.setLevel( 1 );
+  message.setPositionOfFineGridCellRelativeToCoarseGridCell( 0 );
+
+  ForkMessageBatch batch( tarch::parallel::NodePool::getInstance().getTagForForkMessages() );
+  for (int worker: workers) {
+    if (batched) {
+      batch.send( message, worker );
+    }
+    else {
+      message.send( worker, tarch::parallel::NodePool::getInstance().getTagForForkMessages(), true, SendAndReceiveLoadBalancingMessagesBlocking );
+    }
+  }
+  batch.waitForForkMessages();
+
+  int receivedAcknowledgements = 0;
+  while (receivedAcknowledgements<static_cast<int>(workers.size())) {
+    MPI_Status status;
+    int        flag = 0;
+    MPI_Iprobe( MPI_ANY_SOURCE, _tag, tarch::parallel::Node::getInstance().getCommunicator(), &flag, &status );
+    if (flag) {
+      MPI_Recv( 0, 0, MPI_INT, status.MPI_SOURCE, _tag, tarch::parallel::Node::getInstance().getCommunicator(), MPI_STATUS_IGNORE );
+      receivedAcknowledgements++;
+    }
+    else {
+      tarch::parallel::Node::getInstance().receiveDanglingMessages();
+    }
+  }
+
+  watch.stopTimer();
+
+  if (static_cast<int>(workers.size())==numberOfWorkers) {
+    result = watch.getCalendarTime();
+  }
+  else {
+    logWarning( "fork(int,bool)", "node pool delivered only " << workers.size() << " of " << numberOfWorkers << " worker(s)" );
+  }
+
+  tarch::parallel::NodePool::getInstance().waitForAllNodesToBecomeIdle();
+  #endif
+
+  return result;
+}
+
+
+void peano::parallel::benchmarks::TimeToFork::serveAsWorker() {
+  #ifdef Parallel
+  tarch::parallel::NodePool::JobRequestMessageAnswer answer = tarch::parallel::NodePool::getInstance().waitForJob();
+  while (answer!=tarch::parallel::NodePool::JobRequestMessageAnswerValues::Terminate) {
+    if (answer>=0) {
+      peano::parallel::messages::ForkMessage message;
+      message.receive( answer, tarch::parallel::NodePool::getInstance().getTagForForkMessages(), true, SendAndReceiveLoadBalancingMessagesBlocking );
+      MPI_Send( 0, 0, MPI_INT, answer, _tag, tarch::parallel::Node::getInstance().getCommunicator() );
+    }
+    answer = tarch::parallel::NodePool::getInstance().waitForJob();
+  }
+  #endif
+}
+
+
+bool peano::parallel::benchmarks::TimeToFork::run(const std::vector<int>& numberOfWorkers, const std::string& tableFilename) {
+  #if !defined(Parallel)
+  logError( "run(...)", "time-to-fork benchmark requires the code to be translated with MPI" );
+  return false;
+  #else
+  peano::parallel::Partitioner::initDatatypes();
+
+  if (!tarch::parallel::Node::getInstance().isGlobalMaster()) {
+    serveAsWorker();
+    return true;
+  }
+
+  logInfo( "run(...)", "start time-to-fork benchmark " << toString() );
+
+  tarch::parallel::NodePool::getInstance().waitForAllNodesToBecomeIdle();
+
+  bool               result = true;
+  std::ostringstream table;
+  table << "workers,sequential[s],batched[s]" << std::endl;
+
+  for (int workers: numberOfWorkers) {
+    if (workers>=tarch::parallel::Node::getInstance().getNumberOfNodes()) {
+      logWarning( "run(...)", "skip fork into " << workers << " worker(s), as there are only " << tarch::parallel::Node::getInstance().getNumberOfNodes() << " rank(s)" );
+      result = false;
+      continue;
+    }
+
+    double sequentialTime = 0.0;
+    double batchedTime    = 0.0;
+    for (int sample=0; sample<_numberOfSamples; sample++) {
+      const double sequentialSample = fork(workers,false);
+      const double batchedSample    = fork(workers,true);
+      result &= sequentialSample>=0.0 && batchedSample>=0.0;
+      sequentialTime += sequentialSample;
+      batchedTime    += batchedSample;
+    }
+    sequentialTime /= _numberOfSamples;
+    batchedTime    /= _numberOfSamples;
+
+    logInfo(
+      "run(...)",
+      "fork into " << workers << " worker(s): sequential=" << sequentialTime << "s, batched=" << batchedTime << "s"
+    );
+    table << workers << "," << sequentialTime << "," << batchedTime << std::endl;
+  }
+
+  tarch::parallel::NodePool::getInstance().terminate();
+
+  if (tableFilename.empty()) {
+    logInfo( "run(...)", table.str() );
+  }
+  else {
+    std::ofstream file( tableFilename.c_str() );
+    if (file.is_open()) {
+      file << table.str();
+      logInfo( "run(...)", "wrote measurements to " << tableFilename );
+    }
+    else {
+      logError( "run(...)", "could not write " << tableFilename );
+      result = false;
+    }
+  }
+
+  return result;
+  #endif
+}
+
+
+std::string peano::parallel::benchmarks::TimeToFork::toString() const {
+  std::ostringstream msg;
+  msg << "(samples=" << _numberOfSamples
+      << ",ranks=" << tarch::parallel::Node::getInstance().getNumberOfNodes()
+      << ",dimensions=" << DIMENSIONS
+      << ")";
+  return msg.str();
+}
@@ -0,0 +1,106 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PARALLEL_BENCHMARKS_TIME_TO_FORK_H_
+#define _PEANO_PARALLEL_BENCHMARKS_TIME_TO_FORK_H_
+
+
+#include "tarch/logging/Log.h"
+
+
+#include <string>
+#include <vector>
+
+
+namespace peano {
+  namespace parallel {
+    namespace benchmarks {
+      class TimeToFork;
+    }
+  }
+}
+
+
+/**
+ * Time-to-fork benchmark
+ *
+ * Measures how long the global master needs to fork into a given number of
+ * new workers: the time from the request at the node pool until all workers
+ * have received their fork message. The benchmark does not build a grid.
+ * The master books the workers through NodePool::reserveFreeNodes() and
+ * sends them synthetic fork messages, and every worker acknowledges its fork
+ * message with an empty message. Afterwards, the workers go back to the node
+ * pool.
+ *
+ * Each measurement is done twice:
+ *
+ * - sequential: one fork message after another, each send completed before
+ *   the next one starts. This is what the partitioner did before it used
+ *   ForkMessageBatch.
+ * - batched: all fork messages are posted at once through a
+ *   ForkMessageBatch. This is what Partitioner::sendForkMessages() does.
+ *
+ * Both variants reserve the workers the same way, i.e. with one answer
+ * message per worker, and neither streams out any subtree data. On a single
+ * host with 82 ranks, the two variants have been within noise of each other
+ * for 9, 27 and 81 workers, as the fork messages are small eager sends over
+ * shared memory.
+ *
+ * <h2> Usage </h2>
+ *
+ * There is no main in the Peano sources. Write a main that initialises the
+ * parallel environment (peano::initParallelEnvironment()) and restarts the
+ * node pool on all ranks. Then, all ranks create a TimeToFork and call run()
+ * with the same arguments. The global master measures, all other ranks serve
+ * as workers until the global master terminates the node pool. To measure a
+ * fork into 9, 27 and 81 workers on a single host, start the code with at
+ * least 82 ranks, e.g.
+ *
+ * <pre>
+  mpirun -np 82 --oversubscribe ./time-to-fork
+   </pre>
+ *
+ * Worker counts for which there are not enough ranks are skipped.
+ */
+class peano::parallel::benchmarks::TimeToFork {
+  private:
+    static tarch::logging::Log  _log;
+
+    const int   _numberOfSamples;
+
+    /**
+     * Tag of the acknowledgements.
+     */
+    int         _tag;
+
+    /**
+     * Fork into numberOfWorkers and wait for all acknowledgements.
+     *
+     * @return Time in seconds or a negative value if the node pool could
+     *         not deliver enough workers.
+     */
+    double fork(int numberOfWorkers, bool batched);
+
+    void serveAsWorker();
+  public:
+    /**
+     * @param numberOfSamples Forks per worker count and protocol. We report
+     *          the average.
+     */
+    TimeToFork(int numberOfSamples=16);
+    ~TimeToFork();
+
+    /**
+     * Run the benchmark. Has to be called on all ranks.
+     *
+     * @param tableFilename File for the measurement table. Empty string
+     *          means we write the table to the info log.
+     * @return Whether all measurements have been done. Always false if the
+     *         code is translated without MPI.
+     */
+    bool run(const std::vector<int>& numberOfWorkers, const std::string& tableFilename);
+
+    std::string toString() const;
+};
+
+
+#endif
@@ -20,7 +20,10 @@ peano::parallel::loadbalancing::Oracle::Oracle():
   _workers(),
   _startCommand(peano::parallel::loadbalancing::LoadBalancingFlag::ForkAllChildrenAndBecomeAdministrativeRank),
   _loadBalancingActivated(true),
-  _numberOfOracles(0) {
+  _numberOfOracles(0),
+  _beginOfIteration(std::chrono::steady_clock::now()),
+  _beginToReceiveDataFromWorker(std::chrono::steady_clock::now()),
+  _startupOfWorker() {
 }
 
 
@@ -79,6 +82,7 @@ void peano::parallel::loadbalancing::Oracle::removeWorker(int rank) {
         p->_persistentRecords._level
       );
       _workers.erase( p );
+      _startupOfWorker.erase( rank );
       return;
     }
   }
@@ -251,6 +255,8 @@ peano::parallel::loadbalancing::LoadBalancingFlag peano::parallel::loadbalancing
 
   joinIsAllowed &= !tarch::parallel::Node::getInstance().isGlobalMaster();
 
+  _startupOfWorker[workerRank] = std::chrono::steady_clock::now();
+
   peano::parallel::loadbalancing::LoadBalancingFlag result = LoadBalancingFlag::UndefinedLoadBalancingFlag;
   if (_oraclePrototype==0) {
     logWarning( "getCommandForWorker(int)", "no oracle type configured. Perhaps forgot to call peano::kernel::loadbalancing::Oracle::setOracle()" );
@@ -353,3 +359,40 @@ std::vector<peano::parallel::loadbalancing::WorkerEntry> peano::parallel::loadba
   return result;
 }
 #endif
+
+
+void peano::parallel::loadbalancing::Oracle::beginIteration() {
+  _beginOfIteration = std::chrono::steady_clock::now();
+}
+
+
+void peano::parallel::loadbalancing::Oracle::endIteration(double numberOfLocalCells) {
+  const double traversalTime = std::chrono::duration<double>( std::chrono::steady_clock::now()-_beginOfIteration ).count();
+
+  if (_oraclePrototype!=0) {
+    assertion( _currentOracle>=0 );
+    assertion( _currentOracle<static_cast<int>(_oracles.size()));
+    _oracles[_currentOracle]->endIteration(numberOfLocalCells,traversalTime);
+  }
+}
+
+
+void peano::parallel::loadbalancing::Oracle::beginToReceiveDataFromWorker() {
+  _beginToReceiveDataFromWorker = std::chrono::steady_clock::now();
+}
+
+
+void peano::parallel::loadbalancing::Oracle::endToReceiveDataFromWorker(int workerRank, double numberOfWorkerCells) {
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+  if (_oraclePrototype!=0 && _startupOfWorker.count(workerRank)>0) {
+    assertion( _currentOracle>=0 );
+    assertion( _currentOracle<static_cast<int>(_oracles.size()));
+    _oracles[_currentOracle]->receivedWorkerStatistics(
+      workerRank,
+      numberOfWorkerCells,
+      std::chrono::duration<double>( now-_startupOfWorker[workerRank] ).count(),
+      std::chrono::duration<double>( now-_beginToReceiveDataFromWorker ).count()
+    );
+  }
+}
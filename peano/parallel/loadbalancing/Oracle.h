@@ -11,6 +11,8 @@
 #include "peano/utils/Globals.h"
 
 
+#include <chrono>
+#include <map>
 #include <vector>
 
 
@@ -85,6 +87,15 @@ class peano::parallel::loadbalancing::Oracle {
 
     int                                      _numberOfOracles;
 
+    std::chrono::steady_clock::time_point    _beginOfIteration;
+    std::chrono::steady_clock::time_point    _beginToReceiveDataFromWorker;
+
+    /**
+     * Time stamps of the last getCommandForWorker() call per worker, i.e. of
+     * the worker startups.
+     */
+    std::map<int,std::chrono::steady_clock::time_point>  _startupOfWorker;
+
     void createOracles();
     void deleteOracles();
 
@@ -269,6 +280,35 @@ class peano::parallel::loadbalancing::Oracle {
      */
     void activateLoadBalancing(bool value);
 
+    /**
+     * Start the time measurement of the local traversal. Is invoked by the
+     * grid.
+     */
+    void beginIteration();
+
+    /**
+     * Hand the local runtime statistics over to the active oracle. Is invoked
+     * by the grid.
+     *
+     * @see OracleForOnePhase::endIteration()
+     */
+    void endIteration(double numberOfLocalCells);
+
+    /**
+     * Is invoked by the nodes before they receive reduction data from a
+     * worker.
+     */
+    void beginToReceiveDataFromWorker();
+
+    /**
+     * Hand the worker's runtime statistics over to the active oracle. Is
+     * invoked by the nodes once they have received the worker's reduction
+     * data.
+     *
+     * @see OracleForOnePhase::receivedWorkerStatistics()
+     */
+    void endToReceiveDataFromWorker(int workerRank, double numberOfWorkerCells);
+
     bool isLoadBalancingActivated() const;
 };
 
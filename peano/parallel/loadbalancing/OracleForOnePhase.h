@@ -141,6 +141,36 @@ class peano::parallel::loadbalancing::OracleForOnePhase {
      * @see Oracle::getRegularLevelAlongBoundary()
      */
     virtual int getRegularLevelAlongBoundary() const = 0;
+
+    /**
+     * Local runtime statistics
+     *
+     * Is invoked at the end of each traversal of the local tree. Oracles that
+     * do not need runtime data may ignore this call.
+     *
+     * @param numberOfLocalCells Number of cells held by this rank.
+     * @param traversalTime      Calendar time of the whole local traversal in
+     *          seconds, i.e. including the time spent waiting for workers.
+     */
+    virtual void endIteration(double numberOfLocalCells, double traversalTime) {}
+
+    /**
+     * Runtime statistics of one worker
+     *
+     * Is invoked whenever the local rank has received the reduction data from
+     * a worker.
+     *
+     * @param numberOfWorkerCells Number of cells of the worker's subtree. This
+     *          information is available only if TrackGridStatistics is set.
+     *          Otherwise, it is -1.
+     * @param workerTime Calendar time in seconds between the startup of the
+     *          worker through getCommandForWorker() and the end of the
+     *          reduction, i.e. the time after which the worker's results have
+     *          been available on this rank.
+     * @param waitTime Calendar time in seconds this rank has waited for the
+     *          worker's reduction data.
+     */
+    virtual void receivedWorkerStatistics(int workerRank, double numberOfWorkerCells, double workerTime, double waitTime) {}
 };
 
 
@@ -0,0 +1,183 @@
+#include "peano/parallel/loadbalancing/OracleForOnePhaseWithCostModel.h"
+
+#include "tarch/Assertions.h"
+
+
+#include <algorithm>
+
+
+tarch::logging::Log peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::_log( "peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel" );
+
+
+peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::OracleForOnePhaseWithCostModel(
+  bool    joinsAllowed,
+  bool    forksAllowed,
+  int     regularLevelAlongBoundary,
+  double  minimalRelativeImprovement,
+  double  remainingWorkAfterFork
+):
+  _joinsAllowed(joinsAllowed),
+  _forksAllowed(forksAllowed),
+  _regularLevelAlongBoundary(regularLevelAlongBoundary),
+  _minimalRelativeImprovement(minimalRelativeImprovement),
+  _remainingWorkAfterFork(remainingWorkAfterFork),
+  _forkHasFailed(false),
+  _traversalTime(-1.0),
+  _numberOfLocalCells(-1.0),
+  _workerStatistics(),
+  _workersWithCommandInCurrentTraversal(),
+  _numberOfForks(0),
+  _numberOfJoins(0) {
+  assertion1( minimalRelativeImprovement>=0.0 && minimalRelativeImprovement<1.0, minimalRelativeImprovement );
+  assertion1( remainingWorkAfterFork>0.0 && remainingWorkAfterFork<1.0, remainingWorkAfterFork );
+}
+
+
+peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::~OracleForOnePhaseWithCostModel() {
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::receivedStartCommand(LoadBalancingFlag commandFromMaster ) {
+  if (commandFromMaster==LoadBalancingFlag::Join) {
+    _workerStatistics.clear();
+  }
+}
+
+
+double peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::getCostPerLocalCell() const {
+  if (_numberOfLocalCells<=0.0) {
+    return -1.0;
+  }
+
+  double busyTime = _traversalTime;
+  for (const auto& p: _workerStatistics) {
+    busyTime -= p.second.waitTime;
+  }
+  return std::max(0.0,busyTime) / _numberOfLocalCells;
+}
+
+
+double peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::getPredictedTraversalTimeAfterFork(int workerRank) const {
+  if (_traversalTime<0.0 || _workerStatistics.count(workerRank)==0) {
+    return -1.0;
+  }
+
+  const WorkerStatistics& worker = _workerStatistics.at(workerRank);
+  return _traversalTime - std::min( worker.waitTime, (1.0-_remainingWorkAfterFork) * worker.workerTime );
+}
+
+
+double peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::getPredictedTraversalTimeAfterJoin(int workerRank) const {
+  if (_traversalTime<0.0 || _workerStatistics.count(workerRank)==0) {
+    return -1.0;
+  }
+
+  const WorkerStatistics& worker      = _workerStatistics.at(workerRank);
+  const double            costPerCell = getCostPerLocalCell();
+  const double            joinCost    =
+    (worker.numberOfCells>=0.0 && costPerCell>=0.0) ? worker.numberOfCells * costPerCell : worker.workerTime;
+
+  return _traversalTime - worker.waitTime + joinCost;
+}
+
+
+peano::parallel::loadbalancing::LoadBalancingFlag peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::getCommandForWorker( int workerRank, bool forkIsAllowed, bool joinIsAllowed ) {
+  logTraceInWith3Arguments( "getCommandForWorker(int,bool,bool)", workerRank, forkIsAllowed, joinIsAllowed );
+
+  LoadBalancingFlag result = LoadBalancingFlag::Continue;
+
+  const bool mayJoin = joinIsAllowed && _joinsAllowed;
+  const bool mayFork = forkIsAllowed && _forksAllowed && !_forkHasFailed;
+
+  if ( _traversalTime>=0.0 && _workerStatistics.count(workerRank)>0 ) {
+    const double threshold       = (1.0-_minimalRelativeImprovement) * _traversalTime;
+    const double timeAfterFork   = getPredictedTraversalTimeAfterFork(workerRank);
+    const double timeAfterJoin   = getPredictedTraversalTimeAfterJoin(workerRank);
+    // cell count is -1 without TrackGridStatistics, i.e. we then never
+    // identify idle workers
+    const bool   workerIsIdle    = _workerStatistics[workerRank].numberOfCells==0.0;
+
+    if (mayJoin && workerIsIdle) {
+      result = LoadBalancingFlag::Join;
+    }
+    else if (mayJoin && timeAfterJoin<threshold && (!mayFork || timeAfterJoin<=timeAfterFork)) {
+      result = LoadBalancingFlag::Join;
+    }
+    else if (mayFork && timeAfterFork<threshold) {
+      result = LoadBalancingFlag::ForkOnce;
+    }
+
+    if (result!=LoadBalancingFlag::Continue) {
+      logInfo(
+        "getCommandForWorker(int,bool,bool)",
+        "send " << convertLoadBalancingFlagToString(result) << " to rank " << workerRank <<
+        ": traversal time=" << _traversalTime <<
+        ", predicted time after fork=" << timeAfterFork <<
+        ", predicted time after join=" << timeAfterJoin <<
+        ", worker time=" << _workerStatistics[workerRank].workerTime <<
+        ", wait time=" << _workerStatistics[workerRank].waitTime <<
+        ", worker cells=" << _workerStatistics[workerRank].numberOfCells
+      );
+
+      _workerStatistics.erase(workerRank);
+      _workersWithCommandInCurrentTraversal.insert(workerRank);
+      if (result==LoadBalancingFlag::Join) {
+        _numberOfJoins++;
+      }
+      else {
+        _numberOfForks++;
+      }
+    }
+  }
+
+  logTraceOutWith1Argument( "getCommandForWorker(int,bool,bool)", convertLoadBalancingFlagToString(result) );
+  return result;
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::endIteration(double numberOfLocalCells, double traversalTime) {
+  logTraceInWith2Arguments( "endIteration(double,double)", numberOfLocalCells, traversalTime );
+
+  _numberOfLocalCells = numberOfLocalCells;
+  _traversalTime      = traversalTime;
+  _forkHasFailed      = false;
+  _workersWithCommandInCurrentTraversal.clear();
+
+  logTraceOut( "endIteration(double,double)" );
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::receivedWorkerStatistics(int workerRank, double numberOfWorkerCells, double workerTime, double waitTime) {
+  logTraceInWith4Arguments( "receivedWorkerStatistics(int,double,double,double)", workerRank, numberOfWorkerCells, workerTime, waitTime );
+
+  if (_workersWithCommandInCurrentTraversal.count(workerRank)==0) {
+    _workerStatistics[workerRank] = WorkerStatistics{ numberOfWorkerCells, workerTime, waitTime };
+  }
+
+  logTraceOut( "receivedWorkerStatistics(int,double,double,double)" );
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::plotStatistics() {
+  logInfo(
+    "plotStatistics()",
+    "forks=" << _numberOfForks << ", joins=" << _numberOfJoins <<
+    ", last traversal time=" << _traversalTime << ", workers with statistics=" << _workerStatistics.size()
+  );
+}
+
+
+int peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::getRegularLevelAlongBoundary() const {
+  return _regularLevelAlongBoundary;
+}
+
+
+peano::parallel::loadbalancing::OracleForOnePhase* peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::createNewOracle(int adapterNumber) const {
+  return new OracleForOnePhaseWithCostModel(_joinsAllowed,_forksAllowed,_regularLevelAlongBoundary,_minimalRelativeImprovement,_remainingWorkAfterFork);
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel::forkFailed() {
+  logInfo( "forkFailed()", "fork has failed, i.e. there are no idle ranks to realise the predicted improvement. No further forks until the end of the traversal" );
+  _forkHasFailed = true;
+}
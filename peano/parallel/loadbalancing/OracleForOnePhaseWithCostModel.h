@@ -0,0 +1,173 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PARALLEL_LOADBALANCING_ORACLE_FOR_ONE_PHASE_WITH_COST_MODEL_H_
+#define _PEANO_PARALLEL_LOADBALANCING_ORACLE_FOR_ONE_PHASE_WITH_COST_MODEL_H_
+
+
+#include "peano/parallel/loadbalancing/OracleForOnePhase.h"
+#include "tarch/logging/Log.h"
+
+
+#include <map>
+#include <set>
+
+
+namespace peano {
+  namespace parallel {
+    namespace loadbalancing {
+      class OracleForOnePhaseWithCostModel;
+    }
+  }
+}
+
+
+/**
+ * Oracle with a Cost Model
+ *
+ * The greedy oracle forks as long as there are idle ranks and does not know
+ * how much work its workers actually do. This oracle collects runtime data
+ * and issues a fork or join only if it predicts that the local traversal time
+ * drops. As every rank's traversal time includes the time it waits for its
+ * workers, the local traversal time is the time of the critical path through
+ * the local subtree of the rank topology. Improving it locally on each rank
+ * thus improves the global critical path.
+ *
+ * <h2> Measurements </h2>
+ *
+ * From the previous traversal, the oracle knows
+ *
+ * - the local traversal time T and the number of local cells,
+ * - per worker w the time @f$ t_w @f$ between the worker's startup and the
+ *   end of its reduction, and the time @f$ w_w @f$ the local rank has waited
+ *   for the worker's reduction data, and
+ * - per worker the number of cells of its subtree if TrackGridStatistics is
+ *   set.
+ *
+ * See OracleForOnePhase::endIteration() and
+ * OracleForOnePhase::receivedWorkerStatistics().
+ *
+ * <h2> Cost model </h2>
+ *
+ * The local rank is busy for @f$ T - \sum _w w_w @f$. Divided by the number
+ * of local cells, this yields the local cost per cell.
+ *
+ * - A fork (ForkOnce) splits up a worker's work. We assume that the worker
+ *   keeps the fraction remainingWorkAfterFork of its time. The local rank
+ *   then waits at most @f$ (1-remainingWorkAfterFork) t_w @f$ less for the
+ *   worker.
+ * - A join moves the worker's cells to the local rank. The local rank does
+ *   not wait for the worker anymore but has to process the worker's cells
+ *   with the local cost per cell. If the number of the worker's cells is not
+ *   known, we assume that the local rank needs @f$ t_w @f$ for them, i.e. a
+ *   join never pays off.
+ *
+ * The oracle picks the command with the smaller predicted traversal time. If
+ * this time is not at least by minimalRelativeImprovement smaller than T, the
+ * worker continues. Workers without any cells are always joined if joins are
+ * allowed, as they then block ranks that could be used elsewhere.
+ *
+ * Without TrackGridStatistics, the oracle knows neither the worker's cells
+ * nor whether a worker is empty. It then never predicts a gain for a join
+ * and does not join empty workers either, i.e. it only forks.
+ *
+ * <h2> Hysteresis </h2>
+ *
+ * The oracle bases a decision on a worker on the worker's measurements of
+ * the previous traversal. Once it has issued a fork or join for a worker, it
+ * throws away the worker's data and ignores the data of the traversal in
+ * which the command has been issued. As a consequence, each worker gets at
+ * most every second traversal a command. If a fork fails, the oracle does
+ * not try to fork anymore until the end of the traversal.
+ */
+class peano::parallel::loadbalancing::OracleForOnePhaseWithCostModel: public peano::parallel::loadbalancing::OracleForOnePhase {
+  private:
+    static tarch::logging::Log  _log;
+
+    struct WorkerStatistics {
+      double  numberOfCells;
+      double  workerTime;
+      double  waitTime;
+    };
+
+    const bool                   _joinsAllowed;
+    const bool                   _forksAllowed;
+    const int                    _regularLevelAlongBoundary;
+    const double                 _minimalRelativeImprovement;
+    const double                 _remainingWorkAfterFork;
+
+    bool                         _forkHasFailed;
+
+    /**
+     * Is negative as long as there has not been any traversal.
+     */
+    double                       _traversalTime;
+    double                       _numberOfLocalCells;
+
+    std::map<int,WorkerStatistics>  _workerStatistics;
+
+    /**
+     * Workers that have received a fork or join command in the current
+     * traversal. Their statistics are ignored until the traversal has
+     * terminated.
+     */
+    std::set<int>                _workersWithCommandInCurrentTraversal;
+
+    int                          _numberOfForks;
+    int                          _numberOfJoins;
+
+    /**
+     * Local cost per cell or -1 if there are no local cells.
+     */
+    double getCostPerLocalCell() const;
+  public:
+    /**
+     * @param minimalRelativeImprovement Relative reduction of the traversal
+     *          time a command has to yield. Has to be from [0,1).
+     * @param remainingWorkAfterFork Fraction of its time a worker is assumed
+     *          to keep if it forks once. Has to be from (0,1).
+     */
+    OracleForOnePhaseWithCostModel(
+      bool    joinsAllowed,
+      bool    forksAllowed = true,
+      int     regularLevelAlongBoundary = 0,
+      double  minimalRelativeImprovement = 0.1,
+      double  remainingWorkAfterFork = 0.5
+    );
+
+    virtual ~OracleForOnePhaseWithCostModel();
+
+    /**
+     * If the master tells this rank to join, all worker statistics become
+     * invalid.
+     */
+    void receivedStartCommand(LoadBalancingFlag commandFromMaster ) override;
+
+    LoadBalancingFlag getCommandForWorker( int workerRank, bool forkIsAllowed, bool joinIsAllowed ) override;
+
+    void plotStatistics() override;
+
+    OracleForOnePhase* createNewOracle(int adapterNumber) const override;
+
+    void forkFailed() override;
+
+    int getRegularLevelAlongBoundary() const override;
+
+    void endIteration(double numberOfLocalCells, double traversalTime) override;
+
+    void receivedWorkerStatistics(int workerRank, double numberOfWorkerCells, double workerTime, double waitTime) override;
+
+    /**
+     * @return Predicted local traversal time if the worker forks once, or -1
+     *         if there is no data for the worker.
+     */
+    double getPredictedTraversalTimeAfterFork(int workerRank) const;
+
+    /**
+     * @return Predicted local traversal time if the worker joins, or -1 if
+     *         there is no data for the worker.
+     */
+    double getPredictedTraversalTimeAfterJoin(int workerRank) const;
+};
+
+
+#endif
@@ -0,0 +1,169 @@
+#include "peano/parallel/loadbalancing/OracleForOnePhaseWithDiffusion.h"
+
+#include "tarch/Assertions.h"
+
+
+tarch::logging::Log peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::_log( "peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion" );
+
+
+peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::OracleForOnePhaseWithDiffusion(
+  bool    joinsAllowed,
+  bool    forksAllowed,
+  int     regularLevelAlongBoundary,
+  double  diffusionCoefficient,
+  double  smoothing,
+  double  migrationThreshold,
+  double  maximalRelativeSizeOfJoinedWorker
+):
+  _joinsAllowed(joinsAllowed),
+  _forksAllowed(forksAllowed),
+  _regularLevelAlongBoundary(regularLevelAlongBoundary),
+  _diffusionCoefficient(diffusionCoefficient),
+  _smoothing(smoothing),
+  _migrationThreshold(migrationThreshold),
+  _maximalRelativeSizeOfJoinedWorker(maximalRelativeSizeOfJoinedWorker),
+  _forkHasFailed(false),
+  _localLoad(-1.0),
+  _numberOfLocalCells(-1.0),
+  _edges(),
+  _numberOfForks(0),
+  _numberOfJoins(0) {
+  assertion1( diffusionCoefficient>0.0 && diffusionCoefficient<=1.0, diffusionCoefficient );
+  assertion1( smoothing>0.0 && smoothing<=1.0, smoothing );
+  assertion1( migrationThreshold>0.0, migrationThreshold );
+  assertion1( maximalRelativeSizeOfJoinedWorker>=0.0, maximalRelativeSizeOfJoinedWorker );
+}
+
+
+peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::~OracleForOnePhaseWithDiffusion() {
+}
+
+
+double peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::smooth(double oldValue, double newValue) const {
+  return (1.0-_smoothing) * oldValue + _smoothing * newValue;
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::receivedStartCommand(LoadBalancingFlag commandFromMaster ) {
+  if (commandFromMaster==LoadBalancingFlag::Join) {
+    _edges.clear();
+  }
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::receivedWorkerStatistics(int workerRank, double numberOfWorkerCells, double workerTime, double waitTime) {
+  logTraceInWith4Arguments( "receivedWorkerStatistics(int,double,double,double)", workerRank, numberOfWorkerCells, workerTime, waitTime );
+
+  if (_edges.count(workerRank)==0) {
+    _edges[workerRank] = Edge{ workerTime, waitTime, numberOfWorkerCells, 0.0, true };
+  }
+  else {
+    Edge& edge = _edges[workerRank];
+    edge.workerLoad          = smooth(edge.workerLoad,workerTime);
+    edge.waitTime            = waitTime;
+    edge.numberOfWorkerCells = numberOfWorkerCells;
+    edge.hasNewMeasurement   = true;
+  }
+
+  logTraceOut( "receivedWorkerStatistics(int,double,double,double)" );
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::endIteration(double numberOfLocalCells, double traversalTime) {
+  logTraceInWith2Arguments( "endIteration(double,double)", numberOfLocalCells, traversalTime );
+
+  double busyTime = traversalTime;
+  for (const auto& p: _edges) {
+    if (p.second.hasNewMeasurement) {
+      busyTime -= p.second.waitTime;
+    }
+  }
+  busyTime = busyTime<0.0 ? 0.0 : busyTime;
+
+  _localLoad          = _localLoad<0.0 ? busyTime : smooth(_localLoad,busyTime);
+  _numberOfLocalCells = numberOfLocalCells;
+  _forkHasFailed      = false;
+
+  for (auto& p: _edges) {
+    if (p.second.hasNewMeasurement) {
+      p.second.accumulatedFlux   += _diffusionCoefficient * (p.second.workerLoad - _localLoad);
+      p.second.hasNewMeasurement  = false;
+    }
+  }
+
+  logTraceOut( "endIteration(double,double)" );
+}
+
+
+peano::parallel::loadbalancing::LoadBalancingFlag peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::getCommandForWorker( int workerRank, bool forkIsAllowed, bool joinIsAllowed ) {
+  logTraceInWith3Arguments( "getCommandForWorker(int,bool,bool)", workerRank, forkIsAllowed, joinIsAllowed );
+
+  LoadBalancingFlag result = LoadBalancingFlag::Continue;
+
+  if (_localLoad>=0.0 && _edges.count(workerRank)>0) {
+    const Edge& edge    = _edges[workerRank];
+    const bool  mayFork = forkIsAllowed && _forksAllowed && !_forkHasFailed;
+    const bool  mayJoin =
+      joinIsAllowed && _joinsAllowed &&
+      edge.numberOfWorkerCells>=0.0 &&
+      edge.numberOfWorkerCells <= _maximalRelativeSizeOfJoinedWorker * _numberOfLocalCells;
+
+    if (mayFork && edge.accumulatedFlux > _migrationThreshold * edge.workerLoad) {
+      result = LoadBalancingFlag::ForkOnce;
+      _numberOfForks++;
+    }
+    else if (mayJoin && edge.accumulatedFlux < -_migrationThreshold * _localLoad) {
+      result = LoadBalancingFlag::Join;
+      _numberOfJoins++;
+    }
+
+    if (result!=LoadBalancingFlag::Continue) {
+      logInfo(
+        "getCommandForWorker(int,bool,bool)",
+        "send " << convertLoadBalancingFlagToString(result) << " to rank " << workerRank <<
+        ": local load=" << _localLoad <<
+        ", worker load=" << edge.workerLoad <<
+        ", accumulated flux=" << edge.accumulatedFlux <<
+        ", worker cells=" << edge.numberOfWorkerCells <<
+        ", local cells=" << _numberOfLocalCells
+      );
+      _edges.erase(workerRank);
+    }
+  }
+
+  logTraceOutWith1Argument( "getCommandForWorker(int,bool,bool)", convertLoadBalancingFlagToString(result) );
+  return result;
+}
+
+
+double peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::getAccumulatedFlux(int workerRank) const {
+  return _edges.count(workerRank)>0 ? _edges.at(workerRank).accumulatedFlux : 0.0;
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::plotStatistics() {
+  logInfo(
+    "plotStatistics()",
+    "forks=" << _numberOfForks << ", joins=" << _numberOfJoins <<
+    ", local load=" << _localLoad << ", edges with statistics=" << _edges.size()
+  );
+}
+
+
+int peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::getRegularLevelAlongBoundary() const {
+  return _regularLevelAlongBoundary;
+}
+
+
+peano::parallel::loadbalancing::OracleForOnePhase* peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::createNewOracle(int adapterNumber) const {
+  return new OracleForOnePhaseWithDiffusion(
+    _joinsAllowed,_forksAllowed,_regularLevelAlongBoundary,
+    _diffusionCoefficient,_smoothing,_migrationThreshold,_maximalRelativeSizeOfJoinedWorker
+  );
+}
+
+
+void peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion::forkFailed() {
+  logInfo( "forkFailed()", "fork has failed, i.e. there are no idle ranks to take over the load flux. No further forks until the end of the traversal" );
+  _forkHasFailed = true;
+}
@@ -0,0 +1,154 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PARALLEL_LOADBALANCING_ORACLE_FOR_ONE_PHASE_WITH_DIFFUSION_H_
+#define _PEANO_PARALLEL_LOADBALANCING_ORACLE_FOR_ONE_PHASE_WITH_DIFFUSION_H_
+
+
+#include "peano/parallel/loadbalancing/OracleForOnePhase.h"
+#include "tarch/logging/Log.h"
+
+
+#include <map>
+
+
+namespace peano {
+  namespace parallel {
+    namespace loadbalancing {
+      class OracleForOnePhaseWithDiffusion;
+    }
+  }
+}
+
+
+/**
+ * Diffusion-based Incremental Rebalancing
+ *
+ * For long-running adaptive simulations, the load usually shifts gradually.
+ * The greedy oracle then either does nothing or joins whole subtrees. This
+ * oracle instead rebalances in small steps and only if an imbalance persists
+ * over several traversals.
+ *
+ * <h2> Neighbourhood </h2>
+ *
+ * In Peano, data moves only along the edges of the rank tree: A fork moves
+ * one subtree of the master's spacetree (the next one along the space-filling
+ * curve that may be deployed) through the JoinDataBufferPool streams to a new
+ * worker. A join moves the worker's partition back. There is no data
+ * exchange between siblings in the rank tree. The diffusion thus runs along
+ * the master-worker edges. Per traversal, a master learns the load of each
+ * worker through OracleForOnePhase::receivedWorkerStatistics() and its own
+ * load through OracleForOnePhase::endIteration().
+ *
+ * <h2> Diffusion </h2>
+ *
+ * The load @f$ L_w @f$ of a worker is the time from its startup to the end of
+ * its reduction. This is the time the worker's whole subtree of the rank tree
+ * needs. The load @f$ L_m @f$ of the master is the time it is busy, i.e. its
+ * traversal time minus the time it waits for its workers. Both loads are
+ * smoothed exponentially over the traversals. Per traversal, each edge
+ * accumulates the flux
+ *
+ * @f$ \phi _w = \alpha (L_w - L_m) @f$
+ *
+ * with the diffusion coefficient @f$ \alpha @f$. Once the accumulated flux
+ * exceeds the migration threshold times the load of the overloaded side,
+ * the oracle migrates a small amount of work:
+ *
+ * - An overloaded worker is told to fork once, i.e. it hands over one
+ *   subtree to a new rank.
+ * - An underloaded worker is joined if its partition is small compared to
+ *   the master's partition. Workers with big partitions are never joined, as
+ *   a full join and refork would be expensive. If the worker's cell count is
+ *   not known (see TrackGridStatistics), the worker is not joined either.
+ *
+ * After a command, the edge's flux is reset and its measurements are thrown
+ * away, i.e. the edge needs some traversals before it is rebalanced again.
+ * This complements State::IterationsInBetweenRebalancing.
+ */
+class peano::parallel::loadbalancing::OracleForOnePhaseWithDiffusion: public peano::parallel::loadbalancing::OracleForOnePhase {
+  private:
+    static tarch::logging::Log  _log;
+
+    struct Edge {
+      double  workerLoad;
+      double  waitTime;
+      double  numberOfWorkerCells;
+      double  accumulatedFlux;
+      bool    hasNewMeasurement;
+    };
+
+    const bool                   _joinsAllowed;
+    const bool                   _forksAllowed;
+    const int                    _regularLevelAlongBoundary;
+    const double                 _diffusionCoefficient;
+    const double                 _smoothing;
+    const double                 _migrationThreshold;
+    const double                 _maximalRelativeSizeOfJoinedWorker;
+
+    bool                         _forkHasFailed;
+
+    /**
+     * Smoothed busy time of the local rank. Negative as long as there has
+     * not been any traversal.
+     */
+    double                       _localLoad;
+    double                       _numberOfLocalCells;
+
+    std::map<int,Edge>           _edges;
+
+    int                          _numberOfForks;
+    int                          _numberOfJoins;
+
+    double smooth(double oldValue, double newValue) const;
+  public:
+    /**
+     * @param diffusionCoefficient Fraction of the load difference that is
+     *          accumulated per traversal. Has to be from (0,1].
+     * @param smoothing Weight of the latest measurement in the exponential
+     *          smoothing of the loads. Has to be from (0,1].
+     * @param migrationThreshold Accumulated flux relative to the load of the
+     *          overloaded side that triggers a migration.
+     * @param maximalRelativeSizeOfJoinedWorker Underloaded workers are joined
+     *          only if they hold at most this fraction of the master's cells.
+     */
+    OracleForOnePhaseWithDiffusion(
+      bool    joinsAllowed,
+      bool    forksAllowed = true,
+      int     regularLevelAlongBoundary = 0,
+      double  diffusionCoefficient = 0.25,
+      double  smoothing = 0.5,
+      double  migrationThreshold = 0.2,
+      double  maximalRelativeSizeOfJoinedWorker = 0.1
+    );
+
+    virtual ~OracleForOnePhaseWithDiffusion();
+
+    void receivedStartCommand(LoadBalancingFlag commandFromMaster ) override;
+
+    LoadBalancingFlag getCommandForWorker( int workerRank, bool forkIsAllowed, bool joinIsAllowed ) override;
+
+    void plotStatistics() override;
+
+    OracleForOnePhase* createNewOracle(int adapterNumber) const override;
+
+    void forkFailed() override;
+
+    int getRegularLevelAlongBoundary() const override;
+
+    /**
+     * Updates the local load and accumulates the flux of all edges with
+     * fresh worker data.
+     */
+    void endIteration(double numberOfLocalCells, double traversalTime) override;
+
+    void receivedWorkerStatistics(int workerRank, double numberOfWorkerCells, double workerTime, double waitTime) override;
+
+    /**
+     * @return Accumulated flux from the worker to the master. Is positive if
+     *         the worker is overloaded, and 0 if nothing is known.
+     */
+    double getAccumulatedFlux(int workerRank) const;
+};
+
+
+#endif
@@ -0,0 +1,115 @@
+#include "peano/parallel/loadbalancing/tests/OracleForOnePhaseWithCostModelTest.h"
+#include "peano/parallel/loadbalancing/OracleForOnePhaseWithCostModel.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest)
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest::OracleForOnePhaseWithCostModelTest():
+  TestCase( "peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest" ) {
+}
+
+
+peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest::~OracleForOnePhaseWithCostModelTest() {
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest::run() {
+  testMethod( testForkBottleneckWorker );
+  testMethod( testJoinOverheadDominatedWorker );
+  testMethod( testContinueWithBalancedWorker );
+  testMethod( testHysteresis );
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest::setUp() {
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest::testForkBottleneckWorker() {
+  OracleForOnePhaseWithCostModel oracle(true);
+
+  // nothing is known yet
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+
+  // local rank waits 6 out of 10 seconds for a worker with plenty of cells
+  oracle.receivedWorkerStatistics(1,1000.0,9.0,6.0);
+  oracle.endIteration(100.0,10.0);
+
+  validateNumericalEquals( oracle.getPredictedTraversalTimeAfterFork(1), 5.5 );
+  validateNumericalEquals( oracle.getPredictedTraversalTimeAfterJoin(1), 44.0 );
+  validateNumericalEquals( oracle.getPredictedTraversalTimeAfterFork(2), -1.0 );
+
+  oracle.forkFailed();
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+
+  oracle.endIteration(100.0,10.0);
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::ForkOnce) );
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest::testJoinOverheadDominatedWorker() {
+  OracleForOnePhaseWithCostModel oracle(true);
+
+  // worker has hardly any cells, but the local rank waits for it
+  oracle.receivedWorkerStatistics(1,10.0,3.2,3.0);
+  oracle.receivedWorkerStatistics(2,0.0,0.5,0.0);
+  oracle.receivedWorkerStatistics(3,-1.0,3.2,3.0);
+  oracle.endIteration(100.0,10.0);
+
+  validateNumericalEquals( oracle.getPredictedTraversalTimeAfterJoin(1), 7.4 );
+  validateNumericalEquals( oracle.getPredictedTraversalTimeAfterFork(1), 8.4 );
+
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,false)), convertLoadBalancingFlagToString(LoadBalancingFlag::ForkOnce) );
+  oracle.endIteration(100.0,10.0);
+  oracle.receivedWorkerStatistics(1,10.0,3.2,3.0);
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Join) );
+
+  // idle workers are always joined
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(2,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Join) );
+
+  // without cell counts, a join never pays off
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(3,false,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest::testContinueWithBalancedWorker() {
+  OracleForOnePhaseWithCostModel oracle(true);
+
+  oracle.receivedWorkerStatistics(1,100.0,9.0,0.1);
+  oracle.endIteration(100.0,10.0);
+
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+
+  OracleForOnePhaseWithCostModel oracleWithoutJoinsAndForks(false,false);
+  oracleWithoutJoinsAndForks.receivedWorkerStatistics(1,1000.0,9.0,6.0);
+  oracleWithoutJoinsAndForks.receivedWorkerStatistics(2,0.0,0.5,0.0);
+  oracleWithoutJoinsAndForks.endIteration(100.0,10.0);
+
+  validateEquals( convertLoadBalancingFlagToString(oracleWithoutJoinsAndForks.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+  validateEquals( convertLoadBalancingFlagToString(oracleWithoutJoinsAndForks.getCommandForWorker(2,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest::testHysteresis() {
+  OracleForOnePhaseWithCostModel oracle(true);
+
+  oracle.receivedWorkerStatistics(1,1000.0,9.0,6.0);
+  oracle.endIteration(100.0,10.0);
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::ForkOnce) );
+
+  // data of the traversal in which the fork has been issued is ignored
+  oracle.receivedWorkerStatistics(1,1000.0,9.0,6.0);
+  oracle.endIteration(100.0,10.0);
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+
+  oracle.receivedWorkerStatistics(1,1000.0,9.0,6.0);
+  oracle.endIteration(100.0,10.0);
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::ForkOnce) );
+}
@@ -0,0 +1,39 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PARALLEL_LOADBALANCING_TESTS_ORACLE_FOR_ONE_PHASE_WITH_COST_MODEL_TEST_H_
+#define _PEANO_PARALLEL_LOADBALANCING_TESTS_ORACLE_FOR_ONE_PHASE_WITH_COST_MODEL_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+
+namespace peano {
+  namespace parallel {
+    namespace loadbalancing {
+      namespace tests {
+        class OracleForOnePhaseWithCostModelTest;
+      }
+    }
+  }
+}
+
+
+/**
+ * Feeds the oracle with synthetic runtime statistics, i.e. the test does not
+ * need MPI.
+ */
+class peano::parallel::loadbalancing::tests::OracleForOnePhaseWithCostModelTest: public tarch::tests::TestCase {
+  private:
+    void testForkBottleneckWorker();
+    void testJoinOverheadDominatedWorker();
+    void testContinueWithBalancedWorker();
+    void testHysteresis();
+  public:
+    OracleForOnePhaseWithCostModelTest();
+    virtual ~OracleForOnePhaseWithCostModelTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
@@ -0,0 +1,82 @@
+#include "peano/parallel/loadbalancing/tests/OracleForOnePhaseWithDiffusionTest.h"
+#include "peano/parallel/loadbalancing/OracleForOnePhaseWithDiffusion.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(peano::parallel::loadbalancing::tests::OracleForOnePhaseWithDiffusionTest)
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+peano::parallel::loadbalancing::tests::OracleForOnePhaseWithDiffusionTest::OracleForOnePhaseWithDiffusionTest():
+  TestCase( "peano::parallel::loadbalancing::tests::OracleForOnePhaseWithDiffusionTest" ) {
+}
+
+
+peano::parallel::loadbalancing::tests::OracleForOnePhaseWithDiffusionTest::~OracleForOnePhaseWithDiffusionTest() {
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithDiffusionTest::run() {
+  testMethod( testForkAfterPersistentOverload );
+  testMethod( testJoinOnlySmallUnderloadedWorkers );
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithDiffusionTest::setUp() {
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithDiffusionTest::testForkAfterPersistentOverload() {
+  OracleForOnePhaseWithDiffusion oracle(true,true,0,0.25,1.0,0.2,0.1);
+
+  // worker needs 12 seconds, master is busy for 8 seconds, i.e. the flux per
+  // traversal is 1 and the threshold is 2.4
+  for (int traversal=1; traversal<=2; traversal++) {
+    oracle.receivedWorkerStatistics(1,1000.0,12.0,2.0);
+    oracle.endIteration(1000.0,10.0);
+    validateNumericalEqualsWithParams1( oracle.getAccumulatedFlux(1), traversal, traversal );
+    validateEqualsWithParams1( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue), traversal );
+  }
+
+  oracle.receivedWorkerStatistics(1,1000.0,12.0,2.0);
+  oracle.endIteration(1000.0,10.0);
+
+  oracle.forkFailed();
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+
+  oracle.receivedWorkerStatistics(1,1000.0,12.0,2.0);
+  oracle.endIteration(1000.0,10.0);
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::ForkOnce) );
+
+  // the fork resets the edge
+  validateNumericalEquals( oracle.getAccumulatedFlux(1), 0.0 );
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+}
+
+
+void peano::parallel::loadbalancing::tests::OracleForOnePhaseWithDiffusionTest::testJoinOnlySmallUnderloadedWorkers() {
+  OracleForOnePhaseWithDiffusion oracle(true,true,0,0.25,1.0,0.2,0.1);
+
+  // master is busy for 10 seconds, all workers for 1 second, i.e. the flux
+  // per traversal is -2.25 and the threshold is -2
+  oracle.receivedWorkerStatistics(1,5.0,1.0,0.0);
+  oracle.receivedWorkerStatistics(2,50.0,1.0,0.0);
+  oracle.receivedWorkerStatistics(3,-1.0,1.0,0.0);
+  oracle.endIteration(100.0,10.0);
+
+  validateNumericalEquals( oracle.getAccumulatedFlux(1), -2.25 );
+
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,false)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(1,true,true)),  convertLoadBalancingFlagToString(LoadBalancingFlag::Join) );
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(2,true,true)),  convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+  validateEquals( convertLoadBalancingFlagToString(oracle.getCommandForWorker(3,true,true)),  convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+
+  OracleForOnePhaseWithDiffusion oracleWithoutJoins(false,true,0,0.25,1.0,0.2,0.1);
+  oracleWithoutJoins.receivedWorkerStatistics(1,5.0,1.0,0.0);
+  oracleWithoutJoins.endIteration(100.0,10.0);
+  validateEquals( convertLoadBalancingFlagToString(oracleWithoutJoins.getCommandForWorker(1,true,true)), convertLoadBalancingFlagToString(LoadBalancingFlag::Continue) );
+}
@@ -0,0 +1,37 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PARALLEL_LOADBALANCING_TESTS_ORACLE_FOR_ONE_PHASE_WITH_DIFFUSION_TEST_H_
+#define _PEANO_PARALLEL_LOADBALANCING_TESTS_ORACLE_FOR_ONE_PHASE_WITH_DIFFUSION_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+
+namespace peano {
+  namespace parallel {
+    namespace loadbalancing {
+      namespace tests {
+        class OracleForOnePhaseWithDiffusionTest;
+      }
+    }
+  }
+}
+
+
+/**
+ * Feeds the oracle with synthetic runtime statistics. All tests switch off
+ * the smoothing, i.e. each traversal accumulates the same flux.
+ */
+class peano::parallel::loadbalancing::tests::OracleForOnePhaseWithDiffusionTest: public tarch::tests::TestCase {
+  private:
+    void testForkAfterPersistentOverload();
+    void testJoinOnlySmallUnderloadedWorkers();
+  public:
+    OracleForOnePhaseWithDiffusionTest();
+    virtual ~OracleForOnePhaseWithDiffusionTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
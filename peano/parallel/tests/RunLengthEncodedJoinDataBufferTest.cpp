@@ -0,0 +1,241 @@
+#include "peano/parallel/tests/RunLengthEncodedJoinDataBufferTest.h"
+#include "peano/parallel/RunLengthEncodedJoinDataBuffer.h"
+#include "peano/parallel/JoinDataBufferPool.h"
+#include "peano/heap/records/IntegerHeapData.h"
+
+#ifdef Parallel
+#include "tarch/parallel/Node.h"
+#include "tarch/parallel/NodePool.h"
+#include "tarch/parallel/FCFSNodePoolStrategy.h"
+#endif
+
+
+#include <bitset>
+#include <ostream>
+#include <sstream>
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(peano::parallel::tests::RunLengthEncodedJoinDataBufferTest)
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+namespace {
+  /**
+   * Minimal grid entity for the join data buffers which holds one integer.
+   * It serves both as vertex and as cell. See the IntegerVertex of
+   * SendReceiveBufferTest for the reason why we do not use the grid's test
+   * records.
+   */
+  class IntegerGridEntity {
+    public:
+      typedef peano::heap::records::IntegerHeapData Records;
+
+      IntegerGridEntity():
+        _data() {
+      }
+
+      explicit IntegerGridEntity(int value):
+        _data(value) {
+      }
+
+      Records getVertexData() const                   { return _data; }
+      void    setVertexData(const Records& vertexData) { _data = vertexData; }
+      Records getCellData() const                     { return _data; }
+      void    setCellData(const Records& cellData)     { _data = cellData; }
+
+      /**
+       * The pool encodes the level into the marker in Debug builds.
+       */
+      int getLevel() const {
+        return 0;
+      }
+
+      int getValue() const {
+        return _data.getU();
+      }
+
+      std::string toString() const {
+        std::ostringstream out;
+        out << "(value:" << getValue() << ")";
+        return out.str();
+      }
+    private:
+      Records _data;
+  };
+
+  std::ostream& operator<<(std::ostream& out, const IntegerGridEntity& entity) {
+    out << entity.toString();
+    return out;
+  }
+
+  /**
+   * Markers of a typical subtree: a few markers along the master's boundary
+   * and long sequences of interior cells.
+   */
+  int getCellMarker(int cell) {
+    return cell<2 ? 3 : (cell==12 ? 12 : 0);
+  }
+}
+
+
+peano::parallel::tests::RunLengthEncodedJoinDataBufferTest::RunLengthEncodedJoinDataBufferTest():
+  TestCase( "peano::parallel::tests::RunLengthEncodedJoinDataBufferTest" ) {
+}
+
+
+peano::parallel::tests::RunLengthEncodedJoinDataBufferTest::~RunLengthEncodedJoinDataBufferTest() {
+}
+
+
+void peano::parallel::tests::RunLengthEncodedJoinDataBufferTest::run() {
+  testMethod( testEncodeCellMarkers );
+  testMethod( testEncodeAlternatingMarkers );
+  testMethod( testDecodeAppends );
+  testMethod( testCompressedStreamToOwnRank );
+}
+
+
+void peano::parallel::tests::RunLengthEncodedJoinDataBufferTest::setUp() {
+}
+
+
+void peano::parallel::tests::RunLengthEncodedJoinDataBufferTest::testEncodeCellMarkers() {
+  // typical subtree: a few markers along the master's boundary, then
+  // long sequences of interior cells
+  std::vector<int> markers;
+  markers.push_back(3);
+  markers.push_back(3);
+  markers.insert( markers.end(), 100, 0 );
+  markers.push_back(12);
+  markers.insert( markers.end(), 20, 0 );
+
+  std::vector<int> encoded;
+  peano::parallel::RunLengthEncodedJoinDataBuffer::encode(markers,encoded);
+
+  validateEqualsWithParams1( static_cast<int>(encoded.size()), 8, markers.size() );
+  validateEquals( encoded[0], 3 );
+  validateEquals( encoded[1], 2 );
+  validateEquals( encoded[2], 0 );
+  validateEquals( encoded[3], 100 );
+  validateEquals( encoded[4], 12 );
+  validateEquals( encoded[5], 1 );
+  validateEquals( encoded[6], 0 );
+  validateEquals( encoded[7], 20 );
+
+  std::vector<int> decoded;
+  peano::parallel::RunLengthEncodedJoinDataBuffer::decode(encoded.data(),static_cast<int>(encoded.size()),decoded);
+  validateEquals( decoded.size(), markers.size() );
+  const bool decodedEqualsOriginal = decoded==markers;
+  validate( decodedEqualsOriginal );
+}
+
+
+void peano::parallel::tests::RunLengthEncodedJoinDataBufferTest::testEncodeAlternatingMarkers() {
+  std::vector<int> markers;
+  for (int i=0; i<10; i++) {
+    markers.push_back(i%2);
+  }
+
+  std::vector<int> encoded;
+  peano::parallel::RunLengthEncodedJoinDataBuffer::encode(markers,encoded);
+  validateEquals( static_cast<int>(encoded.size()), 20 );
+
+  std::vector<int> decoded;
+  peano::parallel::RunLengthEncodedJoinDataBuffer::decode(encoded.data(),static_cast<int>(encoded.size()),decoded);
+  const bool decodedEqualsOriginal = decoded==markers;
+  validate( decodedEqualsOriginal );
+
+  std::vector<int> empty;
+  encoded.clear();
+  peano::parallel::RunLengthEncodedJoinDataBuffer::encode(empty,encoded);
+  validateEquals( static_cast<int>(encoded.size()), 0 );
+}
+
+
+void peano::parallel::tests::RunLengthEncodedJoinDataBufferTest::testDecodeAppends() {
+  // pages are decoded one after another into the same receive buffer
+  std::vector<int> decoded;
+
+  const int firstPage[]  = {7, 3, 0, 2};
+  const int secondPage[] = {0, 4};
+
+  peano::parallel::RunLengthEncodedJoinDataBuffer::decode(firstPage,4,decoded);
+  peano::parallel::RunLengthEncodedJoinDataBuffer::decode(secondPage,2,decoded);
+
+  validateEquals( static_cast<int>(decoded.size()), 9 );
+  validateEquals( decoded[0], 7 );
+  validateEquals( decoded[2], 7 );
+  validateEquals( decoded[3], 0 );
+  validateEquals( decoded[8], 0 );
+}
+
+
+void peano::parallel::tests::RunLengthEncodedJoinDataBufferTest::testCompressedStreamToOwnRank() {
+  #ifdef Parallel
+  if (IntegerGridEntity::Records::Packed::Datatype==0) {
+    IntegerGridEntity::Records::Packed::initDatatype();
+  }
+  if (IntegerGridEntity::Records::Datatype==0) {
+    IntegerGridEntity::Records::initDatatype();
+  }
+
+  // While the buffers wait for their messages, they poll all services. The
+  // global master's node pool then needs a strategy though no rank registers.
+  if (tarch::parallel::Node::getInstance().isGlobalMaster()) {
+    tarch::parallel::NodePool::getInstance().setStrategy( new tarch::parallel::FCFSNodePoolStrategy() );
+  }
+
+  const int rank            = tarch::parallel::Node::getInstance().getRank();
+  const int NumberOfEntries = 23;
+
+  peano::parallel::JoinDataBufferPool& pool = peano::parallel::JoinDataBufferPool::getInstance();
+  validateEquals( pool._map.size(), 0 );
+
+  // The pool is a singleton, so we restore its settings afterwards
+  const int  oldBufferSize      = pool._bufferSize;
+  const bool oldCompressStreams = pool._compressStreams;
+  pool.setBufferSize(4);
+  pool.setStreamCompression(true);
+  validate( pool.usePackedRecords() );
+
+  for (int i=0; i<NumberOfEntries; i++) {
+    pool.sendVertex( IntegerGridEntity(i), rank );
+    pool.sendCell( IntegerGridEntity(100+i), std::bitset<NUMBER_OF_VERTICES_PER_ELEMENT>(getCellMarker(i)), rank );
+  }
+  validate( dynamic_cast<peano::parallel::RunLengthEncodedJoinDataBuffer*>(pool._map[rank]._cellMarkerBuffer)!=nullptr );
+
+  // sends the remaining entries and destroys the send buffers
+  pool.releaseMessages();
+  validate( pool._map[rank]._vertexBuffer==0 );
+  validate( pool._map[rank]._cellMarkerBuffer==0 );
+
+  for (int i=0; i<NumberOfEntries; i++) {
+    validateEqualsWithParams1( pool.getVertexFromStream<IntegerGridEntity>(rank).getValue(), i, i );
+    pool.removeVertexFromStream(rank);
+
+    validateEqualsWithParams1( pool.getCellFromStream<IntegerGridEntity>(rank).getValue(), 100+i, i );
+    pool.removeCellFromStream(rank);
+
+    validateEqualsWithParams1( static_cast<int>(pool.getCellMarkerFromStream(rank).to_ulong()), getCellMarker(i), i );
+    pool.removeCellMarkerFromStream(rank,false);
+  }
+
+  // all receive buffers are empty now, i.e. they are destroyed
+  pool.releaseMessages();
+  validate( pool._map[rank]._cellMarkerBuffer==0 );
+
+  pool._map.clear();
+  pool._bufferSize      = oldBufferSize;
+  pool._compressStreams = oldCompressStreams;
+  #endif
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
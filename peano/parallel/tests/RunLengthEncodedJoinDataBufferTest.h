@@ -0,0 +1,46 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PARALLEL_TESTS_RUN_LENGTH_ENCODED_JOIN_DATA_BUFFER_TEST_H_
+#define _PEANO_PARALLEL_TESTS_RUN_LENGTH_ENCODED_JOIN_DATA_BUFFER_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+
+namespace peano {
+  namespace parallel {
+    namespace tests {
+      class RunLengthEncodedJoinDataBufferTest;
+    }
+  }
+}
+
+
+/**
+ * Tests the codec of the run-length encoded join buffer. Only
+ * testCompressedStreamToOwnRank() sends data. It makes each rank stream to
+ * itself, i.e. it runs with any number of ranks, and it is nop without MPI.
+ */
+class peano::parallel::tests::RunLengthEncodedJoinDataBufferTest: public tarch::tests::TestCase {
+  private:
+    void testEncodeCellMarkers();
+    void testEncodeAlternatingMarkers();
+    void testDecodeAppends();
+
+    /**
+     * Switch on the stream compression of the JoinDataBufferPool and stream
+     * a couple of vertices and cells plus their markers to the own rank. The
+     * buffer size is smaller than the stream, so the markers go out as
+     * several encoded pages. Records and markers have to arrive unaltered
+     * and in order.
+     */
+    void testCompressedStreamToOwnRank();
+  public:
+    RunLengthEncodedJoinDataBufferTest();
+    virtual ~RunLengthEncodedJoinDataBufferTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
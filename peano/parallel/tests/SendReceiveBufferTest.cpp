@@ -0,0 +1,212 @@
+#include "peano/parallel/tests/SendReceiveBufferTest.h"
+#include "peano/parallel/SendReceiveBufferPool.h"
+
+#ifdef Parallel
+#include "tarch/parallel/Node.h"
+#include "tarch/parallel/NodePool.h"
+#include "tarch/parallel/FCFSNodePoolStrategy.h"
+#endif
+
+
+#include <sstream>
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(peano::parallel::tests::SendReceiveBufferTest)
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+tarch::logging::Log peano::parallel::tests::SendReceiveBufferTest::_log( "peano::parallel::tests::SendReceiveBufferTest" );
+
+
+peano::parallel::tests::SendReceiveBufferTest::IntegerVertex::IntegerVertex():
+  _vertexData() {
+}
+
+
+peano::parallel::tests::SendReceiveBufferTest::IntegerVertex::IntegerVertex(int value):
+  _vertexData(value) {
+}
+
+
+void peano::parallel::tests::SendReceiveBufferTest::IntegerVertex::initDatatype() {
+  #ifdef Parallel
+  if (Records::Packed::Datatype==0) {
+    Records::Packed::initDatatype();
+  }
+  if (Records::Datatype==0) {
+    Records::initDatatype();
+  }
+  #endif
+}
+
+
+peano::parallel::tests::SendReceiveBufferTest::IntegerVertex::Records peano::parallel::tests::SendReceiveBufferTest::IntegerVertex::getVertexData() const {
+  return _vertexData;
+}
+
+
+void peano::parallel::tests::SendReceiveBufferTest::IntegerVertex::setVertexData(const Records& vertexData) {
+  _vertexData = vertexData;
+}
+
+
+int peano::parallel::tests::SendReceiveBufferTest::IntegerVertex::getValue() const {
+  return _vertexData.getU();
+}
+
+
+std::string peano::parallel::tests::SendReceiveBufferTest::IntegerVertex::toString() const {
+  std::ostringstream out;
+  out << "(value:" << getValue() << ")";
+  return out.str();
+}
+
+
+peano::parallel::tests::SendReceiveBufferTest::SendReceiveBufferTest():
+  TestCase( "peano::parallel::tests::SendReceiveBufferTest" ) {
+}
+
+
+peano::parallel::tests::SendReceiveBufferTest::~SendReceiveBufferTest() {
+}
+
+
+void peano::parallel::tests::SendReceiveBufferTest::run() {
+  logTraceIn( "run() ");
+  testMethod( testGrowSendBuffer );
+  #ifdef Parallel
+  testMethod( testAdaptivePageSizeRoundTrip );
+  testMethod( testExchangeOncePerSweep );
+  #endif
+  logTraceOut( "run() ");
+}
+
+
+void peano::parallel::tests::SendReceiveBufferTest::setUp() {
+}
+
+
+void peano::parallel::tests::SendReceiveBufferTest::testGrowSendBuffer() {
+  logTraceIn( "testGrowSendBuffer()" );
+
+  peano::parallel::SendReceiveBufferFIFO<IntegerVertex> buffer(0,2);
+  buffer.setSendWholeSweepAtOnce(true);
+
+  for (int i=0; i<5; i++) {
+    buffer.sendVertex( IntegerVertex(i) );
+  }
+
+  validateEquals( buffer.getBufferPageSize(), 8 );
+  validateEquals( buffer._sendBufferCapacity, 8 );
+  validateEquals( buffer._sendBufferCurrentPageElement, 5 );
+  validate( buffer._sendBufferRequestHandle==nullptr );
+  for (int i=0; i<5; i++) {
+    validateEqualsWithParams1( buffer._sendBuffer[buffer._currentSendBuffer][i].getU(), i, i );
+  }
+
+  logTraceOut( "testGrowSendBuffer()" );
+}
+
+
+#ifdef Parallel
+void peano::parallel::tests::SendReceiveBufferTest::testAdaptivePageSizeRoundTrip() {
+  logTraceIn( "testAdaptivePageSizeRoundTrip()" );
+
+  IntegerVertex::initDatatype();
+
+  // While the buffer waits for its sends, it polls all services. The global
+  // master's node pool then needs a strategy though no rank registers.
+  if (tarch::parallel::Node::getInstance().isGlobalMaster()) {
+    tarch::parallel::NodePool::getInstance().setStrategy( new tarch::parallel::FCFSNodePoolStrategy() );
+  }
+
+  const int rank                     = tarch::parallel::Node::getInstance().getRank();
+  const int numberOfVerticesPerSweep = 10;
+
+  peano::parallel::SendReceiveBufferFIFO<IntegerVertex> buffer(rank,2);
+  buffer.setAdaptivePageSize(2,16,1.0e-8);
+  validateEquals( buffer.getBufferPageSize(), 2 );
+
+  for (int iteration=0; iteration<3; iteration++) {
+    for (int i=0; i<numberOfVerticesPerSweep; i++) {
+      buffer.sendVertex( IntegerVertex(iteration*numberOfVerticesPerSweep+i) );
+    }
+
+    buffer.releaseSentMessages();
+    buffer.releaseReceivedMessages(false);
+
+    validateEqualsWithParams1( buffer.getBufferPageSize(), 4 << iteration, iteration );
+
+    for (int i=0; i<numberOfVerticesPerSweep; i++) {
+      validateEqualsWithParams2( buffer.getVertex().getValue(), iteration*numberOfVerticesPerSweep+i, iteration, i );
+    }
+  }
+
+  logTraceOut( "testAdaptivePageSizeRoundTrip()" );
+}
+
+
+void peano::parallel::tests::SendReceiveBufferTest::testExchangeOncePerSweep() {
+  logTraceIn( "testExchangeOncePerSweep()" );
+
+  IntegerVertex::initDatatype();
+
+  if (tarch::parallel::Node::getInstance().isGlobalMaster()) {
+    tarch::parallel::NodePool::getInstance().setStrategy( new tarch::parallel::FCFSNodePoolStrategy() );
+  }
+
+  const int rank                     = tarch::parallel::Node::getInstance().getRank();
+  const int numberOfVerticesPerSweep = 10;
+
+  peano::parallel::SendReceiveBufferPool& pool = peano::parallel::SendReceiveBufferPool::getInstance();
+  validateEquals( pool._map.size(), 0 );
+
+  // The pool is a singleton, so we restore its buffer size afterwards
+  const int oldBufferSize = pool._bufferSize;
+  pool.setBufferSize(2);
+  pool.setExchangeMode( peano::parallel::SendReceiveBufferPool::ExchangeOncePerSweep );
+  pool.createBufferManually<IntegerVertex>( rank, peano::parallel::SendReceiveBufferPool::FIFO );
+  validateEquals( pool._map.count(rank), 1 );
+
+  // The pool does not accept vertices for the local rank, so we feed the
+  // buffer directly
+  peano::parallel::SendReceiveBufferAbstractImplementation<IntegerVertex>* buffer =
+    static_cast< peano::parallel::SendReceiveBufferAbstractImplementation<IntegerVertex>* >( pool._map[rank] );
+  validate( buffer->_sendWholeSweepAtOnce );
+
+  for (int iteration=0; iteration<2; iteration++) {
+    for (int i=0; i<numberOfVerticesPerSweep; i++) {
+      buffer->sendVertex( IntegerVertex(iteration*numberOfVerticesPerSweep+i) );
+    }
+    validateWithParams1( buffer->_sendBufferRequestHandle==nullptr, iteration );
+    validateEqualsWithParams1( buffer->_sendBufferCurrentPageElement, numberOfVerticesPerSweep, iteration );
+
+    buffer->postSentMessages();
+    buffer->releaseSentMessages();
+    buffer->releaseReceivedMessages(false);
+
+    validateEqualsWithParams1( buffer->getDeployBufferPageSize(0), numberOfVerticesPerSweep, iteration );
+    for (int i=0; i<numberOfVerticesPerSweep; i++) {
+      validateEqualsWithParams2( buffer->getVertex().getValue(), iteration*numberOfVerticesPerSweep+i, iteration, i );
+    }
+  }
+
+  validateEquals( buffer->getBufferPageSize(), 16 );
+
+  pool.terminate();
+  pool.setExchangeMode( peano::parallel::SendReceiveBufferPool::ExchangePagesInBackground );
+  pool._bufferSize = oldBufferSize;
+
+  logTraceOut( "testExchangeOncePerSweep()" );
+}
+#endif
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
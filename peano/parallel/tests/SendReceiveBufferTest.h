@@ -0,0 +1,87 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PARALLEL_TESTS_SEND_RECEIVE_BUFFER_TEST_H_
+#define _PEANO_PARALLEL_TESTS_SEND_RECEIVE_BUFFER_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+#include "tarch/logging/Log.h"
+
+#include "peano/heap/records/IntegerHeapData.h"
+
+
+#include <string>
+
+
+namespace peano {
+  namespace parallel {
+    namespace tests {
+      class SendReceiveBufferTest;
+    }
+  }
+}
+
+
+/**
+ * Tests the boundary data buffers. The MPI tests make each rank send
+ * vertices to itself, i.e. they run with any number of ranks.
+ */
+class peano::parallel::tests::SendReceiveBufferTest: public tarch::tests::TestCase {
+  private:
+    static tarch::logging::Log _log;
+
+    /**
+     * Minimal vertex for the buffers which holds one integer. We do not use
+     * the grid's test vertices: their generated MPI datatypes cover the
+     * exchanged attributes only, i.e. their extent is smaller than the
+     * record, and a page holding more than one of them is scrambled.
+     */
+    class IntegerVertex {
+      public:
+        typedef peano::heap::records::IntegerHeapData Records;
+
+        IntegerVertex();
+        explicit IntegerVertex(int value);
+
+        static void initDatatype();
+
+        Records getVertexData() const;
+        void setVertexData(const Records& vertexData);
+
+        int getValue() const;
+
+        std::string toString() const;
+      private:
+        Records _vertexData;
+    };
+
+    /**
+     * Send more vertices than a page can hold while the buffer sends the
+     * whole sweep at once. The buffer has to grow instead of sending and has
+     * to preserve the vertices written before. No data is sent.
+     */
+    void testGrowSendBuffer();
+
+    #ifdef Parallel
+    /**
+     * Exchange a couple of vertices with an adaptive page size and a tiny
+     * maximal message rate. The page size thus has to double after each
+     * iteration, while the vertices have to arrive unaltered and in order.
+     */
+    void testAdaptivePageSizeRoundTrip();
+
+    /**
+     * Switch the pool to ExchangeOncePerSweep and let it create a buffer.
+     * The buffer has to send all the vertices of a sweep as one message.
+     */
+    void testExchangeOncePerSweep();
+    #endif
+  public:
+    SendReceiveBufferTest();
+    virtual ~SendReceiveBufferTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
@@ -4,6 +4,7 @@
 #include "peano/peano.h"
 
 #include "peano/grid/aspects/CellLocalPeanoCurve.h"
+#include "peano/performanceanalysis/CommunicationMatrix.h"
 #include "tarch/multicore/MulticoreDefinitions.h"
 
 
@@ -11,9 +12,16 @@
 #include "tarch/multicore/Core.h"
 #endif
 
+#ifdef TraceJobs
+#include "tarch/multicore/JobTracing.h"
+
+#include <sstream>
+#endif
+
 
 #include "tarch/parallel/Node.h"
 #include "tarch/parallel/NodePool.h"
+#include "tarch/parallel/ProgressEngine.h"
 
 
 void peano::fillLookupTables() {
@@ -43,7 +51,10 @@ int peano::initParallelEnvironment(int* argc, char*** argv) {
 
 
 void peano::shutdownParallelEnvironment() {
+  peano::performanceanalysis::CommunicationMatrix::getInstance().writeToFile();
+
   tarch::parallel::NodePool::getInstance().shutdown();
+  tarch::parallel::ProgressEngine::getInstance().shutdown();
   tarch::parallel::Node::getInstance().shutdown();
 }
 
@@ -66,6 +77,12 @@ void peano::shutdownSharedMemoryEnvironment() {
   #ifdef SharedMemoryParallelisation
   tarch::multicore::Core::getInstance().shutDown();
   #endif
+
+  #ifdef TraceJobs
+  std::ostringstream traceFilename;
+  traceFilename << "job-trace-rank-" << tarch::parallel::Node::getInstance().getRank() << ".json";
+  tarch::multicore::jobs::tracing::writeChromeTrace( traceFilename.str(), tarch::parallel::Node::getInstance().getRank() );
+  #endif
 }
 
 
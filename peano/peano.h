@@ -41,6 +41,12 @@ namespace peano {
    */
   int initParallelEnvironment(int* argc, char*** argv);
 
+  /**
+   * Shut down the parallel environment. If the communication matrix is
+   * enabled, each rank writes its matrix before MPI is shut down.
+   *
+   * @see peano::performanceanalysis::CommunicationMatrix
+   */
   void shutdownParallelEnvironment();
 
   /**
@@ -52,5 +58,13 @@ namespace peano {
    * If an error occurs, it returns -3.
    */
   int initSharedMemoryEnvironment();
+
+  /**
+   * Shut down shared memory environment.
+   *
+   * If you translate with -DTraceJobs, this routine also dumps the job trace
+   * into job-trace-rank-x.json. Please invoke it before you shut down the
+   * parallel environment, as we need the rank.
+   */
   void shutdownSharedMemoryEnvironment();
 }
@@ -0,0 +1,203 @@
+#include "peano/performanceanalysis/CommunicationMatrix.h"
+
+#include "tarch/Assertions.h"
+#include "tarch/parallel/Node.h"
+#include "tarch/multicore/Lock.h"
+
+
+#include <fstream>
+#include <sstream>
+
+#include <cerrno>
+#include <cstring>
+
+
+tarch::logging::Log peano::performanceanalysis::CommunicationMatrix::_log( "peano::performanceanalysis::CommunicationMatrix" );
+
+
+std::string peano::performanceanalysis::CommunicationMatrix::toString(Kind kind) {
+  switch (kind) {
+    case Kind::BoundaryData:
+      return "boundary-data";
+    case Kind::JoinAndForkData:
+      return "join-and-fork-data";
+    case Kind::HeapData:
+      return "heap-data";
+  }
+  return "undef";
+}
+
+
+bool peano::performanceanalysis::CommunicationMatrix::Key::operator<(const Key& rhs) const {
+  if (iteration!=rhs.iteration) return iteration<rhs.iteration;
+  if (rank!=rhs.rank)           return rank<rhs.rank;
+  if (kind!=rhs.kind)           return static_cast<int>(kind)<static_cast<int>(rhs.kind);
+  return tag<rhs.tag;
+}
+
+
+peano::performanceanalysis::CommunicationMatrix::Entry::Entry():
+  sentMessages(0),
+  sentBytes(0),
+  receivedMessages(0),
+  receivedBytes(0) {
+}
+
+
+peano::performanceanalysis::CommunicationMatrix::CommunicationMatrix():
+  _isEnabled(false),
+  _filename(),
+  _iteration(0),
+  _entries(),
+  _semaphore() {
+}
+
+
+peano::performanceanalysis::CommunicationMatrix& peano::performanceanalysis::CommunicationMatrix::getInstance() {
+  static CommunicationMatrix singleton;
+  return singleton;
+}
+
+
+void peano::performanceanalysis::CommunicationMatrix::enable(const std::string& filename) {
+  _isEnabled = true;
+  _filename  = filename;
+}
+
+
+void peano::performanceanalysis::CommunicationMatrix::disable() {
+  _isEnabled = false;
+}
+
+
+bool peano::performanceanalysis::CommunicationMatrix::isEnabled() const {
+  return _isEnabled;
+}
+
+
+void peano::performanceanalysis::CommunicationMatrix::sentMessages(int toRank, Kind kind, int tag, int numberOfMessages, long int numberOfBytes) {
+  if (_isEnabled) {
+    assertion3( numberOfMessages>=0, toRank, tag, numberOfMessages );
+    assertion3( numberOfBytes>=0, toRank, tag, numberOfBytes );
+
+    tarch::multicore::Lock lock(_semaphore);
+    Entry& entry = _entries[ Key{_iteration,toRank,kind,tag} ];
+    entry.sentMessages += numberOfMessages;
+    entry.sentBytes    += numberOfBytes;
+  }
+}
+
+
+void peano::performanceanalysis::CommunicationMatrix::receivedMessages(int fromRank, Kind kind, int tag, int numberOfMessages, long int numberOfBytes) {
+  if (_isEnabled) {
+    assertion3( numberOfMessages>=0, fromRank, tag, numberOfMessages );
+    assertion3( numberOfBytes>=0, fromRank, tag, numberOfBytes );
+
+    tarch::multicore::Lock lock(_semaphore);
+    Entry& entry = _entries[ Key{_iteration,fromRank,kind,tag} ];
+    entry.receivedMessages += numberOfMessages;
+    entry.receivedBytes    += numberOfBytes;
+  }
+}
+
+
+void peano::performanceanalysis::CommunicationMatrix::endIteration() {
+  if (_isEnabled) {
+    tarch::multicore::Lock lock(_semaphore);
+    _iteration++;
+  }
+}
+
+
+int peano::performanceanalysis::CommunicationMatrix::getIteration() const {
+  tarch::multicore::Lock lock(_semaphore);
+  return _iteration;
+}
+
+
+void peano::performanceanalysis::CommunicationMatrix::clear() {
+  tarch::multicore::Lock lock(_semaphore);
+  _entries.clear();
+  _iteration = 0;
+}
+
+
+peano::performanceanalysis::CommunicationMatrix::Entry peano::performanceanalysis::CommunicationMatrix::getTotal(int rank, Kind kind) const {
+  tarch::multicore::Lock lock(_semaphore);
+  Entry result;
+  for (Entries::const_iterator p=_entries.begin(); p!=_entries.end(); p++) {
+    if (p->first.rank==rank && p->first.kind==kind) {
+      result.sentMessages     += p->second.sentMessages;
+      result.sentBytes        += p->second.sentBytes;
+      result.receivedMessages += p->second.receivedMessages;
+      result.receivedBytes    += p->second.receivedBytes;
+    }
+  }
+  return result;
+}
+
+
+long int peano::performanceanalysis::CommunicationMatrix::getNumberOfSentMessages(int toRank, Kind kind) const {
+  return getTotal(toRank,kind).sentMessages;
+}
+
+
+long int peano::performanceanalysis::CommunicationMatrix::getNumberOfSentBytes(int toRank, Kind kind) const {
+  return getTotal(toRank,kind).sentBytes;
+}
+
+
+long int peano::performanceanalysis::CommunicationMatrix::getNumberOfReceivedMessages(int fromRank, Kind kind) const {
+  return getTotal(fromRank,kind).receivedMessages;
+}
+
+
+long int peano::performanceanalysis::CommunicationMatrix::getNumberOfReceivedBytes(int fromRank, Kind kind) const {
+  return getTotal(fromRank,kind).receivedBytes;
+}
+
+
+void peano::performanceanalysis::CommunicationMatrix::writeToStream(std::ostream& out, int localRank) const {
+  tarch::multicore::Lock lock(_semaphore);
+  writeEntriesToStream(out,localRank);
+}
+
+
+void peano::performanceanalysis::CommunicationMatrix::writeEntriesToStream(std::ostream& out, int localRank) const {
+  out << "rank,peer,kind,tag,iteration,sent-messages,sent-bytes,received-messages,received-bytes" << std::endl;
+  for (Entries::const_iterator p=_entries.begin(); p!=_entries.end(); p++) {
+    out << localRank
+        << "," << p->first.rank
+        << "," << toString(p->first.kind)
+        << "," << p->first.tag
+        << "," << p->first.iteration
+        << "," << p->second.sentMessages
+        << "," << p->second.sentBytes
+        << "," << p->second.receivedMessages
+        << "," << p->second.receivedBytes
+        << std::endl;
+  }
+}
+
+
+void peano::performanceanalysis::CommunicationMatrix::writeToFile() const {
+  if (_isEnabled && !_filename.empty()) {
+    std::ostringstream filename;
+    filename << "rank-" << tarch::parallel::Node::getInstance().getRank() << "-" << _filename;
+
+    std::ofstream f(filename.str().c_str(),std::ios::out );
+    if (f.is_open()) {
+      tarch::multicore::Lock lock(_semaphore);
+      writeEntriesToStream(f,tarch::parallel::Node::getInstance().getRank());
+      const int numberOfEntries = _entries.size();
+      lock.free();
+
+      f.flush();
+      f.close();
+      logInfo( "writeToFile()", "wrote " << numberOfEntries << " entries of communication matrix into " << filename.str() );
+    }
+    else {
+      logError("writeToFile()", "could not write into " << filename.str() << ", error message: " << std::strerror(errno) );
+    }
+  }
+}
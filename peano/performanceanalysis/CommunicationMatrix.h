@@ -0,0 +1,177 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _PEANO_PERFORMANCE_ANALYIS_COMMUNICATION_MATRIX_H_
+#define _PEANO_PERFORMANCE_ANALYIS_COMMUNICATION_MATRIX_H_
+
+
+#include "tarch/logging/Log.h"
+#include "tarch/multicore/BooleanSemaphore.h"
+
+
+#include <map>
+#include <string>
+#include <ostream>
+
+
+namespace peano {
+  namespace performanceanalysis {
+    class CommunicationMatrix;
+  }
+}
+
+
+
+/**
+ * Communication matrix of one rank
+ *
+ * The matrix counts how many messages and bytes a rank exchanges with each
+ * other rank. The counters are split up per kind of exchange, per tag and per
+ * iteration. They are fed by
+ *
+ * - the SendReceiveBufferPool (vertex data exchanged along the boundaries),
+ * - the JoinDataBufferPool (vertices, cells and cell markers exchanged
+ *   throughout joins and forks), and
+ * - the BoundaryDataExchangers of all heaps.
+ *
+ * A message is one MPI message, i.e. one page of a buffer or one heap entry.
+ * Its size is the number of entries times the size of the (packed) record.
+ * The actual number of bytes on the wire thus might differ slightly, as MPI
+ * might skip the gaps within records and as some heaps compress their data
+ * before they send it.
+ *
+ * <h2> Usage </h2>
+ *
+ * The counters are switched off by default. To switch them on, call
+ *
+ * <pre>
+  peano::performanceanalysis::CommunicationMatrix::getInstance().enable("communication-matrix.csv");
+   </pre>
+ *
+ * on each rank before the first iteration. peano::shutdownParallelEnvironment()
+ * then writes the matrix into rank-x-communication-matrix.csv. The files
+ * follow the naming convention of the log files. Each line of a file holds
+ *
+ * <pre>
+ rank,peer,kind,tag,iteration,sent-messages,sent-bytes,received-messages,received-bytes
+   </pre>
+ *
+ * The python script merge-communication-matrices.py in this directory merges
+ * the files of all ranks into rank-by-rank matrices.
+ *
+ * <h2> Iterations </h2>
+ *
+ * The grid advances the iteration counter at the end of each traversal, i.e.
+ * after it has released the join and boundary data. Data exchanged before the
+ * first traversal, such as heap data sent by the repository, is booked on
+ * iteration 0. As workers do not run through all the iterations of their
+ * master, iteration counters of different ranks do not necessarily match.
+ */
+class peano::performanceanalysis::CommunicationMatrix {
+  public:
+    enum class Kind {
+      BoundaryData,
+      JoinAndForkData,
+      HeapData
+    };
+
+    static std::string toString(Kind kind);
+
+  private:
+    static tarch::logging::Log  _log;
+
+    struct Key {
+      int   iteration;
+      int   rank;
+      Kind  kind;
+      int   tag;
+
+      bool operator<(const Key& rhs) const;
+    };
+
+    struct Entry {
+      long int sentMessages;
+      long int sentBytes;
+      long int receivedMessages;
+      long int receivedBytes;
+
+      Entry();
+    };
+
+    typedef std::map<Key,Entry>  Entries;
+
+    bool                               _isEnabled;
+    std::string                        _filename;
+    int                                _iteration;
+    Entries                            _entries;
+
+    /**
+     * Heap data might be received by the progress engine's thread. All
+     * readers thus lock, too.
+     */
+    mutable tarch::multicore::BooleanSemaphore _semaphore;
+
+    CommunicationMatrix();
+
+    Entry getTotal(int rank, Kind kind) const;
+
+    /**
+     * Counterpart of writeToStream() that does not lock. The caller has to
+     * hold _semaphore.
+     */
+    void writeEntriesToStream(std::ostream& out, int localRank) const;
+  public:
+    static CommunicationMatrix& getInstance();
+
+    /**
+     * Switch the counters on.
+     *
+     * @param filename File name without the rank-x- prefix. Pass the empty
+     *          string if you do not want writeToFile() to dump the matrix,
+     *          e.g. as you evaluate it yourself.
+     */
+    void enable(const std::string& filename);
+
+    void disable();
+
+    bool isEnabled() const;
+
+    void sentMessages(int toRank, Kind kind, int tag, int numberOfMessages, long int numberOfBytes);
+    void receivedMessages(int fromRank, Kind kind, int tag, int numberOfMessages, long int numberOfBytes);
+
+    /**
+     * Is called by the grid at the end of each traversal.
+     */
+    void endIteration();
+
+    int getIteration() const;
+
+    /**
+     * Clear all counters and restart the iteration counter.
+     */
+    void clear();
+
+    /**
+     * @return Messages sent to rank of a given kind, accumulated over all
+     *         tags and iterations.
+     */
+    long int getNumberOfSentMessages(int toRank, Kind kind) const;
+    long int getNumberOfSentBytes(int toRank, Kind kind) const;
+    long int getNumberOfReceivedMessages(int fromRank, Kind kind) const;
+    long int getNumberOfReceivedBytes(int fromRank, Kind kind) const;
+
+    /**
+     * Write the matrix in the CSV format documented above. localRank is the
+     * rank written into the first column.
+     */
+    void writeToStream(std::ostream& out, int localRank) const;
+
+    /**
+     * Write the matrix into rank-x-filename if the matrix is enabled and a
+     * file name has been set. Otherwise, the operation degenerates to
+     * nop.
+     */
+    void writeToFile() const;
+};
+
+
+#endif
@@ -0,0 +1,115 @@
+import sys
+import csv
+
+
+#
+# main
+#
+if len(sys.argv)!=3:
+  print( "Usage: python merge-communication-matrices.py filename ranks" )
+  print( "" )
+  print( "filename is the name of the communication matrix files without the " )
+  print( "rank-x- prefix, i.e. the name passed to CommunicationMatrix::enable(). " )
+  print( "ranks is the number of ranks you have used for your simulation. The " )
+  print( "script writes two files:" )
+  print( "" )
+  print( "merged-filename   Sent messages and bytes per pair of ranks, kind and " )
+  print( "                  iteration as CSV." )
+  print( "matrix-filename   Rank-by-rank matrices of the bytes and messages " )
+  print( "                  sent in total. Row i, column j gives the data sent " )
+  print( "                  from rank i to rank j. There is one matrix over all " )
+  print( "                  kinds followed by one matrix per kind." )
+  print( "" )
+  print( "(C) 2018 Tobias Weinzierl" )
+  quit()
+
+
+
+filename = sys.argv[1]
+ranks    = int( sys.argv[2] )
+
+
+#
+# (sender,receiver,kind,iteration) -> [messages,bytes]
+#
+sent     = {}
+#
+# (sender,receiver,kind) -> [messages,bytes] as seen by the receiver
+#
+received = {}
+kinds    = []
+
+for rank in range(0,ranks):
+  inputFilename = "rank-" + str(rank) + "-" + filename
+  print( "read " + inputFilename )
+  try:
+    with open(inputFilename) as f:
+      for row in csv.DictReader(f):
+        localRank = int(row["rank"])
+        peer      = int(row["peer"])
+        kind      = row["kind"]
+        iteration = int(row["iteration"])
+        if kind not in kinds:
+          kinds.append(kind)
+
+        key = (localRank,peer,kind,iteration)
+        if key not in sent:
+          sent[key] = [0,0]
+        sent[key][0] += int(row["sent-messages"])
+        sent[key][1] += int(row["sent-bytes"])
+
+        key = (peer,localRank,kind)
+        if key not in received:
+          received[key] = [0,0]
+        received[key][0] += int(row["received-messages"])
+        received[key][1] += int(row["received-bytes"])
+  except IOError:
+    print( "WARNING: could not read " + inputFilename + ". Rank might not have exchanged any data" )
+
+
+#
+# Cross-check sender and receiver view
+#
+totalSent = {}
+for (sender,receiver,kind,iteration) in sent:
+  key = (sender,receiver,kind)
+  if key not in totalSent:
+    totalSent[key] = [0,0]
+  totalSent[key][0] += sent[(sender,receiver,kind,iteration)][0]
+  totalSent[key][1] += sent[(sender,receiver,kind,iteration)][1]
+for key in set(totalSent.keys()) | set(received.keys()):
+  sentBytes     = totalSent.get(key,[0,0])[1]
+  receivedBytes = received.get(key,[0,0])[1]
+  if sentBytes!=receivedBytes:
+    print( "WARNING: rank " + str(key[0]) + " sent " + str(sentBytes) + " byte(s) of " + key[2] + " to rank " + str(key[1]) + " but the latter received " + str(receivedBytes) + " byte(s)" )
+
+
+print( "write merged-" + filename )
+with open( "merged-" + filename, "w" ) as outputFile:
+  outputFile.write( "sender,receiver,kind,iteration,messages,bytes\n" )
+  for key in sorted(sent.keys()):
+    if sent[key][0]>0:
+      outputFile.write( str(key[0]) + "," + str(key[1]) + "," + key[2] + "," + str(key[3]) + "," + str(sent[key][0]) + "," + str(sent[key][1]) + "\n" )
+
+
+def writeMatrix(outputFile,title,kindsToSum,index):
+  outputFile.write( title + "\n" )
+  outputFile.write( "from/to," + ",".join( [str(i) for i in range(0,ranks)] ) + "\n" )
+  for sender in range(0,ranks):
+    row = []
+    for receiver in range(0,ranks):
+      value = 0
+      for kind in kindsToSum:
+        value += totalSent.get((sender,receiver,kind),[0,0])[index]
+      row.append( str(value) )
+    outputFile.write( str(sender) + "," + ",".join(row) + "\n" )
+  outputFile.write( "\n" )
+
+
+print( "write matrix-" + filename )
+with open( "matrix-" + filename, "w" ) as outputFile:
+  writeMatrix( outputFile, "bytes (all kinds)",    kinds, 1 )
+  writeMatrix( outputFile, "messages (all kinds)", kinds, 0 )
+  for kind in kinds:
+    writeMatrix( outputFile, "bytes (" + kind + ")",    [kind], 1 )
+    writeMatrix( outputFile, "messages (" + kind + ")", [kind], 0 )
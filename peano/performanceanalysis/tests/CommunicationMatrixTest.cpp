@@ -0,0 +1,102 @@
+#include "peano/performanceanalysis/tests/CommunicationMatrixTest.h"
+
+#include "peano/performanceanalysis/CommunicationMatrix.h"
+
+
+#include <sstream>
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(peano::performanceanalysis::tests::CommunicationMatrixTest)
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+peano::performanceanalysis::tests::CommunicationMatrixTest::CommunicationMatrixTest():
+  tarch::tests::TestCase( "peano::performanceanalysis::tests::CommunicationMatrixTest" ) {
+}
+
+
+peano::performanceanalysis::tests::CommunicationMatrixTest::~CommunicationMatrixTest() {
+}
+
+
+void peano::performanceanalysis::tests::CommunicationMatrixTest::run() {
+  testMethod( testDisabledMatrix );
+  testMethod( testAccumulation );
+  testMethod( testWriteToStream );
+}
+
+
+void peano::performanceanalysis::tests::CommunicationMatrixTest::testDisabledMatrix() {
+  CommunicationMatrix& matrix = CommunicationMatrix::getInstance();
+  matrix.disable();
+  matrix.clear();
+
+  matrix.sentMessages( 1, CommunicationMatrix::Kind::BoundaryData, 7, 1, 128 );
+  matrix.endIteration();
+
+  validateEquals( matrix.getNumberOfSentMessages(1,CommunicationMatrix::Kind::BoundaryData), 0 );
+  validateEquals( matrix.getIteration(), 0 );
+}
+
+
+void peano::performanceanalysis::tests::CommunicationMatrixTest::testAccumulation() {
+  CommunicationMatrix& matrix = CommunicationMatrix::getInstance();
+  matrix.enable("");
+  matrix.clear();
+
+  matrix.sentMessages( 1, CommunicationMatrix::Kind::BoundaryData, 7, 1, 128 );
+  matrix.sentMessages( 1, CommunicationMatrix::Kind::HeapData, 12, 1, 40 );
+  matrix.endIteration();
+  matrix.sentMessages( 1, CommunicationMatrix::Kind::BoundaryData, 7, 1, 64 );
+  matrix.sentMessages( 2, CommunicationMatrix::Kind::BoundaryData, 7, 1, 32 );
+  matrix.receivedMessages( 1, CommunicationMatrix::Kind::BoundaryData, 7, 2, 256 );
+
+  validateEquals( matrix.getIteration(), 1 );
+  validateEquals( matrix.getNumberOfSentMessages(1,CommunicationMatrix::Kind::BoundaryData), 2 );
+  validateEquals( matrix.getNumberOfSentBytes(1,CommunicationMatrix::Kind::BoundaryData), 192 );
+  validateEquals( matrix.getNumberOfSentBytes(1,CommunicationMatrix::Kind::HeapData), 40 );
+  validateEquals( matrix.getNumberOfSentBytes(2,CommunicationMatrix::Kind::BoundaryData), 32 );
+  validateEquals( matrix.getNumberOfSentBytes(1,CommunicationMatrix::Kind::JoinAndForkData), 0 );
+  validateEquals( matrix.getNumberOfReceivedMessages(1,CommunicationMatrix::Kind::BoundaryData), 2 );
+  validateEquals( matrix.getNumberOfReceivedBytes(1,CommunicationMatrix::Kind::BoundaryData), 256 );
+
+  matrix.clear();
+  matrix.disable();
+}
+
+
+void peano::performanceanalysis::tests::CommunicationMatrixTest::testWriteToStream() {
+  CommunicationMatrix& matrix = CommunicationMatrix::getInstance();
+  matrix.enable("");
+  matrix.clear();
+
+  matrix.sentMessages( 3, CommunicationMatrix::Kind::JoinAndForkData, 5, 1, 16 );
+  matrix.endIteration();
+  matrix.receivedMessages( 3, CommunicationMatrix::Kind::HeapData, 12, 1, 8 );
+
+  std::ostringstream out;
+  matrix.writeToStream(out,0);
+
+  validateEqualsWithParams1(
+    out.str(),
+    std::string(
+      "rank,peer,kind,tag,iteration,sent-messages,sent-bytes,received-messages,received-bytes\n"
+      "0,3,join-and-fork-data,5,0,1,16,0,0\n"
+      "0,3,heap-data,12,1,0,0,1,8\n"
+    ),
+    out.str()
+  );
+
+  matrix.clear();
+  matrix.disable();
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
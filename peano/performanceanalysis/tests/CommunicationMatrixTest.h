@@ -0,0 +1,40 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef PEANO_PERFORMANCE_ANALYSIS_TESTS_COMMUNICATION_MATRIX_H_
+#define PEANO_PERFORMANCE_ANALYSIS_TESTS_COMMUNICATION_MATRIX_H_
+
+#include "tarch/tests/TestCase.h"
+
+namespace peano {
+  namespace performanceanalysis {
+    namespace tests {
+      class CommunicationMatrixTest;
+    }
+  }
+}
+
+class peano::performanceanalysis::tests::CommunicationMatrixTest: public tarch::tests::TestCase {
+  private:
+    /**
+     * A disabled matrix does not count anything.
+     */
+    void testDisabledMatrix();
+
+    /**
+     * Counters are accumulated per rank and kind over all tags and
+     * iterations.
+     */
+    void testAccumulation();
+
+    /**
+     * Each tag and iteration yields its own line in the CSV output.
+     */
+    void testWriteToStream();
+ public:
+   CommunicationMatrixTest();
+   virtual ~CommunicationMatrixTest();
+
+   virtual void run();
+};
+
+#endif
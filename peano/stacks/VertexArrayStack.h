@@ -12,6 +12,9 @@
 #include "peano/grid/Checkpoint.h"
 
 
+#include <functional>
+
+
 namespace peano {
     namespace stacks {
       template <class Vertex>
@@ -139,6 +142,11 @@ class peano::stacks::VertexArrayStack {
 
     void clear();
 
+    /**
+     * Block pushes are not supported, i.e. there is nothing to wait for.
+     */
+    void setWaitForOutstandingBlockPushes( const std::function<void()>& wait ) {}
+
     /**
      * This operation flips input and output stack.
      */
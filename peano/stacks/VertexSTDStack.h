@@ -12,6 +12,9 @@
 #include "peano/grid/Checkpoint.h"
 
 
+#include <functional>
+
+
 namespace peano {
     namespace stacks {
       template <class Vertex>
@@ -23,6 +26,16 @@ namespace peano {
 /**
  * Vertex Stack Based upon C++'s STD Stack
  *
+ * !!! Asynchronous block writes
+ *
+ * The store tasks of regular subtrees write into push block views on the
+ * output stack. They might still run while the traversal continues with
+ * other parts of the tree (see AsynchronousStoresOnRegularSubtrees). Every
+ * operation that could reallocate the output stack or hand it over as input
+ * stack thus first waits until all outstanding block pushes have terminated.
+ * In a stationary setup, RegularRefined reserves enough space on the output
+ * stack such that this wait only happens at the stack flip.
+ *
  * @author Tobias Weinzierl
  * @version $Revision: 1.2 $
  */
@@ -61,6 +74,12 @@ class peano::stacks::VertexSTDStack {
      */
     PersistentContainer _inputOutputStack[InOutStacks];
 
+    /**
+     * Is invoked over and over again while we wait for block pushes. See
+     * setWaitForOutstandingBlockPushes().
+     */
+    std::function<void()> _waitForOutstandingBlockPushes;
+
     /**
      * One is not allowed to clone a stack.
      */
@@ -71,6 +90,12 @@ class peano::stacks::VertexSTDStack {
      */
     VertexSTDStack<Vertex>& operator=( const VertexSTDStack<Vertex>& stack ) { return *this; }
 
+    /**
+     * Invoke the wait operation until no block view on the output stack is
+     * open anymore. Degenerates to nop if no block push is outstanding.
+     */
+    void waitUntilAllBlockPushesOnOutputStackHaveTerminated();
+
   public:
     typedef typename PersistentContainer::PopBlockVertexStackView   PopBlockVertexStackView;
     typedef typename PersistentContainer::PushBlockVertexStackView  PushBlockVertexStackView;
@@ -117,15 +142,33 @@ class peano::stacks::VertexSTDStack {
     bool isInputStackEmpty() const;
     bool isOutputStackEmpty() const;
 
+    /**
+     * @return Are there push block views on the input or the output stack
+     *         that have not been written completely yet? Never holds right
+     *         after flipInputAndOutputStack() or clear().
+     */
+    bool hasOutstandingBlockPushes() const;
+
     void clear();
 
     /**
-     * This operation flips input and output stack.
+     * Set the operation the stack invokes while it waits for outstanding block
+     * pushes. The stack does not know who writes into the blocks. The default
+     * yields the thread and thus relies on other threads to complete the
+     * pushes. RegularRefined passes an operation that processes the pending
+     * store tasks.
+     */
+    void setWaitForOutstandingBlockPushes( const std::function<void()>& wait );
+
+    /**
+     * This operation flips input and output stack. It is the latest point
+     * where asynchronous block writes to the output stack are synchronised.
      */
     void flipInputAndOutputStack();
 
     /**
-     * @todo
+     * Ensure the output stack can take n further elements without
+     * reallocation.
      */
     void growOutputStackByAtLeastNElements(int n);
 
@@ -10,6 +10,12 @@
 
 #include "tarch/logging/Log.h"
 #include "tarch/Assertions.h"
+#include "tarch/multicore/MulticoreDefinitions.h"
+
+
+#if defined(SharedMemoryParallelisation)
+#include <atomic>
+#endif
 
 
 namespace peano {
@@ -42,6 +48,17 @@ namespace peano {
  * invalid memory. I hence use the TBB vector variant that is thread-safe. As a
  * consequence, OpenMP is not supported for std stacks.
  *
+ * !!! Outstanding block pushes
+ *
+ * A push block view might be written by a task that outlives the code
+ * section that has opened the view. In this case, nobody may reallocate the
+ * container before the view is written completely. The stack thus counts
+ * the records that are reserved by pushBlockOnOutputStack() but not written
+ * yet. Each view hands back its records en block once it is exhausted, i.e.
+ * we do not synchronise per record. Users that might reallocate the stack
+ * have to check hasOutstandingBlockPushes() before, and it is up to them to
+ * wait for the writing tasks. The stack itself does not know about tasks.
+ *
  * @author Tobias Weinzierl
  * @version $Revision: 1.9 $
  */
@@ -61,6 +78,13 @@ class peano::stacks::implementation::STDStack {
     int _maxSize;
 
     int _currentElement;
+
+    #if defined(SharedMemoryParallelisation)
+    /**
+     * Number of records reserved by push block views but not written yet.
+     */
+    std::atomic<int> _numberOfOutstandingBlockPushes;
+    #endif
   public:
     class PopBlockVertexStackView {
       private:
@@ -159,7 +183,25 @@ class peano::stacks::implementation::STDStack {
 
         int         _remainingSize;
 
+        /**
+         * Records written by this view itself, i.e. not by views that have
+         * been split off.
+         */
+        int         _numberOfPushedElements;
+
         peano::stacks::implementation::STDStack<T>*  _stack;
+
+        /**
+         * Hand the records written by this view back to the stack's counter
+         * of outstanding block pushes once the view is exhausted.
+         */
+        void closeIfExhausted() {
+          #if defined(SharedMemoryParallelisation)
+          if (_remainingSize==0 && _numberOfPushedElements>0) {
+            _stack->_numberOfOutstandingBlockPushes -= _numberOfPushedElements;
+          }
+          #endif
+        }
       public:
         /**
          * The default constructor creates an empty stack view
@@ -168,6 +210,7 @@ class peano::stacks::implementation::STDStack {
           _currentElement(0),
           _size(0),
           _remainingSize(0),
+          _numberOfPushedElements(0),
           _stack(0) {
         }
 
@@ -178,6 +221,7 @@ class peano::stacks::implementation::STDStack {
           _currentElement(currentElementBeforeViewIsOpened),
           _size(size),
           _remainingSize(size),
+          _numberOfPushedElements(0),
           _stack(stack) {
         }
 
@@ -199,6 +243,8 @@ class peano::stacks::implementation::STDStack {
           assertion( _stack!=0 );
           _stack->_container[_currentElement] = value;
           _currentElement++;
+          _numberOfPushedElements++;
+          closeIfExhausted();
         }
 
         PushBlockVertexStackView pushBlockOnOutputStack(int numberOfVertices) {
@@ -209,6 +255,8 @@ class peano::stacks::implementation::STDStack {
 
           assertion3( _remainingSize>=0, numberOfVertices, _remainingSize, _currentElement );
 
+          closeIfExhausted();
+
           return result;
         }
 
@@ -228,7 +276,11 @@ class peano::stacks::implementation::STDStack {
      */
     STDStack():
       _maxSize(0),
-      _currentElement(0) {
+      _currentElement(0)
+      #if defined(SharedMemoryParallelisation)
+      , _numberOfOutstandingBlockPushes(0)
+      #endif
+      {
     }
 
     void clear() {
@@ -321,9 +373,33 @@ class peano::stacks::implementation::STDStack {
 
       assertion4( _currentElement < static_cast<int>(_container.size()), _currentElement, static_cast<int>(_container.size()), numberOfVertices, getMaxSize() );
 
+      #if defined(SharedMemoryParallelisation)
+      _numberOfOutstandingBlockPushes += numberOfVertices;
+      #endif
+
       return result;
     }
 
+    /**
+     * @return Are there push block views that have not been written
+     *         completely yet. Always false in serial mode.
+     */
+    bool hasOutstandingBlockPushes() const {
+      #if defined(SharedMemoryParallelisation)
+      return _numberOfOutstandingBlockPushes>0;
+      #else
+      return false;
+      #endif
+    }
+
+    /**
+     * @return Would pushing n further elements alter the underlying
+     *         container's size, i.e. might the container be reallocated.
+     */
+    bool requiresToGrowForNElements(int n) const {
+      return _currentElement + n > static_cast<int>(_container.size());
+    }
+
     /**
      * @return Size of the stack.
      */
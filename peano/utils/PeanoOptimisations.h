@@ -141,6 +141,22 @@
 #endif
 
 
+/**
+ * With a shared memory parallelisation, the store process of a regular
+ * subtree forks tasks that write into reserved blocks of the output stack.
+ * By default, RegularRefined waits for these tasks before it returns. If you
+ * translate with -DAsynchronousStoresOnRegularSubtrees, it does not wait
+ * anymore but continues with the traversal. We then synchronise when the
+ * next regular subtree is entered (it reuses the regular grid container)
+ * and, at the latest, when the vertex stacks are flipped. The feature is
+ * opt-in, as it only works with vertex stacks that track their outstanding
+ * block pushes (VertexSTDStack).
+ */
+#if defined(AsynchronousStoresOnRegularSubtrees) && !defined(UseRecursionUnrollingOnRegularPatches)
+  #error AsynchronousStoresOnRegularSubtrees is enabled though UseRecursionUnrollingOnRegularPatches is disabled
+#endif
+
+
 /**
  * We usually do all the heap data exchange via non-blocking calls, i.e. all
  * meta data (how many records are exchanged) is communicated immediately while
@@ -18,6 +18,8 @@
 
 #define CompilerHasSysinfo
 
+#define CompilerHasFutex
+
 //#define CompilerDefinesMPIMaxNameString
 
 
@@ -21,6 +21,7 @@
 #define CompilerHasUTSName
 #define CompilerHasTimespec
 //#define CompilerHasSysinfo
+//#define CompilerHasFutex
 //#define CompilerDefinesMPIMaxNameString
 //#define DaStGenPackedPadding 1      // 32 bit version
 // #define DaStGenPackedPadding 2   // 64 bit version
@@ -24,6 +24,7 @@
 //#define DaStGenPackedPadding 1      // 32 bit version
 // #define DaStGenPackedPadding 2   // 64 bit version
 //#define CompilerHasSysinfo
+//#define CompilerHasFutex
 
 #ifndef noMultipleThreadsMayTriggerMPICalls
 #define MultipleThreadsMayTriggerMPICalls
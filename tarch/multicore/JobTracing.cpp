@@ -0,0 +1,225 @@
+#include "tarch/multicore/JobTracing.h"
+#include "tarch/logging/Log.h"
+
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+
+#ifdef TraceJobs
+#include "tarch/multicore/BooleanSemaphore.h"
+#include "tarch/multicore/Lock.h"
+
+#include <vector>
+#endif
+
+
+namespace {
+  tarch::logging::Log  _log( "tarch::multicore::jobs::tracing" );
+
+  const std::chrono::steady_clock::time_point  TracingEpoch = std::chrono::steady_clock::now();
+
+  #ifdef TraceJobs
+  struct Record {
+    long long                         spawnTimeStamp;
+    long long                         startTimeStamp;
+    long long                         endTimeStamp;
+    int                               jobClass;
+    tarch::multicore::jobs::JobType   jobType;
+  };
+
+  /**
+   * Ring buffer of one thread. Only the owning thread writes, so we do not
+   * need any synchronisation.
+   */
+  struct RingBuffer {
+    const int            threadNumber;
+    std::vector<Record>  records;
+    long int             numberOfRecords;
+
+    RingBuffer(int threadNumber_):
+      threadNumber(threadNumber_),
+      records(tarch::multicore::jobs::tracing::RingBufferSize),
+      numberOfRecords(0) {
+    }
+
+    void add(const Record& record) {
+      records[ numberOfRecords % tarch::multicore::jobs::tracing::RingBufferSize ] = record;
+      numberOfRecords++;
+    }
+
+    int getNumberOfValidRecords() const {
+      return numberOfRecords < tarch::multicore::jobs::tracing::RingBufferSize ? static_cast<int>(numberOfRecords) : tarch::multicore::jobs::tracing::RingBufferSize;
+    }
+
+    /**
+     * Records in chronological order: If the buffer has wrapped around, the
+     * oldest record sits right after the latest one.
+     */
+    const Record& getRecord(int i) const {
+      const long int first = numberOfRecords - getNumberOfValidRecords();
+      return records[ (first+i) % tarch::multicore::jobs::tracing::RingBufferSize ];
+    }
+  };
+
+  /**
+   * All ring buffers ever created. Buffers are never released as the owning
+   * threads might terminate before we dump the trace. The registry is never
+   * destroyed either, as threads might record after the static objects have
+   * gone down.
+   */
+  struct Registry {
+    tarch::multicore::BooleanSemaphore  semaphore;
+    std::vector<RingBuffer*>            buffers;
+  };
+
+  Registry& getRegistry() {
+    static Registry* registry = new Registry();
+    return *registry;
+  }
+
+  RingBuffer& getThreadLocalRingBuffer() {
+    thread_local RingBuffer* buffer = nullptr;
+    if (buffer==nullptr) {
+      tarch::multicore::Lock lock( getRegistry().semaphore );
+      buffer = new RingBuffer( static_cast<int>(getRegistry().buffers.size()) );
+      getRegistry().buffers.push_back( buffer );
+    }
+    return *buffer;
+  }
+
+  std::string toString( tarch::multicore::jobs::JobType jobType ) {
+    switch (jobType) {
+      case tarch::multicore::jobs::JobType::Job:
+        return "Job";
+      case tarch::multicore::jobs::JobType::Task:
+        return "Task";
+      case tarch::multicore::jobs::JobType::MPIReceiveTask:
+        return "MPIReceiveTask";
+      case tarch::multicore::jobs::JobType::RunTaskAsSoonAsPossible:
+        return "RunTaskAsSoonAsPossible";
+      case tarch::multicore::jobs::JobType::ProcessImmediately:
+        return "ProcessImmediately";
+    }
+    return "<undef>";
+  }
+
+  /**
+   * Chrome traces use microseconds.
+   */
+  double toMicroseconds( long long timeStamp ) {
+    return static_cast<double>(timeStamp) / 1000.0;
+  }
+  #endif
+}
+
+
+long long tarch::multicore::jobs::tracing::getTimeStamp() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - TracingEpoch ).count();
+}
+
+
+#ifdef TraceJobs
+bool tarch::multicore::jobs::tracing::run(Job& job) {
+  Record record;
+  record.spawnTimeStamp = job.getSpawnTimeStamp();
+  record.jobClass       = job.getClass();
+  record.jobType        = job.getJobType();
+  record.startTimeStamp = getTimeStamp();
+
+  const bool result = job.run();
+
+  record.endTimeStamp   = getTimeStamp();
+  getThreadLocalRingBuffer().add(record);
+
+  return result;
+}
+#endif
+
+
+int tarch::multicore::jobs::tracing::getNumberOfRecordedEvents() {
+  int result = 0;
+  #ifdef TraceJobs
+  tarch::multicore::Lock lock( getRegistry().semaphore );
+  for (auto p: getRegistry().buffers) {
+    result += p->getNumberOfValidRecords();
+  }
+  #endif
+  return result;
+}
+
+
+long int tarch::multicore::jobs::tracing::getNumberOfDroppedEvents() {
+  long int result = 0;
+  #ifdef TraceJobs
+  tarch::multicore::Lock lock( getRegistry().semaphore );
+  for (auto p: getRegistry().buffers) {
+    result += p->numberOfRecords - p->getNumberOfValidRecords();
+  }
+  #endif
+  return result;
+}
+
+
+void tarch::multicore::jobs::tracing::clear() {
+  #ifdef TraceJobs
+  tarch::multicore::Lock lock( getRegistry().semaphore );
+  for (auto p: getRegistry().buffers) {
+    p->numberOfRecords = 0;
+  }
+  #endif
+}
+
+
+void tarch::multicore::jobs::tracing::writeChromeTrace(std::ostream& out, int processId) {
+  out << "{\"traceEvents\":[";
+
+  #ifdef TraceJobs
+  tarch::multicore::Lock lock( getRegistry().semaphore );
+
+  out << std::fixed << std::setprecision(3);
+
+  bool first = true;
+  for (auto p: getRegistry().buffers) {
+    out << (first ? "" : ",") << std::endl
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << processId
+        << ",\"tid\":" << p->threadNumber
+        << ",\"args\":{\"name\":\"thread " << p->threadNumber << "\"}}";
+    first = false;
+
+    for (int i=0; i<p->getNumberOfValidRecords(); i++) {
+      const Record& record = p->getRecord(i);
+      out << "," << std::endl
+          << "{\"name\":\"class " << record.jobClass << "\""
+          << ",\"cat\":\"" << toString(record.jobType) << "\""
+          << ",\"ph\":\"X\""
+          << ",\"pid\":" << processId
+          << ",\"tid\":" << p->threadNumber
+          << ",\"ts\":" << toMicroseconds(record.startTimeStamp)
+          << ",\"dur\":" << toMicroseconds(record.endTimeStamp - record.startTimeStamp)
+          << ",\"args\":{\"spawned\":" << toMicroseconds(record.spawnTimeStamp)
+          << ",\"waiting\":" << toMicroseconds(record.startTimeStamp - record.spawnTimeStamp)
+          << "}}";
+    }
+  }
+  lock.free();
+  #endif
+
+  out << std::endl << "],\"displayTimeUnit\":\"ms\""
+      << ",\"otherData\":{\"dropped-events\":" << getNumberOfDroppedEvents() << "}}" << std::endl;
+}
+
+
+void tarch::multicore::jobs::tracing::writeChromeTrace(const std::string& filename, int processId) {
+  if (getNumberOfRecordedEvents()>0) {
+    std::ofstream out( filename.c_str() );
+    if ( out.fail() ) {
+      logWarning( "writeChromeTrace(string,int)", "could not open file " << filename << " to dump job trace" );
+    }
+    else {
+      writeChromeTrace(out,processId);
+      logInfo( "writeChromeTrace(string,int)", "wrote " << getNumberOfRecordedEvents() << " job record(s) into " << filename << " (" << getNumberOfDroppedEvents() << " record(s) dropped)" );
+    }
+  }
+}
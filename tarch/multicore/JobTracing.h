@@ -0,0 +1,106 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_MULTICORE_JOB_TRACING_H_
+#define _TARCH_MULTICORE_JOB_TRACING_H_
+
+
+#include "tarch/multicore/Jobs.h"
+
+
+#include <ostream>
+#include <string>
+
+
+namespace tarch {
+  namespace multicore {
+    namespace jobs {
+      /**
+       * Job tracing
+       *
+       * If you translate with -DTraceJobs, every execution of a job's run()
+       * is recorded: the time stamp when the job has been created (spawned),
+       * when run() started and when it returned, the thread that ran it, the
+       * job class and the job type. A job that asks to be rescheduled
+       * (run() returns true) yields one record per invocation.
+       *
+       * <h2> Overhead </h2>
+       *
+       * Each thread writes into a ring buffer of its own. There are no locks
+       * on the fast path besides the very first record of a thread, when the
+       * buffer is allocated and registered. If a buffer runs full, we
+       * overwrite the oldest records and count the dropped ones. Without
+       * TraceJobs, run() boils down to a plain call of Job::run().
+       *
+       * <h2> Output </h2>
+       *
+       * writeChromeTrace() dumps all records in the Chrome trace event format.
+       * Open the file with chrome://tracing or https://ui.perfetto.dev. Each
+       * thread shows up as a row, every job execution as a box named after
+       * the job class. The box's arguments give the time the job waited in a
+       * queue before it has been picked up. peano::shutdownSharedMemoryEnvironment()
+       * writes one file per rank automatically.
+       */
+      namespace tracing {
+        /**
+         * Number of records per thread before we start to overwrite the
+         * oldest ones.
+         */
+        constexpr int RingBufferSize = 65536;
+
+        /**
+         * Nanoseconds since the tracing component has been initialised.
+         */
+        long long getTimeStamp();
+
+        /**
+         * Run a job once and record the execution if tracing is enabled.
+         * Backends invoke jobs only through this routine.
+         *
+         * @return Result of job.run(), i.e. whether the job wants to be
+         *         rescheduled.
+         */
+        bool run(Job& job);
+
+        /**
+         * Number of records currently held by all ring buffers.
+         */
+        int getNumberOfRecordedEvents();
+
+        /**
+         * Number of records that have been overwritten.
+         */
+        long int getNumberOfDroppedEvents();
+
+        /**
+         * Empty all ring buffers. Is not thread-safe, i.e. you may not call it
+         * while jobs are still running.
+         */
+        void clear();
+
+        /**
+         * Write all records in the Chrome trace event format. Is not
+         * thread-safe, i.e. you may not call it while jobs are still running.
+         *
+         * @param processId Is used as pid within the trace. Typically the rank.
+         */
+        void writeChromeTrace(std::ostream& out, int processId);
+
+        /**
+         * Wrapper around the other writeChromeTrace() that writes into a file.
+         * Does nothing if no records are available.
+         */
+        void writeChromeTrace(const std::string& filename, int processId);
+      }
+    }
+  }
+}
+
+
+#ifndef TraceJobs
+inline bool tarch::multicore::jobs::tracing::run(Job& job) {
+  return job.run();
+}
+#endif
+
+
+#endif
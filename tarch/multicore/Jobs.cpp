@@ -1,4 +1,5 @@
 #include "tarch/multicore/Jobs.h"
+#include "tarch/multicore/JobTracing.h"
 #include "tarch/Assertions.h"
 
 
@@ -23,10 +24,22 @@ tarch::multicore::jobs::JobType tarch::multicore::jobs::Job::getJobType() const
 
 tarch::multicore::jobs::Job::Job( JobType jobType, int jobClass ):
   _jobType(jobType),
-  _jobClass(jobClass) {
+  _jobClass(jobClass)
+  #ifdef TraceJobs
+  ,
+  _spawnTimeStamp( tracing::getTimeStamp() )
+  #endif
+  {
 }
 
 
+#ifdef TraceJobs
+long long tarch::multicore::jobs::Job::getSpawnTimeStamp() const {
+  return _spawnTimeStamp;
+}
+#endif
+
+
 tarch::multicore::jobs::Job::~Job() {
 }
 
@@ -75,7 +88,7 @@ tarch::multicore::jobs::GenericJobWithoutCopyOfFunctor::~GenericJobWithoutCopyOf
 #ifndef SharedMemoryParallelisation
 
 void tarch::multicore::jobs::spawnBackgroundJob(Job* task) {
-  while (task->run()) {};
+  while (tracing::run(*task)) {};
   delete task;
 }
 
@@ -91,7 +104,7 @@ int tarch::multicore::jobs::getNumberOfWaitingBackgroundJobs() {
 
 
 void tarch::multicore::jobs::spawn(Job*  job) {
-  while( job->run() ) {};
+  while( tracing::run(*job) ) {};
   delete job;
 }
 
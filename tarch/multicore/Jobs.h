@@ -55,6 +55,14 @@ namespace tarch {
            const JobType  _jobType;
     	   const int      _jobClass;
 
+           #ifdef TraceJobs
+           /**
+            * Time stamp of the job's construction. As jobs are spawned right
+            * after they have been created, this is the spawn time.
+            */
+           const long long _spawnTimeStamp;
+           #endif
+
     	   friend void spawnBackgroundJob(Job* job);
     	   friend bool processBackgroundJobs();
 
@@ -73,6 +81,10 @@ namespace tarch {
            int getClass() const;
            JobType getJobType() const;
 
+           #ifdef TraceJobs
+           long long getSpawnTimeStamp() const;
+           #endif
+
            /**
             * If jobs are enqueued, they are typically not processed
             * immediately (unless we run on a single core machine), but Peano
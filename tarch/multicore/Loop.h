@@ -5,6 +5,7 @@
 
 
 #include "tarch/multicore/dForRange.h"
+#include "tarch/multicore/dForTilingRange.h"
 #include "tarch/la/Vector.h"
 #include "tarch/multicore/MulticoreDefinitions.h"
 
@@ -106,6 +107,38 @@ namespace tarch {
       const tarch::multicore::dForRange<4>&  range,
       F&                                     function
     );
+
+    /**
+     * Parallel loop over a tiled range
+     *
+     * The tiles are ordered along the Peano curve (see dForTilingRange). We
+     * run a parallel loop over the tile indices with a grain size of one.
+     * As the ranges split the index set into contiguous chunks, every task
+     * processes a sequence of consecutive tiles along the curve. Within a
+     * tile, the functor is invoked in lexicographic order.
+     *
+     * These variants are realised on top of the other parallelFor() and
+     * parallelReduce() operations, i.e. they work with any backend.
+     *
+     * The functor is not copied per task. All tasks share the one instance
+     * you pass in, so its operator() has to be thread-safe. If you need thread-local state, use the tiled
+     * parallelReduce() which hands out a copy per task.
+     */
+    template <int D, typename F>
+    void parallelFor(
+      const tarch::multicore::dForTilingRange<D>&  range,
+      F&                                           function
+    );
+
+    /**
+     * Reduction counterpart of the tiled parallelFor(). The functor has to
+     * provide mergeIntoMasterThread() as for the other reductions.
+     */
+    template <int D, typename F>
+    void parallelReduce(
+      const tarch::multicore::dForTilingRange<D>&  range,
+      F&                                           function
+    );
   }
 }
 
@@ -122,4 +155,7 @@ namespace tarch {
 #endif
 
 
+#include "tarch/multicore/TiledLoop.cpph"
+
+
 #endif
@@ -0,0 +1,62 @@
+#include "tarch/multicore/Reduction.h"
+#include "tarch/multicore/Lock.h"
+
+
+#if defined(SharedMemoryParallelisation)
+#include <set>
+
+
+namespace {
+  /**
+   * Book-keeping of the slot indices. Never destroyed, as threads might
+   * terminate after the static objects have gone down.
+   */
+  struct ThreadSlotIndexRegistry {
+    tarch::multicore::BooleanSemaphore  semaphore;
+    std::set<int>                       freeIndices;
+    int                                 nextIndex;
+
+    ThreadSlotIndexRegistry(): nextIndex(0) {}
+  };
+
+  ThreadSlotIndexRegistry& getThreadSlotIndexRegistry() {
+    static ThreadSlotIndexRegistry* registry = new ThreadSlotIndexRegistry();
+    return *registry;
+  }
+
+  /**
+   * One instance per thread. Takes the smallest free index and hands it back
+   * once the thread terminates.
+   */
+  struct ThreadSlotIndex {
+    int index;
+
+    ThreadSlotIndex() {
+      tarch::multicore::Lock lock( getThreadSlotIndexRegistry().semaphore );
+      if ( getThreadSlotIndexRegistry().freeIndices.empty() ) {
+        index = getThreadSlotIndexRegistry().nextIndex;
+        getThreadSlotIndexRegistry().nextIndex++;
+      }
+      else {
+        index = *getThreadSlotIndexRegistry().freeIndices.begin();
+        getThreadSlotIndexRegistry().freeIndices.erase( getThreadSlotIndexRegistry().freeIndices.begin() );
+      }
+    }
+
+    ~ThreadSlotIndex() {
+      tarch::multicore::Lock lock( getThreadSlotIndexRegistry().semaphore );
+      getThreadSlotIndexRegistry().freeIndices.insert(index);
+    }
+  };
+}
+#endif
+
+
+int tarch::multicore::getThreadSlotIndex() {
+  #if defined(SharedMemoryParallelisation)
+  thread_local ThreadSlotIndex threadSlotIndex;
+  return threadSlotIndex.index;
+  #else
+  return 0;
+  #endif
+}
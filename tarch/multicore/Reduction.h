@@ -0,0 +1,178 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_MULTICORE_REDUCTION_H_
+#define _TARCH_MULTICORE_REDUCTION_H_
+
+
+#include "tarch/multicore/MulticoreDefinitions.h"
+#include "tarch/multicore/BooleanSemaphore.h"
+
+#include <memory>
+#include <limits>
+#include <string>
+
+
+namespace tarch {
+  namespace multicore {
+    /**
+     * Cache line size we pad the accumulator slots to.
+     */
+    constexpr int CacheLineSize = 64;
+
+    /**
+     * Each thread that asks for a slot index gets a unique number that is
+     * dense, i.e. we hand out 0,1,2,... and recycle the index of a thread
+     * once this thread terminates. The index is the same for the whole
+     * lifetime of a thread. Without shared memory parallelisation, the
+     * operation always returns 0.
+     */
+    int getThreadSlotIndex();
+
+    template <typename T, typename Operation>
+    class Accumulator;
+
+    /**
+     * Predefined reduction operations. An operation is a class with two
+     * static functions identity() and combine(). You can write your own
+     * ones for arbitrary types.
+     */
+    namespace reductions {
+      template <typename T>
+      struct Sum {
+        static T     identity()                        { return T(0); }
+        static void  combine(T& lhs, const T& rhs)     { lhs += rhs; }
+      };
+
+      template <typename T>
+      struct Min {
+        static T     identity()                        { return std::numeric_limits<T>::max(); }
+        static void  combine(T& lhs, const T& rhs)     { lhs = rhs<lhs ? rhs : lhs; }
+      };
+
+      template <typename T>
+      struct Max {
+        static T     identity()                        { return std::numeric_limits<T>::lowest(); }
+        static void  combine(T& lhs, const T& rhs)     { lhs = rhs>lhs ? rhs : lhs; }
+      };
+    }
+  }
+}
+
+
+/**
+ * Accumulator for reductions within parallel loops
+ *
+ * The classic way to reduce in Peano is to let parallelReduce() copy the loop
+ * body per task and to merge the copies back via mergeIntoMasterThread().
+ * For the grid's loop bodies, this means that we copy the whole mapping per
+ * task, and we merge sequentially as every merge locks a semaphore. If all
+ * you want to reduce are a few numbers (residuals, counters, maxima), an
+ * accumulator is the better choice:
+ *
+ * - It holds one slot per thread. Each slot is padded to a cache line, so
+ *   threads do not invalidate each other's cache lines (no false sharing).
+ * - A thread contributes to its own slot only. There are no locks or atomics
+ *   on the fast path.
+ * - reduce() combines the slots in a binary tree.
+ *
+ * <h2> Copy semantics </h2>
+ *
+ * An accumulator is a handle. If you copy it, the copy refers to the same
+ * slots. That is what makes it useful within mappings: Peano may copy your
+ * mapping or your loop body around, but all copies write into the same
+ * per-thread slots and you do not have to merge anything in
+ * mergeWithWorkerThread(). If you want an accumulator of your own, use
+ * clone().
+ *
+ * <h2> Usage </h2>
+ *
+ * \code
+  tarch::multicore::Accumulator<double, tarch::multicore::reductions::Max<double> >  _maxResidual;
+
+  void MyMapping::enterCell(...) {
+    _maxResidual.contribute( std::abs(r) );
+  }
+
+  void MyMapping::endIteration(State& solverState) {
+    solverState.setResidual( _maxResidual.reduce() );
+    _maxResidual.reset();
+  }
+\endcode
+ *
+ * Please note that the mapping can now specify altersState as false for
+ * enterCell. Peano then does not copy the mapping per thread at all.
+ *
+ * If more threads than slots use one accumulator, the surplus threads share
+ * one additional slot that is protected by a semaphore. Things remain
+ * correct but become slower. Please increase the number of slots in this
+ * case.
+ */
+template <typename T, typename Operation = tarch::multicore::reductions::Sum<T> >
+class tarch::multicore::Accumulator {
+  private:
+    struct alignas(CacheLineSize) Slot {
+      T  value;
+    };
+
+    struct Slots {
+      char*             memory;
+      Slot*             slots;
+      int               numberOfSlots;
+
+      /**
+       * Value for all threads whose index exceeds numberOfSlots.
+       */
+      T                 overflowValue;
+      BooleanSemaphore  overflowSemaphore;
+
+      Slots(int numberOfSlots_);
+      ~Slots();
+    };
+
+    std::shared_ptr<Slots>  _slots;
+  public:
+    /**
+     * Default number of slots. Zero means that we use the number of hardware
+     * threads.
+     */
+    static constexpr int DefaultNumberOfSlots = 0;
+
+    Accumulator( int numberOfSlots = DefaultNumberOfSlots );
+
+    /**
+     * Add a value to the calling thread's slot.
+     */
+    void contribute( const T& value );
+
+    /**
+     * Direct access to the calling thread's slot, i.e. you can modify the
+     * value in-place. Is not available for overflow threads.
+     */
+    T& getThreadLocalValue();
+
+    /**
+     * Combine all slots. The operation is not thread-safe, i.e. you may not
+     * call it while threads still contribute.
+     */
+    T reduce() const;
+
+    /**
+     * Set all slots to the identity.
+     */
+    void reset();
+
+    /**
+     * Create an accumulator with new slots holding the same values.
+     */
+    Accumulator clone() const;
+
+    int getNumberOfSlots() const;
+
+    std::string toString() const;
+};
+
+
+#include "tarch/multicore/Reduction.cpph"
+
+
+#endif
@@ -1,27 +1,194 @@
 #include "tarch/multicore/BooleanSemaphore.h"
+#include "tarch/compiler/CompilerSpecificSettings.h"
 
 
-// This implementation is valid iff neither OpenMP nor TBBs nor any other
-// shared memory parallelisation are active
-
 #if defined(SharedCPP)
 
+#include <algorithm>
+#include <thread>
+
+#ifdef CompilerHasFutex
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef TrackSemaphoreContention
+#include "tarch/logging/Log.h"
+
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <vector>
+
+
+namespace {
+  tarch::logging::Log  _log( "tarch::multicore::BooleanSemaphore" );
+
+  struct ContentionRecord {
+    std::string  name;
+    long int     numberOfAcquisitions;
+    long int     numberOfSpins;
+    long int     numberOfParks;
+  };
+
+  /**
+   * Global book-keeping of all semaphores. We cannot protect it by a
+   * BooleanSemaphore for obvious reasons. The registry is never destroyed as
+   * semaphores might be static objects that go down after any static
+   * registry.
+   */
+  struct ContentionRegistry {
+    std::mutex                                            mutex;
+    std::set<const tarch::multicore::BooleanSemaphore*>   liveSemaphores;
+    std::vector<ContentionRecord>                         retiredSemaphores;
+  };
+
+  ContentionRegistry& getContentionRegistry() {
+    static ContentionRegistry* registry = new ContentionRegistry();
+    return *registry;
+  }
+
+  std::string getDefaultName( const void* semaphore ) {
+    std::ostringstream msg;
+    msg << "semaphore@" << semaphore;
+    return msg.str();
+  }
+}
+#endif
+
+
 tarch::multicore::BooleanSemaphore::BooleanSemaphore():
-  _mutex() {
+  _state(0)
+  #ifdef TrackSemaphoreContention
+  ,
+  _name( getDefaultName(this) ),
+  _numberOfAcquisitions(0),
+  _numberOfSpins(0),
+  _numberOfParks(0)
+  #endif
+  {
+  #ifdef TrackSemaphoreContention
+  std::lock_guard<std::mutex> guard( getContentionRegistry().mutex );
+  getContentionRegistry().liveSemaphores.insert(this);
+  #endif
 }
 
 
 tarch::multicore::BooleanSemaphore::~BooleanSemaphore() {
+  #ifdef TrackSemaphoreContention
+  std::lock_guard<std::mutex> guard( getContentionRegistry().mutex );
+  getContentionRegistry().liveSemaphores.erase(this);
+  if (_numberOfSpins>0 || _numberOfParks>0) {
+    getContentionRegistry().retiredSemaphores.push_back( {_name, _numberOfAcquisitions, _numberOfSpins, _numberOfParks} );
+  }
+  #endif
+}
+
+
+void tarch::multicore::BooleanSemaphore::park( std::atomic<int>& state ) {
+  #ifdef CompilerHasFutex
+  // Returns immediately if the state is not 2 anymore, i.e. we cannot miss a
+  // wake-up.
+  syscall( SYS_futex, reinterpret_cast<int*>(&state), FUTEX_WAIT_PRIVATE, 2, nullptr, nullptr, 0 );
+  #else
+  std::this_thread::yield();
+  #endif
+}
+
+
+void tarch::multicore::BooleanSemaphore::wakeUpOneSleeper( std::atomic<int>& state ) {
+  #ifdef CompilerHasFutex
+  syscall( SYS_futex, reinterpret_cast<int*>(&state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0 );
+  #endif
 }
 
 
 void tarch::multicore::BooleanSemaphore::enterCriticalSection() {
-  _mutex.lock();
+  int expected = 0;
+  if ( _state.compare_exchange_strong(expected,1,std::memory_order_acquire) ) {
+    #ifdef TrackSemaphoreContention
+    _numberOfAcquisitions++;
+    #endif
+    return;
+  }
+
+  int  spins    = 0;
+  int  parks    = 0;
+  int  backoff  = 1;
+  bool acquired = false;
+
+  while (!acquired && spins<SpinBudget) {
+    for (int i=0; i<backoff; i++) {
+      #if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+      #else
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+      #endif
+    }
+    backoff = std::min(2*backoff,MaxBackoff);
+    spins++;
+
+    expected = 0;
+    acquired =
+      _state.load(std::memory_order_relaxed)==0
+      &&
+      _state.compare_exchange_weak(expected,1,std::memory_order_acquire);
+  }
+
+  if (!acquired) {
+    // We might hold the semaphore in state 2 though nobody else waits. This
+    // only results in one unnecessary wake-up call.
+    while ( _state.exchange(2,std::memory_order_acquire)!=0 ) {
+      park(_state);
+      parks++;
+    }
+  }
+
+  #ifdef TrackSemaphoreContention
+  _numberOfAcquisitions++;
+  _numberOfSpins += spins;
+  _numberOfParks += parks;
+  #endif
 }
 
 
 void tarch::multicore::BooleanSemaphore::leaveCriticalSection() {
-  _mutex.unlock();
+  if ( _state.exchange(0,std::memory_order_release)==2 ) {
+    wakeUpOneSleeper(_state);
+  }
+}
+
+
+void tarch::multicore::BooleanSemaphore::plotContentionStatistics( int maxNumberOfSemaphores ) {
+  #ifdef TrackSemaphoreContention
+  std::vector<ContentionRecord> records;
+
+  std::lock_guard<std::mutex> guard( getContentionRegistry().mutex );
+  records = getContentionRegistry().retiredSemaphores;
+  for (auto p: getContentionRegistry().liveSemaphores) {
+    if (p->_numberOfSpins>0 || p->_numberOfParks>0) {
+      records.push_back( {p->_name, p->_numberOfAcquisitions, p->_numberOfSpins, p->_numberOfParks} );
+    }
+  }
+
+  std::sort(
+    records.begin(), records.end(),
+    [](const ContentionRecord& lhs, const ContentionRecord& rhs) -> bool {
+      return lhs.numberOfParks>rhs.numberOfParks || (lhs.numberOfParks==rhs.numberOfParks && lhs.numberOfSpins>rhs.numberOfSpins);
+    }
+  );
+
+  logInfo( "plotContentionStatistics(int)", records.size() << " semaphore(s) have been contended" );
+  for (int i=0; i<std::min(static_cast<int>(records.size()),maxNumberOfSemaphores); i++) {
+    logInfo(
+      "plotContentionStatistics(int)",
+      records[i].name << ": acquisitions=" << records[i].numberOfAcquisitions
+      << ", spins=" << records[i].numberOfSpins
+      << ", parks=" << records[i].numberOfParks
+    );
+  }
+  #endif
 }
 
 
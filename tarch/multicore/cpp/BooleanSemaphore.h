@@ -5,7 +5,7 @@
 
 
 #include <string>
-#include <mutex>
+#include <atomic>
 
 
 namespace tarch {
@@ -15,12 +15,68 @@ namespace tarch {
   }
 }
 
+
+/**
+ * Boolean semaphore of the C++ backend
+ *
+ * The semaphore used to wrap a std::mutex. Most of our critical sections
+ * (heap creates and deletes, logging, job queues) are tiny, so a thread that
+ * does not get the lock should rather spin for a few cycles than go to sleep
+ * immediately. On the other hand, we have seen threads spinning for ages on
+ * the job queue semaphores while the owner has been descheduled. Therefore,
+ * the semaphore now is an atomic integer with three phases:
+ *
+ * - A test-and-test-and-set fast path: If the semaphore is free, one
+ *   compare-and-swap is all we need.
+ * - A spin phase: We poll the flag (read-only, so the cache line is not
+ *   bouncing around) and retry the CAS whenever it looks free. Between two
+ *   probes, we back off exponentially.
+ * - A park phase: Once the spin budget is exhausted, we mark the semaphore as
+ *   contended and put the thread to sleep with a futex. The thread releasing
+ *   a contended semaphore wakes up one sleeper. On systems without futexes
+ *   (see CompilerHasFutex in the compiler settings) parking degenerates to a
+ *   yield.
+ *
+ * The states are 0 (free), 1 (locked, no sleepers) and 2 (locked, there
+ * might be sleepers).
+ *
+ * <h2> Contention statistics </h2>
+ *
+ * If you translate with -DTrackSemaphoreContention, each semaphore counts how
+ * often it has been acquired, how many spin iterations the acquiring threads
+ * did and how often they had to park. The counters are updated by the thread
+ * holding the semaphore, i.e. they do not require any atomics. All semaphores
+ * are registered in a global list and plotContentionStatistics() writes the
+ * most contended ones to the log. The core calls it at shutdown. As the
+ * semaphores do not have names, we identify them by their address.
+ *
+ * Without the flag, the statistics operations are empty.
+ *
+ * @author Tobias Weinzierl
+ */
 class tarch::multicore::BooleanSemaphore {
   private:
-	std::mutex   _mutex;
-
     friend class tarch::multicore::Lock;
 
+    /**
+     * Number of TTAS probes before a thread parks.
+     */
+    static constexpr int SpinBudget = 1024;
+
+    /**
+     * Maximum number of pause instructions between two probes.
+     */
+    static constexpr int MaxBackoff = 64;
+
+    std::atomic<int>  _state;
+
+    #ifdef TrackSemaphoreContention
+    std::string       _name;
+    long int          _numberOfAcquisitions;
+    long int          _numberOfSpins;
+    long int          _numberOfParks;
+    #endif
+
     /**
      * Waits until I can enter the critical section.
      */
@@ -31,6 +87,9 @@ class tarch::multicore::BooleanSemaphore {
      */
     void leaveCriticalSection();
 
+    static void park( std::atomic<int>& state );
+    static void wakeUpOneSleeper( std::atomic<int>& state );
+
     /**
      * You may not copy a semaphore
      */
@@ -43,7 +102,13 @@ class tarch::multicore::BooleanSemaphore {
   public:
     BooleanSemaphore();
     ~BooleanSemaphore();
+
+    /**
+     * Write the contention statistics of the maxNumberOfSemaphores most
+     * contended semaphores to the log. Semaphores that have been destroyed
+     * already are included. Nop if TrackSemaphoreContention is not set.
+     */
+    static void plotContentionStatistics( int maxNumberOfSemaphores = 20 );
 };
 #endif
 
-
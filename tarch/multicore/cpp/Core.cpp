@@ -10,6 +10,7 @@
 #ifdef SharedCPP
 
 #include "JobConsumer.h"
+#include "tarch/multicore/BooleanSemaphore.h"
 
 #include <thread>
 #include <sched.h>
@@ -131,6 +132,10 @@ void tarch::multicore::Core::shutDown() {
       p->unlock();
     }
   }
+
+  #ifdef TrackSemaphoreContention
+  BooleanSemaphore::plotContentionStatistics();
+  #endif
 }
 
 
@@ -2,6 +2,7 @@
 
 #include "tarch/multicore/cpp/JobQueue.h"
 #include "tarch/multicore/Jobs.h"
+#include "tarch/multicore/JobTracing.h"
 
 
 #include <sstream>
@@ -42,7 +43,7 @@ bool tarch::multicore::internal::JobQueue::processJobs( int maxNumberOfJobs ) {
     result = true;
     jobs::Job* job = _jobs.front();
     _jobs.pop_front();
-    bool reenqueue = job->run();
+    bool reenqueue = jobs::tracing::run(*job);
     if (reenqueue) {
       _jobs.push_back( job );
     }
@@ -82,7 +83,7 @@ bool tarch::multicore::internal::JobQueue::processJobs( int maxNumberOfJobs ) {
       _mutex.unlock();
 
       for (auto& p: localList) {
-        bool reenqueue = p->run();
+        bool reenqueue = jobs::tracing::run(*p);
         if (reenqueue) {
         addJob( p );
         }
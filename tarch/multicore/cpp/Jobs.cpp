@@ -1,5 +1,6 @@
 
 #include "tarch/multicore/Jobs.h"
+#include "tarch/multicore/JobTracing.h"
 #include "tarch/Assertions.h"
 
 
@@ -15,9 +16,12 @@
 #include <atomic>
 
 #include "tarch/multicore/Jobs.h"
+#include "tarch/logging/Log.h"
 
 
 namespace {
+  tarch::logging::Log _log( "tarch::multicore::jobs" );
+
   /**
    * The spawn and wait routines fire their job and then have to wait for all
    * jobs to be processed. They do this through an integer atomic that they
@@ -51,7 +55,7 @@ namespace {
 void tarch::multicore::jobs::spawnBackgroundJob(Job* job) {
   switch (job->getJobType()) {
      case JobType::ProcessImmediately:
-       while (job->run()) {};
+       while (tracing::run(*job)) {};
        delete job;
        break;
      case JobType::RunTaskAsSoonAsPossible:
@@ -59,6 +63,7 @@ void tarch::multicore::jobs::spawnBackgroundJob(Job* job) {
        break;
      case JobType::MPIReceiveTask:
        internal::JobQueue::getMPIReceiveQueue().addJob(job);
+       break;
      case JobType::Task:
      case JobType::Job:
        internal::JobQueue::getBackgroundQueue().addJob(job);
@@ -87,7 +92,7 @@ bool tarch::multicore::jobs::processBackgroundJobs() {
 
     if (result) {
       #ifdef Asserts
-      logInfo( "processMPIReceiveJobs()", "consumer task (pin=" << _pinCore << ") processes MPI receive background jobs" );
+      logInfo( "processBackgroundJobs()", "process " << numberOfJobs << " MPI receive background job(s)" );
       #endif
       internal::JobQueue::getMPIReceiveQueue().processJobs( numberOfJobs );
       result = true;
@@ -0,0 +1,108 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_MULTICORE_DFOR_TILING_RANGE_H_
+#define _TARCH_MULTICORE_DFOR_TILING_RANGE_H_
+
+
+#include "tarch/multicore/dForRange.h"
+#include "tarch/la/Vector.h"
+#include "tarch/logging/Log.h"
+
+
+#include <vector>
+
+
+namespace tarch {
+  namespace multicore {
+    template <int D>
+    class dForTilingRange;
+  }
+}
+
+
+/**
+ * Cache-aware tiling of a d-dimensional range
+ *
+ * dForRange bisects a range along its longest axis until the grain size is
+ * reached. It knows neither how much data one iteration touches nor how the
+ * data is ordered. The tiling range takes a different approach:
+ *
+ * - It cuts the range into tiles (hypercubes) such that the data of one tile
+ *   fits into a cache of a given size. You have to tell the range how many
+ *   bytes one iteration touches.
+ * - The tile edge length is rounded down to a power of three. If the range
+ *   is a regular Peano patch, the tiles thus coincide with subtrees of the
+ *   spacetree.
+ * - The tiles are ordered along the Peano space-filling curve.
+ *
+ * If you hand the tiles to parallelFor() or parallelReduce() (see Loop.h),
+ * the tasks are built from consecutive tiles along the curve. A thread hence
+ * processes a spatially coherent block, and tasks that are handled by the
+ * same thread one after another share faces of their tiles, i.e. cache lines.
+ *
+ * If the tile count along an axis is not a power of three, we embed the tile
+ * grid into the next bigger 3^k grid and skip the empty tiles. The order
+ * still follows the curve, but consecutive tiles are not necessarily face
+ * neighbours anymore.
+ */
+template <int D>
+class tarch::multicore::dForTilingRange {
+  private:
+    static tarch::logging::Log _log;
+
+    tarch::la::Vector<D,int>  _offset;
+    tarch::la::Vector<D,int>  _range;
+    int                       _interleaving;
+    int                       _tileSize;
+
+    /**
+     * Position of a tile along the Peano curve within a 3^levels grid.
+     */
+    static long int getPeanoIndex( const tarch::la::Vector<D,int>& tile, int levels );
+  public:
+    /**
+     * Default cache size we tile for. Corresponds to a typical L2 cache per
+     * core.
+     */
+    static constexpr int DefaultCacheSize = 256*1024;
+
+    /**
+     * @param bytesPerIteration  Bytes of data one loop iteration reads or
+     *                           writes. Is used to derive the tile size.
+     * @param cacheSize          Bytes of cache one tile may use.
+     */
+    dForTilingRange(
+      const tarch::la::Vector<D,int>&  offset,
+      const tarch::la::Vector<D,int>&  range,
+      int                              interleaving,
+      int                              bytesPerIteration,
+      int                              cacheSize = DefaultCacheSize
+    );
+
+    /**
+     * Largest power of three t such that t^D iterations of bytesPerIteration
+     * fit into the cache. Is at least one.
+     */
+    static int computeTileSize( int bytesPerIteration, int cacheSize );
+
+    int getTileSize() const;
+
+    tarch::la::Vector<D,int> getOffset() const;
+    tarch::la::Vector<D,int> getRange() const;
+
+    /**
+     * Tiles ordered along the Peano curve. Each tile is a dForRange with the
+     * same interleaving as this range and a grain size equal to its volume,
+     * i.e. it is not divisible anymore. Tiles along the range's boundary
+     * might be smaller than the tile size.
+     */
+    std::vector< dForRange<D> >  getTiles() const;
+
+    std::string toString() const;
+};
+
+
+#include "tarch/multicore/dForTilingRange.cpph"
+
+
+#endif
@@ -109,7 +109,7 @@ void tarch::multicore::jobs::terminateAllPendingBackgroundConsumerJobs() {
 void tarch::multicore::jobs::spawnBackgroundJob(Job* job) {
   switch (job->getJobType()) {
     case JobType::ProcessImmediately:
-      while (job->run()) {};
+      while (tracing::run(*job)) {};
       delete job;
       break;
     case JobType::RunTaskAsSoonAsPossible:
@@ -186,7 +186,7 @@ bool tarch::multicore::jobs::processJobs(int jobClass, int maxNumberOfJobs) {
   bool result   = false;
   while (gotOne) {
     logDebug( "processJob(int)", "start to process job of class " << jobClass );
-    bool reschedule = myTask->run();
+    bool reschedule = tracing::run(*myTask);
     if (reschedule) {
       internal::getJobQueue(jobClass).jobs.push(myTask);
     }
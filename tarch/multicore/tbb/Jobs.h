@@ -2,6 +2,7 @@
 
 
 #include "tarch/Assertions.h"
+#include "tarch/multicore/JobTracing.h"
 
 
 #include <tbb/task.h>
@@ -117,7 +118,7 @@ namespace tarch {
             }
 
             tbb::task* execute() {
-              while ( _job->run() ) {};
+              while ( tarch::multicore::jobs::tracing::run(*_job) ) {};
               delete _job;
               return nullptr;
             }
@@ -0,0 +1,97 @@
+#include "tarch/multicore/tests/AccumulatorTest.h"
+#include "tarch/multicore/Reduction.h"
+#include "tarch/multicore/Loop.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(tarch::multicore::tests::AccumulatorTest)
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+tarch::multicore::tests::AccumulatorTest::AccumulatorTest():
+  TestCase( "tarch::multicore::tests::AccumulatorTest" ) {
+}
+
+
+tarch::multicore::tests::AccumulatorTest::~AccumulatorTest() {
+}
+
+
+void tarch::multicore::tests::AccumulatorTest::run() {
+  testMethod( testSumMinMax );
+  testMethod( testCopySemantics );
+  testMethod( testParallelFor );
+}
+
+
+void tarch::multicore::tests::AccumulatorTest::setUp() {
+}
+
+
+void tarch::multicore::tests::AccumulatorTest::testSumMinMax() {
+  tarch::multicore::Accumulator<int>                                          sum;
+  tarch::multicore::Accumulator<double, tarch::multicore::reductions::Min<double> >  min;
+  tarch::multicore::Accumulator<double, tarch::multicore::reductions::Max<double> >  max;
+
+  for (int i=0; i<10; i++) {
+    sum.contribute(i);
+    min.contribute(-1.0*i);
+    max.contribute(-1.0*i);
+  }
+
+  validateEquals( sum.reduce(), 45 );
+  validateNumericalEquals( min.reduce(), -9.0 );
+  validateNumericalEquals( max.reduce(), 0.0 );
+
+  sum.reset();
+  validateEquals( sum.reduce(), 0 );
+}
+
+
+void tarch::multicore::tests::AccumulatorTest::testCopySemantics() {
+  tarch::multicore::Accumulator<int>  accumulator;
+  tarch::multicore::Accumulator<int>  copy(accumulator);
+
+  accumulator.contribute(2);
+  copy.contribute(3);
+  validateEquals( accumulator.reduce(), 5 );
+  validateEquals( copy.reduce(), 5 );
+
+  tarch::multicore::Accumulator<int>  clone = accumulator.clone();
+  clone.contribute(1);
+  validateEquals( accumulator.reduce(), 5 );
+  validateEquals( clone.reduce(), 6 );
+}
+
+
+namespace {
+  struct SumUpLoopBody {
+    tarch::multicore::Accumulator<int>  sum;
+
+    void operator()(const tarch::la::Vector<2,int>& i) {
+      sum.contribute( i(0) + i(1) );
+    }
+  };
+}
+
+
+void tarch::multicore::tests::AccumulatorTest::testParallelFor() {
+  SumUpLoopBody loopBody;
+
+  tarch::multicore::parallelFor(
+    tarch::multicore::dForRange<2>( 0, tarch::la::Vector<2,int>(16), 8, 1 ),
+    loopBody
+  );
+
+  // sum over i0+i1 with i0,i1 in [0,15]
+  validateEquals( loopBody.sum.reduce(), 2*16*120 );
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
@@ -0,0 +1,40 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_MULTICORE_TESTS_ACCUMULATOR_TEST_H_
+#define _TARCH_MULTICORE_TESTS_ACCUMULATOR_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+namespace tarch {
+    namespace multicore {
+      namespace tests {
+        class AccumulatorTest;
+      }
+    }
+}
+
+
+class tarch::multicore::tests::AccumulatorTest: public tarch::tests::TestCase {
+  private:
+    void testSumMinMax();
+
+    /**
+     * Copies of an accumulator have to write into the same slots, while
+     * clone() has to yield an independent accumulator.
+     */
+    void testCopySemantics();
+
+    /**
+     * Run a parallel for where the loop body holds the accumulator.
+     */
+    void testParallelFor();
+  public:
+    AccumulatorTest();
+    virtual ~AccumulatorTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
@@ -0,0 +1,90 @@
+#include "tarch/multicore/tests/BooleanSemaphoreTest.h"
+#include "tarch/multicore/BooleanSemaphore.h"
+#include "tarch/multicore/Lock.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(tarch::multicore::tests::BooleanSemaphoreTest)
+
+
+#ifdef SharedCPP
+#include <thread>
+#include <vector>
+#endif
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+tarch::multicore::tests::BooleanSemaphoreTest::BooleanSemaphoreTest():
+  TestCase( "tarch::multicore::tests::BooleanSemaphoreTest" ) {
+}
+
+
+tarch::multicore::tests::BooleanSemaphoreTest::~BooleanSemaphoreTest() {
+}
+
+
+void tarch::multicore::tests::BooleanSemaphoreTest::run() {
+  testMethod( testSequentialLockAndFree );
+  testMethod( testConcurrentIncrements );
+}
+
+
+void tarch::multicore::tests::BooleanSemaphoreTest::setUp() {
+}
+
+
+void tarch::multicore::tests::BooleanSemaphoreTest::testSequentialLockAndFree() {
+  tarch::multicore::BooleanSemaphore semaphore;
+  int counter = 0;
+
+  for (int i=0; i<16; i++) {
+    tarch::multicore::Lock lock(semaphore);
+    counter++;
+    lock.free();
+  }
+
+  validateEquals( counter, 16 );
+}
+
+
+void tarch::multicore::tests::BooleanSemaphoreTest::testConcurrentIncrements() {
+  constexpr int NumberOfThreads      = 8;
+  constexpr int IncrementsPerThread  = 20000;
+
+  tarch::multicore::BooleanSemaphore semaphore;
+  // Deliberately no atomic: A lost update means that the semaphore failed.
+  int counter = 0;
+
+  auto increment = [&]() -> void {
+    for (int i=0; i<IncrementsPerThread; i++) {
+      tarch::multicore::Lock lock(semaphore);
+      counter++;
+      lock.free();
+    }
+  };
+
+  #ifdef SharedCPP
+  std::vector<std::thread> threads;
+  for (int i=0; i<NumberOfThreads; i++) {
+    threads.push_back( std::thread(increment) );
+  }
+  for (auto& p: threads) {
+    p.join();
+  }
+  #else
+  for (int i=0; i<NumberOfThreads; i++) {
+    increment();
+  }
+  #endif
+
+  validateEquals( counter, NumberOfThreads*IncrementsPerThread );
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
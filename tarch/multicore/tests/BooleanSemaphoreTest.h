@@ -0,0 +1,36 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_MULTICORE_TESTS_BOOLEAN_SEMAPHORE_TEST_H_
+#define _TARCH_MULTICORE_TESTS_BOOLEAN_SEMAPHORE_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+namespace tarch {
+    namespace multicore {
+      namespace tests {
+        class BooleanSemaphoreTest;
+      }
+    }
+}
+
+
+/**
+ * Checks that a semaphore does ensure mutual exclusion. With the C++ backend,
+ * we let several threads hammer the same semaphore such that the spin and the
+ * park phase of the semaphore are both used. Without any shared memory
+ * parallelisation, the test degenerates to a sequential sanity check.
+ */
+class tarch::multicore::tests::BooleanSemaphoreTest: public tarch::tests::TestCase {
+  private:
+    void testSequentialLockAndFree();
+    void testConcurrentIncrements();
+  public:
+    BooleanSemaphoreTest();
+    virtual ~BooleanSemaphoreTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
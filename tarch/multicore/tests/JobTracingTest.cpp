@@ -0,0 +1,91 @@
+#include "tarch/multicore/tests/JobTracingTest.h"
+#include "tarch/multicore/JobTracing.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(tarch::multicore::tests::JobTracingTest)
+
+
+#include <sstream>
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+tarch::multicore::tests::JobTracingTest::JobTracingTest():
+  TestCase( "tarch::multicore::tests::JobTracingTest" ) {
+}
+
+
+tarch::multicore::tests::JobTracingTest::~JobTracingTest() {
+}
+
+
+void tarch::multicore::tests::JobTracingTest::run() {
+  testMethod( testRecordRescheduledJob );
+  testMethod( testChromeTraceExport );
+}
+
+
+void tarch::multicore::tests::JobTracingTest::setUp() {
+}
+
+
+void tarch::multicore::tests::JobTracingTest::testRecordRescheduledJob() {
+  int numberOfInvocations = 0;
+  tarch::multicore::jobs::GenericJobWithCopyOfFunctor job(
+    [&numberOfInvocations]() -> bool {
+      numberOfInvocations++;
+      return numberOfInvocations<3;
+    },
+    tarch::multicore::jobs::JobType::Task,
+    7
+  );
+
+  const int recordsBefore = tarch::multicore::jobs::tracing::getNumberOfRecordedEvents();
+  while ( tarch::multicore::jobs::tracing::run(job) ) {};
+
+  validateEquals( numberOfInvocations, 3 );
+  #ifdef TraceJobs
+  validateEquals( tarch::multicore::jobs::tracing::getNumberOfRecordedEvents(), recordsBefore+3 );
+  validate( job.getSpawnTimeStamp()<=tarch::multicore::jobs::tracing::getTimeStamp() );
+  #else
+  validateEquals( tarch::multicore::jobs::tracing::getNumberOfRecordedEvents(), recordsBefore );
+  #endif
+}
+
+
+void tarch::multicore::tests::JobTracingTest::testChromeTraceExport() {
+  tarch::multicore::jobs::tracing::clear();
+  validateEquals( tarch::multicore::jobs::tracing::getNumberOfRecordedEvents(), 0 );
+
+  tarch::multicore::jobs::GenericJobWithCopyOfFunctor job(
+    []() -> bool {
+      return false;
+    },
+    tarch::multicore::jobs::JobType::Job,
+    5
+  );
+  tarch::multicore::jobs::tracing::run(job);
+
+  std::ostringstream out;
+  tarch::multicore::jobs::tracing::writeChromeTrace(out,3);
+  const std::string trace = out.str();
+
+  validateWithParams1( trace.find("{\"traceEvents\":[")==0, trace );
+  validateWithParams1( trace.find("\"dropped-events\":0")!=std::string::npos, trace );
+  #ifdef TraceJobs
+  validateWithParams1( trace.find("\"name\":\"class 5\",\"cat\":\"Job\",\"ph\":\"X\",\"pid\":3")!=std::string::npos, trace );
+  #else
+  validateWithParams1( trace.find("class 5")==std::string::npos, trace );
+  #endif
+
+  tarch::multicore::jobs::tracing::clear();
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
@@ -0,0 +1,35 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_MULTICORE_TESTS_JOB_TRACING_TEST_H_
+#define _TARCH_MULTICORE_TESTS_JOB_TRACING_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+namespace tarch {
+    namespace multicore {
+      namespace tests {
+        class JobTracingTest;
+      }
+    }
+}
+
+
+/**
+ * Runs a job that reschedules itself a few times and checks that every
+ * invocation shows up in the trace. Without TraceJobs, we only check that
+ * the exporter yields an empty but well-formed trace.
+ */
+class tarch::multicore::tests::JobTracingTest: public tarch::tests::TestCase {
+  private:
+    void testRecordRescheduledJob();
+    void testChromeTraceExport();
+  public:
+    JobTracingTest();
+    virtual ~JobTracingTest();
+    virtual void run();
+    virtual void setUp();
+};
+
+
+#endif
@@ -1,11 +1,14 @@
 #include "tarch/multicore/tests/dForRangeTest.h"
 #include "tarch/multicore/dForRange.h"
+#include "tarch/multicore/dForTilingRange.h"
+#include "tarch/multicore/Loop.h"
 
 
 #include "tarch/tests/TestCaseFactory.h"
 registerTest(tarch::multicore::tests::dForRangeTest)
 
 
+#include <atomic>
 #include <bitset>
 
 
@@ -35,6 +38,12 @@ void tarch::multicore::tests::dForRangeTest::run() {
   testMethod( test2Dg14x14WithGrainSize1AndOffset1 );
 
   testMethod( test2Dg14x14WithGrainSize1AndOffset1AndColouring );
+
+  testMethod( testTileSize );
+  testMethod( test2DTilingRange );
+  testMethod( test3DTilingRange );
+  testMethod( test2DTilingRangeWithRemainder );
+  testMethod( test2DTiledParallelFor );
 }
 
 
@@ -293,6 +302,115 @@ void tarch::multicore::tests::dForRangeTest::test2D10x10Range80() {
 */
 }
 
+void tarch::multicore::tests::dForRangeTest::testTileSize() {
+  // 9x9x8 bytes fit into 1kB, 27x27x8 don't
+  validateEquals( tarch::multicore::dForTilingRange<2>::computeTileSize(8,1024), 9 );
+  validateEquals( tarch::multicore::dForTilingRange<3>::computeTileSize(8,1024), 3 );
+  validateEquals( tarch::multicore::dForTilingRange<2>::computeTileSize(2048,1024), 1 );
+}
+
+
+void tarch::multicore::tests::dForRangeTest::test2DTilingRange() {
+  // 27x27 range with tile size 3 yields 9x9 tiles
+  tarch::multicore::dForTilingRange<2> range( 0, 27, 1, 8, 9*8 );
+  validateEquals( range.getTileSize(), 3 );
+
+  std::vector< dForRange<2> > tiles = range.getTiles();
+  validateEquals( static_cast<int>(tiles.size()), 81 );
+
+  std::bitset<27> hit[27];
+  for (int i=0; i<static_cast<int>(tiles.size()); i++) {
+    if (i>0) {
+      validateEqualsWithParams2(
+        tarch::la::sum( tarch::la::abs(tiles[i].getOffset()-tiles[i-1].getOffset()) ), 3,
+        tiles[i].toString(), tiles[i-1].toString()
+      );
+    }
+    for (int i0=0; i0<tiles[i].getRange()(0); i0++)
+    for (int i1=0; i1<tiles[i].getRange()(1); i1++) {
+      tarch::la::Vector<2,int> loc;
+      loc = i0, i1;
+      validateWithParams2( !hit[ tiles[i](loc)(0) ][ tiles[i](loc)(1) ], tiles[i](loc), tiles[i].toString() );
+      hit[ tiles[i](loc)(0) ][ tiles[i](loc)(1) ] = true;
+    }
+  }
+
+  for (int d=0; d<27; d++) {
+    validateWithParams1( hit[d].all(), d );
+  }
+
+  validateEquals( tiles[0].getOffset()(0), 0 );
+  validateEquals( tiles[0].getOffset()(1), 0 );
+  validateEquals( tiles[80].getOffset()(0), 24 );
+  validateEquals( tiles[80].getOffset()(1), 24 );
+}
+
+
+void tarch::multicore::tests::dForRangeTest::test3DTilingRange() {
+  tarch::multicore::dForTilingRange<3> range( 0, 9, 2, 1, 1 );
+  validateEquals( range.getTileSize(), 1 );
+
+  std::vector< dForRange<3> > tiles = range.getTiles();
+  validateEquals( static_cast<int>(tiles.size()), 729 );
+
+  for (int i=1; i<static_cast<int>(tiles.size()); i++) {
+    validateEqualsWithParams2(
+      tarch::la::sum( tarch::la::abs(tiles[i].getOffset()-tiles[i-1].getOffset()) ), 2,
+      tiles[i].toString(), tiles[i-1].toString()
+    );
+  }
+}
+
+
+void tarch::multicore::tests::dForRangeTest::test2DTilingRangeWithRemainder() {
+  tarch::la::Vector<2,int> rangeSize;
+  rangeSize = 10, 4;
+  tarch::multicore::dForTilingRange<2> range( 1, rangeSize, 1, 1, 9 );
+  validateEquals( range.getTileSize(), 3 );
+
+  std::vector< dForRange<2> > tiles = range.getTiles();
+  validateEquals( static_cast<int>(tiles.size()), 8 );
+
+  int volume = 0;
+  for (auto& p: tiles) {
+    volume += tarch::la::volume( p.getRange() );
+    validateWithParams1( !p.isDivisible(), p.toString() );
+  }
+  validateEquals( volume, 40 );
+}
+
+
+namespace {
+  struct CountHitsLoopBody {
+    std::atomic<int>*  hits;
+
+    void operator()(const tarch::la::Vector<2,int>& i) {
+      hits[ i(0)*20 + i(1) ].fetch_add(1);
+    }
+  };
+}
+
+
+void tarch::multicore::tests::dForRangeTest::test2DTiledParallelFor() {
+  std::atomic<int> hits[20*20];
+  for (int i=0; i<20*20; i++) {
+    hits[i].store(0);
+  }
+
+  CountHitsLoopBody loopBody;
+  loopBody.hits = hits;
+
+  tarch::multicore::parallelFor(
+    tarch::multicore::dForTilingRange<2>( 0, 20, 1, 1, 9 ),
+    loopBody
+  );
+
+  for (int i=0; i<20*20; i++) {
+    validateEqualsWithParams1( hits[i].load(), 1, i );
+  }
+}
+
+
 #ifdef UseTestSpecificCompilerSettings
 #pragma optimize("",on)
 #endif
@@ -31,6 +31,27 @@ class tarch::multicore::tests::dForRangeTest: public tarch::tests::TestCase {
     void test2Dg14x14WithGrainSize1AndOffset1();
 
     void test2Dg14x14WithGrainSize1AndOffset1AndColouring();
+
+    void testTileSize();
+
+    /**
+     * Tiles of a 3^k x 3^k grid of tiles have to follow the Peano curve,
+     * i.e. two subsequent tiles are face-connected. All tiles together have
+     * to cover the range exactly once.
+     */
+    void test2DTilingRange();
+    void test3DTilingRange();
+
+    /**
+     * Range that is not a multiple of the tile size.
+     */
+    void test2DTilingRangeWithRemainder();
+
+    /**
+     * parallelFor() over a tiling range has to invoke the functor exactly
+     * once per entry.
+     */
+    void test2DTiledParallelFor();
   public:
     dForRangeTest();
     virtual ~dForRangeTest();
@@ -1,6 +1,7 @@
 #include "tarch/parallel/Node.h"
 #include "tarch/Assertions.h"
 #include "tarch/services/ServiceRepository.h"
+#include "tarch/parallel/ProgressEngine.h"
 
 #include <sstream>
 #include <cstdlib>
@@ -398,6 +399,10 @@ void tarch::parallel::Node::setCommunicator( MPI_Comm communicator ) {
 
 void tarch::parallel::Node::receiveDanglingMessages() {
   #ifdef Parallel
+  if ( ProgressEngine::getInstance().isInvokedByProgressThread() ) {
+    return;
+  }
+
   MPI_Status status;
   int        flag   = 0;
   MPI_Iprobe(
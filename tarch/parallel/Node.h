@@ -350,6 +350,11 @@ class tarch::parallel::Node {
      * 'hey poll the MPI queues' is always triggered by blocking sends and
      * receives, i.e. it is tied to the parallelisation. And, thus, it is part
      * of the node singleton.
+     *
+     * If a blocking send or receive is issued by a polling routine of the
+     * progress engine, the operation does not poll the services. The engine's
+     * thread holds the engine's semaphore and the services would wait for it
+     * if they suspend their own routines (see ProgressEngine).
      */
     void receiveDanglingMessages();
 
@@ -1,5 +1,6 @@
 #include "tarch/parallel/NodePool.h"
 #include "tarch/parallel/Node.h"
+#include "tarch/parallel/FCFSNodePoolStrategy.h"
 
 
 #include "tarch/compiler/CompilerSpecificSettings.h"
@@ -10,11 +11,33 @@
 #include "tarch/parallel/messages/NodePoolAnswerMessage.h"
 
 #include <sstream>
+#include <map>
 
 #include "tarch/services/ServiceFactory.h"
 registerService(tarch::parallel::NodePool)
 
 
+namespace {
+  /**
+   * Commands of the global master to the sub-pool managers. Each command is
+   * an integer pair: command and argument. There is no terminate command, as
+   * a manager terminates its sub-pool as soon as it is told to terminate
+   * itself (see waitForJob()).
+   */
+  const int SubPoolCommandRunAllNodes     = 0;
+  const int SubPoolCommandReturnIdleRanks = 1;
+
+  /**
+   * Notifications of the managers to the global master. A notification
+   * message is a sequence of integer pairs: event and rank.
+   */
+  const int SubPoolNotificationIdle             = 0;
+  const int SubPoolNotificationBusy             = 1;
+  const int SubPoolNotificationTerminated       = 2;
+  const int SubPoolNotificationCommandProcessed = 3;
+}
+
+
 tarch::logging::Log tarch::parallel::NodePool::_log("tarch::parallel::NodePool");
 
 
@@ -23,6 +46,7 @@ const int tarch::parallel::NodePool::NoFreeNodesMessage = -1;
 const int tarch::parallel::NodePool::JobRequestMessageAnswerValues::NewMaster = 0;
 const int tarch::parallel::NodePool::JobRequestMessageAnswerValues::Terminate = -1;
 const int tarch::parallel::NodePool::JobRequestMessageAnswerValues::RunAllNodes = -2;
+const int tarch::parallel::NodePool::JobRequestMessageAnswerValues::ReturnToGlobalMaster = -3;
 
 
 tarch::parallel::NodePool::NodePool():
@@ -30,12 +54,41 @@ tarch::parallel::NodePool::NodePool():
   _registrationTag(-1),
   _jobManagementTag(-1),
   _jobServicesTag(-1),
+  _subPoolJobManagementTag(-1),
+  _subPoolJobServicesTag(-1),
+  _subPoolControlTag(-1),
+  _ranksPerSubPool(0),
+  _ownerRank(-1),
+  _subPoolIsAlive(false),
+  _numberOfRanksThatHaveLeftSubPool(0),
+  _isServingSubPool(false),
+  _idleRanksOfSubPools(),
+  _subPoolManagersWithPendingCommand(),
   _isAlive(false),
   _hasGivenOutRankSizeLastQuery(false),
   _strategy(0) {
   #ifdef Asserts
   _isInitialised = false;
   #endif
+  #ifdef MPIUsesItsOwnThread
+  _progressEngineHandle = ProgressEngine::InvalidHandle;
+  #endif
+}
+
+
+int tarch::parallel::NodePool::suspendBackgroundReceives() const {
+  #ifdef MPIUsesItsOwnThread
+  return ProgressEngine::getInstance().pausePollingRoutine(_progressEngineHandle);
+  #else
+  return ProgressEngine::InvalidHandle;
+  #endif
+}
+
+
+void tarch::parallel::NodePool::resumeBackgroundReceives(int pauseToken) const {
+  #ifdef MPIUsesItsOwnThread
+  ProgressEngine::getInstance().resumePollingRoutine(pauseToken);
+  #endif
 }
 
 
@@ -46,7 +99,23 @@ void tarch::parallel::NodePool::restart() {
 
   logTraceIn( "restart()" );
 
-  _isAlive = true;
+  _isAlive   = true;
+  _ownerRank = getSubPoolManager( Node::getInstance().getRank(), _ranksPerSubPool );
+  if (_ownerRank==Node::getInstance().getRank()) {
+    _ownerRank = Node::getGlobalMasterRank();
+  }
+
+  _idleRanksOfSubPools.clear();
+  _subPoolManagersWithPendingCommand.clear();
+
+  if ( isSubPoolManager() ) {
+    if (_strategy==0) {
+      setStrategy( new FCFSNodePoolStrategy() );
+    }
+    assertion1( _strategy->getNumberOfRegisteredNodes()==0, Node::getInstance().getRank() );
+    _subPoolIsAlive                   = true;
+    _numberOfRanksThatHaveLeftSubPool = 0;
+  }
 
   #ifdef Parallel
   MPI_Barrier(Node::getInstance().getCommunicator());
@@ -58,6 +127,27 @@ void tarch::parallel::NodePool::restart() {
     );
     registerMessage.send( Node::getGlobalMasterRank(), _registrationTag, true, SendAndReceiveLoadBalancingMessagesBlocking);
     logDebug( "restart()", "register message sent: " << registerMessage.toString() << " on tag " << _registrationTag );
+
+    if (_ownerRank!=Node::getGlobalMasterRank()) {
+      registerMessage.send( _ownerRank, _registrationTag, true, SendAndReceiveLoadBalancingMessagesBlocking);
+      logDebug( "restart()", "registered at sub-pool manager " << _ownerRank );
+    }
+  }
+  #endif
+
+  #ifdef MPIUsesItsOwnThread
+  if (
+    (Node::getInstance().isGlobalMaster() || isSubPoolManager())
+    &&
+    _progressEngineHandle==ProgressEngine::InvalidHandle
+  ) {
+    _progressEngineHandle = ProgressEngine::getInstance().registerPollingRoutine(
+      "tarch::parallel::NodePool",
+      [this]() -> void {
+        replyToMessages();
+      },
+      true
+    );
   }
   #endif
 
@@ -70,7 +160,10 @@ int tarch::parallel::NodePool::getNumberOfWorkingNodes() const {
   assertion1( Node::getInstance().isGlobalMaster(), Node::getInstance().getRank() );
   assertion1( _strategy!=0, Node::getInstance().getRank() );
 
-  return _strategy->getNumberOfRegisteredNodes() - _strategy->getNumberOfIdleNodes() + 1; // +1 is the master
+  const int backgroundReceivesPauseToken = suspendBackgroundReceives();
+  const int  result = _strategy->getNumberOfRegisteredNodes() - getNumberOfIdleNodes() + 1; // +1 is the master
+  resumeBackgroundReceives(backgroundReceivesPauseToken);
+  return result;
   #else
   return 1;
   #endif
@@ -83,7 +176,10 @@ int tarch::parallel::NodePool::getNumberOfIdleNodes() const {
   assertion1( Node::getInstance().isGlobalMaster(), Node::getInstance().getRank() );
   assertion1( _strategy!=0, Node::getInstance().getRank() );
 
-  return _strategy->getNumberOfIdleNodes();
+  const int backgroundReceivesPauseToken = suspendBackgroundReceives();
+  const int  result = _strategy->getNumberOfIdleNodes() + static_cast<int>(_idleRanksOfSubPools.size());
+  resumeBackgroundReceives(backgroundReceivesPauseToken);
+  return result;
   #else
   return 0;
   #endif
@@ -96,7 +192,7 @@ bool tarch::parallel::NodePool::areAllNodesWorking() const {
   assertion1( Node::getInstance().isGlobalMaster(), Node::getInstance().getRank() );
   assertion1( _strategy!=0, Node::getInstance().getRank() );
 
-  return _strategy->getNumberOfIdleNodes()==0;
+  return getNumberOfIdleNodes()==0;
   #else
   return true;
   #endif
@@ -108,6 +204,10 @@ void tarch::parallel::NodePool::init() {
   _jobManagementTag = Node::getInstance().reserveFreeTag( "tarch::parallel::NodePool[job-management]" );
   _jobServicesTag   = Node::getInstance().reserveFreeTag( "tarch::parallel::NodePool[job-services]" );
 
+  _subPoolJobManagementTag = Node::getInstance().reserveFreeTag( "tarch::parallel::NodePool[sub-pool-job-management]" );
+  _subPoolJobServicesTag   = Node::getInstance().reserveFreeTag( "tarch::parallel::NodePool[sub-pool-job-services]" );
+  _subPoolControlTag       = Node::getInstance().reserveFreeTag( "tarch::parallel::NodePool[sub-pool-control]" );
+
   #ifdef Parallel
   tarch::parallel::messages::ActivationMessage::initDatatype();
   tarch::parallel::messages::JobRequestMessage::initDatatype();
@@ -136,7 +236,7 @@ int tarch::parallel::NodePool::getTagForForkMessages() const {
 
 
 void tarch::parallel::NodePool::setStrategy(NodePoolStrategy* strategy) {
-  assertion1( Node::getInstance().isGlobalMaster(), Node::getInstance().getRank() );
+  assertion1( Node::getInstance().isGlobalMaster() || isSubPoolManager(), Node::getInstance().getRank() );
 
   logTraceIn( "setStrategy(...)" );
 
@@ -147,12 +247,61 @@ void tarch::parallel::NodePool::setStrategy(NodePoolStrategy* strategy) {
   }
 
   _strategy = strategy;
-  _strategy->setNodePoolTag(_jobServicesTag);
+  _strategy->setNodePoolTag( Node::getInstance().isGlobalMaster() ? _jobServicesTag : _subPoolJobServicesTag );
 
   logTraceOut( "setStrategy(...)" );
 }
 
 
+void tarch::parallel::NodePool::setRanksPerSubPool(int ranksPerSubPool) {
+  assertion1( ranksPerSubPool>=0, ranksPerSubPool );
+  assertion1WithExplanation( !_isAlive, Node::getInstance().getRank(), "setRanksPerSubPool() has to be called before restart()" );
+  assertion1( _strategy==0 || _strategy->getNumberOfRegisteredNodes()==0, Node::getInstance().getRank() );
+
+  if (ranksPerSubPool==1) {
+    logWarning( "setRanksPerSubPool(int)", "sub-pools with one rank only hold their manager. Switch to flat node pool" );
+    ranksPerSubPool = 0;
+  }
+
+  _ranksPerSubPool = ranksPerSubPool;
+}
+
+
+int tarch::parallel::NodePool::getRanksPerSubPool() const {
+  return _ranksPerSubPool;
+}
+
+
+int tarch::parallel::NodePool::getSubPoolManager(int rank, int ranksPerSubPool) {
+  assertion2( rank>=0, rank, ranksPerSubPool );
+  if (ranksPerSubPool<=0 || rank<ranksPerSubPool) {
+    return Node::getGlobalMasterRank();
+  }
+  else {
+    return rank - rank % ranksPerSubPool;
+  }
+}
+
+
+bool tarch::parallel::NodePool::isSubPoolManager() const {
+  return _ranksPerSubPool>0
+      && !Node::getInstance().isGlobalMaster()
+      && getSubPoolManager(Node::getInstance().getRank(),_ranksPerSubPool)==Node::getInstance().getRank();
+}
+
+
+int tarch::parallel::NodePool::getFirstRankOfSubPool() const {
+  assertion( isSubPoolManager() );
+  return Node::getInstance().getRank();
+}
+
+
+int tarch::parallel::NodePool::getLastRankOfSubPool() const {
+  assertion( isSubPoolManager() );
+  return std::min( Node::getInstance().getRank()+_ranksPerSubPool, Node::getInstance().getNumberOfNodes() );
+}
+
+
 
 void tarch::parallel::NodePool::waitForAllNodesToBecomeIdle() {
   #ifdef Parallel
@@ -163,13 +312,16 @@ void tarch::parallel::NodePool::waitForAllNodesToBecomeIdle() {
     clock_t      timeOutShutdown  = tarch::parallel::Node::getInstance().getDeadlockTimeOutTimeStamp();
     bool         triggeredTimeoutWarning = false;
 
+    // The loop's receiveDanglingMessages() answers all requests
+    const int backgroundReceivesPauseToken = suspendBackgroundReceives();
+
     logInfo(
       "waitForAllNodesToBecomeIdle()",
-      _strategy->getNumberOfIdleNodes() << " out of " <<
+      getNumberOfIdleNodes() << " out of " <<
       (Node::getInstance().getNumberOfNodes()-1) << " ranks are already registered as idle. Wait for registration of remaining nodes"
     );
 
-    while ( _strategy->getNumberOfIdleNodes() < Node::getInstance().getNumberOfNodes()-1) {
+    while ( getNumberOfIdleNodes() < Node::getInstance().getNumberOfNodes()-1) {
       receiveDanglingMessages();
 
       // deadlock aspect
@@ -196,12 +348,21 @@ void tarch::parallel::NodePool::waitForAllNodesToBecomeIdle() {
          );
       }
     }
+
+    resumeBackgroundReceives(backgroundReceivesPauseToken);
   }
   #endif
 }
 
 
 void tarch::parallel::NodePool::shutdown() {
+  #ifdef MPIUsesItsOwnThread
+  if (_progressEngineHandle!=ProgressEngine::InvalidHandle) {
+    ProgressEngine::getInstance().deregisterPollingRoutine(_progressEngineHandle);
+    _progressEngineHandle = ProgressEngine::InvalidHandle;
+  }
+  #endif
+
   emptyReceiveBuffers();
 
   if ( _isAlive ) {
@@ -251,18 +412,43 @@ tarch::parallel::NodePool::JobRequestMessageAnswer tarch::parallel::NodePool::wa
   _masterNode = -1;
 
   #ifdef Parallel
-  tarch::parallel::messages::JobRequestMessage message;
-  message.send(Node::getInstance().getGlobalMasterRank(),_jobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking);
-
-  logInfo( "waitForJob()", "sent out job request message" );
+  // Managers serve their sub-pool through receiveDanglingMessages() while
+  // they wait
+  const int backgroundReceivesPauseToken = suspendBackgroundReceives();
 
   tarch::parallel::messages::ActivationMessage answer;
-  answer.receive(
-    Node::getInstance().getGlobalMasterRank(),
-    _jobManagementTag,
-    true,
-    SendAndReceiveLoadBalancingMessagesBlocking
-  );
+  do {
+    const int tag = _ownerRank==Node::getInstance().getGlobalMasterRank() ? _jobManagementTag : _subPoolJobManagementTag;
+
+    tarch::parallel::messages::JobRequestMessage message;
+    message.send(_ownerRank,tag, true, SendAndReceiveLoadBalancingMessagesBlocking);
+
+    logInfo( "waitForJob()", "sent out job request message to rank " << _ownerRank );
+
+    // Sub-pool managers have to serve their sub-pool while they wait. So
+    // we may not rely on a blocking receive.
+    if ( isSubPoolManager() ) {
+      int flag = 0;
+      while (!flag) {
+        MPI_Iprobe( _ownerRank, tag, Node::getInstance().getCommunicator(), &flag, MPI_STATUS_IGNORE );
+        if (!flag) {
+          Node::getInstance().receiveDanglingMessages();
+        }
+      }
+    }
+
+    answer.receive(
+      _ownerRank,
+      tag,
+      true,
+      SendAndReceiveLoadBalancingMessagesBlocking
+    );
+
+    if ( answer.getNewMaster() == JobRequestMessageAnswerValues::ReturnToGlobalMaster ) {
+      logDebug("waitForJob()", "sub-pool manager " << _ownerRank << " has handed rank over to global master" );
+      _ownerRank = Node::getInstance().getGlobalMasterRank();
+    }
+  } while ( answer.getNewMaster() == JobRequestMessageAnswerValues::ReturnToGlobalMaster );
 
 /*
   int result = MPI_Recv(
@@ -283,19 +469,42 @@ tarch::parallel::NodePool::JobRequestMessageAnswer tarch::parallel::NodePool::wa
 
   if ( answer.getNewMaster() == JobRequestMessageAnswerValues::Terminate ) {
     logDebug("waitForJob()", "node received termination signal");
+    if ( isSubPoolManager() ) {
+      terminateSubPool();
+
+      clock_t      timeOutWarning   = Node::getInstance().getDeadlockWarningTimeStamp();
+      clock_t      timeOutShutdown  = Node::getInstance().getDeadlockTimeOutTimeStamp();
+      bool         triggeredTimeoutWarning = false;
+
+      while ( _numberOfRanksThatHaveLeftSubPool < getLastRankOfSubPool()-getFirstRankOfSubPool()-1 ) {
+        Node::getInstance().receiveDanglingMessages();
+
+        // deadlock aspect
+        if ( Node::getInstance().isTimeOutWarningEnabled() && (clock()>timeOutWarning) && (!triggeredTimeoutWarning)) {
+          Node::getInstance().writeTimeOutWarning( "tarch::parallel::NodePool", "waitForJob()", -1, _subPoolJobManagementTag, 1);
+          triggeredTimeoutWarning = true;
+        }
+        if ( Node::getInstance().isTimeOutDeadlockEnabled() && (clock()>timeOutShutdown)) {
+          Node::getInstance().triggerDeadlockTimeOut( "tarch::parallel::NodePool", "waitForJob()", -1, _subPoolJobManagementTag, 1 );
+        }
+      }
+    }
     _isAlive = false;
+    resumeBackgroundReceives(backgroundReceivesPauseToken);
     logTraceOutWith1Argument( "waitForJob()", "terminate" );
     return JobRequestMessageAnswerValues::Terminate;
   }
   else if ( answer.getNewMaster() == JobRequestMessageAnswerValues::RunAllNodes ) {
     logDebug("waitForJob()", "node received run code on all nodes signal. Will wake up for global step and then ask for new job again");
     _isAlive = true;
+    resumeBackgroundReceives(backgroundReceivesPauseToken);
     logTraceOutWith1Argument( "waitForJob()", "run global step" );
     return JobRequestMessageAnswerValues::RunAllNodes;
   }
   else {
     _masterNode = answer.getNewMaster();
     assertion1(_masterNode>=0, _masterNode);
+    resumeBackgroundReceives(backgroundReceivesPauseToken);
     logTraceOutWith1Argument( "waitForJob()", _masterNode );
     return _masterNode;
   }
@@ -316,11 +525,17 @@ void tarch::parallel::NodePool::terminate() {
 
     logTraceIn("terminate()" );
 
+    #ifdef Parallel
+    const int backgroundReceivesPauseToken = suspendBackgroundReceives();
+    #endif
+
     _isAlive = false;
 
     #ifdef Parallel
+    waitForSubPoolCommandsToBeProcessed();
+
     for (int i=0; i<tarch::parallel::Node::getInstance().getNumberOfNodes(); i++) {
-      if ( _strategy->isIdleNode(i) ) {
+      if ( _strategy->isRegisteredNode(i) && _strategy->isIdleNode(i) ) {
         tarch::parallel::messages::ActivationMessage answerMessage( JobRequestMessageAnswerValues::Terminate );
         answerMessage.send( i, _jobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
         _strategy->removeNode(i);
@@ -353,6 +568,8 @@ void tarch::parallel::NodePool::terminate() {
         Node::getInstance().triggerDeadlockTimeOut( "tarch::parallel::NodePool", "terminate()", -1, _jobManagementTag, 1 );
       }
     }
+
+    resumeBackgroundReceives(backgroundReceivesPauseToken);
     #endif
     logTraceOut( "terminate()" );
   }
@@ -401,6 +618,8 @@ std::vector<int>  tarch::parallel::NodePool::reserveFreeNodesForServer(int numbe
     static_cast<int>(result.size())<numberOfRanksWanted
   );
 
+  requestRanksFromSubPools( numberOfRanksWanted - static_cast<int>(result.size()) );
+
   logTraceOutWith1Argument( "reserveFreeNodeForServer()", result.size());
 
   return result;
@@ -414,7 +633,10 @@ std::vector<int> tarch::parallel::NodePool::reserveFreeNodes(int numberOfRanksWa
     assertion2( _masterNode == -1, _masterNode, Node::getInstance().getRank() );
   	assertion1( _isAlive, Node::getInstance().getRank() );
   	receiveDanglingMessages();
-  	return reserveFreeNodesForServer(numberOfRanksWanted);
+  	const int backgroundReceivesPauseToken = suspendBackgroundReceives();
+  	std::vector<int> result = reserveFreeNodesForServer(numberOfRanksWanted);
+  	resumeBackgroundReceives(backgroundReceivesPauseToken);
+  	return result;
   }
   else {
     assertion1( _isAlive, Node::getInstance().getRank() );
@@ -431,30 +653,73 @@ std::vector<int>  tarch::parallel::NodePool::reserveFreeNodesForClient(int numbe
   logTraceIn( "reserveFreeNodeForClient()" );
 
   std::vector<int> result;
-  int activatedNode = NoFreeNodesMessage;
+
+  #ifdef Parallel
+  const int subPoolManager = getSubPoolManager( Node::getInstance().getRank(), _ranksPerSubPool );
+  if ( isSubPoolManager() ) {
+    const int backgroundReceivesPauseToken = suspendBackgroundReceives();
+    result = reserveFreeNodesOfSubPool( Node::getInstance().getRank(), numberOfRanksWanted );
+    resumeBackgroundReceives(backgroundReceivesPauseToken);
+  }
+  else if ( subPoolManager!=Node::getInstance().getGlobalMasterRank() ) {
+    tarch::parallel::messages::WorkerRequestMessage queryMessage(numberOfRanksWanted);
+    queryMessage.send(subPoolManager,_subPoolJobServicesTag, true, SendAndReceiveLoadBalancingMessagesBlocking);
+    result = receiveReservedNodes(subPoolManager,_subPoolJobServicesTag,numberOfRanksWanted);
+  }
+
+  if ( static_cast<int>(result.size())<numberOfRanksWanted ) {
+    std::vector<int> ranksFromGlobalMaster = reserveFreeNodesFromGlobalMaster( numberOfRanksWanted-static_cast<int>(result.size()) );
+    result.insert( result.end(), ranksFromGlobalMaster.begin(), ranksFromGlobalMaster.end() );
+  }
+  #endif
+
+  logTraceOutWith1Argument( "reserveFreeNodeForClient()", result.size() );
+
+  return result;
+}
+
+
+std::vector<int> tarch::parallel::NodePool::reserveFreeNodesFromGlobalMaster(int numberOfRanksWanted) {
+  assertion(numberOfRanksWanted>0);
+
+  std::vector<int> result;
 
   #ifdef Parallel
   tarch::parallel::messages::WorkerRequestMessage queryMessage(numberOfRanksWanted);
   queryMessage.send(Node::getInstance().getGlobalMasterRank(),_jobServicesTag, true, SendAndReceiveLoadBalancingMessagesBlocking);
+
+  result = receiveReservedNodes(Node::getInstance().getGlobalMasterRank(),_jobServicesTag,numberOfRanksWanted);
   #endif
 
-  do {
+  return result;
+}
+
+
+void tarch::parallel::NodePool::sendReservedNodes(const std::vector<int>& ranks, int numberOfRequestedRanks, int destination, int tag) {
+  assertion2( static_cast<int>(ranks.size())<=numberOfRequestedRanks, ranks.size(), numberOfRequestedRanks );
+
   #ifdef Parallel
+  for (int i=0; i<numberOfRequestedRanks; i++) {
+    tarch::parallel::messages::NodePoolAnswerMessage answerMessage( i<static_cast<int>(ranks.size()) ? ranks[i] : NoFreeNodesMessage );
+    answerMessage.send( destination, tag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+  }
+  #endif
+}
+
+
+std::vector<int> tarch::parallel::NodePool::receiveReservedNodes(int source, int tag, int numberOfRequestedRanks) {
+  std::vector<int> result;
+
+  #ifdef Parallel
+  for (int i=0; i<numberOfRequestedRanks; i++) {
     tarch::parallel::messages::NodePoolAnswerMessage answer;
-    answer.receive(Node::getInstance().getGlobalMasterRank(),_jobServicesTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+    answer.receive( source, tag, true, SendAndReceiveLoadBalancingMessagesBlocking );
 
-    activatedNode = answer.getNewWorker();
-    if (activatedNode!=NoFreeNodesMessage) {
-      result.push_back( activatedNode );
+    if (answer.getNewWorker()!=NoFreeNodesMessage) {
+      result.push_back( answer.getNewWorker() );
     }
+  }
   #endif
-  } while (
-    activatedNode!=NoFreeNodesMessage
-    &&
-    static_cast<int>(result.size())<numberOfRanksWanted
-  );
-
-  logTraceOutWith1Argument( "reserveFreeNodeForClient()", result.size() );
 
   return result;
 }
@@ -472,10 +737,21 @@ tarch::parallel::NodePool& tarch::parallel::NodePool::operator=( const tarch::pa
 
 
 void tarch::parallel::NodePool::receiveDanglingMessages() {
+  const int backgroundReceivesPauseToken = suspendBackgroundReceives();
+  replyToMessages();
+  resumeBackgroundReceives(backgroundReceivesPauseToken);
+}
+
+
+void tarch::parallel::NodePool::replyToMessages() {
   if ( Node::getInstance().isGlobalMaster() ) {
     replyToRegistrationMessages();
     replyToJobRequestMessages();
     replyToWorkerRequestMessages();
+    receiveSubPoolNotifications();
+  }
+  else if ( isSubPoolManager() && _strategy!=0 ) {
+    replyToSubPoolMessages();
   }
 }
 
@@ -494,6 +770,7 @@ void tarch::parallel::NodePool::emptyReceiveBuffers() {
   emptyRegisterMessageReceiveBuffer();
   emptyJobRequestMessageBuffer();
   emptyWorkerRequestMessageBuffer();
+  emptySubPoolMessageBuffers();
 }
 
 
@@ -516,6 +793,55 @@ void tarch::parallel::NodePool::replyToRegistrationMessages() {
 }
 
 
+void tarch::parallel::NodePool::waitForRegistration(int rank) {
+  #ifdef Parallel
+  if ( !_strategy->isRegisteredNode(rank) ) {
+    logWarning(
+      "waitForRegistration(int)",
+      "node pool does not contain entry for rank " << rank
+       << ". Message from rank " << rank
+       << " might have overtaken registration message. Waiting for registration"
+    );
+
+    clock_t      timeOutWarning   = tarch::parallel::Node::getInstance().getDeadlockWarningTimeStamp();;
+    clock_t      timeOutShutdown  = tarch::parallel::Node::getInstance().getDeadlockTimeOutTimeStamp();
+    bool         triggeredTimeoutWarning = false;
+
+    while ( !_strategy->isRegisteredNode(rank) ) {
+      replyToRegistrationMessages();
+
+      // deadlock aspect
+      if (
+         tarch::parallel::Node::getInstance().isTimeOutWarningEnabled() &&
+         (clock()>timeOutWarning) &&
+         (!triggeredTimeoutWarning)
+      ) {
+         tarch::parallel::Node::getInstance().writeTimeOutWarning(
+         "tarch::parallel::NodePool",
+         "waitForRegistration(int)", rank,_registrationTag,1
+         );
+         triggeredTimeoutWarning = true;
+      }
+      if (
+         tarch::parallel::Node::getInstance().isTimeOutDeadlockEnabled() &&
+         (clock()>timeOutShutdown)
+      ) {
+        logError( "waitForRegistration(int)", "deadlocked while waiting for registration message from rank " << rank << ". strategy=" << _strategy->toString() );
+        logError( "waitForRegistration(int)", "no of registered nodes=" << _strategy->getNumberOfRegisteredNodes() );
+
+         tarch::parallel::Node::getInstance().triggerDeadlockTimeOut(
+         "tarch::parallel::NodePool",
+         "waitForRegistration(int)", rank,_registrationTag,1
+         );
+      }
+    }
+
+    logDebug( "waitForRegistration(int)", "registration from " << rank << " finally arrived" );
+  }
+  #endif
+}
+
+
 void tarch::parallel::NodePool::replyToJobRequestMessages() {
   logTraceIn( "replyToJobRequestMessage() ");
   assertion1( _strategy!=0, Node::getInstance().getRank() );
@@ -527,49 +853,10 @@ void tarch::parallel::NodePool::replyToJobRequestMessages() {
 
     assertion1( queryMessage.getSenderRank() !=Node::getInstance().getGlobalMasterRank(), Node::getInstance().getRank() );
 
-    if ( !_strategy->isRegisteredNode(queryMessage.getSenderRank()) ) {
-      logWarning(
-        "replyToJobRequestMessages()",
-        "node pool does not contain entry for rank " << queryMessage.getSenderRank()
-         << ". Message from rank " << queryMessage.getSenderRank()
-         << " might have overtaken registration message. Waiting for registration"
-      );
-
-      clock_t      timeOutWarning   = tarch::parallel::Node::getInstance().getDeadlockWarningTimeStamp();;
-      clock_t      timeOutShutdown  = tarch::parallel::Node::getInstance().getDeadlockTimeOutTimeStamp();
-      bool         triggeredTimeoutWarning = false;
-
-      while ( !_strategy->isRegisteredNode(queryMessage.getSenderRank()) ) {
-        receiveDanglingMessages();
+    waitForRegistration( queryMessage.getSenderRank() );
 
-        // deadlock aspect
-        if (
-           tarch::parallel::Node::getInstance().isTimeOutWarningEnabled() &&
-           (clock()>timeOutWarning) &&
-           (!triggeredTimeoutWarning)
-        ) {
-           tarch::parallel::Node::getInstance().writeTimeOutWarning(
-           "tarch::parallel::NodePool",
-           "replyToJobRequestMessages()", queryMessage.getSenderRank(),_registrationTag,1
-           );
-           triggeredTimeoutWarning = true;
-        }
-        if (
-           tarch::parallel::Node::getInstance().isTimeOutDeadlockEnabled() &&
-           (clock()>timeOutShutdown)
-        ) {
-          logError( "replyToJobRequestMessages()", "deadlocked while waiting for registration message from rank " << queryMessage.getSenderRank() << ". strategy=" << _strategy->toString() );
-          logError( "replyToJobRequestMessages()", "no of registered nodes=" << _strategy->getNumberOfRegisteredNodes() );
-
-           tarch::parallel::Node::getInstance().triggerDeadlockTimeOut(
-           "tarch::parallel::NodePool",
-           "waitForAllNodesToBecomeIdle()", queryMessage.getSenderRank(),_registrationTag,1
-           );
-        }
-      }
-
-      logDebug( "replyToJobRequestMessages()", "registration from " << queryMessage.getSenderRank() << " finally arrived" );
-    }
+    // The rank might have been returned by a sub-pool manager
+    _idleRanksOfSubPools.erase( queryMessage.getSenderRank() );
 
     if ( !_isAlive ) {
       _strategy->setNodeIdle( queryMessage.getSenderRank() );
@@ -600,21 +887,27 @@ void tarch::parallel::NodePool::replyToWorkerRequestMessages() {
 
     while ( !queue.empty() ) {
       tarch::parallel::messages::WorkerRequestMessage nextRequestToAnswer = _strategy->extractElementFromRequestQueue(queue);
-      for (int i=0; i<nextRequestToAnswer.getNumberOfRequestedWorkers(); i++) {
-        int activatedNode = NoFreeNodesMessage;
-        if ( _isAlive && _strategy->hasIdleNode(nextRequestToAnswer.getSenderRank()) ) {
-          activatedNode = _strategy->reserveNode(nextRequestToAnswer.getSenderRank());
-          assertionEquals(-1,NoFreeNodesMessage);
-        }
+      std::vector<int> activatedNodes;
+      while (
+        static_cast<int>(activatedNodes.size())<nextRequestToAnswer.getNumberOfRequestedWorkers()
+        &&
+        _isAlive
+        &&
+        _strategy->hasIdleNode(nextRequestToAnswer.getSenderRank())
+      ) {
+        const int activatedNode = _strategy->reserveNode(nextRequestToAnswer.getSenderRank());
+        assertion1( activatedNode!=NoFreeNodesMessage, nextRequestToAnswer.toString() );
 
-        if (activatedNode!=NoFreeNodesMessage) {
-          _hasGivenOutRankSizeLastQuery = true;
-          tarch::parallel::messages::ActivationMessage activationMessage( nextRequestToAnswer.getSenderRank() );
-          activationMessage.send( activatedNode, _jobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
-        }
+        _hasGivenOutRankSizeLastQuery = true;
+        tarch::parallel::messages::ActivationMessage activationMessage( nextRequestToAnswer.getSenderRank() );
+        activationMessage.send( activatedNode, _jobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+        activatedNodes.push_back( activatedNode );
+      }
 
-        tarch::parallel::messages::NodePoolAnswerMessage answerMessage( activatedNode );
-        answerMessage.send( nextRequestToAnswer.getSenderRank(), _jobServicesTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+      sendReservedNodes( activatedNodes, nextRequestToAnswer.getNumberOfRequestedWorkers(), nextRequestToAnswer.getSenderRank(), _jobServicesTag );
+
+      if (_isAlive) {
+        requestRanksFromSubPools( nextRequestToAnswer.getNumberOfRequestedWorkers() - static_cast<int>(activatedNodes.size()) );
       }
 
       //NOTE: Take care of recursive calls.
@@ -667,12 +960,18 @@ void tarch::parallel::NodePool::activateIdleNodes() {
 
   tarch::parallel::messages::ActivationMessage message( JobRequestMessageAnswerValues::RunAllNodes );
 
+  const int backgroundReceivesPauseToken = suspendBackgroundReceives();
   for (int rank=1; rank<Node::getInstance().getNumberOfNodes(); rank++) {
     if (_strategy->isIdleNode(rank)) {
       _strategy->reserveParticularNode(rank);
       message.send(rank,getTagForForkMessages(), true, SendAndReceiveLoadBalancingMessagesBlocking);
     }
   }
+
+  if (_ranksPerSubPool>0) {
+    sendSubPoolCommandToAllManagers( SubPoolCommandRunAllNodes, 0 );
+  }
+  resumeBackgroundReceives(backgroundReceivesPauseToken);
   logTraceOut( "activateIdleNodes(int)" );
   #endif
 }
@@ -680,7 +979,10 @@ void tarch::parallel::NodePool::activateIdleNodes() {
 
 bool tarch::parallel::NodePool::isIdleNode( int rank ) const {
   #ifdef Parallel
-  return _strategy->isIdleNode(rank);
+  const int backgroundReceivesPauseToken = suspendBackgroundReceives();
+  const bool result = _strategy->isIdleNode(rank) || _idleRanksOfSubPools.count(rank)>0;
+  resumeBackgroundReceives(backgroundReceivesPauseToken);
+  return result;
   #else
   return rank>0;
   #endif
@@ -688,7 +990,409 @@ bool tarch::parallel::NodePool::isIdleNode( int rank ) const {
 
 
 bool tarch::parallel::NodePool::hasGivenOutRankSizeLastQuery() {
+  const int backgroundReceivesPauseToken = suspendBackgroundReceives();
   bool result = _hasGivenOutRankSizeLastQuery;
   _hasGivenOutRankSizeLastQuery = false;
+  resumeBackgroundReceives(backgroundReceivesPauseToken);
   return result;
 }
+
+
+void tarch::parallel::NodePool::emptySubPoolMessageBuffers() {
+  #ifdef Parallel
+  while ( tarch::parallel::messages::JobRequestMessage::isMessageInQueue(_subPoolJobManagementTag, true) ) {
+    tarch::parallel::messages::JobRequestMessage message;
+    message.receive( MPI_ANY_SOURCE, _subPoolJobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+  }
+  while ( tarch::parallel::messages::WorkerRequestMessage::isMessageInQueue(_subPoolJobServicesTag, true) ) {
+    tarch::parallel::messages::WorkerRequestMessage message;
+    message.receive( MPI_ANY_SOURCE, _subPoolJobServicesTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+  }
+
+  MPI_Status status;
+  int        flag = 0;
+  MPI_Iprobe( MPI_ANY_SOURCE, _subPoolControlTag, Node::getInstance().getCommunicator(), &flag, &status );
+  while (flag) {
+    int count = 0;
+    MPI_Get_count( &status, MPI_INT, &count );
+    std::vector<int> message( std::max(count,1) );
+    MPI_Recv( message.data(), count, MPI_INT, status.MPI_SOURCE, _subPoolControlTag, Node::getInstance().getCommunicator(), MPI_STATUS_IGNORE );
+    MPI_Iprobe( MPI_ANY_SOURCE, _subPoolControlTag, Node::getInstance().getCommunicator(), &flag, &status );
+  }
+  #endif
+}
+
+
+std::vector<int> tarch::parallel::NodePool::reserveFreeNodesOfSubPool(int forMaster, int numberOfRanksWanted) {
+  assertion1( isSubPoolManager(), Node::getInstance().getRank() );
+  assertion1( _strategy!=0, Node::getInstance().getRank() );
+
+  logTraceInWith2Arguments( "reserveFreeNodesOfSubPool(int,int)", forMaster, numberOfRanksWanted );
+
+  const bool wasServingSubPool = _isServingSubPool;
+  _isServingSubPool = true;
+
+  std::vector<int> result;
+  while (
+    _subPoolIsAlive
+    &&
+    static_cast<int>(result.size())<numberOfRanksWanted
+    &&
+    _strategy->hasIdleNode(forMaster)
+  ) {
+    result.push_back( _strategy->reserveNode(forMaster) );
+  }
+
+  #ifdef Parallel
+  if (!result.empty()) {
+    std::vector<int> notifications;
+    for (int rank: result) {
+      notifications.push_back( SubPoolNotificationBusy );
+      notifications.push_back( rank );
+    }
+    sendSubPoolNotifications( notifications );
+
+    tarch::parallel::messages::ActivationMessage activationMessage( forMaster );
+    for (int rank: result) {
+      activationMessage.send( rank, _subPoolJobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+    }
+  }
+  #endif
+
+  _isServingSubPool = wasServingSubPool;
+
+  logTraceOutWith1Argument( "reserveFreeNodesOfSubPool(int,int)", result.size() );
+  return result;
+}
+
+
+void tarch::parallel::NodePool::replyToSubPoolMessages() {
+  assertion1( isSubPoolManager(), Node::getInstance().getRank() );
+  assertion1( _strategy!=0, Node::getInstance().getRank() );
+
+  if (!_isServingSubPool) {
+    _isServingSubPool = true;
+
+    replyToRegistrationMessages();
+    replyToSubPoolCommands();
+    replyToSubPoolJobRequestMessages();
+    replyToSubPoolWorkerRequestMessages();
+
+    _isServingSubPool = false;
+  }
+}
+
+
+void tarch::parallel::NodePool::replyToSubPoolJobRequestMessages() {
+  #ifdef Parallel
+  logTraceIn( "replyToSubPoolJobRequestMessages()" );
+
+  std::vector<int> notifications;
+  while ( tarch::parallel::messages::JobRequestMessage::isMessageInQueue(_subPoolJobManagementTag, true) ) {
+    tarch::parallel::messages::JobRequestMessage queryMessage;
+    queryMessage.receive( MPI_ANY_SOURCE, _subPoolJobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+
+    const int rank = queryMessage.getSenderRank();
+    waitForRegistration( rank );
+    _strategy->setNodeIdle( rank );
+
+    if ( !_subPoolIsAlive ) {
+      _strategy->removeNode( rank );
+      _numberOfRanksThatHaveLeftSubPool++;
+      tarch::parallel::messages::ActivationMessage answerMessage( JobRequestMessageAnswerValues::Terminate );
+      answerMessage.send( rank, _subPoolJobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+      notifications.push_back( SubPoolNotificationTerminated );
+    }
+    else {
+      notifications.push_back( SubPoolNotificationIdle );
+    }
+    notifications.push_back( rank );
+  }
+
+  sendSubPoolNotifications( notifications );
+
+  logTraceOut( "replyToSubPoolJobRequestMessages()" );
+  #endif
+}
+
+
+void tarch::parallel::NodePool::replyToSubPoolWorkerRequestMessages() {
+  #ifdef Parallel
+  logTraceIn( "replyToSubPoolWorkerRequestMessages()" );
+
+  if (tarch::parallel::messages::WorkerRequestMessage::isMessageInQueue(_subPoolJobServicesTag, true)) {
+    NodePoolStrategy::RequestQueue queue;
+    _strategy->fillWorkerRequestQueue(queue);
+
+    while ( !queue.empty() ) {
+      tarch::parallel::messages::WorkerRequestMessage nextRequestToAnswer = _strategy->extractElementFromRequestQueue(queue);
+
+      const std::vector<int> activatedNodes = reserveFreeNodesOfSubPool(
+        nextRequestToAnswer.getSenderRank(),
+        nextRequestToAnswer.getNumberOfRequestedWorkers()
+      );
+      sendReservedNodes( activatedNodes, nextRequestToAnswer.getNumberOfRequestedWorkers(), nextRequestToAnswer.getSenderRank(), _subPoolJobServicesTag );
+
+      _strategy->fillWorkerRequestQueue(queue);
+    }
+  }
+
+  logTraceOut( "replyToSubPoolWorkerRequestMessages()" );
+  #endif
+}
+
+
+void tarch::parallel::NodePool::replyToSubPoolCommands() {
+  #ifdef Parallel
+  int flag = 0;
+  MPI_Iprobe( Node::getGlobalMasterRank(), _subPoolControlTag, Node::getInstance().getCommunicator(), &flag, MPI_STATUS_IGNORE );
+  while (flag) {
+    int command[2];
+    MPI_Recv( command, 2, MPI_INT, Node::getGlobalMasterRank(), _subPoolControlTag, Node::getInstance().getCommunicator(), MPI_STATUS_IGNORE );
+
+    logDebug( "replyToSubPoolCommands()", "received command " << command[0] << " with argument " << command[1] );
+
+    std::vector<int> notifications;
+    std::vector<int> ranksToWakeUp;
+    switch (command[0]) {
+      case SubPoolCommandRunAllNodes:
+        for (int rank=getFirstRankOfSubPool()+1; rank<getLastRankOfSubPool(); rank++) {
+          if ( _strategy->isRegisteredNode(rank) && _strategy->isIdleNode(rank) ) {
+            _strategy->reserveParticularNode(rank);
+            ranksToWakeUp.push_back(rank);
+            notifications.push_back( SubPoolNotificationBusy );
+            notifications.push_back( rank );
+          }
+        }
+        break;
+      case SubPoolCommandReturnIdleRanks:
+        {
+          int numberOfReturnedRanks = 0;
+          for (int rank=getFirstRankOfSubPool()+1; rank<getLastRankOfSubPool() && numberOfReturnedRanks<command[1]; rank++) {
+            if ( _strategy->isRegisteredNode(rank) && _strategy->isIdleNode(rank) ) {
+              _strategy->reserveParticularNode(rank);
+              _strategy->removeNode(rank);
+              _numberOfRanksThatHaveLeftSubPool++;
+              numberOfReturnedRanks++;
+              tarch::parallel::messages::ActivationMessage answerMessage( JobRequestMessageAnswerValues::ReturnToGlobalMaster );
+              answerMessage.send( rank, _subPoolJobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+            }
+          }
+          logInfo( "replyToSubPoolCommands()", "returned " << numberOfReturnedRanks << " idle rank(s) to global master" );
+        }
+        break;
+      default:
+        assertion1( false, command[0] );
+        break;
+    }
+
+    notifications.push_back( SubPoolNotificationCommandProcessed );
+    notifications.push_back( Node::getInstance().getRank() );
+    sendSubPoolNotifications( notifications );
+
+    tarch::parallel::messages::ActivationMessage runAllNodesMessage( JobRequestMessageAnswerValues::RunAllNodes );
+    for (int rank: ranksToWakeUp) {
+      runAllNodesMessage.send( rank, _subPoolJobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+    }
+
+    MPI_Iprobe( Node::getGlobalMasterRank(), _subPoolControlTag, Node::getInstance().getCommunicator(), &flag, MPI_STATUS_IGNORE );
+  }
+  #endif
+}
+
+
+void tarch::parallel::NodePool::terminateSubPool() {
+  assertion1( isSubPoolManager(), Node::getInstance().getRank() );
+
+  if (_subPoolIsAlive) {
+    logTraceIn( "terminateSubPool()" );
+
+    const bool wasServingSubPool = _isServingSubPool;
+    _isServingSubPool = true;
+    _subPoolIsAlive   = false;
+
+    #ifdef Parallel
+    std::vector<int> notifications;
+    for (int rank=getFirstRankOfSubPool()+1; rank<getLastRankOfSubPool(); rank++) {
+      if ( _strategy->isRegisteredNode(rank) && _strategy->isIdleNode(rank) ) {
+        tarch::parallel::messages::ActivationMessage answerMessage( JobRequestMessageAnswerValues::Terminate );
+        answerMessage.send( rank, _subPoolJobManagementTag, true, SendAndReceiveLoadBalancingMessagesBlocking );
+        _strategy->removeNode(rank);
+        _numberOfRanksThatHaveLeftSubPool++;
+        notifications.push_back( SubPoolNotificationTerminated );
+        notifications.push_back( rank );
+      }
+    }
+    sendSubPoolNotifications( notifications );
+    #endif
+
+    _isServingSubPool = wasServingSubPool;
+
+    logTraceOutWith1Argument( "terminateSubPool()", _numberOfRanksThatHaveLeftSubPool );
+  }
+}
+
+
+void tarch::parallel::NodePool::sendSubPoolNotifications(const std::vector<int>& notifications) {
+  #ifdef Parallel
+  if (!notifications.empty()) {
+    MPI_Request request;
+    MPI_Issend(
+      const_cast<int*>(notifications.data()), static_cast<int>(notifications.size()), MPI_INT,
+      Node::getGlobalMasterRank(), _subPoolControlTag, Node::getInstance().getCommunicator(), &request
+    );
+
+    clock_t      timeOutWarning   = Node::getInstance().getDeadlockWarningTimeStamp();
+    clock_t      timeOutShutdown  = Node::getInstance().getDeadlockTimeOutTimeStamp();
+    bool         triggeredTimeoutWarning = false;
+
+    int flag = 0;
+    MPI_Test( &request, &flag, MPI_STATUS_IGNORE );
+    while (!flag) {
+      Node::getInstance().receiveDanglingMessages();
+
+      // deadlock aspect
+      if ( Node::getInstance().isTimeOutWarningEnabled() && (clock()>timeOutWarning) && (!triggeredTimeoutWarning)) {
+        Node::getInstance().writeTimeOutWarning( "tarch::parallel::NodePool", "sendSubPoolNotifications(...)", Node::getGlobalMasterRank(), _subPoolControlTag, 1);
+        triggeredTimeoutWarning = true;
+      }
+      if ( Node::getInstance().isTimeOutDeadlockEnabled() && (clock()>timeOutShutdown)) {
+        Node::getInstance().triggerDeadlockTimeOut( "tarch::parallel::NodePool", "sendSubPoolNotifications(...)", Node::getGlobalMasterRank(), _subPoolControlTag, 1 );
+      }
+
+      MPI_Test( &request, &flag, MPI_STATUS_IGNORE );
+    }
+  }
+  #endif
+}
+
+
+void tarch::parallel::NodePool::receiveSubPoolNotifications() {
+  #ifdef Parallel
+  if (_ranksPerSubPool>0) {
+    logTraceIn( "receiveSubPoolNotifications()" );
+
+    MPI_Status status;
+    int        flag = 0;
+    MPI_Iprobe( MPI_ANY_SOURCE, _subPoolControlTag, Node::getInstance().getCommunicator(), &flag, &status );
+    while (flag) {
+      int count = 0;
+      MPI_Get_count( &status, MPI_INT, &count );
+      assertion1( count>0 && count%2==0, count );
+
+      std::vector<int> notifications( count );
+      const int manager = status.MPI_SOURCE;
+      MPI_Recv( notifications.data(), count, MPI_INT, manager, _subPoolControlTag, Node::getInstance().getCommunicator(), MPI_STATUS_IGNORE );
+
+      for (int i=0; i<count; i+=2) {
+        const int rank = notifications[i+1];
+        switch (notifications[i]) {
+          case SubPoolNotificationIdle:
+            _idleRanksOfSubPools.insert(rank);
+            break;
+          case SubPoolNotificationBusy:
+            _idleRanksOfSubPools.erase(rank);
+            _hasGivenOutRankSizeLastQuery = true;
+            break;
+          case SubPoolNotificationTerminated:
+            _idleRanksOfSubPools.erase(rank);
+            waitForRegistration(rank);
+            _strategy->removeNode(rank);
+            break;
+          case SubPoolNotificationCommandProcessed:
+            _subPoolManagersWithPendingCommand.erase(manager);
+            break;
+          default:
+            assertion2( false, notifications[i], manager );
+            break;
+        }
+      }
+
+      MPI_Iprobe( MPI_ANY_SOURCE, _subPoolControlTag, Node::getInstance().getCommunicator(), &flag, &status );
+    }
+
+    logTraceOut( "receiveSubPoolNotifications()" );
+  }
+  #endif
+}
+
+
+void tarch::parallel::NodePool::sendSubPoolCommand(int manager, int command, int argument) {
+  #ifdef Parallel
+  assertion1( Node::getInstance().isGlobalMaster(), Node::getInstance().getRank() );
+  assertion3( getSubPoolManager(manager,_ranksPerSubPool)==manager, manager, command, argument );
+
+  int message[] = {command, argument};
+  MPI_Send( message, 2, MPI_INT, manager, _subPoolControlTag, Node::getInstance().getCommunicator() );
+  _subPoolManagersWithPendingCommand.insert(manager);
+  #endif
+}
+
+
+void tarch::parallel::NodePool::sendSubPoolCommandToAllManagers(int command, int argument) {
+  #ifdef Parallel
+  logTraceInWith2Arguments( "sendSubPoolCommandToAllManagers(int,int)", command, argument );
+
+  waitForSubPoolCommandsToBeProcessed();
+
+  for (int manager=_ranksPerSubPool; manager<Node::getInstance().getNumberOfNodes(); manager+=_ranksPerSubPool) {
+    sendSubPoolCommand( manager, command, argument );
+  }
+
+  waitForSubPoolCommandsToBeProcessed();
+
+  logTraceOut( "sendSubPoolCommandToAllManagers(int,int)" );
+  #endif
+}
+
+
+void tarch::parallel::NodePool::waitForSubPoolCommandsToBeProcessed() {
+  #ifdef Parallel
+  clock_t      timeOutWarning   = Node::getInstance().getDeadlockWarningTimeStamp();
+  clock_t      timeOutShutdown  = Node::getInstance().getDeadlockTimeOutTimeStamp();
+  bool         triggeredTimeoutWarning = false;
+
+  while ( !_subPoolManagersWithPendingCommand.empty() ) {
+    receiveDanglingMessages();
+
+    // deadlock aspect
+    if ( Node::getInstance().isTimeOutWarningEnabled() && (clock()>timeOutWarning) && (!triggeredTimeoutWarning)) {
+      Node::getInstance().writeTimeOutWarning( "tarch::parallel::NodePool", "waitForSubPoolCommandsToBeProcessed()", *_subPoolManagersWithPendingCommand.begin(), _subPoolControlTag, 1);
+      triggeredTimeoutWarning = true;
+    }
+    if ( Node::getInstance().isTimeOutDeadlockEnabled() && (clock()>timeOutShutdown)) {
+      Node::getInstance().triggerDeadlockTimeOut( "tarch::parallel::NodePool", "waitForSubPoolCommandsToBeProcessed()", *_subPoolManagersWithPendingCommand.begin(), _subPoolControlTag, 1 );
+    }
+  }
+  #endif
+}
+
+
+void tarch::parallel::NodePool::requestRanksFromSubPools(int numberOfRanks) {
+  if (_ranksPerSubPool>0 && numberOfRanks>0 && !_idleRanksOfSubPools.empty()) {
+    std::map<int,int> idleRanksPerManager;
+    for (int rank: _idleRanksOfSubPools) {
+      idleRanksPerManager[ getSubPoolManager(rank,_ranksPerSubPool) ]++;
+    }
+
+    int bestManager = -1;
+    for (const auto& p: idleRanksPerManager) {
+      if (
+        _subPoolManagersWithPendingCommand.count(p.first)==0
+        &&
+        (bestManager==-1 || p.second>idleRanksPerManager[bestManager])
+      ) {
+        bestManager = p.first;
+      }
+    }
+
+    if (bestManager!=-1) {
+      logInfo(
+        "requestRanksFromSubPools(int)",
+        "global master ran out of idle ranks. Ask sub-pool manager " << bestManager << " to return up to " <<
+        numberOfRanks << " of its " << idleRanksPerManager[bestManager] << " idle rank(s)"
+      );
+      sendSubPoolCommand( bestManager, SubPoolCommandReturnIdleRanks, numberOfRanks );
+    }
+  }
+}
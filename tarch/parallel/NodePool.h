@@ -7,10 +7,12 @@
 #include <mpi.h>
 #endif
 #include <vector>
+#include <set>
 #include <sstream>
 
 #include "tarch/parallel/MPIConstants.h"
 #include "tarch/parallel/NodePoolStrategy.h"
+#include "tarch/parallel/ProgressEngine.h"
 #include "tarch/services/Service.h"
 #include "tarch/logging/Log.h"
 
@@ -59,6 +61,51 @@ namespace tarch {
  * A detailed overview of the different message types and their semantics can
  * be found no the directory's page.
  *
+ * !!! Hierarchical node pool
+ *
+ * By default, all registration, job and worker requests are answered by the
+ * global master. With many ranks, the global master becomes a bottleneck, as
+ * it answers the requests one by one. If you call setRanksPerSubPool() with
+ * k>0 on all ranks before restart(), the ranks are split up into sub-pools of
+ * k contiguous ranks. The first rank of each sub-pool besides the first one
+ * becomes the sub-pool manager:
+ *
+ * - Ranks of a sub-pool send their job requests, i.e. their idle
+ *   notifications, to their manager. The manager holds them in its own
+ *   strategy (see setStrategy()) and activates them.
+ * - A rank asks its manager for workers first. Only if the manager runs dry,
+ *   the rank asks the global master for the remaining workers. Managers serve
+ *   their own requests from their sub-pool without any message.
+ * - The global master answers the requests of the first sub-pool and of the
+ *   managers, i.e. the managers' job requests go to the global master.
+ * - The global master keeps a mirror of the idle ranks of all sub-pools, so
+ *   isIdleNode(), getNumberOfIdleNodes() and broadcastToWorkingNodes() still
+ *   have a global view. A manager tells the global master that a rank is
+ *   idle after it has received the rank's job request. Before it activates a
+ *   rank, it tells the global master through a synchronous send. The global
+ *   master thus knows about all activations before they happen, as in the
+ *   flat pool.
+ * - If the global master runs out of idle ranks, it asks the manager with the
+ *   most idle ranks to return some of them. Returned ranks belong to the
+ *   global master from then on.
+ * - A manager terminates its sub-pool once the global master tells the
+ *   manager itself to terminate. The global master waits until the managers
+ *   have reported all ranks of their sub-pools as terminated.
+ *
+ * The sub-pools use their own tags, so messages of the managers and the
+ * global master do not interfere. Requests and answers use the same message
+ * types as the flat pool. Only the commands of the global master and the
+ * notifications of the managers are plain integer arrays.
+ *
+ * With a progress engine thread (MPIUsesItsOwnThread), the global master and
+ * the managers answer their requests through one polling routine.
+ *
+ * !!! Worker requests
+ *
+ * reserveFreeNodes() asks for all ranks in one WorkerRequestMessage. The
+ * answer is one NodePoolAnswerMessage per requested rank. It holds either a
+ * reserved rank or NoFreeNodesMessage.
+ *
  * @author Tobias Weinzierl
  * @version $Revision: 1.56 $
  */
@@ -91,6 +138,12 @@ class tarch::parallel::NodePool: public tarch::services::Service {
        * continue with Peano or ask again for a new job.
        */
       static const int RunAllNodes;
+
+      /**
+       * A sub-pool manager hands a rank over to the global master. The rank
+       * then sends its job requests to the global master.
+       */
+      static const int ReturnToGlobalMaster;
     };
 
 
@@ -110,6 +163,68 @@ class tarch::parallel::NodePool: public tarch::services::Service {
     int _jobManagementTag;
     int _jobServicesTag;
 
+    /**
+     * Job requests and activations between the ranks of a sub-pool and their
+     * manager.
+     */
+    int _subPoolJobManagementTag;
+
+    /**
+     * Worker requests and their answers between the ranks of a sub-pool and
+     * their manager.
+     */
+    int _subPoolJobServicesTag;
+
+    /**
+     * Commands of the global master to the managers and notifications of the
+     * managers to the global master. Both are plain integer arrays.
+     */
+    int _subPoolControlTag;
+
+    /**
+     * @see setRanksPerSubPool()
+     */
+    int _ranksPerSubPool;
+
+    /**
+     * Rank that answers this rank's job requests. This is the global master
+     * or the rank's sub-pool manager.
+     */
+    int _ownerRank;
+
+    /**
+     * Only used on sub-pool managers. Is false as soon as the global master
+     * has told the manager to terminate.
+     */
+    bool _subPoolIsAlive;
+
+    /**
+     * Only used on sub-pool managers. Counts the ranks that have been
+     * terminated or handed over to the global master. A manager may not
+     * terminate before all other ranks of its sub-pool have left.
+     */
+    int _numberOfRanksThatHaveLeftSubPool;
+
+    /**
+     * Sub-pool managers answer requests within receiveDanglingMessages().
+     * While they wait for a synchronous send to the global master, they call
+     * receiveDanglingMessages() again. The flag avoids that they answer
+     * requests recursively.
+     */
+    bool _isServingSubPool;
+
+    /**
+     * Only used on the global master. Idle ranks that belong to sub-pool
+     * managers.
+     */
+    std::set<int> _idleRanksOfSubPools;
+
+    /**
+     * Only used on the global master. Managers that have not yet acknowledged
+     * a command.
+     */
+    std::set<int> _subPoolManagersWithPendingCommand;
+
     #ifdef Asserts
     bool _isInitialised;
     #endif
@@ -132,6 +247,33 @@ class tarch::parallel::NodePool: public tarch::services::Service {
      */
     NodePoolStrategy* _strategy;
 
+    #ifdef MPIUsesItsOwnThread
+    /**
+     * Handle of the node pool's polling routine within the progress engine.
+     * Only the global master and the sub-pool managers register a routine,
+     * as only they answer requests. The routine is replyToMessages().
+     *
+     * @see tarch::parallel::ProgressEngine
+     */
+    int _progressEngineHandle;
+    #endif
+
+    /**
+     * Pause the polling through the progress engine.
+     *
+     * The progress engine's routine alters the strategy and the node pool's
+     * attributes. All operations that read or write them from outside the
+     * routine thus have to pause the routine first. The operations are
+     * const, as the queries such as getNumberOfIdleNodes() have to use them,
+     * too. If the routine itself ends up here, there is nothing to pause.
+     * Pauses nest, so several threads may query the pool at the same time.
+     *
+     * @return Token that you have to hand over to resumeBackgroundReceives().
+     * @see ProgressEngine::pausePollingRoutine()
+     */
+    int suspendBackgroundReceives() const;
+    void resumeBackgroundReceives(int pauseToken) const;
+
     /**
      * The operation reserves the number of a free process, if there's one.
      * Afterwards this free process is sent an activation message and the number
@@ -200,9 +342,114 @@ class tarch::parallel::NodePool: public tarch::services::Service {
     void replyToJobRequestMessages();
     void replyToWorkerRequestMessages();
 
+    /**
+     * Answer all requests this rank is responsible for, i.e. those of the
+     * flat pool on the global master and those of the sub-pool on a
+     * manager. This is the body of receiveDanglingMessages() and of the
+     * progress engine's polling routine.
+     */
+    void replyToMessages();
+
     void emptyRegisterMessageReceiveBuffer();
     void emptyJobRequestMessageBuffer();
     void emptyWorkerRequestMessageBuffer();
+    void emptySubPoolMessageBuffers();
+
+    /**
+     * A job request might overtake the registration of a rank. In this case,
+     * we answer registration messages until the rank has registered.
+     */
+    void waitForRegistration(int rank);
+
+    /**
+     * Answer a worker request, i.e. send one NodePoolAnswerMessage per
+     * requested rank. If there are fewer reserved ranks than requested ones,
+     * the remaining answers carry NoFreeNodesMessage.
+     */
+    void sendReservedNodes(const std::vector<int>& ranks, int numberOfRequestedRanks, int destination, int tag);
+
+    /**
+     * Counterpart of sendReservedNodes(). Answers dangling messages while it
+     * waits.
+     */
+    std::vector<int> receiveReservedNodes(int source, int tag, int numberOfRequestedRanks);
+
+    /**
+     * Ask the global master for workers. This is the flat variant of
+     * reserveFreeNodesForClient().
+     */
+    std::vector<int> reserveFreeNodesFromGlobalMaster(int numberOfRanksWanted);
+
+    /**
+     * @return Is this rank the manager of a sub-pool besides the first one?
+     */
+    bool isSubPoolManager() const;
+
+    /**
+     * First and last rank (exclusive) of the local manager's sub-pool.
+     */
+    int getFirstRankOfSubPool() const;
+    int getLastRankOfSubPool() const;
+
+    /**
+     * Reserve idle ranks of the local sub-pool for a master, tell the global
+     * master about it and activate the ranks. Only called on sub-pool
+     * managers.
+     */
+    std::vector<int> reserveFreeNodesOfSubPool(int forMaster, int numberOfRanksWanted);
+
+    /**
+     * Manager-side counterparts of the reply operations of the global
+     * master.
+     */
+    void replyToSubPoolMessages();
+    void replyToSubPoolJobRequestMessages();
+    void replyToSubPoolWorkerRequestMessages();
+    void replyToSubPoolCommands();
+
+    /**
+     * Tell all idle ranks of the local sub-pool to terminate. Ranks that are
+     * still working are told to terminate as soon as they send their next
+     * job request.
+     */
+    void terminateSubPool();
+
+    /**
+     * Global-master side: Receive the managers' notifications and update
+     * the mirror of idle ranks.
+     */
+    void receiveSubPoolNotifications();
+
+    /**
+     * Global-master side: Send a command to one manager.
+     */
+    void sendSubPoolCommand(int manager, int command, int argument);
+
+    /**
+     * Global-master side: Send a command to all managers and wait until they
+     * have acknowledged it.
+     */
+    void sendSubPoolCommandToAllManagers(int command, int argument);
+
+    /**
+     * Global-master side: Wait until all managers have acknowledged their
+     * commands. terminate() uses it, as a manager that is told to terminate
+     * would not pick up a command anymore.
+     */
+    void waitForSubPoolCommandsToBeProcessed();
+
+    /**
+     * Global-master side: Ask the manager with the most idle ranks to return
+     * up to numberOfRanks ranks.
+     */
+    void requestRanksFromSubPools(int numberOfRanks);
+
+    /**
+     * Manager side: Send notifications to the global master through a
+     * synchronous send, i.e. the global master has received them when the
+     * operation returns.
+     */
+    void sendSubPoolNotifications(const std::vector<int>& notifications);
 
     /**
      * Only the master is allowed to call this operation.
@@ -282,6 +529,18 @@ class tarch::parallel::NodePool: public tarch::services::Service {
      * queries are usually only answered if the node pool is waiting for any
      * message.
      *
+     * Only the request is batched: One WorkerRequestMessage asks for all
+     * numberOfRanksWanted ranks. The answer is not batched. The global master
+     * or the sub-pool manager sends one NodePoolAnswerMessage per requested
+     * rank, each of them through a blocking send, and answers the ranks it
+     * cannot serve with NoFreeNodesMessage (see sendReservedNodes()). A
+     * request for n ranks thus costs n+1 messages. If the local manager
+     * cannot serve all of them, the requesting rank pays this once more for
+     * the remainder at the global master. The global master and the sub-pool
+     * managers serve their own requests from their pools without any request
+     * or answer message, but a manager that runs dry asks the global master
+     * like any other rank.
+     *
      * @return Set of integers. Though the result is a set, we return a vector
      *               as the order makes a difference, too.
      */
@@ -326,9 +585,29 @@ class tarch::parallel::NodePool: public tarch::services::Service {
      * later on). Please ensure that the node pool is shut down before you
      * reset the strategy, i.e. that you've called terminate and the
      * corresponding wait. After you've set a new strategy, call restart().
+     *
+     * Sub-pool managers may set a strategy for their sub-pool, too. If they
+     * do not, restart() equips them with an FCFS strategy.
      */
     void setStrategy(NodePoolStrategy* strategy);
 
+    /**
+     * Switch to a hierarchical node pool
+     *
+     * Has to be called with the same argument on all ranks before restart().
+     * 0 switches back to the flat node pool, which is the default. See the
+     * class documentation.
+     */
+    void setRanksPerSubPool(int ranksPerSubPool);
+
+    int getRanksPerSubPool() const;
+
+    /**
+     * @return Rank that manages the sub-pool of rank. This is the global
+     *         master for the first sub-pool or if there are no sub-pools.
+     */
+    static int getSubPoolManager(int rank, int ranksPerSubPool);
+
     /**
      * Tag for Fork Message
      *
@@ -373,6 +652,10 @@ class tarch::parallel::NodePool: public tarch::services::Service {
      * operations always returns 1.
      */
     int getNumberOfWorkingNodes() const;
+
+    /**
+     * Number of idle ranks including the idle ranks of all sub-pools.
+     */
     int getNumberOfIdleNodes() const;
 
     /**
@@ -408,9 +691,15 @@ class tarch::parallel::NodePool: public tarch::services::Service {
      * This routine wakes up all idle nodes and sends them a new master with
      * the flag RunAllNodes. Typically they do something and then immediately
      * afterwards register themselves as idle again.
+     *
+     * In a hierarchical pool, the managers wake up the idle ranks of their
+     * sub-pools. The operation returns once all managers have done so.
      */
     void activateIdleNodes();
 
+    /**
+     * On the global master, this includes the idle ranks of the sub-pools.
+     */
     bool isIdleNode( int rank ) const;
 
     /**
@@ -0,0 +1,386 @@
+#include "tarch/parallel/ProgressEngine.h"
+#include "tarch/parallel/Node.h"
+#include "tarch/multicore/Lock.h"
+#include "tarch/Assertions.h"
+
+
+#include "tarch/compiler/CompilerSpecificSettings.h"
+
+
+#ifdef MPIUsesItsOwnThread
+#include <thread>
+#ifdef CompilerHasSysinfo
+#include <sched.h>
+#endif
+#endif
+
+
+#include "tarch/services/ServiceFactory.h"
+registerService(tarch::parallel::ProgressEngine)
+
+
+tarch::logging::Log  tarch::parallel::ProgressEngine::_log( "tarch::parallel::ProgressEngine" );
+
+
+namespace {
+  /**
+   * Is set by the engine's thread once it starts up.
+   */
+  thread_local bool isProgressThread = false;
+}
+
+
+tarch::parallel::ProgressEngine::ProgressEngine():
+  _pollingRoutinesSemaphore(),
+  _requestsSemaphore(),
+  _pollingRoutines(),
+  _pendingRequests(),
+  _nextHandle(0),
+  _pinCore(NoPinning),
+  _state(State::NotStarted),
+  _numberOfPollingSweeps(0),
+  _numberOfCompletedRequests(0)
+  #ifdef MPIUsesItsOwnThread
+  ,
+  _wakeUpMutex(),
+  _wakeUpCondition(),
+  _numberOfWakeUps(0)
+  #endif
+  {
+}
+
+
+tarch::parallel::ProgressEngine::~ProgressEngine() {
+  if (_state.load()==State::Running) {
+    std::cerr << "progress engine on rank " << tarch::parallel::Node::getInstance().getRank() << " is still running. Would be nicer to call shutdown() on ProgressEngine." << std::endl;
+  }
+}
+
+
+tarch::parallel::ProgressEngine& tarch::parallel::ProgressEngine::getInstance() {
+  static tarch::parallel::ProgressEngine singleton;
+  return singleton;
+}
+
+
+std::string tarch::parallel::ProgressEngine::toString(State state) {
+  switch (state) {
+    case State::NotStarted:
+      return "not-started";
+    case State::Running:
+      return "running";
+    case State::TerminateTriggered:
+      return "terminate-triggered";
+    case State::Terminated:
+      return "terminated";
+  }
+  return "<undef>";
+}
+
+
+bool tarch::parallel::ProgressEngine::usesDedicatedThread() const {
+  #ifdef MPIUsesItsOwnThread
+  return true;
+  #else
+  return false;
+  #endif
+}
+
+
+void tarch::parallel::ProgressEngine::pinToCore( int core ) {
+  assertion1( core>=0 || core==NoPinning, core );
+  if (_state.load()!=State::NotStarted) {
+    logWarning( "pinToCore(int)", "progress thread is already running (state=" << toString(_state.load()) << "). Pinning will be ignored" );
+  }
+  _pinCore = core;
+}
+
+
+void tarch::parallel::ProgressEngine::startThreadIfNotYetRunning() {
+  #ifdef MPIUsesItsOwnThread
+  State expected = State::NotStarted;
+  if ( _state.compare_exchange_strong(expected,State::Running) ) {
+    logInfo( "startThreadIfNotYetRunning()", "launch progress thread (pin=" << _pinCore << ")" );
+    std::thread t( [this]() -> void { runThread(); } );
+    t.detach();
+  }
+  #endif
+}
+
+
+void tarch::parallel::ProgressEngine::runThread() {
+  isProgressThread = true;
+
+  #if defined(MPIUsesItsOwnThread) && defined(CompilerHasSysinfo)
+  if (_pinCore!=NoPinning) {
+    cpu_set_t mask;
+    CPU_ZERO( &mask );
+    CPU_SET( _pinCore % std::thread::hardware_concurrency(), &mask );
+    if ( sched_setaffinity( 0, sizeof(cpu_set_t), &mask )!=0 ) {
+      logWarning( "runThread()", "failed to pin progress thread to core " << _pinCore );
+    }
+  }
+  #endif
+
+  while (_state.load()==State::Running) {
+    #ifdef MPIUsesItsOwnThread
+    std::unique_lock<std::mutex> wakeUpLock(_wakeUpMutex);
+    const int numberOfWakeUps = _numberOfWakeUps;
+    wakeUpLock.unlock();
+    #endif
+
+    bool progress = completePendingRequests();
+
+    tarch::multicore::Lock lock(_pollingRoutinesSemaphore);
+    const int invokedPollingRoutines = invokeActivePollingRoutines();
+    lock.free();
+
+    #ifdef MPIUsesItsOwnThread
+    if (invokedPollingRoutines==0 && getNumberOfPendingRequests()==0) {
+      waitForWakeUp(numberOfWakeUps);
+    }
+    else if (!progress) {
+      std::this_thread::yield();
+    }
+    #endif
+  }
+
+  _state.store(State::Terminated);
+}
+
+
+void tarch::parallel::ProgressEngine::wakeUpThread() {
+  #ifdef MPIUsesItsOwnThread
+  std::unique_lock<std::mutex> lock(_wakeUpMutex);
+  _numberOfWakeUps++;
+  lock.unlock();
+  _wakeUpCondition.notify_all();
+  #endif
+}
+
+
+void tarch::parallel::ProgressEngine::waitForWakeUp(int numberOfWakeUps) {
+  #ifdef MPIUsesItsOwnThread
+  std::unique_lock<std::mutex> lock(_wakeUpMutex);
+  _wakeUpCondition.wait(
+    lock,
+    [this,numberOfWakeUps]() -> bool {
+      return _numberOfWakeUps!=numberOfWakeUps || _state.load()!=State::Running;
+    }
+  );
+  #endif
+}
+
+
+int tarch::parallel::ProgressEngine::invokeActivePollingRoutines() {
+  int result = 0;
+  for (auto& p: _pollingRoutines) {
+    if (p.second.active && p.second.pauses==0) {
+      p.second.routine();
+      result++;
+    }
+  }
+  _numberOfPollingSweeps.fetch_add(1);
+  return result;
+}
+
+
+bool tarch::parallel::ProgressEngine::completePendingRequests() {
+  bool result = false;
+
+  #ifdef Parallel
+  std::list<PendingRequest> completedRequests;
+
+  tarch::multicore::Lock lock(_requestsSemaphore);
+  std::list<PendingRequest>::iterator p = _pendingRequests.begin();
+  while (p!=_pendingRequests.end()) {
+    int flag = 0;
+    MPI_Test( &(p->request), &flag, MPI_STATUS_IGNORE );
+    if (flag) {
+      completedRequests.push_back(*p);
+      p = _pendingRequests.erase(p);
+    }
+    else {
+      p++;
+    }
+  }
+  lock.free();
+
+  // We spawn the continuations outside of the lock, as spawning might
+  // process the job immediately and the job in turn might add requests.
+  for (auto& p: completedRequests) {
+    if (p.continuation!=nullptr) {
+      tarch::multicore::jobs::spawnBackgroundJob( p.continuation );
+    }
+    _numberOfCompletedRequests.fetch_add(1);
+    result = true;
+  }
+  #endif
+
+  return result;
+}
+
+
+int tarch::parallel::ProgressEngine::registerPollingRoutine( const std::string& name, const PollingRoutine& routine, bool active ) {
+  tarch::multicore::Lock lock(_pollingRoutinesSemaphore);
+  const int handle = _nextHandle;
+  _nextHandle++;
+  PollingRoutineEntry newEntry;
+  newEntry.name    = name;
+  newEntry.routine = routine;
+  newEntry.active  = active;
+  newEntry.pauses  = 0;
+  _pollingRoutines.insert( std::pair<int,PollingRoutineEntry>(handle,newEntry) );
+  lock.free();
+
+  wakeUpThread();
+
+  logDebug( "registerPollingRoutine(...)", "registered " << name << " with handle " << handle );
+
+  startThreadIfNotYetRunning();
+
+  return handle;
+}
+
+
+void tarch::parallel::ProgressEngine::deregisterPollingRoutine( int handle ) {
+  tarch::multicore::Lock lock(_pollingRoutinesSemaphore);
+  assertion1( _pollingRoutines.count(handle)==1, handle );
+  _pollingRoutines.erase(handle);
+}
+
+
+void tarch::parallel::ProgressEngine::suspendPollingRoutine( int handle ) {
+  tarch::multicore::Lock lock(_pollingRoutinesSemaphore);
+  assertion1( _pollingRoutines.count(handle)==1, handle );
+  _pollingRoutines[handle].active = false;
+}
+
+
+void tarch::parallel::ProgressEngine::activatePollingRoutine( int handle ) {
+  tarch::multicore::Lock lock(_pollingRoutinesSemaphore);
+  assertion1( _pollingRoutines.count(handle)==1, handle );
+  _pollingRoutines[handle].active = true;
+  lock.free();
+
+  wakeUpThread();
+}
+
+
+bool tarch::parallel::ProgressEngine::isPollingRoutineActive( int handle ) const {
+  // The engine's thread holds the semaphore while it runs the routines
+  tarch::multicore::Lock lock(_pollingRoutinesSemaphore,!isProgressThread);
+  assertion1( _pollingRoutines.count(handle)==1, handle );
+  return _pollingRoutines.at(handle).active;
+}
+
+
+int tarch::parallel::ProgressEngine::pausePollingRoutine( int handle ) {
+  if (handle==InvalidHandle || isProgressThread) {
+    return InvalidHandle;
+  }
+
+  tarch::multicore::Lock lock(_pollingRoutinesSemaphore);
+  assertion1( _pollingRoutines.count(handle)==1, handle );
+  _pollingRoutines[handle].pauses++;
+  return handle;
+}
+
+
+void tarch::parallel::ProgressEngine::resumePollingRoutine( int token ) {
+  if (token!=InvalidHandle) {
+    tarch::multicore::Lock lock(_pollingRoutinesSemaphore);
+    assertion1( _pollingRoutines.count(token)==1, token );
+    assertion1( _pollingRoutines[token].pauses>0, token );
+    _pollingRoutines[token].pauses--;
+    lock.free();
+
+    wakeUpThread();
+  }
+}
+
+
+bool tarch::parallel::ProgressEngine::isInvokedByProgressThread() const {
+  return isProgressThread;
+}
+
+
+void tarch::parallel::ProgressEngine::addRequest( MPI_Request request, tarch::multicore::jobs::Job* continuation ) {
+  PendingRequest newRequest;
+  newRequest.request      = request;
+  newRequest.continuation = continuation;
+
+  tarch::multicore::Lock lock(_requestsSemaphore);
+  _pendingRequests.push_back(newRequest);
+  lock.free();
+
+  startThreadIfNotYetRunning();
+  wakeUpThread();
+}
+
+
+int tarch::parallel::ProgressEngine::getNumberOfPendingRequests() {
+  tarch::multicore::Lock lock(_requestsSemaphore);
+  return static_cast<int>(_pendingRequests.size());
+}
+
+
+void tarch::parallel::ProgressEngine::receiveDanglingMessages() {
+  if (!usesDedicatedThread() || _state.load()!=State::Running) {
+    completePendingRequests();
+  }
+}
+
+
+void tarch::parallel::ProgressEngine::shutdown() {
+  logTraceInWith1Argument( "shutdown()", toString(_state.load()) );
+
+  State expected = State::Running;
+  if ( _state.compare_exchange_strong(expected,State::TerminateTriggered) ) {
+    wakeUpThread();
+    while (_state.load()!=State::Terminated) {
+      #ifdef MPIUsesItsOwnThread
+      std::this_thread::yield();
+      #endif
+    }
+  }
+
+  const clock_t  timeOutWarning          = tarch::parallel::Node::getInstance().getDeadlockWarningTimeStamp();
+  const clock_t  timeOutShutdown         = tarch::parallel::Node::getInstance().getDeadlockTimeOutTimeStamp();
+  bool           triggeredTimeoutWarning = false;
+
+  while ( getNumberOfPendingRequests()>0 ) {
+    completePendingRequests();
+
+    if (
+       tarch::parallel::Node::getInstance().isTimeOutWarningEnabled() &&
+       (clock()>timeOutWarning) &&
+       (!triggeredTimeoutWarning)
+    ) {
+       tarch::parallel::Node::getInstance().writeTimeOutWarning(
+         "tarch::parallel::ProgressEngine", "shutdown()", -1, -1, getNumberOfPendingRequests()
+       );
+       triggeredTimeoutWarning = true;
+    }
+    if (
+       tarch::parallel::Node::getInstance().isTimeOutDeadlockEnabled() &&
+       (clock()>timeOutShutdown)
+    ) {
+       tarch::parallel::Node::getInstance().triggerDeadlockTimeOut(
+         "tarch::parallel::ProgressEngine", "shutdown()", -1, -1, getNumberOfPendingRequests()
+       );
+    }
+  }
+
+  logTraceOut( "shutdown()" );
+}
+
+
+void tarch::parallel::ProgressEngine::plotStatistics() const {
+  logInfo( "plotStatistics()", "state=" << toString(_state.load()) << ", dedicated-thread=" << usesDedicatedThread() << ", pin=" << _pinCore );
+  logInfo( "plotStatistics()", "number of polling sweeps: " << _numberOfPollingSweeps.load() );
+  logInfo( "plotStatistics()", "number of completed requests: " << _numberOfCompletedRequests.load() );
+  for (auto& p: _pollingRoutines) {
+    logInfo( "plotStatistics()", "polling routine " << p.first << ": " << p.second.name << " (active=" << p.second.active << ",pauses=" << p.second.pauses << ")" );
+  }
+}
@@ -0,0 +1,326 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_PARALLEL_PROGRESS_ENGINE_H_
+#define _TARCH_PARALLEL_PROGRESS_ENGINE_H_
+
+
+#include "tarch/parallel/MPIConstants.h"
+#include "tarch/logging/Log.h"
+#include "tarch/services/Service.h"
+#include "tarch/multicore/MulticoreDefinitions.h"
+#include "tarch/multicore/BooleanSemaphore.h"
+#include "tarch/multicore/Jobs.h"
+
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+
+
+/**
+ * With this ifdef, we can define whether the progress engine shall use a
+ * dedicated thread to poll the MPI queues in the background. If it is not
+ * set, all polling is done by the thread calling receiveDanglingMessages().
+ */
+#if defined(SharedMemoryParallelisation) && defined(MultipleThreadsMayTriggerMPICalls) && defined(Parallel) && !defined(noMPIUsesItsOwnThread) && !defined(MPIUsesItsOwnThread)
+#define MPIUsesItsOwnThread
+#endif
+
+
+#ifdef MPIUsesItsOwnThread
+#include <condition_variable>
+#include <mutex>
+#endif
+
+
+namespace tarch {
+  namespace parallel {
+    class ProgressEngine;
+
+    namespace tests {
+      class ProgressEngineTest;
+    }
+  }
+}
+
+
+/**
+ * Communication Progress Engine
+ *
+ * Before this class has been introduced, the heaps' boundary data exchangers
+ * and the SendReceiveBufferPool each spawned a background thread of their own
+ * that polled the MPI queues. Progress for all other communication relied on
+ * somebody calling receiveDanglingMessages(). The progress engine unifies
+ * these threads: There's one thread per rank that owns all the MPI_Test and
+ * MPI_Iprobe polling. Components that want to receive data in the background
+ * register a polling routine. They keep the handle and may suspend or
+ * reactivate their routine whenever they have to access their data
+ * structures themselves.
+ *
+ * <h2> Polling routines </h2>
+ *
+ * A polling routine is a functor that checks the MPI queues for one
+ * component and receives what is available. It should never block. The
+ * engine's thread runs through all active routines in a round-robin fashion.
+ * While it runs through the routines, it holds the engine's semaphore. If a
+ * component suspends its routine, we thus know that the routine is not
+ * running anymore once suspendPollingRoutine() returns.
+ *
+ * There are two ways to switch a routine off. The component that registers
+ * the routine uses activatePollingRoutine() and suspendPollingRoutine() to
+ * say whether there is anything to receive in the background at all, i.e.
+ * typically outside of the traversal. Any thread that wants to run the
+ * receive loop of a component itself uses pausePollingRoutine() and
+ * resumePollingRoutine() instead. Pauses nest: The engine invokes the
+ * routine only if it is active and all pauses have been resumed. Several
+ * threads thus may run the receive loop of the same component at the same
+ * time without the first one to finish handing the loop back to the engine
+ * while the others are still receiving.
+ *
+ * A routine may use blocking sends or receives of the generated messages.
+ * These poll through tarch::parallel::Node::receiveDanglingMessages() while
+ * they wait. On the engine's thread, this polling does not dive into the
+ * services again, as the services would try to suspend their routines and
+ * thus wait for the semaphore that the thread itself holds.
+ *
+ * <h2> Requests and continuations </h2>
+ *
+ * Besides the polling routines, the engine can also complete MPI requests.
+ * You hand over a request plus a job. As soon as the MPI_Test on the request
+ * succeeds, the engine spawns the job as background job. The ownership of the
+ * job goes over to the engine. This is the way to realise a continuation.
+ *
+ * <h2> Threading </h2>
+ *
+ * The engine uses a dedicated thread if and only if MPIUsesItsOwnThread is
+ * defined. This requires MPI_THREAD_MULTIPLE (see tarch::parallel::Node::init()).
+ * With MPI_THREAD_FUNNELED or MPI_THREAD_SERIALIZED, a second thread may not
+ * issue MPI calls. In this case, the engine is driven by the services
+ * (receiveDanglingMessages()) which are called by the main thread, i.e. the
+ * progress engine then realises the same behaviour as before without any
+ * thread of its own.
+ *
+ * The thread is created lazily once the first polling routine is registered,
+ * as the engine is a singleton and might be created before the multicore
+ * environment is up. You can pin it to a core through pinToCore().
+ *
+ * If no routine may be invoked and there are no pending requests, the thread
+ * does not spin but sleeps until a routine is registered, activated or
+ * resumed, or a request is added.
+ */
+class tarch::parallel::ProgressEngine: public tarch::services::Service {
+  private:
+    friend class tarch::parallel::tests::ProgressEngineTest;
+  public:
+    typedef std::function<void()>  PollingRoutine;
+
+    static constexpr int NoPinning       = -1;
+    static constexpr int InvalidHandle   = -1;
+  private:
+    static tarch::logging::Log _log;
+
+    enum class State {
+      NotStarted,
+      Running,
+      TerminateTriggered,
+      Terminated
+    };
+
+    struct PollingRoutineEntry {
+      std::string     name;
+      PollingRoutine  routine;
+      bool            active;
+      /**
+       * Number of pauses that have not been resumed yet.
+       */
+      int             pauses;
+    };
+
+    struct PendingRequest {
+      MPI_Request                     request;
+      tarch::multicore::jobs::Job*    continuation;
+    };
+
+    /**
+     * Protects the polling routines. The engine's thread holds this semaphore
+     * while it runs through the routines.
+     */
+    mutable tarch::multicore::BooleanSemaphore  _pollingRoutinesSemaphore;
+
+    /**
+     * Protects the list of pending requests.
+     */
+    tarch::multicore::BooleanSemaphore          _requestsSemaphore;
+
+    std::map<int,PollingRoutineEntry>           _pollingRoutines;
+    std::list<PendingRequest>                   _pendingRequests;
+
+    int                                         _nextHandle;
+    int                                         _pinCore;
+
+    std::atomic<State>                          _state;
+
+    /**
+     * Statistics. Only used for plotStatistics().
+     */
+    std::atomic<int>                            _numberOfPollingSweeps;
+    std::atomic<int>                            _numberOfCompletedRequests;
+
+    #ifdef MPIUsesItsOwnThread
+    /**
+     * The thread sleeps on this condition if there is nothing to do. We
+     * count the wake-ups, so the thread can tell whether anything has
+     * happened since it last checked for work.
+     */
+    std::mutex                                  _wakeUpMutex;
+    std::condition_variable                     _wakeUpCondition;
+    int                                         _numberOfWakeUps;
+    #endif
+
+    ProgressEngine();
+    ProgressEngine(const ProgressEngine&) = delete;
+    ProgressEngine& operator=(const ProgressEngine&) = delete;
+
+    /**
+     * Lazily kick off the thread. Nop if MPIUsesItsOwnThread is not set.
+     */
+    void startThreadIfNotYetRunning();
+
+    /**
+     * Body of the progress thread.
+     */
+    void runThread();
+
+    /**
+     * Run once through all active polling routines that are not paused. The
+     * caller is responsible to hold _pollingRoutinesSemaphore.
+     *
+     * @return Number of routines invoked.
+     */
+    int invokeActivePollingRoutines();
+
+    /**
+     * Tell the thread that there might be something to do. Nop if
+     * MPIUsesItsOwnThread is not set.
+     */
+    void wakeUpThread();
+
+    /**
+     * Let the thread sleep until wakeUpThread() has been called after the
+     * numberOfWakeUps-th time or the engine shuts down.
+     */
+    void waitForWakeUp(int numberOfWakeUps);
+
+    /**
+     * Test all pending requests and spawn the continuations of those which
+     * have completed.
+     *
+     * @return Has there been a request that has completed.
+     */
+    bool completePendingRequests();
+
+    static std::string toString(State state);
+  public:
+    ~ProgressEngine();
+
+    static ProgressEngine& getInstance();
+
+    /**
+     * Register a polling routine
+     *
+     * @param name    Only used for debug and statistics output.
+     * @param active  Shall the routine be invoked in the background
+     *                immediately.
+     * @return Handle that you have to store to switch the routine on and off
+     *         or to deregister it.
+     */
+    int registerPollingRoutine( const std::string& name, const PollingRoutine& routine, bool active );
+
+    /**
+     * Removes the routine. Once this operation returns, the routine is not
+     * invoked anymore, i.e. you may destroy whatever it refers to.
+     */
+    void deregisterPollingRoutine( int handle );
+
+    /**
+     * Tell the engine that the routine shall not be invoked anymore until
+     * activatePollingRoutine() is called. If the routine currently is
+     * running, the operation waits until the routine has finished.
+     */
+    void suspendPollingRoutine( int handle );
+    void activatePollingRoutine( int handle );
+    bool isPollingRoutineActive( int handle ) const;
+
+    /**
+     * Keep the engine from invoking a routine until resumePollingRoutine()
+     * is called with the token returned. Use this pair whenever a thread
+     * runs a component's receive loop itself. Pauses nest and do not alter
+     * whether the routine is active, i.e. you may call the operation without
+     * checking the routine's state first. If the routine currently is
+     * running, the operation waits until the routine has finished.
+     *
+     * If the engine's thread calls the operation, i.e. a polling routine,
+     * or if the handle is InvalidHandle, there is nothing to pause.
+     *
+     * @return Token which you have to hand over to resumePollingRoutine().
+     *         InvalidHandle if nothing has been paused.
+     */
+    int pausePollingRoutine( int handle );
+
+    /**
+     * Counterpart of pausePollingRoutine(). Nop for InvalidHandle.
+     */
+    void resumePollingRoutine( int token );
+
+    /**
+     * @return Whether the calling thread is the engine's thread, i.e. whether
+     *         we are inside a polling routine. Always false if the engine has
+     *         no thread of its own.
+     */
+    bool isInvokedByProgressThread() const;
+
+    /**
+     * Hand over a request plus a continuation. The engine tests the request
+     * whenever it polls. Once the request has completed, the continuation is
+     * spawned as background job. The engine takes over the ownership of the
+     * continuation.
+     *
+     * If you hand in nullptr, the engine only completes the request.
+     */
+    void addRequest( MPI_Request request, tarch::multicore::jobs::Job* continuation );
+
+    int getNumberOfPendingRequests();
+
+    /**
+     * Pin the progress thread. Has to be called before the first polling
+     * routine is registered, as the thread is launched lazily and pins
+     * itself when it starts up.
+     */
+    void pinToCore( int core );
+
+    /**
+     * @return Whether the engine has a thread of its own.
+     */
+    bool usesDedicatedThread() const;
+
+    /**
+     * If the engine has no thread of its own, the services drive the engine
+     * through this operation, i.e. we complete pending requests. The polling
+     * routines are not invoked as all components poll their MPI queues
+     * anyway through their own receiveDanglingMessages().
+     */
+    void receiveDanglingMessages() override;
+
+    /**
+     * Terminate the thread and wait for it to go down. Should be called
+     * before MPI is shut down. Pending requests are completed first.
+     */
+    void shutdown();
+
+    void plotStatistics() const;
+};
+
+
+#endif
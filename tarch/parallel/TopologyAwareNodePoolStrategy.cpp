@@ -0,0 +1,206 @@
+#include "tarch/parallel/TopologyAwareNodePoolStrategy.h"
+#include "tarch/parallel/Node.h"
+#include "tarch/Assertions.h"
+
+
+tarch::logging::Log tarch::parallel::TopologyAwareNodePoolStrategy::_log( "tarch::parallel::TopologyAwareNodePoolStrategy" );
+
+
+tarch::parallel::TopologyAwareNodePoolStrategy::TopologyAwareNodePoolStrategy(int ranksPerSocket):
+  FCFSNodePoolStrategy(),
+  _ranksPerSocket(ranksPerSocket),
+  _socketOfRank(),
+  _hostOfGlobalMaster() {
+  assertion1( ranksPerSocket>=0, ranksPerSocket );
+}
+
+
+tarch::parallel::TopologyAwareNodePoolStrategy::~TopologyAwareNodePoolStrategy() {
+}
+
+
+std::string tarch::parallel::TopologyAwareNodePoolStrategy::extractHostName(const std::string& nodeName) {
+  const std::string::size_type openingBracket = nodeName.find('[');
+  const std::string::size_type closingBracket = nodeName.find(']');
+  if (
+    openingBracket!=std::string::npos &&
+    closingBracket!=std::string::npos &&
+    openingBracket<closingBracket
+  ) {
+    return nodeName.substr(openingBracket+1,closingBracket-openingBracket-1);
+  }
+
+  // Without CompilerHasUTSName, the machine information holds the rank only
+  if (nodeName.find("rank:")==0) {
+    return "";
+  }
+
+  const std::string::size_type rankInformation = nodeName.find(",rank:");
+  return nodeName.substr(0,rankInformation);
+}
+
+
+void tarch::parallel::TopologyAwareNodePoolStrategy::setNodePoolTag(int tag) {
+  FCFSNodePoolStrategy::setNodePoolTag(tag);
+
+  #ifdef Parallel
+  _hostOfGlobalMaster = extractHostName( _log.getMachineInformation() );
+  if (_hostOfGlobalMaster.empty()) {
+    logWarning( "setNodePoolTag(int)", "host names are not available (code has been translated without CompilerHasUTSName). Strategy cannot group ranks by host and hands out the idle rank with the smallest number" );
+  }
+  else {
+    logInfo( "setNodePoolTag(int)", "global master runs on host " << _hostOfGlobalMaster );
+  }
+  #endif
+}
+
+
+void tarch::parallel::TopologyAwareNodePoolStrategy::addNode(const tarch::parallel::messages::RegisterAtNodePoolMessage& node) {
+  #ifdef Parallel
+  addNode(
+    node.getSenderRank(),
+    tarch::parallel::StringTools::convert(node.getNodeName())
+  );
+  #endif
+}
+
+
+void tarch::parallel::TopologyAwareNodePoolStrategy::addNode(int rank, const std::string& nodeName) {
+  logTraceInWith2Arguments( "addNode(int,std::string)", rank, nodeName );
+  assertion1( !isRegisteredNode(rank), rank );
+
+  NodePoolListEntry newEntry( rank, extractHostName(nodeName) );
+  _nodes.push_back( newEntry );
+  _nodes.sort();
+
+  logTraceOutWith1Argument( "addNode(int,std::string)", newEntry.toString() );
+}
+
+
+void tarch::parallel::TopologyAwareNodePoolStrategy::setSocket(int rank, int socket) {
+  assertion2( rank>=0, rank, socket );
+  assertion2( socket>=0, rank, socket );
+  _socketOfRank[rank] = socket;
+}
+
+
+int tarch::parallel::TopologyAwareNodePoolStrategy::getSocket(int rank) const {
+  if (_socketOfRank.count(rank)>0) {
+    return _socketOfRank.at(rank);
+  }
+  else if (_ranksPerSocket>0 && rank>=0) {
+    return rank / _ranksPerSocket;
+  }
+  else {
+    return -1;
+  }
+}
+
+
+std::string tarch::parallel::TopologyAwareNodePoolStrategy::getHost(int rank) const {
+  for (const auto& p: _nodes) {
+    if (p.getRank()==rank) {
+      return p.getNodeName();
+    }
+  }
+
+  #ifdef Parallel
+  if (rank==Node::getGlobalMasterRank()) {
+    return _hostOfGlobalMaster;
+  }
+  #endif
+
+  return "";
+}
+
+
+int tarch::parallel::TopologyAwareNodePoolStrategy::getNumberOfIdleNodes(const std::string& host) const {
+  int result = 0;
+  for (
+    NodeContainer::const_iterator p = _nodes.begin();
+    p != _nodes.end() && p->isIdle();
+    p++
+  ) {
+    if (p->getNodeName()==host) {
+      result++;
+    }
+  }
+  return result;
+}
+
+
+tarch::parallel::TopologyAwareNodePoolStrategy::NodeContainer::iterator tarch::parallel::TopologyAwareNodePoolStrategy::findBestIdleNode(int forMaster) {
+  const std::string masterHost   = forMaster==AnyMaster ? "" : getHost(forMaster);
+  const int         masterSocket = forMaster==AnyMaster ? -1 : getSocket(forMaster);
+
+  // Idle nodes are at the front of the list. We compare them
+  // lexicographically: same socket, same host, number of idle nodes on the
+  // node's host, and finally small ranks.
+  std::map<std::string,int> idleNodesPerHost;
+  for (
+    NodeContainer::const_iterator p = _nodes.begin();
+    p != _nodes.end() && p->isIdle();
+    p++
+  ) {
+    idleNodesPerHost[p->getNodeName()]++;
+  }
+
+  NodeContainer::iterator result              = _nodes.end();
+  int                     bestLocality        = -1;
+  int                     bestIdleNodesOnHost = -1;
+
+  for (
+    NodeContainer::iterator p = _nodes.begin();
+    p != _nodes.end() && p->isIdle();
+    p++
+  ) {
+    int locality = 0;
+    if (!masterHost.empty() && p->getNodeName()==masterHost) {
+      locality = 1;
+      if (masterSocket>=0 && getSocket(p->getRank())==masterSocket) {
+        locality = 2;
+      }
+    }
+
+    const int idleNodesOnHost = locality>0 ? 0 : idleNodesPerHost[p->getNodeName()];
+
+    const bool isBetter =
+      result == _nodes.end()
+      ||
+      locality > bestLocality
+      ||
+      (locality == bestLocality && idleNodesOnHost > bestIdleNodesOnHost)
+      ||
+      (locality == bestLocality && idleNodesOnHost == bestIdleNodesOnHost && p->getRank() < result->getRank());
+
+    if (isBetter) {
+      result              = p;
+      bestLocality        = locality;
+      bestIdleNodesOnHost = idleNodesOnHost;
+    }
+  }
+
+  return result;
+}
+
+
+int tarch::parallel::TopologyAwareNodePoolStrategy::reserveNode(int forMaster) {
+  logTraceInWith1Argument( "reserveNode(int)", forMaster );
+  assertion1(hasIdleNode(forMaster),forMaster);
+
+  NodeContainer::iterator p = findBestIdleNode(forMaster);
+  assertion2( p!=_nodes.end(), forMaster, toString() );
+
+  logDebug(
+    "reserveNode(int)",
+    "found free node " << p->toString() << " for master " << forMaster <<
+    " on host " << getHost(forMaster) << " (socket " << getSocket(forMaster) << ")"
+  );
+
+  const int result = p->getRank();
+  p->activate();
+  _nodes.sort();
+
+  logTraceOutWith1Argument( "reserveNode(int)", result );
+  return result;
+}
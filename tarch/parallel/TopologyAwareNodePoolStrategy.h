@@ -0,0 +1,153 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_PARALLEL_TOPOLOGY_AWARE_NODE_POOL_STRATEGY_H_
+#define _TARCH_PARALLEL_TOPOLOGY_AWARE_NODE_POOL_STRATEGY_H_
+
+
+#include "tarch/parallel/FCFSNodePoolStrategy.h"
+#include "tarch/logging/Log.h"
+
+#include <map>
+#include <string>
+
+
+namespace tarch {
+  namespace parallel {
+    class TopologyAwareNodePoolStrategy;
+  }
+}
+
+
+/**
+ * Topology-aware Node Pool Strategy
+ *
+ * The FCFS strategy hands out the first idle rank it finds. It does not know
+ * where the ranks live, so master-worker traffic often crosses the network
+ * although there are idle ranks on the master's node. This strategy groups
+ * the ranks by the host they are running on. Each rank tells the node pool
+ * its host when it registers (see NodePool::restart() and the node name of
+ * RegisterAtNodePoolMessage). Besides the host, the strategy knows a socket
+ * per rank if the user configures one.
+ *
+ * <h2> Choice of a worker </h2>
+ *
+ * If a master asks for a worker, the strategy picks the idle rank
+ *
+ * - on the same socket of the master's host, or, if there is none,
+ * - on the master's host, or, if there is none,
+ * - on the host with the most idle ranks. The new worker then is likely to
+ *   find workers on its own host if it forks further.
+ *
+ * Among equally good ranks, the strategy takes the one with the smallest
+ * rank. Requests without a master (AnyMaster) are treated like requests from a
+ * remote host. The order in which requests are answered is inherited from the
+ * FCFS strategy.
+ *
+ * <h2> Sockets </h2>
+ *
+ * MPI does not tell us to which socket a rank is bound. Users thus either
+ * set the socket of individual ranks via setSocket(), or they pass the number
+ * of ranks per socket to the constructor. The latter assumes that ranks are
+ * placed block-wise, i.e. that ranks 0 to ranksPerSocket-1 share one socket,
+ * and so forth. This is the default of most mpirun implementations with
+ * binding to sockets. Explicit entries have priority. If the socket of a rank
+ * is not known, the strategy only compares hosts.
+ *
+ * <h2> Usage </h2>
+ *
+ * <pre>
+  if (tarch::parallel::Node::getInstance().isGlobalMaster()) {
+    tarch::parallel::TopologyAwareNodePoolStrategy* strategy = new tarch::parallel::TopologyAwareNodePoolStrategy(12);
+    tarch::parallel::NodePool::getInstance().setStrategy( strategy );
+  }
+   </pre>
+ *
+ * The node pool takes over the ownership of the strategy.
+ */
+class tarch::parallel::TopologyAwareNodePoolStrategy: public tarch::parallel::FCFSNodePoolStrategy {
+  private:
+    static tarch::logging::Log _log;
+
+    const int           _ranksPerSocket;
+
+    std::map<int,int>   _socketOfRank;
+
+    /**
+     * Host of the global master. The global master does not register at the
+     * node pool, so we have to find out its host ourselves.
+     */
+    std::string         _hostOfGlobalMaster;
+
+    /**
+     * Find the best idle node for a master. Returns _nodes.end() if there is
+     * no idle node.
+     */
+    NodeContainer::iterator findBestIdleNode(int forMaster);
+  public:
+    /**
+     * @param ranksPerSocket Number of ranks per socket if the ranks are
+     *          placed block-wise. 0 if the socket is not known.
+     */
+    TopologyAwareNodePoolStrategy(int ranksPerSocket = 0);
+    virtual ~TopologyAwareNodePoolStrategy();
+
+    /**
+     * Besides the tag, we memorise the host of the global master, i.e. of the
+     * rank that holds the strategy.
+     */
+    void setNodePoolTag(int tag) override;
+
+    /**
+     * Forwards to addNode(int,std::string).
+     */
+    void addNode(const tarch::parallel::messages::RegisterAtNodePoolMessage& node ) override;
+
+    /**
+     * Register a rank. Is used by the node pool in the parallel mode and by
+     * the tests.
+     *
+     * @param nodeName Either a plain host name or the machine information
+     *          as returned by tarch::logging::Log::getMachineInformation().
+     */
+    void addNode(int rank, const std::string& nodeName);
+
+    int reserveNode(int forMaster) override;
+
+    /**
+     * Overwrite the socket of one rank. The socket numbers have to be unique
+     * per host only.
+     */
+    void setSocket(int rank, int socket);
+
+    /**
+     * @return Socket of the rank or -1 if it is not known.
+     */
+    int getSocket(int rank) const;
+
+    /**
+     * @return Host of a registered rank or of the global master. Empty
+     *         string if the rank is not known.
+     */
+    std::string getHost(int rank) const;
+
+    /**
+     * @return Number of idle ranks on a host.
+     */
+    int getNumberOfIdleNodes(const std::string& host) const;
+
+    using FCFSNodePoolStrategy::getNumberOfIdleNodes;
+
+    /**
+     * Extract the host from the machine information. Log::getMachineInformation()
+     * yields something like "[host],rank:12". We return "host". Strings
+     * without square brackets are returned without the rank suffix.
+     *
+     * If the code is translated without CompilerHasUTSName, the machine
+     * information is "rank:12" only. We then return the empty string, i.e.
+     * all ranks seem to be remote, and the strategy degenerates to handing
+     * out the idle rank with the smallest number.
+     */
+    static std::string extractHostName(const std::string& nodeName);
+};
+
+#endif
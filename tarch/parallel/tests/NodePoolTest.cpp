@@ -0,0 +1,188 @@
+#include "tarch/parallel/tests/NodePoolTest.h"
+#include "tarch/parallel/NodePool.h"
+#include "tarch/parallel/Node.h"
+#include "tarch/parallel/FCFSNodePoolStrategy.h"
+
+
+#include <algorithm>
+#include <chrono>
+#include <set>
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(tarch::parallel::tests::NodePoolTest)
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+tarch::parallel::tests::NodePoolTest::NodePoolTest():
+  TestCase( "tarch::parallel::tests::NodePoolTest" ) {
+}
+
+
+tarch::parallel::tests::NodePoolTest::~NodePoolTest() {
+}
+
+
+void tarch::parallel::tests::NodePoolTest::run() {
+  testMethod( testGetSubPoolManager );
+  testMethod( testFlatNodePool );
+  testMethod( testHierarchicalNodePool );
+}
+
+
+void tarch::parallel::tests::NodePoolTest::testGetSubPoolManager() {
+  const int globalMaster = Node::getGlobalMasterRank();
+
+  validateEquals( NodePool::getSubPoolManager(0,4),  globalMaster );
+  validateEquals( NodePool::getSubPoolManager(1,4),  globalMaster );
+  validateEquals( NodePool::getSubPoolManager(3,4),  globalMaster );
+  validateEquals( NodePool::getSubPoolManager(4,4),  4 );
+  validateEquals( NodePool::getSubPoolManager(5,4),  4 );
+  validateEquals( NodePool::getSubPoolManager(7,4),  4 );
+  validateEquals( NodePool::getSubPoolManager(8,4),  8 );
+  validateEquals( NodePool::getSubPoolManager(11,4), 8 );
+  validateEquals( NodePool::getSubPoolManager(12,4), 12 );
+}
+
+
+void tarch::parallel::tests::NodePoolTest::testFlatNodePool() {
+  const int globalMaster = Node::getGlobalMasterRank();
+
+  validateEquals( NodePool::getSubPoolManager(0,0),   globalMaster );
+  validateEquals( NodePool::getSubPoolManager(5,0),   globalMaster );
+  validateEquals( NodePool::getSubPoolManager(123,0), globalMaster );
+}
+
+
+
+void tarch::parallel::tests::NodePoolTest::serveAsWorker(int round) {
+  #ifdef Parallel
+  const int rank            = Node::getInstance().getRank();
+  const int ranksPerSubPool = NodePool::getInstance().getRanksPerSubPool();
+  const int manager         = NodePool::getSubPoolManager(rank,ranksPerSubPool);
+  const int ranksInSubPool  = std::min(rank+ranksPerSubPool,Node::getInstance().getNumberOfNodes()) - rank - 1;
+
+  NodePool::JobRequestMessageAnswer answer = NodePool::getInstance().waitForJob();
+  while (answer!=NodePool::JobRequestMessageAnswerValues::Terminate) {
+    validateWithParams1( answer>=0, rank );
+
+    if ( round<3 && answer==Node::getGlobalMasterRank() && manager==rank && ranksInSubPool>0 ) {
+      // Managers book their sub-pool. Nobody else asks for ranks in the
+      // first round, so the whole sub-pool has to be idle.
+      std::vector<int> workers = NodePool::getInstance().reserveFreeNodes(ranksInSubPool);
+      if (round==1) {
+        validateEqualsWithParams1( static_cast<int>(workers.size()), ranksInSubPool, rank );
+      }
+      for (int worker: workers) {
+        validateEqualsWithParams2( NodePool::getSubPoolManager(worker,ranksPerSubPool), rank, worker, rank );
+      }
+    }
+    else if (
+      round==2
+      &&
+      (
+        (answer==manager && manager!=Node::getGlobalMasterRank())
+        ||
+        (answer==Node::getGlobalMasterRank() && rank==1)
+      )
+    ) {
+      // Ranks of a sub-pool find their manager dry and escalate to the
+      // global master. Rank 1 asks the global master directly.
+      std::vector<int> workers = NodePool::getInstance().reserveFreeNodes(2);
+      validateWithParams1( workers.size()<=2, rank );
+      validateWithParams1( std::find(workers.begin(),workers.end(),rank)==workers.end(), rank );
+    }
+
+    answer = NodePool::getInstance().waitForJob();
+  }
+  #endif
+}
+
+
+void tarch::parallel::tests::NodePoolTest::testHierarchicalNodePool() {
+  #ifdef Parallel
+  const int numberOfRanks   = Node::getInstance().getNumberOfNodes();
+  const int ranksPerSubPool = 4;
+
+  if (numberOfRanks>1) {
+    NodePool& pool = NodePool::getInstance();
+
+    // Ranks served by the global master directly: the first sub-pool plus
+    // the managers
+    int ranksOfGlobalMaster = 0;
+    for (int rank=1; rank<numberOfRanks; rank++) {
+      if (NodePool::getSubPoolManager(rank,ranksPerSubPool)==Node::getGlobalMasterRank() || rank%ranksPerSubPool==0) {
+        ranksOfGlobalMaster++;
+      }
+    }
+
+    pool.setRanksPerSubPool(ranksPerSubPool);
+
+    //
+    // Round 1: registration, requests served by the managers and
+    // termination of populated sub-pools. Round 2: additional requests that
+    // the managers cannot serve
+    //
+    for (int round=1; round<=2; round++) {
+      if (Node::getInstance().isGlobalMaster()) {
+        pool.setStrategy( new FCFSNodePoolStrategy() );
+        pool.restart();
+        pool.waitForAllNodesToBecomeIdle();
+        validateEqualsWithParams1( pool.getNumberOfIdleNodes(), numberOfRanks-1, round );
+
+        std::vector<int> workers = pool.reserveFreeNodes(ranksOfGlobalMaster);
+        validateEqualsWithParams1( static_cast<int>(workers.size()), ranksOfGlobalMaster, round );
+        for (int worker: workers) {
+          validateWithParams2( NodePool::getSubPoolManager(worker,ranksPerSubPool)==Node::getGlobalMasterRank() || worker%ranksPerSubPool==0, worker, round );
+        }
+
+        pool.waitForAllNodesToBecomeIdle();
+        validateEqualsWithParams1( pool.getNumberOfIdleNodes(), numberOfRanks-1, round );
+        pool.terminate();
+      }
+      else {
+        pool.restart();
+        serveAsWorker(round);
+      }
+    }
+
+    //
+    // Round 3: the global master books all ranks, i.e. the managers have to
+    // return theirs
+    //
+    if (Node::getInstance().isGlobalMaster()) {
+      pool.setStrategy( new FCFSNodePoolStrategy() );
+      pool.restart();
+      pool.waitForAllNodesToBecomeIdle();
+
+      std::set<int> bookedRanks;
+      const auto    timeOut = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+      while ( static_cast<int>(bookedRanks.size())<numberOfRanks-1 && std::chrono::steady_clock::now()<timeOut ) {
+        std::vector<int> workers = pool.reserveFreeNodes(numberOfRanks-1);
+        bookedRanks.insert( workers.begin(), workers.end() );
+        pool.receiveDanglingMessages();
+      }
+      validateEquals( static_cast<int>(bookedRanks.size()), numberOfRanks-1 );
+
+      pool.waitForAllNodesToBecomeIdle();
+      validateEquals( pool.getNumberOfIdleNodes(), numberOfRanks-1 );
+      pool.terminate();
+    }
+    else {
+      pool.restart();
+      serveAsWorker(3);
+    }
+
+    pool.setRanksPerSubPool(0);
+  }
+  #endif
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
@@ -0,0 +1,66 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_PARALLEL_TESTS_NODE_POOL_TEST_H_
+#define _TARCH_PARALLEL_TESTS_NODE_POOL_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+namespace tarch {
+  namespace parallel {
+    namespace tests {
+      class NodePoolTest;
+    }
+  }
+}
+
+
+/**
+ * Most tests check the mapping of ranks onto sub-pools which does not depend
+ * on any MPI state. testHierarchicalNodePool() needs a real MPI run with more
+ * than one rank and degenerates to nop otherwise. Run it with eight ranks or
+ * more to cover the sub-pools, e.g. mpirun -np 8.
+ */
+class tarch::parallel::tests::NodePoolTest: public tarch::tests::TestCase {
+  private:
+    /**
+     * Sub-pools of four ranks. Ranks 0 to 3 are served by the global master,
+     * the other ranks by the first rank of their block.
+     */
+    void testGetSubPoolManager();
+
+    /**
+     * Without sub-pools, the global master serves everybody.
+     */
+    void testFlatNodePool();
+
+    /**
+     * All ranks run through the node pool protocol with sub-pools of four
+     * ranks. The test is run on all ranks at the same time. It requires the
+     * node pool to be initialised, i.e. peano::initParallelEnvironment() to
+     * be called before the tests.
+     *
+     * - The first round covers the registration, requests served by the
+     *   managers and the termination of sub-pools that still hold ranks.
+     * - In the second round, further ranks ask their dry manager and then
+     *   the global master for workers. Rank 1 asks the global master
+     *   directly.
+     * - The third round makes the global master book all ranks. This works
+     *   only if the managers return their idle ranks (ReturnToGlobalMaster).
+     *   Afterwards, the managers terminate with empty sub-pools.
+     */
+    void testHierarchicalNodePool();
+
+    /**
+     * Worker side of testHierarchicalNodePool(). Serves jobs until the node
+     * pool terminates.
+     */
+    void serveAsWorker(int round);
+  public:
+    NodePoolTest();
+    virtual ~NodePoolTest();
+    virtual void run();
+};
+
+
+#endif
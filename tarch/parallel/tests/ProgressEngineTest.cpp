@@ -0,0 +1,183 @@
+#include "tarch/parallel/tests/ProgressEngineTest.h"
+#include "tarch/parallel/ProgressEngine.h"
+#include "tarch/parallel/Node.h"
+#include "tarch/multicore/Lock.h"
+#include "tarch/multicore/Jobs.h"
+
+
+#include <atomic>
+#include <vector>
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(tarch::parallel::tests::ProgressEngineTest)
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+tarch::parallel::tests::ProgressEngineTest::ProgressEngineTest():
+  TestCase( "tarch::parallel::tests::ProgressEngineTest" ) {
+}
+
+
+tarch::parallel::tests::ProgressEngineTest::~ProgressEngineTest() {
+}
+
+
+void tarch::parallel::tests::ProgressEngineTest::run() {
+  testMethod( testRegisterSuspendAndActivate );
+  testMethod( testNestedPauses );
+  testMethod( testRequestCompletion );
+}
+
+
+void tarch::parallel::tests::ProgressEngineTest::invokePollingRoutine(int handle) {
+  ProgressEngine& engine = ProgressEngine::getInstance();
+
+  // Other components' routines must not run on this thread, as they might
+  // try to pause themselves while we hold the engine's semaphore
+  std::vector<int> otherHandles;
+  tarch::multicore::Lock lock(engine._pollingRoutinesSemaphore);
+  for (auto& p: engine._pollingRoutines) {
+    if (p.first!=handle) {
+      otherHandles.push_back(p.first);
+    }
+  }
+  lock.free();
+
+  std::vector<int> pauseTokens;
+  for (int p: otherHandles) {
+    pauseTokens.push_back( engine.pausePollingRoutine(p) );
+  }
+
+  lock.lock();
+  engine.invokeActivePollingRoutines();
+  lock.free();
+
+  for (int p: pauseTokens) {
+    engine.resumePollingRoutine(p);
+  }
+}
+
+
+void tarch::parallel::tests::ProgressEngineTest::testRegisterSuspendAndActivate() {
+  ProgressEngine&   engine = ProgressEngine::getInstance();
+  std::atomic<int>  invocations(0);
+
+  const int handle = engine.registerPollingRoutine(
+    "tarch::parallel::tests::ProgressEngineTest",
+    [&invocations]() -> void {
+      invocations.fetch_add(1);
+    },
+    false
+  );
+  validate( handle!=ProgressEngine::InvalidHandle );
+  validate( !engine.isPollingRoutineActive(handle) );
+
+  invokePollingRoutine(handle);
+  validateEquals( invocations.load(), 0 );
+
+  engine.activatePollingRoutine(handle);
+  validate( engine.isPollingRoutineActive(handle) );
+  invokePollingRoutine(handle);
+  validate( invocations.load()>0 );
+
+  engine.suspendPollingRoutine(handle);
+  validate( !engine.isPollingRoutineActive(handle) );
+  const int invocationsWhileSuspended = invocations.load();
+  invokePollingRoutine(handle);
+  validateEquals( invocations.load(), invocationsWhileSuspended );
+
+  engine.activatePollingRoutine(handle);
+  invokePollingRoutine(handle);
+  validate( invocations.load()>invocationsWhileSuspended );
+
+  engine.deregisterPollingRoutine(handle);
+}
+
+
+void tarch::parallel::tests::ProgressEngineTest::testNestedPauses() {
+  ProgressEngine&   engine = ProgressEngine::getInstance();
+  std::atomic<int>  invocations(0);
+
+  validateEquals( engine.pausePollingRoutine(ProgressEngine::InvalidHandle), ProgressEngine::InvalidHandle );
+
+  const int handle = engine.registerPollingRoutine(
+    "tarch::parallel::tests::ProgressEngineTest",
+    [&invocations]() -> void {
+      invocations.fetch_add(1);
+    },
+    true
+  );
+
+  const int firstToken  = engine.pausePollingRoutine(handle);
+  const int secondToken = engine.pausePollingRoutine(handle);
+  validateEquals( firstToken,  handle );
+  validateEquals( secondToken, handle );
+  validate( engine.isPollingRoutineActive(handle) );
+
+  const int invocationsWhilePaused = invocations.load();
+  invokePollingRoutine(handle);
+  validateEquals( invocations.load(), invocationsWhilePaused );
+
+  engine.resumePollingRoutine(firstToken);
+  invokePollingRoutine(handle);
+  validateEquals( invocations.load(), invocationsWhilePaused );
+
+  engine.resumePollingRoutine(secondToken);
+  invokePollingRoutine(handle);
+  validate( invocations.load()>invocationsWhilePaused );
+
+  engine.deregisterPollingRoutine(handle);
+}
+
+
+void tarch::parallel::tests::ProgressEngineTest::testRequestCompletion() {
+  #ifdef Parallel
+  ProgressEngine&   engine = ProgressEngine::getInstance();
+  std::atomic<int>  completedRequests(0);
+
+  const int tag  = Node::reserveFreeTag( "tarch::parallel::tests::ProgressEngineTest" );
+  const int rank = Node::getInstance().getRank();
+
+  int sentValue     = 23 + rank;
+  int receivedValue = -1;
+
+  MPI_Request receiveRequest;
+  MPI_Request sendRequest;
+  MPI_Irecv( &receivedValue, 1, MPI_INT, rank, tag, Node::getInstance().getCommunicator(), &receiveRequest );
+  MPI_Isend( &sentValue,     1, MPI_INT, rank, tag, Node::getInstance().getCommunicator(), &sendRequest );
+
+  for (MPI_Request request: {receiveRequest,sendRequest}) {
+    engine.addRequest(
+      request,
+      new tarch::multicore::jobs::GenericJobWithCopyOfFunctor(
+        [&completedRequests]() -> bool {
+          completedRequests.fetch_add(1);
+          return false;
+        },
+        tarch::multicore::jobs::JobType::ProcessImmediately,
+        0
+      )
+    );
+  }
+
+  // Without a thread of its own, the engine completes the requests only if
+  // it is polled
+  while (completedRequests.load()<2) {
+    engine.receiveDanglingMessages();
+  }
+
+  validateEquals( receivedValue, 23 + rank );
+
+  Node::releaseTag(tag);
+  #endif
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
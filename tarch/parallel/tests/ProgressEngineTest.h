@@ -0,0 +1,59 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_PARALLEL_TESTS_PROGRESS_ENGINE_TEST_H_
+#define _TARCH_PARALLEL_TESTS_PROGRESS_ENGINE_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+namespace tarch {
+  namespace parallel {
+    namespace tests {
+      class ProgressEngineTest;
+    }
+  }
+}
+
+
+/**
+ * The tests invoke the polling routines through the engine's own sweep
+ * while they hold the engine's semaphore. If the engine has a thread of its
+ * own, this thread might invoke the routines as well. We thus only check
+ * whether a routine has been invoked at all, never how often.
+ * testRequestCompletion() requires MPI and is nop otherwise.
+ */
+class tarch::parallel::tests::ProgressEngineTest: public tarch::tests::TestCase {
+  private:
+    /**
+     * Run once through the engine's routines while all routines besides
+     * handle are paused.
+     */
+    void invokePollingRoutine(int handle);
+
+    /**
+     * Register a routine that is not active, activate it, suspend it and
+     * activate it again.
+     */
+    void testRegisterSuspendAndActivate();
+
+    /**
+     * Pause an active routine twice. The engine may invoke it again only
+     * once both pauses are resumed. The pauses do not alter whether the
+     * routine is active.
+     */
+    void testNestedPauses();
+
+    /**
+     * Send an integer to the own rank and hand both the send and the
+     * receive request over to the engine. Both continuations have to run
+     * and the integer has to arrive.
+     */
+    void testRequestCompletion();
+  public:
+    ProgressEngineTest();
+    virtual ~ProgressEngineTest();
+    virtual void run();
+};
+
+
+#endif
@@ -0,0 +1,165 @@
+#include "tarch/parallel/tests/TopologyAwareNodePoolStrategyTest.h"
+#include "tarch/parallel/TopologyAwareNodePoolStrategy.h"
+#include "tarch/parallel/Node.h"
+
+
+#include "tarch/tests/TestCaseFactory.h"
+registerTest(tarch::parallel::tests::TopologyAwareNodePoolStrategyTest)
+
+
+#ifdef Parallel
+#include <mpi.h>
+#include <vector>
+#endif
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",off)
+#endif
+
+
+tarch::parallel::tests::TopologyAwareNodePoolStrategyTest::TopologyAwareNodePoolStrategyTest():
+  TestCase( "tarch::parallel::tests::TopologyAwareNodePoolStrategyTest" ) {
+}
+
+
+tarch::parallel::tests::TopologyAwareNodePoolStrategyTest::~TopologyAwareNodePoolStrategyTest() {
+}
+
+
+void tarch::parallel::tests::TopologyAwareNodePoolStrategyTest::run() {
+  testMethod( testExtractHostName );
+  testMethod( testPrefersMasterHost );
+  testMethod( testPrefersMasterSocket );
+  testMethod( testRemoteHostWithMostIdleNodes );
+  testMethod( testLocalRanks );
+}
+
+
+void tarch::parallel::tests::TopologyAwareNodePoolStrategyTest::testExtractHostName() {
+  validateEquals( TopologyAwareNodePoolStrategy::extractHostName("[node17],rank:12"), "node17" );
+  validateEquals( TopologyAwareNodePoolStrategy::extractHostName("[node17]rank:0"),   "node17" );
+  validateEquals( TopologyAwareNodePoolStrategy::extractHostName("node17,rank:12"),   "node17" );
+  validateEquals( TopologyAwareNodePoolStrategy::extractHostName("node17"),           "node17" );
+  validateEquals( TopologyAwareNodePoolStrategy::extractHostName("rank:12"),          "" );
+}
+
+
+void tarch::parallel::tests::TopologyAwareNodePoolStrategyTest::testPrefersMasterHost() {
+  TopologyAwareNodePoolStrategy strategy;
+
+  for (int rank=1; rank<8; rank++) {
+    strategy.addNode( rank, rank<4 ? "[a],rank:0" : "[b],rank:0" );
+    strategy.setNodeIdle( rank );
+  }
+  strategy.reserveParticularNode( 2 );
+
+  validateEquals( strategy.getNumberOfIdleNodes(), 6 );
+  validateEquals( strategy.getNumberOfIdleNodes("a"), 2 );
+  validateEquals( strategy.getNumberOfIdleNodes("b"), 4 );
+  validateEquals( strategy.getHost(2), "a" );
+  validateEquals( strategy.getSocket(2), -1 );
+
+  validateEquals( strategy.reserveNode(2), 1 );
+  validateEquals( strategy.reserveNode(2), 3 );
+  validateEquals( strategy.reserveNode(2), 4 );
+
+  strategy.setNodeIdle( 3 );
+  validateEquals( strategy.reserveNode(2), 3 );
+
+  validateEquals( strategy.reserveNode(4), 5 );
+  validateEquals( strategy.getNumberOfIdleNodes(), 2 );
+}
+
+
+void tarch::parallel::tests::TopologyAwareNodePoolStrategyTest::testPrefersMasterSocket() {
+  TopologyAwareNodePoolStrategy strategy(2);
+
+  for (int rank=1; rank<6; rank++) {
+    strategy.addNode( rank, "[a],rank:0" );
+    strategy.setNodeIdle( rank );
+  }
+  strategy.reserveParticularNode( 3 );
+  strategy.setSocket( 5, 1 );
+
+  validateEquals( strategy.getSocket(1), 0 );
+  validateEquals( strategy.getSocket(2), 1 );
+  validateEquals( strategy.getSocket(3), 1 );
+  validateEquals( strategy.getSocket(4), 2 );
+  validateEquals( strategy.getSocket(5), 1 );
+
+  validateEquals( strategy.reserveNode(3), 2 );
+  validateEquals( strategy.reserveNode(3), 5 );
+  validateEquals( strategy.reserveNode(3), 1 );
+  validateEquals( strategy.reserveNode(3), 4 );
+  validate( !strategy.hasIdleNode(3) );
+}
+
+
+void tarch::parallel::tests::TopologyAwareNodePoolStrategyTest::testRemoteHostWithMostIdleNodes() {
+  TopologyAwareNodePoolStrategy strategy;
+
+  strategy.addNode( 1, "a" );
+  strategy.addNode( 2, "b" );
+  strategy.addNode( 3, "b" );
+  strategy.addNode( 4, "c" );
+  strategy.addNode( 5, "c" );
+  strategy.addNode( 6, "c" );
+
+  strategy.setNodeIdle( 3 );
+  strategy.setNodeIdle( 5 );
+  strategy.setNodeIdle( 6 );
+
+  validateEquals( strategy.reserveNode(1), 5 );
+  validateEquals( strategy.reserveNode(1), 3 );
+  validateEquals( strategy.reserveNode(1), 6 );
+
+  strategy.setNodeIdle( 2 );
+  strategy.setNodeIdle( 3 );
+  strategy.setNodeIdle( 5 );
+  validateEquals( strategy.reserveNode(TopologyAwareNodePoolStrategy::AnyMaster), 2 );
+}
+
+
+void tarch::parallel::tests::TopologyAwareNodePoolStrategyTest::testLocalRanks() {
+  #ifdef Parallel
+  const int numberOfRanks = Node::getInstance().getNumberOfNodes();
+  const int localRank     = Node::getInstance().getRank();
+
+  char localHost[MPI_MAX_PROCESSOR_NAME+1] = {0};
+  int  lengthOfLocalHost = 0;
+  MPI_Get_processor_name( localHost, &lengthOfLocalHost );
+
+  std::vector<char> hosts( numberOfRanks * (MPI_MAX_PROCESSOR_NAME+1), 0 );
+  MPI_Allgather(
+    localHost,    MPI_MAX_PROCESSOR_NAME+1, MPI_CHAR,
+    hosts.data(), MPI_MAX_PROCESSOR_NAME+1, MPI_CHAR,
+    Node::getInstance().getCommunicator()
+  );
+
+  TopologyAwareNodePoolStrategy strategy;
+  int numberOfRanksOnLocalHost = 0;
+  for (int rank=0; rank<numberOfRanks; rank++) {
+    const std::string host( hosts.data() + rank*(MPI_MAX_PROCESSOR_NAME+1) );
+    strategy.addNode( rank, host );
+    strategy.setNodeIdle( rank );
+    if (host==std::string(localHost) && rank!=localRank) {
+      numberOfRanksOnLocalHost++;
+    }
+  }
+  strategy.reserveParticularNode( localRank );
+
+  for (int i=0; i<numberOfRanks-1; i++) {
+    const int  worker         = strategy.reserveNode( localRank );
+    const bool isOnLocalHost  = strategy.getHost(worker)==std::string(localHost);
+    const bool shallBeLocal   = i<numberOfRanksOnLocalHost;
+    validateEqualsWithParams2( isOnLocalHost, shallBeLocal, worker, strategy.toString() );
+  }
+  validate( !strategy.hasIdleNode(localRank) );
+  #endif
+}
+
+
+#ifdef UseTestSpecificCompilerSettings
+#pragma optimize("",on)
+#endif
@@ -0,0 +1,61 @@
+// This file is part of the Peano project. For conditions of distribution and
+// use, please see the copyright notice at www.peano-framework.org
+#ifndef _TARCH_PARALLEL_TESTS_TOPOLOGY_AWARE_NODE_POOL_STRATEGY_TEST_H_
+#define _TARCH_PARALLEL_TESTS_TOPOLOGY_AWARE_NODE_POOL_STRATEGY_TEST_H_
+
+
+#include "tarch/tests/TestCase.h"
+
+namespace tarch {
+  namespace parallel {
+    namespace tests {
+      class TopologyAwareNodePoolStrategyTest;
+    }
+  }
+}
+
+
+/**
+ * Most tests feed synthetic registrations into a strategy and thus run in
+ * the serial mode, too. testLocalRanks() is the exception: It registers all
+ * ranks of the current MPI run with their real hosts in a rank-local
+ * strategy, i.e. it does not touch the node pool. Run the tests with several
+ * local ranks, e.g. mpirun -np 4, to exercise it.
+ */
+class tarch::parallel::tests::TopologyAwareNodePoolStrategyTest: public tarch::tests::TestCase {
+  private:
+    void testExtractHostName();
+
+    /**
+     * Two hosts. The master's host is served first. Once it runs out of idle
+     * ranks, the other host is used.
+     */
+    void testPrefersMasterHost();
+
+    /**
+     * Block-wise placement with two ranks per socket plus one explicit socket
+     * entry.
+     */
+    void testPrefersMasterSocket();
+
+    /**
+     * If the master's host has no idle ranks, the host with the most idle
+     * ranks is chosen.
+     */
+    void testRemoteHostWithMostIdleNodes();
+
+    /**
+     * Every rank gathers the hosts of all ranks, registers them at a local
+     * strategy and reserves all of them for itself. All ranks on the own
+     * host have to be served before any remote rank. Degenerates to nothing
+     * in the serial mode.
+     */
+    void testLocalRanks();
+  public:
+    TopologyAwareNodePoolStrategyTest();
+    virtual ~TopologyAwareNodePoolStrategyTest();
+    virtual void run();
+};
+
+
+#endif